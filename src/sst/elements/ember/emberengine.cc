@@ -32,13 +32,17 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
     Component( id ),
 	currentMotif(0),
 	m_motifDone(false),
-	m_detailedCompute(NULL)
+	m_detailedCompute(NULL),
+	m_numInline(0),
+	m_numScheduled(0)
 {
 	// Get the level of verbosity the user is asking to print out, default is 1
 	// which means don't print much.
 	uint32_t verbosity = (uint32_t) params.find("verbose", 1);
 	uint32_t mask = (uint32_t) params.find("verboseMask", 0);
 	m_jobId = params.find("jobId", -1);
+	m_inlineEvents = params.find<bool>("inlineEvents", false);
+	m_inlineBatch = params.find<uint32_t>("inlineBatch", 1024);
 
 
 	std::ostringstream prefix;
@@ -83,6 +87,9 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
         params.insert("motif" + tmp.str() + ".rankmap.mapFile", params.find<string>("mapFile", "mapFile.txt"), true);
         //NetworkSim->end
 
+        // a motif's own replay param wins over the engine wide default
+        params.insert("motif" + tmp.str() + ".replay", params.find<string>("replayMotifs", "false"), false);
+
 		motifParams[i] = params.get_scoped_params( "motif" + tmp.str() );
 	}
 
@@ -101,6 +108,9 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
 	// Create a time converter for our compute events
 	nanoTimeConverter =
         Simulation::getSimulation()->getTimeLord()->getTimeConverter("1ns");
+
+	m_statInline = registerStatistic<uint64_t>("events_inline");
+	m_statScheduled = registerStatistic<uint64_t>("events_scheduled");
 }
 
 EmberEngine::~EmberEngine() {
@@ -215,6 +225,9 @@ void EmberEngine::init(unsigned int phase) {
 }
 
 void EmberEngine::finish() {
+    m_statInline->addData( m_numInline );
+    m_statScheduled->addData( m_numScheduled );
+
     ApiMap::iterator iter = m_apiMap.begin();
     for ( ; iter != m_apiMap.end(); ++ iter ) {
         iter->second->api->finish();
@@ -252,6 +265,64 @@ void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
 
     output.debug(CALL_INFO, 8, ENGINE_MASK, "Engine issuing next event with delay %" PRIu64 "\n", nanoDelay);
 
+    if ( m_inlineEvents && 0 == nanoDelay ) {
+        issueInline();
+        return;
+    }
+
+	EmberEvent* nextEv = nextEvent();
+	if ( nextEv ) {
+		// issue the next event to the engine for deliver later
+		scheduleEvent( nanoDelay * 1000, nextEv );
+	}
+}
+
+// Events which do not call into an API (GetTime, Compute ...) are issued
+// and completed here, a nonzero delay costs a single trip through the
+// event queue rather than two. Events which call an API still go through
+// the event queue, this may be called from an API's completion callback
+// and the API must not be re-entered from there.
+void EmberEngine::issueInline() {
+
+    for ( uint32_t i = 0; i < m_inlineBatch; i++ ) {
+
+        EmberEvent* ev = nextEvent();
+        if ( NULL == ev ) {
+            return;
+        }
+
+        if ( EmberEvent::Issue != ev->state() ) {
+            scheduleEvent( 0, ev );
+            return;
+        }
+
+        output.debug(CALL_INFO, 2, ENGINE_MASK, "inline %s Event\n", ev->getName().c_str());
+
+        ev->issue( getCurrentSimTimeNano() );
+        ++m_numInline;
+
+        uint64_t delay = ev->completeDelayNS();
+        if ( delay ) {
+            scheduleEvent( delay * 1000, ev );
+            return;
+        }
+
+        if ( ev->complete( getCurrentSimTimeNano() ) && ! ev->recorded() ) {
+            delete ev;
+        }
+    }
+
+    // batch used up, let everything else at this time run first
+    EmberEvent* ev = nextEvent();
+    if ( ev ) {
+        scheduleEvent( 0, ev );
+    }
+}
+
+// The next event to issue, refilling the queue and moving on to the next
+// motif as needed. NULL once the last motif is done.
+EmberEvent* EmberEngine::nextEvent() {
+
     while ( evQueue.empty() ) {
 
         if ( ! m_motifDone ) {
@@ -271,7 +342,7 @@ void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
             delete m_generator;
 
             if ( ++currentMotif == motifParams.size() ) {
-                return;
+                return NULL;
             } else {
                 m_generator = initMotif( motifParams[currentMotif],
 								m_apiMap, m_jobId, currentMotif, m_nodePerf );
@@ -289,8 +360,7 @@ void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
 	EmberEvent* nextEv = evQueue.front();
 	evQueue.pop();
 
-	// issue the next event to the engine for deliver later
-	selfEventLink->send(nanoDelay, nanoTimeConverter, nextEv);
+	return nextEv;
 }
 
 bool EmberEngine::completeFunctor( int retval, EmberEvent* ev )
@@ -298,7 +368,7 @@ bool EmberEngine::completeFunctor( int retval, EmberEvent* ev )
     output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
               ev->stateName( ev->state() ).c_str(), ev->getName().c_str());
 
-    if ( ev->complete( getCurrentSimTimeNano(), retval ) ) {
+    if ( ev->complete( getCurrentSimTimeNano(), retval ) && ! ev->recorded() ) {
         delete ev;
     }
 
@@ -321,7 +391,7 @@ void EmberEngine::handleEvent(Event* ev) {
 
         eEv->issue( getCurrentSimTimeNano() );
 
-	    selfEventLink->send( eEv->completeDelayNS() * 1000, ev );
+	    scheduleEvent( eEv->completeDelayNS() * 1000, eEv );
         break;
 
       case EmberEvent::IssueFunctor:
@@ -344,7 +414,7 @@ void EmberEngine::handleEvent(Event* ev) {
         break;
 
       case EmberEvent::Complete:
-        if ( eEv->complete( getCurrentSimTimeNano() ) ) {
+        if ( eEv->complete( getCurrentSimTimeNano() ) && ! eEv->recorded() ) {
             delete ev;
         }
 	    issueNextEvent(0);
@@ -56,6 +56,9 @@ public:
         { "mapFile", "Sets the name of the input file for custom map", "mapFile.txt" },
 
         { "motif%(motif_count)d", "Sets the event generator or motif for the engine", "ember.EmberPingPongGenerator" },
+        { "inlineEvents", "Run events which need no API call in line rather than through the event queue", "false" },
+        { "inlineBatch", "Sets the maximum number of events run in line before going back through the event queue", "1024" },
+        { "replayMotifs", "Sets the default of the motif replay param, motifs that support it record one iteration and replay it", "false" },
     )
 	/* PARAMS
 		api.*
@@ -64,6 +67,11 @@ public:
 		distribParams.*
 	*/
 
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "events_inline", "Number of events run in line", "events", 1 },
+        { "events_scheduled", "Number of trips events took through the event queue", "events", 1 },
+    )
+
     SST_ELI_DOCUMENT_PORTS(
         {"detailed%(num_vNics)d", "Port connected to the detailed model", {}},
         {"nic", "Port connected to the nic", {}},
@@ -103,7 +111,9 @@ public:
 
 private:
 	bool refillQueue() {
-		return m_generator->generate( evQueue );
+		bool done = m_generator->generate( evQueue );
+		m_generator->recordEvents( evQueue );
+		return done;
 	}
 
     std::string getComputeModelName() {
@@ -115,6 +125,12 @@ private:
 
 	void handleEvent(SST::Event* ev);
 	void issueNextEvent(uint64_t nanoSecDelay);
+	void issueInline();
+	EmberEvent* nextEvent();
+	void scheduleEvent(uint64_t psDelay, EmberEvent* ev) {
+		++m_numScheduled;
+		selfEventLink->send(psDelay, ev);
+	}
 
     void completeCallback( EmberEvent* ev, int retval ) {
         completeFunctor(retval, ev);
@@ -152,6 +168,13 @@ private:
 	Thornhill::DetailedCompute* m_detailedCompute;
 	Thornhill::MemoryHeapLink*  m_memHeapLink;
 
+	bool                        m_inlineEvents;
+	uint32_t                    m_inlineBatch;
+	uint64_t                    m_numInline;
+	uint64_t                    m_numScheduled;
+	Statistic<uint64_t>*        m_statInline;
+	Statistic<uint64_t>*        m_statScheduled;
+
 	EmberEngine();			    		// For serialization
 	EmberEngine(const EmberEngine&);    // Do not implement
 	void operator=(const EmberEngine&); // Do not implement
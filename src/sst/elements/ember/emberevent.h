@@ -52,18 +52,31 @@ public:
     } m_state;
 
 	EmberEvent( Output* output, EmberEventTimeStatistic* stat = NULL) :
-        m_state(Issue), m_output(output), m_evStat(stat), m_completeDelayNS(0), m_retvalPtr(NULL)
+        m_state(Issue), m_output(output), m_evStat(stat), m_completeDelayNS(0), m_retvalPtr(NULL),
+        m_recorded(false)
 	{}
 	EmberEvent( Output* output, int* retval) :
-        m_state(Issue), m_output(output), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(retval)
+        m_state(Issue), m_output(output), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(retval),
+        m_recorded(false)
 	{}
 	EmberEvent( ) :
-        m_state(Issue), m_output(NULL), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(NULL) {}
+        m_state(Issue), m_output(NULL), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(NULL),
+        m_recorded(false) {}
 	~EmberEvent() {}
 
 	virtual std::string getName() { return "?????"; };
 
     State state() { return m_state; }
+
+    // A recorded event belongs to its generator, the engine does not delete
+    // it once complete and rearm() returns it to the state it was generated
+    // in so it can be issued again.
+    void setRecorded() {
+        m_recorded = true;
+        m_recordedState = m_state;
+    }
+    bool recorded() { return m_recorded; }
+    void rearm() { m_state = m_recordedState; }
     std::string stateName( State i ) { return m_enumName[i]; }
 
     virtual void issue( uint64_t time, FOO* = NULL ) {
@@ -120,6 +133,8 @@ public:
     uint64_t            m_completeDelayNS;
     uint64_t            m_issueTime;
     int*                m_retvalPtr;
+    bool                m_recorded;
+    State               m_recordedState;
 
     NotSerializable(EmberEvent)
 };
@@ -25,11 +25,16 @@ EmberGenerator::EmberGenerator( ComponentId_t id, Params& params, std::string na
     m_dataMode( NoBacking ),
     m_motifName( name ),
     m_ee(NULL),
-    m_curVirtAddr( 0x1000 )
+    m_curVirtAddr( 0x1000 ),
+    m_recordState( RecordOff ),
+    m_numReplays( 0 )
 {
     m_primary = params.find<bool>("primary",true);
     m_motifNum = params.find<int>( "_motifNum", -1 );
     m_jobId = params.find<int>( "_jobId", -1 );
+    if ( params.find<bool>( "replay", false ) ) {
+        m_recordState = RecordIdle;
+    }
     uint64_t parentPtr = params.find<uint64_t>("_enginePtr",0 );
     assert( parentPtr != 0 );
 
@@ -50,6 +55,73 @@ EmberGenerator::EmberGenerator( ComponentId_t id, Params& params, std::string na
 }
 
 
+EmberGenerator::~EmberGenerator()
+{
+    if ( ! m_recordedEvents.empty() ) {
+        verbose(CALL_INFO, 1, MOTIF_MASK, "replayed %zu events %" PRIu64 " times\n",
+                                    m_recordedEvents.size(), m_numReplays );
+    }
+    for ( size_t i = 0; i < m_recordedEvents.size(); i++ ) {
+        delete m_recordedEvents[i];
+    }
+}
+
+bool EmberGenerator::replayIteration( Queue& q )
+{
+    if ( Recorded != m_recordState ) {
+        return false;
+    }
+
+    for ( size_t i = 0; i < m_recordedEvents.size(); i++ ) {
+        m_recordedEvents[i]->rearm();
+        q.push( m_recordedEvents[i] );
+    }
+    ++m_numReplays;
+    return true;
+}
+
+void EmberGenerator::beginIteration( Queue& q )
+{
+    if ( RecordIdle == m_recordState ) {
+        m_recordState = Recording;
+        m_recordStart = q.size();
+        m_recordEnd = -1;
+    }
+}
+
+void EmberGenerator::endIteration( Queue& q )
+{
+    if ( Recording == m_recordState ) {
+        m_recordEnd = q.size();
+    }
+}
+
+// the queue is empty when generate() is called so everything in it now was
+// generated by this call, keep the events between the begin and end marks
+void EmberGenerator::recordEvents( Queue& q )
+{
+    if ( Recording != m_recordState ) {
+        return;
+    }
+
+    size_t num = q.size();
+    for ( size_t i = 0; i < num; i++ ) {
+        EmberEvent* ev = q.front();
+        q.pop();
+        if ( i >= m_recordStart && i < m_recordEnd ) {
+            ev->setRecorded();
+            m_recordedEvents.push_back( ev );
+        }
+        q.push( ev );
+    }
+
+    m_recordStart = 0;
+    if ( m_recordEnd != (size_t) -1 ) {
+        verbose(CALL_INFO, 1, MOTIF_MASK, "recorded %zu events\n", m_recordedEvents.size() );
+        m_recordState = Recorded;
+    }
+}
+
 void EmberGenerator::setEngine( EmberEngine* ee ) {
 
 	m_ee = ee;
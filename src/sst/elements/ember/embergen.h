@@ -18,6 +18,7 @@
 #define _H_EMBER_GENERATOR
 
 #include <queue>
+#include <vector>
 
 #include <sst/core/output.h>
 #include <sst/core/module.h>
@@ -61,6 +62,7 @@ class EmberGenerator : public SubComponent {
         { "_jobId", "used internally", "-1"},
         { "_enginePtr", "used internally", "-1"},
 		{ "distribModule", "Sets the distribution SST module for compute modeling, default is a constant distribution of mean 1", "1.0"},
+		{ "replay", "Record the events of one iteration of motifs that support it and replay them for the later iterations", "0"},
 	)
 
     EmberGenerator( ComponentId_t id, Params& params ) : SubComponent(id) { assert(0); }
@@ -68,7 +70,7 @@ class EmberGenerator : public SubComponent {
 
 	void setEngine( EmberEngine* );
 
-	~EmberGenerator(){ };
+	~EmberGenerator();
 
     virtual void generate( const SST::Output* output, const uint32_t phase,
         std::queue<EmberEvent*>* evQ ) {
@@ -125,6 +127,20 @@ class EmberGenerator : public SubComponent {
     Thornhill::DetailedCompute*   m_detailedCompute;
     Thornhill::MemoryHeapLink*    m_memHeapLink;
 
+    // Iteration replay. A motif whose iterations all generate the same events
+    // brackets the generation of one iteration, which may span several calls
+    // to generate(), with beginIteration() and endIteration(). Later
+    // iterations call replayIteration(), which queues the recorded events
+    // again rather than generating new ones. Recorded events must not free
+    // anything when they are issued. All of this is a no-op unless the
+    // "replay" param is set.
+    bool replayIteration( Queue& );
+    void beginIteration( Queue& );
+    void endIteration( Queue& );
+
+    // called by the engine after each call to generate()
+    void recordEvents( Queue& );
+
 	inline void enQ_getTime( Queue&, uint64_t* time );
     inline void enQ_memAlloc( Queue&, Hermes::MemAddr* addr, size_t length  );
     inline void enQ_compute( Queue&, uint64_t nanoSecondDelay );
@@ -143,6 +159,12 @@ class EmberGenerator : public SubComponent {
     bool                    m_primary;
     EmberComputeDistribution*           m_computeDistrib;
     uint64_t m_curVirtAddr;
+
+    enum { RecordOff, RecordIdle, Recording, Recorded } m_recordState;
+    size_t                      m_recordStart;
+    size_t                      m_recordEnd;
+    std::vector<EmberEvent*>    m_recordedEvents;
+    uint64_t                    m_numReplays;
 };
 
 void EmberGenerator::enQ_getTime( Queue& q, uint64_t* time ) {
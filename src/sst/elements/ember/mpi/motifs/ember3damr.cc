@@ -935,6 +935,17 @@ void Ember3DAMRGenerator::aggregateBlockCommunication(const std::vector<Ember3DA
 bool Ember3DAMRGenerator::generate( std::queue<EmberEvent*>& evQ)
 {
 	if(iteration < maxIterations) {
+		// an iteration takes one call per local block to generate but is
+		// the same every time, replay the first if it was recorded
+		if( replayIteration( evQ ) ) {
+			iteration++;
+			return false;
+		}
+
+		if(0 == nextBlockToBeProcessed) {
+			beginIteration( evQ );
+		}
+
 		enQ_compute( evQ, 5 );
 
 		out->verbose(CALL_INFO, 8, 0, "Executing iteration: %" PRIu32 " on rank %" PRIu32 ", local blocks count: %" PRIu32 "\n", iteration,
@@ -979,6 +990,8 @@ bool Ember3DAMRGenerator::generate( std::queue<EmberEvent*>& evQ)
 				out->verbose(CALL_INFO, 2, 0, "Enqueued no communication events, stepping over wait-all issue.\n");
 			}
 
+			endIteration( evQ );
+
 			iteration++;
 			nextBlockToBeProcessed = 0;
 			nextRequestID = 0;
@@ -308,6 +308,17 @@ bool EmberFFT3DGenerator::generate( std::queue<EmberEvent*>& evQ )
         return false;
     }
 
+    // every iteration is the same, replay the first if it was recorded
+    if ( replayIteration( evQ ) ) {
+        if ( ++m_loopIndex == (signed) m_iterations ) {
+            enQ_commDestroy( evQ, m_rowComm );
+            enQ_commDestroy( evQ, m_colComm );
+        }
+        return false;
+    }
+
+    beginIteration( evQ );
+
     enQ_getTime( evQ, &m_forwardStart );
 
     enQ_compute( evQ, (uint64_t) ((double) calcFwdFFT1() ) );
@@ -346,6 +357,8 @@ bool EmberFFT3DGenerator::generate( std::queue<EmberEvent*>& evQ )
     enQ_barrier( evQ, GroupWorld );
     enQ_getTime( evQ, &m_backwardStop );
 
+    endIteration( evQ );
+
     if ( ++m_loopIndex == (signed) m_iterations ) {
         enQ_commDestroy( evQ, m_rowComm );
         enQ_commDestroy( evQ, m_colComm );
@@ -234,6 +234,13 @@ EmberHalo3D26Generator::EmberHalo3D26Generator(SST::ComponentId_t id, Params& pa
 bool EmberHalo3D26Generator::generate( std::queue<EmberEvent*>& evQ) {
 	verbose(CALL_INFO, 1, MOTIF_MASK, "Iteration on rank %" PRId32 "\n", rank());
 
+	// every iteration is the same, replay the first if it was recorded
+	if ( replayIteration( evQ ) ) {
+		return ++m_loopIndex == iterations;
+	}
+
+	beginIteration( evQ );
+
 		enQ_compute( evQ, compute_the_time );
 
 		int nextRequest = 0;
@@ -503,6 +510,8 @@ bool EmberHalo3D26Generator::generate( std::queue<EmberEvent*>& evQ) {
 		// Enqueue a wait all for all the communications we have set up
 		enQ_waitall( evQ, nextRequest, &requests[0], NULL );
 
+	endIteration( evQ );
+
 		verbose(CALL_INFO, 1, MOTIF_MASK, "Iteration on rank %" PRId32 " completed generation, %d events in queue\n",
 			rank(), (int)evQ.size());
 
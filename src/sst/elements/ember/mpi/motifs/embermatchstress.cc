@@ -0,0 +1,131 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include "embermatchstress.h"
+
+#define TAG 0xf00d0000
+
+using namespace SST::Ember;
+
+EmberMatchStressGenerator::EmberMatchStressGenerator(SST::ComponentId_t id, Params& params) :
+	EmberMessagePassingGenerator(id, params, "MatchStress"),
+    m_loopIndex( 0 ),
+    m_startTime( 0 ),
+    m_stopTime( 0 ),
+    m_totalTime( 0 )
+{
+	m_numPeers    = (uint32_t) params.find("arg.numPeers", 8);
+	m_msgsPerPeer = (uint32_t) params.find("arg.msgsPerPeer", 256);
+	m_wildcards   = (uint32_t) params.find("arg.wildcards", 0);
+	m_msgSize     = (uint32_t) params.find("arg.msgSize", 0);
+	m_unexpected  = params.find<bool>("arg.unexpected", false);
+	m_iterations  = (uint32_t) params.find("arg.iterations", 1);
+
+    if ( m_wildcards > m_msgsPerPeer ) {
+        m_wildcards = m_msgsPerPeer;
+    }
+}
+
+bool EmberMatchStressGenerator::generate( std::queue<EmberEvent*>& evQ)
+{
+    // note that the first time through start and stop are 0
+    m_totalTime += m_stopTime - m_startTime;
+
+    if ( m_loopIndex == m_iterations  ) {
+        if ( 0 == rank() ) {
+            uint64_t totalMsgs = (uint64_t) m_numPeers * m_msgsPerPeer * m_iterations;
+            output("MatchStress: peers %" PRIu32 ", recvs posted %" PRIu32 ", wildcards %" PRIu32
+                    ", %s, totalTime %.6f sec, %.0f ns/msg\n",
+                    m_numPeers, m_numPeers * m_msgsPerPeer, m_numPeers * m_wildcards,
+                    m_unexpected ? "unexpected" : "expected",
+                    (double) m_totalTime / 1000000000.0,
+                    totalMsgs ? (double) m_totalTime / totalMsgs : 0.0 );
+        }
+        return true;
+    }
+
+    if ( 0 == m_loopIndex ) {
+        if ( m_numPeers >= (uint32_t) size() ) {
+            m_numPeers = size() - 1;
+        }
+        m_reqs.resize( 2 * m_numPeers * m_msgsPerPeer );
+        m_resp.resize( m_reqs.size() );
+        verbose(CALL_INFO, 1, 0, "rank=%d size=%d peers=%" PRIu32 "\n", rank(), size(), m_numPeers);
+    }
+
+    enQ_barrier( evQ, GroupWorld );
+    enQ_getTime( evQ, &m_startTime );
+
+    if ( m_unexpected ) {
+        postSends( evQ );
+        enQ_barrier( evQ, GroupWorld );
+        postRecvs( evQ );
+    } else {
+        postRecvs( evQ );
+        enQ_barrier( evQ, GroupWorld );
+        postSends( evQ );
+    }
+
+    if ( ! m_reqs.empty() ) {
+        enQ_waitall( evQ, m_reqs.size(), &m_reqs[0],
+                                        (MessageResponse**)&m_resp[0] );
+    }
+    enQ_getTime( evQ, &m_stopTime );
+
+    ++m_loopIndex;
+
+    return false;
+}
+
+// Receives are posted peer by peer in tag order, the AnySrc receives for
+// the last m_wildcards tags go after all of them. Collectives never match
+// them since they still name a tag.
+void EmberMatchStressGenerator::postRecvs( std::queue<EmberEvent*>& evQ )
+{
+    MessageRequest* req = &m_reqs[ m_numPeers * m_msgsPerPeer ];
+    uint32_t exact = m_msgsPerPeer - m_wildcards;
+
+    for ( uint32_t peer = 1; peer <= m_numPeers; peer++ ) {
+        int src = ( rank() + size() - peer ) % size();
+        for ( uint32_t tag = 0; tag < exact; tag++ ) {
+            enQ_irecv( evQ, NULL, m_msgSize, CHAR, src, TAG + tag,
+                                                GroupWorld, req++ );
+        }
+    }
+
+    for ( uint32_t tag = exact; tag < m_msgsPerPeer; tag++ ) {
+        for ( uint32_t peer = 1; peer <= m_numPeers; peer++ ) {
+            enQ_irecv( evQ, NULL, m_msgSize, CHAR, AnySrc, TAG + tag,
+                                                GroupWorld, req++ );
+        }
+    }
+}
+
+// Sends go out in the reverse of the receiver's post order so every
+// arriving message matches as deep in the posted queue as it can
+void EmberMatchStressGenerator::postSends( std::queue<EmberEvent*>& evQ )
+{
+    MessageRequest* req = &m_reqs[0];
+
+    for ( uint32_t peer = m_numPeers; peer > 0; peer-- ) {
+        int dest = ( rank() + peer ) % size();
+        for ( uint32_t tag = m_msgsPerPeer; tag > 0; tag-- ) {
+            enQ_isend( evQ, NULL, m_msgSize, CHAR, dest, TAG + tag - 1,
+                                                GroupWorld, req++ );
+        }
+    }
+}
@@ -0,0 +1,96 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_MATCH_STRESS
+#define _H_EMBER_MATCH_STRESS
+
+#include "mpi/embermpigen.h"
+
+namespace SST {
+namespace Ember {
+
+class EmberMatchStressGenerator : public EmberMessagePassingGenerator {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        EmberMatchStressGenerator,
+        "ember",
+        "MatchStressMotif",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Keeps thousands of receives outstanding to stress message matching.",
+        SST::Ember::EmberGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {   "arg.numPeers",     "Sets the number of ranks each rank receives from",     "8"},
+        {   "arg.msgsPerPeer",  "Sets the number of messages received from each peer",  "256"},
+        {   "arg.wildcards",    "Sets how many of each peer's messages are received with AnySrc receives", "0"},
+        {   "arg.msgSize",      "Sets the size of the message in bytes",                "0"},
+        {   "arg.unexpected",   "Send before the receives are posted so messages are matched from the unexpected queue", "0"},
+        {   "arg.iterations",   "Sets the number of times to repeat the exchange",      "1"},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "time-Init", "Time spent in Init event",          "ns",  0},
+        { "time-Finalize", "Time spent in Finalize event",  "ns", 0},
+        { "time-Rank", "Time spent in Rank event",          "ns", 0},
+        { "time-Size", "Time spent in Size event",          "ns", 0},
+        { "time-Send", "Time spent in Recv event",          "ns", 0},
+        { "time-Recv", "Time spent in Recv event",          "ns", 0},
+        { "time-Irecv", "Time spent in Irecv event",        "ns", 0},
+        { "time-Isend", "Time spent in Isend event",        "ns", 0},
+        { "time-Wait", "Time spent in Wait event",          "ns", 0},
+        { "time-Waitall", "Time spent in Waitall event",    "ns", 0},
+        { "time-Waitany", "Time spent in Waitany event",    "ns", 0},
+        { "time-Compute", "Time spent in Compute event",    "ns", 0},
+        { "time-Barrier", "Time spent in Barrier event",    "ns", 0},
+        { "time-Alltoallv", "Time spent in Alltoallv event", "ns", 0},
+        { "time-Alltoall", "Time spent in Alltoall event",  "ns", 0},
+        { "time-Allreduce", "Time spent in Allreduce event", "ns", 0},
+        { "time-Reduce", "Time spent in Reduce event",      "ns", 0},
+        { "time-Bcast", "Time spent in Bcast event",        "ns", 0},
+        { "time-Gettime", "Time spent in Gettime event",    "ns", 0},
+        { "time-Commsplit", "Time spent in Commsplit event", "ns", 0},
+        { "time-Commcreate", "Time spent in Commcreate event", "ns", 0},
+    )
+
+public:
+	EmberMatchStressGenerator(SST::ComponentId_t, Params& params);
+    bool generate( std::queue<EmberEvent*>& evQ);
+
+private:
+    void postRecvs( std::queue<EmberEvent*>& evQ );
+    void postSends( std::queue<EmberEvent*>& evQ );
+
+    uint32_t m_numPeers;
+    uint32_t m_msgsPerPeer;
+    uint32_t m_wildcards;
+    uint32_t m_msgSize;
+    bool     m_unexpected;
+    uint32_t m_iterations;
+    uint32_t m_loopIndex;
+    uint64_t m_startTime;
+    uint64_t m_stopTime;
+    uint64_t m_totalTime;
+
+    std::vector<MessageRequest>     m_reqs;
+    std::vector<MessageResponse>    m_resp;
+};
+
+}
+}
+
+#endif
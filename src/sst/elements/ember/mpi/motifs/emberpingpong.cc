@@ -33,6 +33,9 @@ EmberPingPongGenerator::EmberPingPongGenerator(SST::ComponentId_t id, Params& pa
 	m_iterations = (uint32_t) params.find("arg.iterations", 1);
 	m_rank2 = (uint32_t) params.find("arg.rank2", 1);
 
+    if ( params.find<bool>("arg.backed", false) ) {
+        memSetBacked();
+    }
     m_sendBuf = memAlloc(m_messageSize);
     m_recvBuf = memAlloc(m_messageSize);
     m_blockingSend = (uint32_t) params.find("arg.blockingSend", true);;
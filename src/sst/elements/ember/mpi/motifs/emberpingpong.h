@@ -41,6 +41,7 @@ public:
         {   "arg.blockingSend",     "Sets the send mode",   "1"},
         {   "arg.blockingRecv",     "Sets the recv mode",   "1"},
         {   "arg.waitall",          "Sets the wait mode",   "1"},
+        {   "arg.backed",           "Back the send and receive buffers with real memory so message data is moved",   "0"},
     )
     SST_ELI_DOCUMENT_STATISTICS(
         { "time-Init", "Time spent in Init event",          "ns",  0},
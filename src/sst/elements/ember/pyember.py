@@ -218,7 +218,7 @@ class EmberSHMEMJob(EmberSimpleMemoryJob):
         self._declareParamsWithUserPrefix(
             "ember",
             "ember.firefly.hadesSHMEM",
-            ["verboseLevel","verboseMask"],
+            ["verboseLevel","verboseMask","nicCollectives"],
             "firefly.hadesSHMEM."
         )
 
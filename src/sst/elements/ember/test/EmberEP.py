@@ -155,6 +155,9 @@ class EmberEP( EndPoint ):
                 cpuNum = 0
                 for link in links: 
                     dc = os.setSubComponent( "detailedCompute", self.driverParams["hermesParams.detailedCompute.name"] )
+                    for key, value in list(self.driverParams.items()):
+                        if key.startswith("hermesParams.detailedCompute.") and key != "hermesParams.detailedCompute.name":
+                            dc.addParam( key[len("hermesParams.detailedCompute."):], value )
                     dc.addLink(link,"detailed"+str(cpuNum),"1ps")
                     cpuNum = cpuNum + 1
 
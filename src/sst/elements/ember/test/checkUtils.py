@@ -0,0 +1,125 @@
+# Run and report helpers for the scripts that time emberLoad.py runs,
+# msgSizeSweep.py, collectiveModelCheck.py, memoryModelCheck.py,
+# nicCollectiveCheck.py and replayCheck.py
+
+import sys,getopt,re,time
+from subprocess import Popen, PIPE
+
+config = "emberLoad.py"
+
+# Parses --name=value for each name in defaults and returns the defaults
+# updated with the given values. A value is converted to the type of its
+# default, lists are comma separated and --motifs names a motifs file.
+def getOptions( defaults ):
+    values = dict( defaults )
+
+    try:
+        opts, args = getopt.getopt(sys.argv[1:], "", [ name + "=" for name in defaults ])
+    except getopt.GetoptError as err:
+        print (str(err))
+        sys.exit(2)
+
+    for o, a in opts:
+        name = o[2:]
+        if name == "motifs":
+            values[ name ] = loadMotifs( a )
+        elif isinstance( defaults[ name ], list ):
+            values[ name ] = [ type( defaults[ name ][0] )( x ) for x in a.split(',') ]
+        else:
+            values[ name ] = type( defaults[ name ] )( a )
+
+    return values
+
+# one motif command line per line, blank lines and lines starting with #
+# are skipped
+def loadMotifs( filename ):
+    with open( filename ) as f:
+        return [ line.strip() for line in f if line.strip() and not line.startswith('#') ]
+
+# the motif wrapped in Init and Fini
+def cmdLines( motif ):
+    return "--cmdLine=\\\"Init\\\" --cmdLine=\\\"{0}\\\" --cmdLine=\\\"Fini\\\"".format( motif )
+
+timeRe = re.compile( r"simulated time: ([0-9.]+) (\w+)" )
+scale = { "ps" : 1e-6, "ns" : 1e-3, "us" : 1.0, "ms" : 1e3, "s" : 1e6 }
+
+# simulated time in us reported by sst
+def simulatedTime( out ):
+    match = timeRe.search( out )
+    if not match:
+        return None
+    return float( match.group(1) ) * scale[ match.group(2) ]
+
+latencyRe = re.compile( r"latency ([0-9.]+) us" )
+
+# latency in us reported by a collective motif
+def motifLatency( out ):
+    match = latencyRe.search( out )
+    if not match:
+        return None
+    return float( match.group(1) )
+
+# Runs emberLoad.py with the model options and returns what parse finds in
+# its output, described by what, and the wall clock seconds of the run
+def run( options, parse=None, what=None ):
+    cmd = "sst --model-options=\"{0}\" {1}".format( options, config )
+
+    start = time.time()
+    proc = Popen( cmd, shell=True, stdout=PIPE, stderr=PIPE, universal_newlines=True )
+    out, err = proc.communicate()
+    elapsed = time.time() - start
+
+    if proc.returncode != 0:
+        sys.exit( "Error: `{0}` failed\n{1}".format( cmd, err ) )
+
+    if parse is None:
+        return None, elapsed
+
+    value = parse( out )
+    if value is None:
+        sys.exit( "Error: no {0} reported by `{1}`".format( what, cmd ) )
+
+    return value, elapsed
+
+def error( reference, value ):
+    return 100.0 * ( value - reference ) / reference if reference else 0.0
+
+def speedup( reference, value ):
+    return reference / value if value else 0.0
+
+# Prints the worst of the errors and exits non zero if it is above
+# maxError percent, a maxError of 0 only reports
+def checkErrors( errors, maxError ):
+    worst = max( abs( e ) for e in errors ) if errors else 0.0
+    print ("worst error {0:.1f}%".format( worst ))
+
+    if maxError > 0 and worst > maxError:
+        sys.exit( "Error: worst error {0:.1f}% is above {1:.1f}%".format( worst, maxError ) )
+
+# Runs each test with first and second and prints a row of the test's
+# labels, the time of each run, compare( first, second ) and the wall
+# clock time of both runs. labels holds the ( heading, width ) of each
+# label of a test, headings the five headings after them. Returns the
+# compare results.
+def compareRuns( tests, labels, first, second, compare, headings, precision=1 ):
+    columns = [ "{{{0}:>{1}}}".format( i, width ) for i, ( heading, width ) in enumerate( labels ) ]
+    n = len( labels )
+
+    header = " ".join( columns + [ "{{{0}:>12}} {{{1}:>12}} {{{2}:>8}} {{{3}:>10}} {{{4}:>10}}".format(
+                *range( n, n + 5 ) ) ] )
+    row = " ".join( columns + [ "{{{0}:>12.3f}} {{{1}:>12.3f}} {{{2}:>8.{5}f}} {{{3}:>10.2f}} {{{4}:>10.2f}}".format(
+                *( list( range( n, n + 5 ) ) + [ precision ] ) ) ] )
+
+    print (header.format( *( [ heading for heading, width in labels ] + headings ) ))
+
+    results = []
+    for test in tests:
+        a, aWall = first( *test )
+        b, bWall = second( *test )
+
+        result = compare( a, b )
+        results.append( result )
+
+        print (row.format( *( list( test ) + [ a, b, result, aWall, bWall ] ) ))
+
+    return results
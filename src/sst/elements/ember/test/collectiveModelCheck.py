@@ -0,0 +1,48 @@
+#! /usr/bin/env python
+
+# Runs the Allreduce and Barrier motifs with message level collectives and
+# again with analytic (LogGOPS) collectives and reports the latency of each
+# and the error of the model relative to the message level simulation.
+#
+#   ./collectiveModelCheck.py [--shapes=2x2,4x4,8x8] [--iterations=10]
+#                             [--counts=1,1024] [--sampleInterval=0]
+#                             [--maxError=0]
+#
+# The LogGOPS parameters are derived from the network and NIC parameters
+# by emberLoad.py, with --sampleInterval=N every Nth collective is
+# simulated message by message to calibrate the model. With --maxError=N
+# the script exits non zero if any model latency is more than N% off.
+
+from checkUtils import *
+
+opts = getOptions( {
+    "shapes" : [ "2x2", "4x4", "8x8" ],
+    "iterations" : 10,
+    "counts" : [ 1, 1024 ],
+    "sampleInterval" : 0,
+    "maxError" : 0.0,
+} )
+
+def runModel( analytic ):
+    def runTest( shape, motif ):
+        options = "--topo=torus --shape={0} --numCores=1 {1}".format( shape, cmdLines( motif ) )
+
+        # the analytic collective has the motif's name
+        if analytic:
+            options += " --param=hermes:hermesParams.functionSM.analyticCollectives={0}".format(
+                            motif.split()[0].lower() )
+            options += " --param=hermes:hermesParams.functionSM.analytic.sampleInterval={0}".format(
+                            opts["sampleInterval"] )
+
+        return run( options, motifLatency, "latency" )
+    return runTest
+
+motifs = [ "Allreduce iterations={0} count={1}".format( opts["iterations"], count ) for count in opts["counts"] ]
+motifs += [ "Barrier iterations={0}".format( opts["iterations"] ) ]
+
+tests = [ ( shape, motif ) for shape in opts["shapes"] for motif in motifs ]
+
+errors = compareRuns( tests, [ ( "shape", 8 ), ( "motif", 40 ) ], runModel( False ), runModel( True ), error,
+        [ "message us", "model us", "error %", "msg sec", "model sec" ] )
+
+checkErrors( errors, opts["maxError"] )
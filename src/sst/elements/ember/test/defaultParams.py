@@ -57,6 +57,7 @@ nicParams = {
 
 	"simpleMemoryModel.busBandwidth_Gbs" : 7.8,
 	"simpleMemoryModel.busNumLinks" : 8,
+	"simpleMemoryModel.useAnalyticModel" : "no",
 	"simpleMemoryModel.detailedModel.name" : "firefly.detailedInterface",
 	"maxRecvMachineQsize" : 100,
 	"maxSendMachineQsize" : 100,
@@ -89,6 +90,7 @@ emberParams = {
     'firefly.hadesSHMEM.verboseMask'  : -1,
     'firefly.hadesSHMEM.enterLat_ns'  : 7,
     'firefly.hadesSHMEM.returnLat_ns' : 7,
+    'firefly.hadesSHMEM.nicCollectives' : 0,
     "verbose" : 0,
 }
 
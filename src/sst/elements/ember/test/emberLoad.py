@@ -431,6 +431,9 @@ for a in params['merlin']:
 
 nicParams["packetSize"] =    networkParams['packetSize']
 nicParams["link_bw"] = networkParams['link_bw']
+
+if hermesParams.get('hermesParams.functionSM.analyticCollectives'):
+    deriveLogGOPS( networkParams, nicParams, hermesParams )
 sst.merlin._params["link_lat"] = networkParams['link_lat']
 sst.merlin._params["link_bw"] = networkParams['link_bw']
 sst.merlin._params["xbar_bw"] = networkParams['xbar_bw']
@@ -0,0 +1,45 @@
+#! /usr/bin/env python
+
+# Runs a set of motifs with the SimpleMemoryModel unit network and again
+# with its analytic model and reports the simulated time of each, the error
+# of the analytic model relative to the unit network and the wall clock time
+# of both runs.
+#
+#   ./memoryModelCheck.py [--shapes=2x2,4x4x4] [--motifs=file] [--maxError=0]
+#
+# A motifs file holds one motif command line per line, blank lines and lines
+# starting with # are skipped. With --maxError=N the script exits non zero
+# if any analytic time is more than N% off.
+
+from checkUtils import *
+
+opts = getOptions( {
+    "shapes" : [ "2x2", "4x4x4" ],
+    "motifs" : [
+        "PingPong messageSize=8 iterations=10",
+        "PingPong messageSize=65536 iterations=10",
+        "Allreduce iterations=10 count=1024",
+        "Alltoall iterations=4 bytes=4096",
+        "Halo3D iterations=4 nx=32 ny=32 nz=32",
+        "Bcast iterations=10 count=16384",
+    ],
+    "maxError" : 0.0,
+} )
+
+def runModel( analytic ):
+    def runTest( shape, motif ):
+        options = "--topo=torus --shape={0} --numCores=1 --useSimpleMemoryModel {1}".format(
+                        shape, cmdLines( motif ) )
+
+        if analytic:
+            options += " --param=nic:simpleMemoryModel.useAnalyticModel=yes"
+
+        return run( options, simulatedTime, "simulated time" )
+    return runTest
+
+tests = [ ( shape, motif ) for shape in opts["shapes"] for motif in opts["motifs"] ]
+
+errors = compareRuns( tests, [ ( "shape", 8 ), ( "motif", 42 ) ], runModel( False ), runModel( True ), error,
+        [ "units us", "analytic us", "error %", "units sec", "model sec" ] )
+
+checkErrors( errors, opts["maxError"] )
@@ -0,0 +1,27 @@
+#! /usr/bin/env python
+
+# Sweeps PingPong message sizes with backed buffers and reports the wall
+# clock time of each simulation. Use it to compare the cost of moving
+# message data between builds.
+#
+#   ./msgSizeSweep.py [--numCores=2] [--iterations=100] [--sizes=0,1024,...]
+#
+# With --numCores=2 both ranks are on one node and messages take the
+# loopback path, otherwise they cross the network.
+
+from checkUtils import *
+
+opts = getOptions( {
+    "numCores" : 1,
+    "iterations" : 100,
+    "sizes" : [ 0, 64, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304 ],
+} )
+
+print ("{0:>10} {1:>12}".format( "bytes", "wall sec" ))
+
+for size in opts["sizes"]:
+    motif = "PingPong messageSize={0} iterations={1} backed=1".format( size, opts["iterations"] )
+
+    value, elapsed = run( "--topo=torus --shape=2 --numCores={0} {1}".format( opts["numCores"], cmdLines( motif ) ) )
+
+    print ("{0:>10} {1:>12.3f}".format( size, elapsed ))
@@ -0,0 +1,45 @@
+#! /usr/bin/env python
+
+# Runs the SHMEM collective motifs with the collectives built from puts and
+# atomics in HadesSHMEM and again with the collectives run by the NIC and
+# reports the simulated time of each and the speedup of the NIC collectives.
+#
+#   ./nicCollectiveCheck.py [--shapes=4x4,8x8] [--numCores=1,4] [--radix=8]
+#                           [--motifs=file]
+#
+# A motifs file holds one motif command line per line, blank lines and lines
+# starting with # are skipped. A motif that fails its own check of the
+# result fails the run.
+
+from checkUtils import *
+
+opts = getOptions( {
+    "shapes" : [ "4x4", "8x8" ],
+    "numCores" : [ 1, 4 ],
+    "radix" : 8,
+    "motifs" : [
+        "ShmemBarrierAll iterations=20",
+        "ShmemBarrier iterations=20",
+        "ShmemBroadcast64 root=1 nelems=1024",
+        "ShmemFcollect64 nelems=64",
+        "ShmemReductionLong nelems=128 op=SUM",
+    ],
+} )
+
+def runColl( nic ):
+    def runTest( shape, cores, motif ):
+        options = "--topo=torus --shape={0} --numCores={1} --useSimpleMemoryModel --motifAPI=HadesSHMEM " \
+                  "--cmdLine=\\\"{2}\\\"".format( shape, cores, motif )
+
+        if nic:
+            options += " --param=ember:firefly.hadesSHMEM.nicCollectives=1"
+            options += " --param=nic:shmem.collRadix={0}".format( opts["radix"] )
+
+        return run( options, simulatedTime, "simulated time" )
+    return runTest
+
+tests = [ ( shape, cores, motif ) for shape in opts["shapes"] for cores in opts["numCores"]
+                for motif in opts["motifs"] ]
+
+compareRuns( tests, [ ( "shape", 8 ), ( "cores", 6 ), ( "motif", 40 ) ], runColl( False ), runColl( True ), speedup,
+        [ "host us", "nic us", "speedup", "host sec", "nic sec" ], precision=2 )
@@ -30,3 +30,55 @@ def updateParams( params, merlinParams, nicParams, emberParams ):
         else:
             sys.exit('ERROR: unknown dictionary {0}'.format(prefix))
 
+
+def toNanoSeconds( value ):
+    value = str(value).strip()
+    for suffix, scale in ( ('ps',0.001), ('ns',1.0), ('us',1000.0), ('ms',1000000.0) ):
+        if value.endswith( suffix ):
+            return float( value[:-len(suffix)] ) * scale
+    return float( value )
+
+def toBytesPerSecond( value ):
+    value = str(value).strip()
+    for suffix, scale in ( ('GB/s',1e9), ('MB/s',1e6), ('KB/s',1e3), ('B/s',1.0) ):
+        if value.endswith( suffix ):
+            return float( value[:-len(suffix)] ) * scale
+    return float( value )
+
+# latency of a firefly.LatencyMod range such as "0-:130ns". A
+# firefly.ScaleLatMod range such as "0-50000:450ps-80ps" scales from the
+# first to the second latency across the range, the second one is taken.
+def rangeLatency( params, key, default ):
+    if key in params:
+        return toNanoSeconds( params[key].split(':',1)[1].split('-')[-1] )
+    return default
+
+# Fills in the LogGOPS parameters of analytic collectives that were not set
+# explicitly from the network, NIC and ctrlMsg configuration. An edge of
+# the collective tree is taken to cross 'hops' routers.
+def deriveLogGOPS( networkParams, nicParams, hermesParams, hops=2 ):
+    prefix = 'hermesParams.functionSM.analytic.'
+    ctrlMsg = 'hermesParams.ctrlMsg.'
+
+    linkLat = toNanoSeconds( networkParams['link_lat'] )
+    routerLat = toNanoSeconds( networkParams['input_latency'] ) + toNanoSeconds( networkParams['output_latency'] )
+    nic2host = toNanoSeconds( nicParams.get('nic2host_lat','0ns') )
+
+    sendOverhead = rangeLatency( hermesParams, ctrlMsg + 'txSetupModParams.range.0', 0 ) + \
+                    float( nicParams.get('txDelay_ns',0) )
+    recvOverhead = rangeLatency( hermesParams, ctrlMsg + 'rxSetupModParams.range.0', 0 ) + \
+                    float( hermesParams.get( ctrlMsg + 'matchDelay_ns',0) ) + \
+                    float( nicParams.get('rxMatchDelay_ns',0) )
+
+    derived = {
+        'L_ns' : 2 * nic2host + ( hops + 1 ) * linkLat + hops * routerLat,
+        'o_ns' : ( sendOverhead + recvOverhead ) / 2,
+        'g_ns' : float( nicParams.get('txDelay_ns',0) ),
+        'G_ps_per_byte' : 1e12 / toBytesPerSecond( networkParams['link_bw'] ),
+        'O_ps_per_byte' : rangeLatency( hermesParams, ctrlMsg + 'txMemcpyModParams.range.0', 0 ) * 1000,
+    }
+
+    for key, value in list(derived.items()):
+        if prefix + key not in hermesParams:
+            print ("set hermesParams {0}={1}".format( prefix + key, value ))
+            hermesParams[ prefix + key ] = value
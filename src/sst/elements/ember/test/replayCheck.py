@@ -0,0 +1,39 @@
+#! /usr/bin/env python
+
+# Runs the motifs which record and replay their iterations with replay off
+# and again with it on (the engine's replayMotifs param) and reports the
+# simulated time of each. Replaying an iteration must queue exactly the
+# events generating it would have, so the script exits non zero if the
+# simulated times differ at all.
+#
+#   ./replayCheck.py [--shapes=2x2x2] [--motifs=<file>]
+#
+# The default motifs are Halo3D26 and FFT3D sized for 8 ranks, a motifs
+# file holds one motif command line per line.
+
+from checkUtils import *
+
+opts = getOptions( {
+    "shapes" : [ "2x2x2" ],
+    "motifs" : [ "Halo3D26 iterations=10 nx=16 ny=16 nz=16 pex=2 pey=2 pez=2",
+                 "FFT3D iterations=4 nx=16 ny=16 nz=16 npRow=2" ],
+} )
+
+def runReplay( replay ):
+    def runTest( shape, motif ):
+        options = "--topo=torus --shape={0} --numCores=1 {1}".format( shape, cmdLines( motif ) )
+        options += " --param=ember:replayMotifs={0}".format( 1 if replay else 0 )
+
+        return run( options, simulatedTime, "simulated time" )
+    return runTest
+
+def difference( generated, replayed ):
+    return replayed - generated
+
+tests = [ ( shape, motif ) for shape in opts["shapes"] for motif in opts["motifs"] ]
+
+differences = compareRuns( tests, [ ( "shape", 8 ), ( "motif", 60 ) ], runReplay( False ), runReplay( True ),
+        difference, [ "generated us", "replayed us", "diff us", "gen sec", "replay sec" ], precision=3 )
+
+if any( d != 0 for d in differences ):
+    sys.exit( "Error: replaying iterations changed the simulated time" )
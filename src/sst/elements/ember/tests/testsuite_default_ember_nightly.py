@@ -52,6 +52,21 @@ class testcase_EmberNightly(SSTTestCase):
         otherargs = '--verbose --model-options \"--topo=torus --shape=4x4x4 --cmdLine=\"Init\" --cmdLine=\"Allreduce\" --cmdLine=\"Fini\" \"'
         self.Ember_test_template("test_emberparams", otherargs = otherargs, testoutput = False)
 
+    # The analytic (LogGOPS) collectives must stay within 15% of the message
+    # level collectives on a 4x4 torus
+    def test_Ember_CollectiveModel(self):
+        self.Ember_check_template("collectiveModelCheck.py", "--shapes=4x4 --maxError=15")
+
+    # The analytic SimpleMemoryModel, host cache included, must stay within
+    # 10% of the unit network on a 2x2 torus
+    def test_Ember_MemoryModel(self):
+        self.Ember_check_template("memoryModelCheck.py", "--shapes=2x2 --maxError=10")
+
+    # Halo3D26 and FFT3D must simulate to the same time whether their
+    # iterations are generated or replayed
+    def test_Ember_Replay(self):
+        self.Ember_check_template("replayCheck.py", "--shapes=2x2x2")
+
 
 #####
 
@@ -95,6 +110,17 @@ class testcase_EmberNightly(SSTTestCase):
             log_testing_note("Ember Nightly test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
 
 
+    # Runs one of the ember/test check scripts, these run sst themselves and
+    # exit non zero when their bound is exceeded
+    def Ember_check_template(self, script, args):
+        tmpdir = self.get_test_output_tmp_dir()
+        self.emberSweep_Folder = "{0}/embernightly_folder".format(tmpdir)
+
+        cmd = "python {0} {1}".format(script, args)
+        rtn = OSCommand(cmd, set_cwd=self.emberSweep_Folder).run()
+        log_debug("{0} result = {1}; output =\n{2}".format(script, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "{0} failed, output:\n{1}".format(script, rtn.output()))
+
 ###############################################
 
     def _setupEmberTestFiles(self):
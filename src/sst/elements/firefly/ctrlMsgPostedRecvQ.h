@@ -0,0 +1,262 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_CTRLMSGPOSTEDRECVQ_H
+#define COMPONENTS_FIREFLY_CTRLMSGPOSTEDRECVQ_H
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "ctrlMsg.h"
+#include "ctrlMsgCommReq.h"
+
+namespace SST {
+namespace Firefly {
+namespace CtrlMsg {
+
+// Posted receive queue. Receives that name a source and a tag are kept in
+// a bucket per (group, rank, tag), receives with a wildcard source, a
+// wildcard tag or a tag ignore mask are kept in a single list. Every
+// receive is stamped with its post order so a message matches the oldest
+// receive that accepts it, exactly as a walk of one list in post order
+// would.
+//
+// Finding a match does not walk the queue but the modelled cost of the
+// walk still depends on where the match sits in post order. The number of
+// receives posted ahead of the match is counted with a Fenwick tree over
+// the post order stamps so match() reports the same count the linear walk
+// did.
+
+class PostedRecvQ {
+
+    struct Entry {
+        Entry( uint64_t _seq, _CommReq* _req ) : seq( _seq ), req( _req ) {}
+        uint64_t  seq;
+        _CommReq* req;
+    };
+
+    struct Key {
+        Key( MatchHdr& hdr ) : group( hdr.group ), rank( hdr.rank ), tag( hdr.tag ) {}
+        bool operator==( const Key& rhs ) const {
+            return group == rhs.group && rank == rhs.rank && tag == rhs.tag;
+        }
+        MP::Communicator group;
+        MP::RankID       rank;
+        uint64_t         tag;
+    };
+
+    struct KeyHash {
+        size_t operator()( const Key& key ) const {
+            uint64_t hash = key.tag * 0x9E3779B97F4A7C15ULL;
+            hash ^= ( (uint64_t) key.rank << 32 | (uint32_t) key.group ) + ( hash >> 29 );
+            return hash * 0xBF58476D1CE4E5B9ULL >> 16;
+        }
+    };
+
+    typedef std::deque< Entry > Bucket;
+
+  public:
+    PostedRecvQ() : m_nextSeq( 0 ), m_size( 0 ) {}
+
+    size_t size() const { return m_size; }
+    bool empty() const { return 0 == m_size; }
+
+    void push_back( _CommReq* req ) {
+        if ( m_nextSeq == m_live.size() ) {
+            makeRoom();
+        }
+
+        uint64_t seq = m_nextSeq++;
+
+        if ( isWildcard( req ) ) {
+            m_wildcards.push_back( Entry( seq, req ) );
+        } else {
+            m_buckets[ Key( req->hdr() ) ].push_back( Entry( seq, req ) );
+        }
+
+        m_seqOf[ req ] = seq;
+        update( seq, 1 );
+        ++m_size;
+    }
+
+    // Removes and returns the oldest receive for which match( hdr, want,
+    // ignore ) holds. count is advanced by the number of receives a walk in
+    // post order would have examined.
+    template < class Match >
+    _CommReq* match( MatchHdr& hdr, int& count, Match check ) {
+        Bucket* bucket = NULL;
+        Bucket::iterator exact;
+        bool haveExact = false;
+
+        auto iter = m_buckets.find( Key( hdr ) );
+        if ( iter != m_buckets.end() ) {
+            bucket = &iter->second;
+            for ( exact = bucket->begin(); exact != bucket->end(); ++exact ) {
+                if ( check( hdr, exact->req->hdr(), exact->req->ignore() ) ) {
+                    haveExact = true;
+                    break;
+                }
+            }
+        }
+
+        Bucket::iterator wild = m_wildcards.begin();
+        for ( ; wild != m_wildcards.end(); ++wild ) {
+            if ( haveExact && wild->seq > exact->seq ) {
+                wild = m_wildcards.end();
+                break;
+            }
+            if ( check( hdr, wild->req->hdr(), wild->req->ignore() ) ) {
+                break;
+            }
+        }
+
+        if ( ! haveExact && wild == m_wildcards.end() ) {
+            count += m_size;
+            return NULL;
+        }
+
+        Entry found( 0, NULL );
+        if ( wild != m_wildcards.end() ) {
+            found = *wild;
+            m_wildcards.erase( wild );
+        } else {
+            found = *exact;
+            bucket->erase( exact );
+            if ( bucket->empty() ) {
+                m_buckets.erase( iter );
+            }
+        }
+
+        count += prefix( found.seq ) + 1;
+        retire( found );
+        return found.req;
+    }
+
+    // Removes req if it is posted, returns it or NULL if it is not
+    _CommReq* remove( MP::MessageRequest req ) {
+        auto seqIter = m_seqOf.find( static_cast< _CommReq* >( req ) );
+        if ( seqIter == m_seqOf.end() ) {
+            return NULL;
+        }
+
+        _CommReq* found = seqIter->first;
+        uint64_t seq = seqIter->second;
+
+        Bucket* bucket;
+        auto bucketIter = m_buckets.end();
+        if ( isWildcard( found ) ) {
+            bucket = &m_wildcards;
+        } else {
+            bucketIter = m_buckets.find( Key( found->hdr() ) );
+            bucket = &bucketIter->second;
+        }
+
+        for ( Bucket::iterator iter = bucket->begin(); iter != bucket->end(); ++iter ) {
+            if ( iter->seq == seq ) {
+                bucket->erase( iter );
+                break;
+            }
+        }
+
+        if ( bucketIter != m_buckets.end() && bucketIter->second.empty() ) {
+            m_buckets.erase( bucketIter );
+        }
+
+        retire( Entry( seq, found ) );
+        return found;
+    }
+
+  private:
+
+    static bool isWildcard( _CommReq* req ) {
+        return AnyTag == req->hdr().tag || MP::AnySrc == req->hdr().rank ||
+                0 != req->ignore();
+    }
+
+    void retire( const Entry& entry ) {
+        m_seqOf.erase( entry.req );
+        update( entry.seq, -1 );
+
+        // restart the stamps whenever the queue drains so the tree stays
+        // as small as the longest run of outstanding receives
+        if ( 0 == --m_size ) {
+            std::fill( m_live.begin(), m_live.end(), 0 );
+            m_nextSeq = 0;
+        }
+    }
+
+    // Out of stamps, renumber the posted receives if at most half the
+    // stamps are still in use otherwise double the number of stamps
+    void makeRoom() {
+        std::vector< Entry* > entries;
+        entries.reserve( m_size );
+
+        for ( auto& bucket : m_buckets ) {
+            for ( auto& entry : bucket.second ) {
+                entries.push_back( &entry );
+            }
+        }
+        for ( auto& entry : m_wildcards ) {
+            entries.push_back( &entry );
+        }
+
+        std::sort( entries.begin(), entries.end(),
+                [](const Entry* a, const Entry* b) { return a->seq < b->seq; } );
+
+        if ( m_live.size() < 64 || m_size * 2 > m_live.size() ) {
+            m_live.resize( std::max( m_live.size() * 2, (size_t) 64 ) );
+        }
+
+        std::fill( m_live.begin(), m_live.end(), 0 );
+
+        for ( size_t i = 0; i < entries.size(); i++ ) {
+            entries[i]->seq = i;
+            m_seqOf[ entries[i]->req ] = i;
+            update( i, 1 );
+        }
+
+        m_nextSeq = entries.size();
+    }
+
+    void update( uint64_t seq, int delta ) {
+        for ( size_t i = seq + 1; i <= m_live.size(); i += i & -i ) {
+            m_live[ i - 1 ] += delta;
+        }
+    }
+
+    // number of posted receives stamped before seq
+    size_t prefix( uint64_t seq ) const {
+        size_t sum = 0;
+        for ( size_t i = seq; i > 0; i -= i & -i ) {
+            sum += m_live[ i - 1 ];
+        }
+        return sum;
+    }
+
+    std::unordered_map< Key, Bucket, KeyHash > m_buckets;
+    Bucket                                     m_wildcards;
+    std::unordered_map< _CommReq*, uint64_t >  m_seqOf;
+    std::vector< int >                         m_live;
+    uint64_t                                   m_nextSeq;
+    size_t                                     m_size;
+};
+
+}
+}
+}
+
+#endif
@@ -52,6 +52,8 @@ ProcessQueuesState::ProcessQueuesState( ComponentId_t id, Params& params ) :
 
     m_statPstdRcv = registerStatistic<uint64_t>("posted_receive_list");
     m_statRcvdMsg = registerStatistic<uint64_t>("received_msg_list");
+    m_statPstdMatchLen = registerStatistic<uint64_t>("posted_match_length");
+    m_statUnexpMatchLen = registerStatistic<uint64_t>("unexpected_match_length");
 
     m_msgTiming = loadAnonymousSubComponent< MsgTiming >( "firefly.msgTiming", "", 0, ComponentInfo::SHARE_NONE, params );
 
@@ -207,15 +209,25 @@ void ProcessQueuesState::processSend_2( _CommReq* req )
 
     if ( length <= shortMsgLength() ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"Short %lu bytes dest %#x\n",length,nid);
+
+        // the send completes now so take one copy of the payload, the
+        // packets built from it hold references rather than copies and
+        // the last one to go frees it
+        SharedBuf payload;
+        size_t offset = 0;
 		for ( int i = 0; i < req->ioVec().size(); i++ ) {
 			size_t len = req->ioVec()[i].len;
 			MemAddr& addr =	req->ioVec()[i].addr;
 			void* backing = NULL;
 			if ( addr.getBacking() ) {
-				backing = malloc( len );
+                if ( ! payload ) {
+                    payload = std::make_shared< std::vector<unsigned char> >( length );
+                }
+				backing = &(*payload)[offset];
 				memcpy( backing, addr.getBacking(), len );
 			}
-			vec.push_back( IoVec( MemAddr( addr.getSimVAddr(), backing),len ) );
+			vec.push_back( IoVec( MemAddr( addr.getSimVAddr(), backing),len, payload ) );
+            offset += len;
 		}
         req->setDone( sendReqFiniDelay( length ) );
         ++m_numSent;
@@ -408,15 +420,10 @@ void ProcessQueuesState::processMakeProgress( Stack* stack )
 
 void ProcessQueuesState::enterCancel( MP::MessageRequest req, uint64_t exitDelay ) {
 
-    std::deque< _CommReq* >:: iterator iter = m_pstdRcvQ.begin();
-    for ( ; iter != m_pstdRcvQ.end(); ++iter ) {
-
-		if ( *iter == req ) {
-    		dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",*iter);
-			delete( *iter );
-        	m_pstdRcvQ.erase(iter);
-			break;
-		}
+    _CommReq* found = m_pstdRcvQ.remove( req );
+    if ( found ) {
+        dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",found);
+        delete found;
     }
     enterMakeProgress(m_exitDelay);
 }
@@ -627,9 +634,20 @@ void ProcessQueuesState::processShortList_1( Stack* stack )
 
     int count = 0;
     if ( m_intStack.empty() ) {
-        ctx->req = searchPostedRecv( m_pstdRcvPreQ, ctx->hdr(), count );
+        // skip over the unexpected messages that do not match in one walk,
+        // it costs the same as walking them one at a time
+        while ( ! ( ctx->req = searchPostedRecv( m_pstdRcvPreQ, ctx->hdr(), count ) ) &&
+                                                            ! ctx->isLast() ) {
+            ctx->incPos();
+        }
+        m_statUnexpMatchLen->addData( count );
     } else {
-        ctx->req = searchPostedRecv( m_pstdRcvQ, ctx->hdr(), count );
+        ctx->req = m_pstdRcvQ.match( ctx->hdr(), count,
+            [this]( MatchHdr& hdr, MatchHdr& wantHdr, uint64_t ignore ) {
+                return checkMatchHdr( hdr, wantHdr, ignore );
+            }
+        );
+        m_statPstdMatchLen->addData( count );
     }
 
     m_mem->walk(
@@ -1052,19 +1070,25 @@ void ProcessQueuesState::copyIoVec(
     size_t rV = 0,rP =0;
     for ( unsigned int i=0; i < src.size() && copied < len; i++ )
     {
-        assert( rV < dst.size() );
         dbg().debug(CALL_INFO,3,DBG_MSK_PQS_Q,"src[%d].len %lu\n", i, src[i].len);
 
-        for ( unsigned int j=0; j < src[i].len && copied < len ; j++ ) {
-            dbg().debug(CALL_INFO,3,DBG_MSK_PQS_Q,"copied=%lu rV=%lu rP=%lu\n",
-                                                        copied,rV,rP);
+        size_t sP = 0;
+        while ( sP < src[i].len && copied < len ) {
+            assert( rV < dst.size() );
+
+            size_t chunk = std::min( src[i].len - sP, dst[rV].len - rP );
+            chunk = std::min( chunk, len - copied );
+
+            dbg().debug(CALL_INFO,3,DBG_MSK_PQS_Q,"copied=%lu rV=%lu rP=%lu chunk=%lu\n",
+                                                        copied,rV,rP,chunk);
 
             if ( dst[rV].addr.getBacking() && src[i].addr.getBacking() ) {
-                ((char*)dst[rV].addr.getBacking())[rP] =
-                            ((char*)src[i].addr.getBacking())[j];
+                memcpy( (char*)dst[rV].addr.getBacking() + rP,
+                            (const char*)src[i].addr.getBacking() + sP, chunk );
             }
-            ++copied;
-            ++rP;
+            copied += chunk;
+            sP += chunk;
+            rP += chunk;
             if ( rP == dst[rV].len ) {
                 rP = 0;
                 ++rV;
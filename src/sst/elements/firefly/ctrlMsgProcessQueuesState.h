@@ -27,6 +27,7 @@
 #include "loopBack.h"
 
 #include "ctrlMsgCommReq.h"
+#include "ctrlMsgPostedRecvQ.h"
 #include "ctrlMsgWaitReq.h"
 
 #define DBG_MSK_PQS_APP_SIDE 1 << 0
@@ -100,7 +101,9 @@ class ProcessQueuesState : public SubComponent
     
     SST_ELI_DOCUMENT_STATISTICS(
         { "posted_receive_list", "", "count", 1 },
-        { "received_msg_list", "", "count", 1 }
+        { "received_msg_list", "", "count", 1 },
+        { "posted_match_length", "Posted receives examined to match an arriving message, use a histogram for the distribution", "count", 1 },
+        { "unexpected_match_length", "Unexpected messages examined to match a new receive, use a histogram for the distribution", "count", 1 }
     )
 
   private:
@@ -224,7 +227,7 @@ class ProcessQueuesState : public SubComponent
             Msg( (MatchHdr*)_vec[0].addr.getBacking() ),
             srcCore( _srcCore ), vec(_vec), key( _key)
         {
-            m_ioVec.push_back( vec[1] );
+            m_ioVec.assign( vec.begin() + 1, vec.end() );
         }
 
         int srcCore;
@@ -299,6 +302,7 @@ class ProcessQueuesState : public SubComponent
         void unlinkMsg() { m_iter = m_msgQ->erase(m_iter); }
         void setDone( ) { m_done = true; }
         bool isDone() { return m_done || m_iter == m_msgQ->end();  }
+        bool isLast() { return m_iter + 1 == m_msgQ->end(); }
         void incPos() { ++m_iter; }
       private:
         bool m_done;
@@ -480,7 +484,7 @@ class ProcessQueuesState : public SubComponent
     int     m_numRecvLooped;
     bool    m_missedInt;
 
-    std::deque< _CommReq* >         m_pstdRcvQ;
+    PostedRecvQ                     m_pstdRcvQ;
     std::deque< _CommReq* >         m_pstdRcvPreQ;
     std::vector<std::deque< Msg* >> m_recvdMsgQ;
 	int m_recvdMsgQpos;
@@ -506,6 +510,8 @@ class ProcessQueuesState : public SubComponent
 
     Statistic<uint64_t>* m_statRcvdMsg;
     Statistic<uint64_t>* m_statPstdRcv;
+    Statistic<uint64_t>* m_statPstdMatchLen;
+    Statistic<uint64_t>* m_statUnexpMatchLen;
     int m_numSent;
     int m_numRecv;
     int m_nicsPerNode;
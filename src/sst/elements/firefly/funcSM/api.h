@@ -52,9 +52,20 @@ class FunctionSMInterface : public Module {
         uint64_t m_value;
     };
 
+    // Lets a function wait on something other than its protocol. Times
+    // are absolute and in picoseconds, wakeAt() reenters the function
+    // through handleEnterEvent() no earlier than the given time.
+    class Timer {
+      public:
+        virtual ~Timer() {}
+        virtual uint64_t now() = 0;
+        virtual void wakeAt( uint64_t ) = 0;
+    };
+
     FunctionSMInterface( SST::Params& params ) :
         m_info( NULL ),
         m_proto( NULL ),
+        m_timer( NULL ),
         m_name( params.find<std::string>("name","???") ),
         m_enterLatency( params.find<int>("enterLatency",0) ),
         m_returnLatency( params.find<int>("returnLatency",0) )
@@ -78,6 +89,7 @@ class FunctionSMInterface : public Module {
 
     void setInfo( Info* info ) { m_info = info; }
     void setProtocol( ProtocolAPI* proto ) { m_proto = proto; }
+    void setTimer( Timer* timer ) { m_timer = timer; }
     virtual void  handleStartEvent( SST::Event*, Retval& ) = 0;
     virtual void  handleEnterEvent( Retval& ) { assert(0); }
     virtual std::string  name() { return m_name; }
@@ -88,6 +100,7 @@ class FunctionSMInterface : public Module {
   protected:
     Info*           m_info;
     ProtocolAPI*    m_proto;
+    Timer*          m_timer;
     Output          m_dbg;
     std::string     m_name;
     int             m_enterLatency;
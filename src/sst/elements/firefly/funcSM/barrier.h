@@ -34,7 +34,9 @@ class BarrierFuncSM :  public CollectiveTreeFuncSM
     )
 
   public:
-    BarrierFuncSM( SST::Params& params ) : CollectiveTreeFuncSM( params ) {}
+    BarrierFuncSM( SST::Params& params ) : CollectiveTreeFuncSM( params ) {
+        m_barrier = true;
+    }
 
     virtual void handleStartEvent( SST::Event* e, Retval& retval ) {
         BarrierStartEvent* event = static_cast<BarrierStartEvent*>( e );
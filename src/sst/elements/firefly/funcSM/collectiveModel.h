@@ -0,0 +1,153 @@
+// Copyright 2013-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_FUNCSM_COLLECTIVEMODEL_H
+#define COMPONENTS_FIREFLY_FUNCSM_COLLECTIVEMODEL_H
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "funcSM/api.h"
+
+namespace SST {
+namespace Firefly {
+
+// LogGOPS parameters, all in picoseconds
+struct LogGOPS {
+    double L;   // network latency
+    double o;   // CPU overhead per message
+    double g;   // gap between consecutive messages
+    double G;   // network time per byte
+    double O;   // CPU overhead per byte
+};
+
+// Meeting point for the ranks of an analytic collective. Every rank
+// records when it entered the collective and the timer that wakes it, the
+// rank that arrives last gets the whole instance back, works out when each
+// rank completes and does the reduction on the ranks' buffers. Instances
+// are matched on the kind of collective, the communicator, the group's
+// first member and size and a per communicator sequence number.
+//
+// Collectives that are sampled (simulated message by message) meet here
+// when they finish so the measured time can be compared with what the
+// model predicts for the same arrival times. The ratio is folded into the
+// scale applied to that kind of collective from then on.
+//
+// Ranks simulated by other processes are not visible here so analytic
+// collectives need a single process, single thread simulation.
+
+class CollectiveModel {
+
+  public:
+    typedef FunctionSMInterface::Timer Timer;
+    typedef std::tuple< int, uint32_t, int, int, uint64_t > Key;
+
+    struct Instance {
+        Instance( int size ) : count( 0 ), start( size ), finish( size ),
+            timer( size, NULL ), data( size, NULL ), result( size, NULL ) {}
+        int count;
+        std::vector<double> start;
+        std::vector<double> finish;
+        std::vector<Timer*> timer;
+        std::vector<void*>  data;
+        std::vector<void*>  result;
+    };
+
+    // Returns the instance once every rank has arrived, the caller owns it
+    static Instance* arrive( const Key& key, int size, int rank, uint64_t now,
+                            Timer* timer, void* data, void* result ) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock( reg.lock );
+
+        Instance* inst = join( reg.arrivals, key, size );
+        inst->start[rank] = now;
+        inst->timer[rank] = timer;
+        inst->data[rank] = data;
+        inst->result[rank] = result;
+        return complete( reg.arrivals, key, inst );
+    }
+
+    // Returns the instance once every rank has finished, the caller owns it
+    static Instance* finish( const Key& key, int size, int rank,
+                                        uint64_t start, uint64_t now ) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock( reg.lock );
+
+        Instance* inst = join( reg.samples, key, size );
+        inst->start[rank] = start;
+        inst->finish[rank] = now;
+        return complete( reg.samples, key, inst );
+    }
+
+    static double scale( int type ) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock( reg.lock );
+
+        std::map<int,double>::iterator iter = reg.scale.find( type );
+        return iter == reg.scale.end() ? 1.0 : iter->second;
+    }
+
+    // The first sample of a type replaces the initial scale of 1
+    static double calibrate( int type, double ratio, double weight ) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock( reg.lock );
+
+        std::map<int,double>::iterator iter = reg.scale.find( type );
+        if ( iter == reg.scale.end() ) {
+            reg.scale[type] = ratio;
+        } else {
+            iter->second = ( 1.0 - weight ) * iter->second + weight * ratio;
+        }
+        return reg.scale[type];
+    }
+
+  private:
+    typedef std::map< Key, Instance* > InstanceMap;
+
+    struct Registry {
+        std::mutex              lock;
+        InstanceMap             arrivals;
+        InstanceMap             samples;
+        std::map<int,double>    scale;
+    };
+
+    static Registry& registry() {
+        static Registry reg;
+        return reg;
+    }
+
+    static Instance* join( InstanceMap& map, const Key& key, int size ) {
+        InstanceMap::iterator iter = map.find( key );
+        if ( iter == map.end() ) {
+            iter = map.insert( std::make_pair( key, new Instance( size ) ) ).first;
+        }
+        return iter->second;
+    }
+
+    static Instance* complete( InstanceMap& map, const Key& key, Instance* inst ) {
+        if ( ++inst->count < (int) inst->start.size() ) {
+            return NULL;
+        }
+        map.erase( key );
+        return inst;
+    }
+};
+
+}
+}
+
+#endif
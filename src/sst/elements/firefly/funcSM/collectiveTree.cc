@@ -16,6 +16,12 @@
 
 #include <sst_config.h>
 
+#include <sst/core/simulation.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
 #include "funcSM/collectiveTree.h"
 #include "funcSM/collectiveOps.h"
 #include "info.h"
@@ -26,6 +32,57 @@ const char* CollectiveTreeFuncSM::m_enumName[] = {
     FOREACH_ENUM(GENERATE_STRING)
 };
 
+CollectiveTreeFuncSM::CollectiveTreeFuncSM( SST::Params& params ) :
+    FunctionSMInterface( params ),
+    m_barrier( false ),
+    m_event( NULL ),
+    m_seq( 0 ),
+    m_mode( Simulated ),
+    m_start( 0 ),
+    m_vn( 0 )
+{
+    m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
+    m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
+
+    bool analytic = false;
+    std::fill( m_analytic, m_analytic + NumModelTypes, false );
+
+    std::stringstream list( params.find<std::string>( "analyticCollectives", "" ) );
+    std::string name;
+    while ( std::getline( list, name, ',' ) ) {
+        name.erase( 0, name.find_first_not_of( " \t" ) );
+        name.erase( name.find_last_not_of( " \t" ) + 1 );
+        if ( name.empty() ) {
+            continue;
+        }
+        if ( 0 == name.compare( "allreduce" ) ) {
+            m_analytic[ModelAllreduce] = true;
+        } else if ( 0 == name.compare( "reduce" ) ) {
+            m_analytic[ModelReduce] = true;
+        } else if ( 0 == name.compare( "bcast" ) ) {
+            m_analytic[ModelBcast] = true;
+        } else if ( 0 == name.compare( "barrier" ) ) {
+            m_analytic[ModelBarrier] = true;
+        } else {
+            m_dbg.fatal( CALL_INFO, -1, "unknown analytic collective `%s`\n", name.c_str() );
+        }
+        analytic = true;
+    }
+
+    if ( analytic && ( Simulation::getSimulation()->getNumRanks().rank > 1 ||
+                Simulation::getSimulation()->getNumRanks().thread > 1 ) ) {
+        m_dbg.fatal( CALL_INFO, -1, "analytic collectives need a single rank, single thread simulation\n" );
+    }
+
+    m_logGOPS.L = params.find<double>( "analytic.L_ns", 500 ) * 1000;
+    m_logGOPS.o = params.find<double>( "analytic.o_ns", 1000 ) * 1000;
+    m_logGOPS.g = params.find<double>( "analytic.g_ns", 100 ) * 1000;
+    m_logGOPS.G = params.find<double>( "analytic.G_ps_per_byte", 250 );
+    m_logGOPS.O = params.find<double>( "analytic.O_ps_per_byte", 0 );
+    m_sampleInterval = params.find<uint64_t>( "analytic.sampleInterval", 0 );
+    m_sampleWeight = params.find<double>( "analytic.sampleWeight", 0.5 );
+}
+
 void CollectiveTreeFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
 {
     assert( NULL == m_event );
@@ -84,9 +141,189 @@ void CollectiveTreeFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
     } else {
         m_state = WaitUp;
     }
+
+    // each rank counts the collectives of this kind it starts on a group so
+    // the kind and the count identify the instance whichever way it is
+    // timed, other kinds are counted by their own state machine. User
+    // reduction functions are only ever handed a tree node's inputs so
+    // collectives using them on real buffers are always simulated.
+    ModelType type = modelType();
+    uint64_t seq = m_groupSeq[m_event->group]++;
+
+    bool userFunc = m_event->mydata.getBacking() && m_event->op &&
+                        MP::ReductionOpType::Func == m_event->op->type;
+
+    m_mode = Simulated;
+    if ( m_analytic[type] && ! userFunc ) {
+        Group* group = m_info->getGroup(m_event->group);
+        m_key = CollectiveModel::Key( type, m_event->group, group->getMapping(0),
+                                            group->getSize(), seq );
+        m_start = m_timer->now();
+
+        if ( m_sampleInterval && 0 == seq % m_sampleInterval ) {
+            m_mode = Sampled;
+        } else {
+            m_mode = Modelled;
+            m_state = Analytic;
+            startModel();
+            return;
+        }
+    }
+
     handleEnterEvent( retval );
 }
 
+CollectiveTreeFuncSM::ModelType CollectiveTreeFuncSM::modelType()
+{
+    if ( m_barrier ) {
+        return ModelBarrier;
+    }
+    switch ( m_event->type ) {
+      case CollectiveStartEvent::Reduce:
+        return ModelReduce;
+      case CollectiveStartEvent::Bcast:
+        return ModelBcast;
+      default:
+        return ModelAllreduce;
+    }
+}
+
+// The last rank to arrive works out when every rank completes and wakes
+// them, none of them can complete before now
+void CollectiveTreeFuncSM::startModel()
+{
+    m_dbg.debug(CALL_INFO,1,0,"analytic %s seq %" PRIu64 "\n",
+                            m_event->typeName(), std::get<4>( m_key ) );
+
+    CollectiveModel::Instance* inst = CollectiveModel::arrive( m_key,
+                            m_yyy->size(), m_yyy->myRank(), m_start, m_timer,
+                            m_event->mydata.getBacking(), m_event->result.getBacking() );
+    if ( NULL == inst ) {
+        return;
+    }
+
+    ModelType type = modelType();
+    std::vector<double> done;
+    predict( type, m_event->root, inst->start, CollectiveModel::scale( type ), done );
+
+    // like the message level broadcast this moves no data
+    if ( ( ModelAllreduce == type || ModelReduce == type ) && inst->data[0] ) {
+        void* result = inst->result[ ModelReduce == type ? m_event->root : 0 ];
+        collectiveOp( &inst->data[0], inst->data.size(), result,
+                            m_event->count, m_event->dtype, m_event->op );
+
+        for ( unsigned int i = 0; ModelAllreduce == type && i < inst->result.size(); i++ ) {
+            if ( inst->result[i] && inst->result[i] != result ) {
+                memcpy( inst->result[i], result, m_bufLen );
+            }
+        }
+    }
+
+    for ( unsigned int i = 0; i < done.size(); i++ ) {
+        uint64_t time = std::max( (uint64_t) done[i], m_start );
+        inst->timer[i]->wakeAt( time );
+    }
+    delete inst;
+}
+
+// The last rank to finish a sampled collective compares its time with
+// the model's prediction for the same arrival times
+void CollectiveTreeFuncSM::finishSample()
+{
+    CollectiveModel::Instance* inst = CollectiveModel::finish( m_key,
+            m_yyy->size(), m_yyy->myRank(), m_start, m_timer->now() );
+    if ( NULL == inst ) {
+        return;
+    }
+
+    ModelType type = modelType();
+    std::vector<double> done;
+    predict( type, m_event->root, inst->start, 1.0, done );
+
+    double measured = 0;
+    double modelled = 0;
+    for ( unsigned int i = 0; i < done.size(); i++ ) {
+        measured += inst->finish[i] - inst->start[i];
+        modelled += done[i] - inst->start[i];
+    }
+
+    if ( modelled > 0 ) {
+        double scale = CollectiveModel::calibrate( type, measured / modelled, m_sampleWeight );
+        m_dbg.debug(CALL_INFO,1,0,"%s sample measured %.0f ps modelled %.0f ps scale %f\n",
+                            m_event->typeName(), measured, modelled, scale );
+    }
+    delete inst;
+}
+
+// LogGOPS evaluation of the degree 2 tree the message level collective
+// uses. start holds the time each rank entered the collective, done is
+// filled with the time each rank leaves it. A message costs the sender
+// o + O*bytes, the network L + G*bytes and the receiver o + O*bytes,
+// consecutive sends from one rank are at least g apart.
+void CollectiveTreeFuncSM::predict( ModelType type, int root,
+        const std::vector<double>& start, double scale, std::vector<double>& done )
+{
+    int size = start.size();
+    double bytes = m_bufLen;
+    double send = scale * ( m_logGOPS.o + m_logGOPS.O * bytes );
+    double wire = scale * ( m_logGOPS.L + m_logGOPS.G * bytes );
+    double recv = send;
+    double gap = std::max( scale * m_logGOPS.g, send );
+
+    std::vector<YYY> tree;
+    tree.reserve( size );
+    for ( int rank = 0; rank < size; rank++ ) {
+        tree.push_back( YYY( 2, rank, size, root ) );
+    }
+
+    // the tree is numbered with the root swapped with rank 0, children
+    // always have higher numbers than their parent
+    std::vector<int> order( size );
+    for ( int i = 0; i < size; i++ ) {
+        order[i] = i == 0 ? root : ( i == root ? 0 : i );
+    }
+
+    std::vector<double> up( start );
+    std::vector<double> down( size );
+    done.resize( size );
+
+    if ( ModelBcast != type ) {
+        std::vector<double> ready;
+        for ( int i = size - 1; i >= 0; i-- ) {
+            int rank = order[i];
+            ready.clear();
+            for ( unsigned int child = 0; child < tree[rank].numChildren(); child++ ) {
+                ready.push_back( up[ tree[rank].calcChild( child ) ] + send + wire );
+            }
+            std::sort( ready.begin(), ready.end() );
+            for ( unsigned int child = 0; child < ready.size(); child++ ) {
+                up[rank] = std::max( up[rank], ready[child] ) + recv;
+            }
+        }
+    }
+
+    if ( ModelReduce == type ) {
+        for ( int rank = 0; rank < size; rank++ ) {
+            done[rank] = rank == root ? up[rank] : up[rank] + send;
+        }
+        return;
+    }
+
+    // a child can take its parent's message once it has arrived, or once
+    // it has sent its own contribution up
+    down[root] = up[root];
+    for ( int i = 0; i < size; i++ ) {
+        int rank = order[i];
+        size_t numChildren = tree[rank].numChildren();
+        for ( unsigned int child = 0; child < numChildren; child++ ) {
+            int childRank = tree[rank].calcChild( child );
+            double posted = ModelBcast == type ? start[childRank] : up[childRank] + send;
+            down[childRank] = std::max( down[rank] + child * gap + send + wire, posted ) + recv;
+        }
+        done[rank] = numChildren ? down[rank] + ( numChildren - 1 ) * gap + send : down[rank];
+    }
+}
+
 void CollectiveTreeFuncSM::handleEnterEvent( Retval& retval )
 {
 	Hermes::MemAddr addr;
@@ -190,8 +427,12 @@ void CollectiveTreeFuncSM::handleEnterEvent( Retval& retval )
 			}
         }
 
+    case Analytic:
     case Exit:
         m_dbg.debug(CALL_INFO,1,0,"Exit\n" );
+        if ( Sampled == m_mode ) {
+            finishSample();
+        }
         retval.setExit( 0 );
         for ( unsigned int i = 0; i < m_yyy->numChildren(); i++ ) {
             if ( m_bufV[i+1] ) {
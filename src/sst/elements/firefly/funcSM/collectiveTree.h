@@ -16,7 +16,10 @@
 #ifndef COMPONENTS_FIREFLY_FUNCSM_COLLECTIVE_H
 #define COMPONENTS_FIREFLY_FUNCSM_COLLECTIVE_H
 
+#include <map>
+
 #include "funcSM/api.h"
+#include "funcSM/collectiveModel.h"
 #include "funcSM/event.h"
 #include "ctrlMsg.h"
 
@@ -98,6 +101,7 @@ class YYY {
     NAME( SendUp ) \
     NAME( WaitDown ) \
     NAME( SendDown ) \
+    NAME( Analytic ) \
     NAME( Exit ) \
 
 #define GENERATE_ENUM(ENUM) ENUM,
@@ -129,22 +133,32 @@ class CollectiveTreeFuncSM :  public FunctionSMInterface
         void init() { state = Sending; count = 0; }
     };
 
+    // how the time of one collective is arrived at
+    enum Mode { Simulated, Sampled, Modelled };
+
+  protected:
+    // kinds of collective that can be modelled, indexes m_analytic
+    enum ModelType { ModelAllreduce, ModelReduce, ModelBcast, ModelBarrier,
+                        NumModelTypes };
+
   public:
-    CollectiveTreeFuncSM( SST::Params& params ) :
-        FunctionSMInterface( params ),
-        m_event( NULL ),
-        m_seq( 0 ),
-        m_vn( 0 )
-    {
-        m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
-        m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
-    }
+    CollectiveTreeFuncSM( SST::Params& params );
 
     virtual void handleStartEvent( SST::Event*, Retval& );
     virtual void handleEnterEvent( Retval& );
 
+  protected:
+    // set by functions that implement themselves as another collective
+    bool                m_barrier;
+
   private:
 
+    ModelType modelType();
+    void startModel();
+    void finishSample();
+    void predict( ModelType, int root, const std::vector<double>& start,
+                        double scale, std::vector<double>& done );
+
     uint32_t    genTag() {
         return CtrlMsg::CollectiveTag | (m_seq & 0xffff);
     }
@@ -164,6 +178,15 @@ class CollectiveTreeFuncSM :  public FunctionSMInterface
     YYY*                m_yyy;
     int                 m_seq;
 
+    bool                m_analytic[NumModelTypes];
+    LogGOPS             m_logGOPS;
+    uint64_t            m_sampleInterval;
+    double              m_sampleWeight;
+    std::map<MP::Communicator,uint64_t> m_groupSeq;
+    Mode                m_mode;
+    CollectiveModel::Key m_key;
+    uint64_t            m_start;
+
     int m_vn;
     int m_smallCollectiveVN;
     int m_smallCollectiveSize;
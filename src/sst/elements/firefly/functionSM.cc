@@ -16,6 +16,7 @@
 #include <sst_config.h>
 
 #include <string.h>
+#include <set>
 #include <sstream>
 
 #include <sst/core/link.h>
@@ -65,6 +66,8 @@ FunctionSM::FunctionSM( ComponentId_t id, SST::Params& params, ProtocolAPI* prot
     m_toMeLink = configureSelfLink("ToMe", "1 ns",
         new Event::Handler<FunctionSM>(this,&FunctionSM::handleEnterEvent));
     assert( m_toMeLink );
+
+    m_psTimeConverter = getTimeConverter( "1ps" );
 }
 
 FunctionSM::~FunctionSM()
@@ -100,6 +103,16 @@ void FunctionSM::setup( Info* info )
                         m_params.find<std::string>("smallCollectiveVN","0"), true );
     defaultParams.insert( "smallCollectiveSize",
                         m_params.find<std::string>("smallCollectiveSize","0"), true );
+    defaultParams.insert( "analyticCollectives",
+                        m_params.find<std::string>("analyticCollectives",""), true );
+
+    Params analytic = m_params.get_scoped_params( "analytic" );
+    std::set<std::string> keys = analytic.getKeys();
+    for ( std::set<std::string>::iterator iter = keys.begin(); iter != keys.end(); ++iter ) {
+        defaultParams.insert( "analytic." + *iter, analytic.find<std::string>( *iter ), true );
+        m_analyticKeys.push_back( "analytic." + *iter );
+    }
+
     defaultParams.insert( "verboseLevel", m_params.find<std::string>("verboseLevel","0"), true );
     std::ostringstream tmp;
     tmp <<  nodeId;
@@ -148,6 +161,15 @@ void FunctionSM::initFunction( Info* info,
         params.insert( "smallCollectiveSize", defaultParams.find<std::string>( "smallCollectiveSize" ), true );
     }
 
+    if ( params.find<std::string>("analyticCollectives").empty() ) {
+        params.insert( "analyticCollectives", defaultParams.find<std::string>( "analyticCollectives" ), true );
+    }
+    for ( unsigned int i = 0; i < m_analyticKeys.size(); i++ ) {
+        if ( params.find<std::string>( m_analyticKeys[i] ).empty() ) {
+            params.insert( m_analyticKeys[i], defaultParams.find<std::string>( m_analyticKeys[i] ), true );
+        }
+    }
+
     params.insert( "nodeId", defaultParams.find<std::string>( "nodeId" ), true );
 
     m_smV[ num ] = (FunctionSMInterface*)loadModule( module + "." + name,
@@ -159,6 +181,7 @@ void FunctionSM::initFunction( Info* info,
     if ( ! m_smV[ num ]->protocolName().empty() ) {
         m_smV[ num ]->setProtocol( m_proto );
     }
+    m_smV[ num ]->setTimer( this );
 }
 
 void FunctionSM::enter( )
@@ -167,6 +190,24 @@ void FunctionSM::enter( )
     m_toMeLink->send( NULL );
 }
 
+uint64_t FunctionSM::now()
+{
+    return getCurrentSimTime( m_psTimeConverter );
+}
+
+// The ToMe link adds its own latency so it is taken out of the delay, a
+// wake up closer than that is late by the difference
+void FunctionSM::wakeAt( uint64_t time )
+{
+    uint64_t delay = 0;
+    uint64_t linkLatency = 1000;
+    if ( time > now() + linkLatency ) {
+        delay = time - now() - linkLatency;
+    }
+    m_dbg.debug(CALL_INFO,3,0,"wake at %" PRIu64 " ps\n", time );
+    m_toMeLink->send( delay, m_psTimeConverter, NULL );
+}
+
 void FunctionSM::start(int type, Callback callback,  SST::Event* e)
 {
     assert( e );
@@ -59,7 +59,7 @@ class ProtocolAPI;
 #define GENERATE_ENUM(ENUM) ENUM,
 #define GENERATE_STRING(STRING) #STRING,
 
-class FunctionSM : public SubComponent {
+class FunctionSM : public SubComponent, public FunctionSMInterface::Timer {
 
     typedef FunctionSMInterface::Retval Retval;
 	typedef CtrlMsg::Functor_0<FunctionSM, bool> Functor;
@@ -86,6 +86,14 @@ class FunctionSM : public SubComponent {
 		{"defaultReturnLatency","Sets the default latency to return from a function","0"},
 		{"smallCollectiveVN","Sets the VN to use for small collectives","0"},
 		{"smallCollectiveSize","Sets the size of small collectives","0"},
+		{"analyticCollectives","Comma separated list of collectives (allreduce, reduce, bcast, barrier) whose time is computed from a LogGOPS model instead of being simulated message by message",""},
+		{"analytic.L_ns","LogGOPS network latency of one tree edge","500"},
+		{"analytic.o_ns","LogGOPS CPU overhead of sending or receiving one message","1000"},
+		{"analytic.g_ns","LogGOPS gap between consecutive messages sent by one rank","100"},
+		{"analytic.G_ps_per_byte","LogGOPS network time per byte","250"},
+		{"analytic.O_ps_per_byte","LogGOPS CPU overhead per byte","0"},
+		{"analytic.sampleInterval","Simulate every Nth analytic collective message by message and scale the model by the measured time, 0 disables sampling","0"},
+		{"analytic.sampleWeight","Weight given to the newest sample when updating the model scale","0.5"},
 		{"nodeId","Sets the node ID",""},
 	)
 	/* PARAMS
@@ -111,6 +119,9 @@ class FunctionSM : public SubComponent {
     void start(int type, Callback,  SST::Event* );
     void enter( );
 
+    uint64_t now();
+    void wakeAt( uint64_t );
+
   private:
     void handleStartEvent( SST::Event* );
     void handleToDriver(SST::Event*);
@@ -128,8 +139,10 @@ class FunctionSM : public SubComponent {
     SST::Link*          m_fromDriverLink;
     SST::Link*          m_toDriverLink;
     SST::Link*          m_toMeLink;
+    TimeConverter*      m_psTimeConverter;
     Output              m_dbg;
     SST::Params         m_params;
+    std::vector<std::string> m_analyticKeys;
     ProtocolAPI*	m_proto;
 };
 
@@ -41,6 +41,7 @@ HadesSHMEM::HadesSHMEM(ComponentId_t id, Params& params) :
 	m_enterLat_ns = params.find<int>("enterLat_ns",30);
 	m_returnLat_ns = params.find<int>("returnLat_ns",30);
 	m_blockingReturnLat_ns = params.find<int>("blockingReturnLat_ns",300);
+	m_nicCollectives = params.find<bool>("nicCollectives",false);
 
 	Params famMapperParams = params.get_scoped_params( "famNodeMapper" );
 	if ( famMapperParams.size() ) {
@@ -322,6 +323,24 @@ void HadesSHMEM::barrier_all( Barrier_all* info )
 {
     dbg().debug(CALL_INFO,1,SHMEM_BASE,"\n");
 
+	if ( m_nicCollectives ) {
+		quiet(
+			[=](int) {
+				this->nicCollective( 0, 0, m_num_pes,
+					[=]( std::vector<int>& pes ) {
+						this->nic().shmemBarrier( pes, m_pSync.getSimVAddr(),
+							[=]() {
+								this->delayReturn( info->callback );
+								delete info;
+							}
+						);
+					}
+				);
+			}
+		);
+		return;
+	}
+
     m_barrier->start( 0, 0, m_num_pes, m_pSync.getSimVAddr(),
             [=](int) {
 
@@ -346,6 +365,24 @@ void HadesSHMEM::barrier( Barrier* info )
 {
     dbg().debug(CALL_INFO,1,SHMEM_BASE,"\n");
 
+	if ( m_nicCollectives ) {
+		quiet(
+			[=](int) {
+				this->nicCollective( info->start, info->stride, info->size,
+					[=]( std::vector<int>& pes ) {
+						this->nic().shmemBarrier( pes, info->pSync,
+							[=]() {
+								this->delayReturn( info->callback );
+								delete info;
+							}
+						);
+					}
+				);
+			}
+		);
+		return;
+	}
+
     m_barrier->start( info->start, info->stride, info->size, info->pSync,
             [=](int) {
 				this->delayReturn( info->callback );
@@ -368,6 +405,20 @@ void HadesSHMEM::broadcast( Vaddr dest, Vaddr source, size_t nelems, int root, i
 void HadesSHMEM::broadcast( Broadcast* info )
 {
     dbg().debug(CALL_INFO,1,SHMEM_BASE,"\n");
+
+	if ( m_nicCollectives ) {
+		nicCollective( info->PE_start, info->logPE_stride, info->PE_size,
+			[=]( std::vector<int>& pes ) {
+				this->nic().shmemBroadcast( pes, info->root, info->dest, info->source, info->nelems, info->pSync,
+					[=]() {
+						this->delayReturn( info->callback );
+						delete info;
+					}
+				);
+			}
+		);
+		return;
+	}
     m_broadcast->start( info->dest, info->source, info->nelems, info->root, info->PE_start, info->logPE_stride, info->PE_size, info->pSync,
             [=](int) {
 				this->delayReturn( info->callback );
@@ -390,6 +441,20 @@ void HadesSHMEM::fcollect( Vaddr dest, Vaddr source, size_t nelems, int start,
 void HadesSHMEM::fcollect( Fcollect* info )
 {
     dbg().debug(CALL_INFO,1,SHMEM_BASE,"\n");
+
+	if ( m_nicCollectives ) {
+		nicCollective( info->PE_start, info->logPE_stride, info->PE_size,
+			[=]( std::vector<int>& pes ) {
+				this->nic().shmemFcollect( pes, info->dest, info->source, info->nelems, info->pSync,
+					[=]() {
+						this->delayReturn( info->callback );
+						delete info;
+					}
+				);
+			}
+		);
+		return;
+	}
     m_fcollect->start( info->dest, info->source, info->nelems, info->PE_start, info->logPE_stride, info->PE_size, info->pSync,
             [=](int) {
 				this->delayReturn( info->callback );
@@ -480,6 +545,21 @@ void HadesSHMEM::reduction( Vaddr dest, Vaddr source, int nelems, int PE_start,
 void HadesSHMEM::reduction( Reduction* info )
 {
     dbg().debug(CALL_INFO,1,SHMEM_BASE,"\n");
+
+	if ( m_nicCollectives ) {
+		nicCollective( info->PE_start, info->logPE_stride, info->PE_size,
+			[=]( std::vector<int>& pes ) {
+				this->nic().shmemReduction( pes, info->dest, info->source,
+						info->nelems * Hermes::Value::getLength( info->type ), info->pSync, info->op, info->type,
+					[=]() {
+						this->delayReturn( info->callback );
+						delete info;
+					}
+				);
+			}
+		);
+		return;
+	}
     m_reduction->start( info->dest, info->source, info->nelems, info->PE_start, info->logPE_stride, info->PE_size, info->pSync,
             info->op, info->type,
             [=](int) {
@@ -489,6 +569,29 @@ void HadesSHMEM::reduction( Reduction* info )
 	);
 }
 
+// Hands a collective to the NIC. The active set is passed to "issue" as
+// network PEs once the NIC has room for another command.
+void HadesSHMEM::nicCollective( int PE_start, int logPE_stride, int PE_size, std::function<void(std::vector<int>&)> issue )
+{
+    dbg().debug(CALL_INFO,1,SHMEM_BASE,"PE_start=%d logPE_stride=%d PE_size=%d\n",PE_start,logPE_stride,PE_size);
+
+	std::vector<int> pes;
+	for ( int i = 0; i < PE_size; i++ ) {
+		pes.push_back( calcNetPE( PE_start + ( i << logPE_stride ) ) );
+	}
+
+	Callback callback = [=]() {
+		std::vector<int> _pes = pes;
+		issue( _pes );
+	};
+
+	if ( nic().isBlocked() ) {
+		nic().setBlockedCallback( callback );
+	} else {
+		callback();
+	}
+}
+
 void HadesSHMEM::get(Hermes::Vaddr dest, Hermes::Vaddr src, size_t length, int pe, bool blocking, Shmem::Callback callback )
 {
     dbg().debug(CALL_INFO,1,SHMEM_BASE,"destSimVAddr=%#" PRIx64 " srcSimVaddr=%#" PRIx64 " length=%lu\n",
@@ -62,6 +62,7 @@ class HadesSHMEM : public Shmem::Interface
         {"enterLat_ns","Sets the latency of entering a SHMEM call","" },
         {"returnLat_ns","Sets the latency of returning from a SHMEM call","" },
         {"blockingReturnLat_ns","Sets the latency of returning from a SHMEM call that blocked on response","" },
+        {"nicCollectives","Run barrier, broadcast, fcollect and reduction on the NIC","0" },
 
 		/* PARAMS passed to another module
 			famNodeMapper.*
@@ -548,6 +549,8 @@ class HadesSHMEM : public Shmem::Interface
     Output m_dbg;
     Hades*      m_os;
 
+	void nicCollective( int PE_start, int logPE_stride, int PE_size, std::function<void(std::vector<int>&)> issue );
+
 	void delayEnter( Callback callback, SimTime_t delay = 0 );
 	void delayEnter( Shmem::Callback callback, SimTime_t delay = 0 );
 	void delayReturn( Shmem::Callback callback, SimTime_t delay = 0 );
@@ -657,6 +660,7 @@ class HadesSHMEM : public Shmem::Interface
 	SimTime_t m_returnLat_ns;
 	SimTime_t m_enterLat_ns;
     SimTime_t m_blockingReturnLat_ns;
+    bool m_nicCollectives;
 
 	uint64_t m_shmemAddrStart;
 
@@ -17,18 +17,28 @@
 #define COMPONENTS_FIREFLY_IOVEC_H
 
 #include <stddef.h>
+#include <memory>
+#include <vector>
 
 #include "sst/elements/hermes/hermes.h"
 
 namespace SST {
 namespace Firefly {
 
+// Reference counted copy of message data. Segments that point into one
+// keep it alive, so packets can carry a reference rather than their own
+// copy of the bytes.
+typedef std::shared_ptr< std::vector<unsigned char> > SharedBuf;
+
 struct IoVec {
     IoVec() {}
     IoVec( const Hermes::MemAddr& _addr, size_t _size ) :
         addr( _addr ), len( _size ) {}
+    IoVec( const Hermes::MemAddr& _addr, size_t _size, const SharedBuf& _owner ) :
+        addr( _addr ), len( _size ), owner( _owner ) {}
 	Hermes::MemAddr addr;
     size_t len;
+    SharedBuf owner;
 };
 }
 }
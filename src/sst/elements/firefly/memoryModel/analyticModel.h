@@ -0,0 +1,346 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Closed form replacement for the unit network. Every shared resource (host
+// memory and the two directions of the PCIe bus) is reduced to the time it is
+// next free and every thread to the time it can next issue and the time its
+// last op retired. A Work is costed op by op when it is posted, giving the
+// time each op and the Work itself complete, no events are needed until then.
+//
+// The host cache and the NIC TLB keep their tags, in the same LRU order as
+// CacheUnit and SharedTlb, so hits are free and only misses reach memory or
+// pay a page walk. Like the unit network every op takes at least one trip
+// across the model's self link.
+class AnalyticModel {
+
+	struct ThreadState {
+		ThreadState() : issued(0), done(0), retired(0), lastOp(MemOp::NotInit) {}
+		double issued;
+		double done;
+		double retired;
+		MemOp::Op lastOp;
+	};
+
+	struct Timing {
+		Timing( double issued, double done ) : issued(issued), done(done) {}
+		double issued;
+		double done;
+	};
+
+  public:
+	AnalyticModel( Output& dbg, int id, int numThreads, int numNicThreads, int memReadLat_ns, int memWriteLat_ns,
+			int memNumSlots, int nicNumLoadSlots, int nicNumStoreSlots, int hostNumLoadSlots, int hostNumStoreSlots,
+			bool useBusBridge, double busBandwidth, int busNumLinks, int busLatency, int TLP_overhead, int DLL_bytes,
+			int cacheLineSize, int nicToHostMTU ) :
+		m_dbg(dbg), m_threads( numThreads ), m_numNicThreads( numNicThreads ),
+		m_memReadLat( memReadLat_ns ), m_memWriteLat( memWriteLat_ns ), m_memNumSlots( memNumSlots ),
+		m_nicNumLoadSlots( nicNumLoadSlots ), m_nicNumStoreSlots( nicNumStoreSlots ),
+		m_hostNumLoadSlots( hostNumLoadSlots ), m_hostNumStoreSlots( hostNumStoreSlots ),
+		m_useBusBridge( useBusBridge ), m_busBandwidth( busBandwidth ), m_busNumLinks( busNumLinks ),
+		m_busLatency( busLatency ), m_TLP_overhead( TLP_overhead ), m_DLL_bytes( DLL_bytes ),
+		m_cacheLineSize( cacheLineSize ), m_nicToHostMTU( nicToHostMTU ),
+		m_hostCache(NULL), m_hostCacheNumMSHR(0), m_tlb(NULL), m_tlbPageSize(0), m_tlbMissLat(0), m_tlbNumWalkers(1),
+		m_memFree(0), m_reqBusFree(0), m_respBusFree(0)
+	{
+		m_prefix = "@t:" + std::to_string(id) + ":SimpleMemoryModel::AnalyticModel::@p():@l ";
+	}
+
+	~AnalyticModel() {
+		delete m_hostCache;
+		delete m_tlb;
+	}
+
+	// every host and bus access goes through a host cache of "numLines" lines
+	void setHostCache( int numLines, int numMSHR ) {
+		m_hostCache = new Cache( numLines );
+		m_hostCacheNumMSHR = numMSHR;
+	}
+
+	// NIC accesses are translated by a TLB of "size" pages
+	void setTlb( int size, int pageSize, int missLat_ns, int numWalkers ) {
+		m_tlb = new Cache( size );
+		m_tlbPageSize = pageSize;
+		m_tlbMissLat = missLat_ns;
+		m_tlbNumWalkers = numWalkers;
+	}
+
+	// Costs the ops of a Work of process "pid" posted to thread "slot" at
+	// time "now". The completion time of each op, kept in order of
+	// retirement, is returned in "done", the last entry is when the Work
+	// itself completes.
+	void cost( int slot, int pid, SimTime_t now, std::vector< MemOp >& ops, std::vector<SimTime_t>& done ) {
+		ThreadState& thread = m_threads[slot];
+		bool isNic = slot < m_numNicThreads;
+
+		for ( unsigned i = 0; i < ops.size(); i++ ) {
+			MemOp& op = ops[i];
+
+			// an op of the same type as the one before it is pipelined behind
+			// it, a change of type waits for the previous op to complete
+			double start = now;
+			if ( op.getType() == thread.lastOp ) {
+				start = std::max( start, thread.issued );
+			} else {
+				start = std::max( start, thread.done );
+			}
+
+			Timing timing = costOp( isNic, pid, op, start );
+
+			m_dbg.verbosePrefix(prefix(),CALL_INFO,2,SM_MASK,"slot=%d op=%s length=%zu start=%.1f issued=%.1f done=%.1f\n",
+					slot, op.getName(), op.length, start, timing.issued, timing.done );
+
+			thread.issued = timing.issued;
+			thread.done = std::max( thread.done, timing.done );
+			thread.lastOp = op.getType();
+
+			// ops retire in order
+			thread.retired = std::max( thread.retired, timing.done );
+			done.push_back( round( thread.retired ) );
+		}
+
+		if ( ops.empty() ) {
+			thread.retired = std::max( thread.retired, (double) now );
+			done.push_back( round( thread.retired ) );
+		}
+	}
+
+  private:
+
+	Timing costOp( bool isNic, int pid, MemOp& op, double start ) {
+		size_t length = op.length;
+
+		// the unit network tags host addresses with the pid
+		Hermes::Vaddr addr = op.addr | (uint64_t) pid << 56;
+
+		switch( op.getType() ) {
+		  case MemOp::NoOp:
+		  case MemOp::LocalLoad:
+		  case MemOp::LocalStore:
+			return Timing( start, start + SelfLinkLat );
+
+		  case MemOp::HostBusWrite:
+			if ( ! m_useBusBridge ) {
+				return Timing( start, start + SelfLinkLat );
+			}
+			return busWrite( start, length );
+
+		  case MemOp::HostLoad:
+		  case MemOp::BusLoad:
+		  case MemOp::BusDmaFromHost:
+			return load( isNic, translate( isNic, start, addr, length ), addr, length );
+
+		  case MemOp::HostStore:
+		  case MemOp::BusStore:
+		  case MemOp::BusDmaToHost:
+			return store( isNic, translate( isNic, start, addr, length ), addr, length );
+
+		  case MemOp::HostCopy:
+			{
+				Hermes::Vaddr src = op.src | (uint64_t) pid << 56;
+				Hermes::Vaddr dest = op.dest | (uint64_t) pid << 56;
+				Timing loaded = load( isNic, start, src, length );
+				Timing stored = store( isNic, loaded.issued, dest, length );
+				return Timing( stored.issued, std::max( loaded.done, stored.done ) );
+			}
+
+		  default:
+			m_dbg.fatal(CALL_INFO,-1,"unsupported op %s\n", op.getName() );
+		}
+		return Timing( start, start );
+	}
+
+	// NIC threads reach host memory across the bus, host threads go to it
+	// directly
+	Timing load( bool isNic, double start, Hermes::Vaddr addr, size_t length ) {
+		if ( isNic && m_useBusBridge ) {
+			return busLoad( start, addr, length, m_nicNumLoadSlots );
+		}
+		return hostAccess( start, addr, length, isNic ? m_nicNumLoadSlots : m_hostNumLoadSlots, true );
+	}
+
+	Timing store( bool isNic, double start, Hermes::Vaddr addr, size_t length ) {
+		if ( isNic && m_useBusBridge ) {
+			return busStore( start, addr, length, m_nicNumStoreSlots );
+		}
+		return hostAccess( start, addr, length, isNic ? m_nicNumStoreSlots : m_hostNumStoreSlots, false );
+	}
+
+	// NIC accesses wait for the walks of the pages the TLB misses on, the
+	// walkers resolve those in parallel
+	double translate( bool isNic, double start, Hermes::Vaddr addr, size_t length ) {
+		if ( ! isNic || ! m_tlb ) {
+			return start;
+		}
+
+		uint64_t pageMask = ~( (uint64_t) m_tlbPageSize - 1 );
+		size_t misses = 0;
+		for ( uint64_t page = addr & pageMask; page < addr + std::max( length, (size_t) 1 ); page += m_tlbPageSize ) {
+			misses += lookup( *m_tlb, page ) ? 0 : 1;
+		}
+
+		return start + (double) ( ( misses + m_tlbNumWalkers - 1 ) / m_tlbNumWalkers ) * m_tlbMissLat;
+	}
+
+	// With a host cache hits complete after a self link trip and each miss
+	// loads its line and writes back the line it evicts, as CacheUnit does
+	// for loads and stores alike. The cache's MSHRs limit the misses in
+	// flight. Without one every line goes to memory.
+	Timing hostAccess( double start, Hermes::Vaddr addr, size_t length, int threadSlots, bool isLoad ) {
+		if ( ! m_hostCache ) {
+			return memAccess( start, numLines( length ), isLoad ? m_memReadLat : m_memWriteLat, threadSlots, isLoad );
+		}
+
+		uint64_t lineMask = ~( (uint64_t) m_cacheLineSize - 1 );
+		size_t misses = 0;
+		for ( uint64_t line = addr & lineMask; line < addr + std::max( length, (size_t) 1 ); line += m_cacheLineSize ) {
+			misses += lookup( *m_hostCache, line ) ? 0 : 1;
+		}
+
+		if ( 0 == misses ) {
+			return Timing( start, start + SelfLinkLat );
+		}
+
+		Timing filled = memAccess( start, misses, m_memReadLat, std::min( threadSlots, m_hostCacheNumMSHR ), true );
+		m_memFree += misses * (double) m_memWriteLat / m_memNumSlots;
+
+		return filled;
+	}
+
+	// true on a hit, a miss replaces the least recently used entry
+	bool lookup( Cache& cache, Hermes::Vaddr addr ) {
+		if ( cache.isValid( addr ) ) {
+			cache.updateAge( addr );
+			return true;
+		}
+		cache.evict();
+		cache.insert( addr );
+		return false;
+	}
+
+	// "lines" accesses of "latency" pipelined through the memory slots, a
+	// thread with fewer slots than memory fills the pipe more slowly. Loads
+	// complete when the data returns, stores once memory has accepted them.
+	Timing memAccess( double start, size_t lines, int latency, int threadSlots, bool isLoad ) {
+		double perLine = (double) latency / m_memNumSlots;
+
+		double begin = std::max( start, m_memFree );
+		m_memFree = begin + lines * perLine;
+
+		int slots = std::min( threadSlots, m_memNumSlots );
+		double pipe = start + (double) ( lines - 1 ) * latency / slots;
+
+		if ( isLoad ) {
+			return Timing( m_memFree, std::max( m_memFree + latency - perLine, pipe + latency ) );
+		} else {
+			double accepted = std::max( m_memFree - perLine, pipe );
+			return Timing( accepted, accepted );
+		}
+	}
+
+	// read requests go out on the request bus as bare TLPs, the data comes
+	// back on the response bus once host memory has returned it
+	Timing busLoad( double start, Hermes::Vaddr addr, size_t length, int threadSlots ) {
+		size_t chunks = numChunks( length );
+
+		double reqBegin = std::max( start, m_reqBusFree );
+		m_reqBusFree = reqBegin + chunks * byteDelay( m_TLP_overhead + m_DLL_bytes );
+
+		double arrive = reqBegin + byteDelay( m_TLP_overhead ) + m_busLatency;
+		Timing mem = hostAccess( arrive, addr, length, threadSlots, true );
+
+		double respBusy = byteDelay( length + chunks * ( m_TLP_overhead - 4 + m_DLL_bytes ) );
+		double respBegin = std::max( arrive + m_memReadLat, m_respBusFree );
+		m_respBusFree = respBegin + respBusy;
+
+		size_t last = std::min( length, (size_t) m_nicToHostMTU );
+		double done = std::max( m_respBusFree, mem.done + byteDelay( last + m_TLP_overhead - 4 ) ) + m_busLatency;
+
+		return Timing( m_reqBusFree, done );
+	}
+
+	// posted writes, the store is complete once the request bus has taken
+	// it and host memory has accepted it
+	Timing busStore( double start, Hermes::Vaddr addr, size_t length, int threadSlots ) {
+		size_t chunks = numChunks( length );
+
+		double reqBegin = std::max( start, m_reqBusFree );
+		m_reqBusFree = reqBegin + byteDelay( length + chunks * ( m_TLP_overhead + m_DLL_bytes ) );
+
+		size_t first = std::min( length, (size_t) m_nicToHostMTU );
+		double arrive = reqBegin + byteDelay( first + m_TLP_overhead ) + m_busLatency;
+		Timing mem = hostAccess( arrive, addr, length, threadSlots, false );
+
+		double done = std::max( m_reqBusFree, mem.done - m_busLatency );
+		return Timing( done, done );
+	}
+
+	// host writes straight to the NIC over the response bus
+	Timing busWrite( double start, size_t length ) {
+		double begin = std::max( start, m_respBusFree );
+		m_respBusFree = begin + byteDelay( length + m_TLP_overhead - 4 + m_DLL_bytes );
+		return Timing( m_respBusFree, m_respBusFree + m_busLatency );
+	}
+
+	// matches BusBridgeUnit::calcByteDelay()
+	double byteDelay( size_t numBytes ) {
+		return (double) ( numBytes / ( m_busNumLinks / 8 ) ) / m_busBandwidth;
+	}
+
+	size_t numLines( size_t length ) {
+		return length ? ( length + m_cacheLineSize - 1 ) / m_cacheLineSize : 1;
+	}
+
+	size_t numChunks( size_t length ) {
+		return length ? ( length + m_nicToHostMTU - 1 ) / m_nicToHostMTU : 1;
+	}
+
+	const char* prefix() { return m_prefix.c_str(); }
+
+	// latency of SimpleMemoryModel's self link, every unit callback crosses it
+	static const int SelfLinkLat = 1;
+
+	Output&		m_dbg;
+	std::string	m_prefix;
+	std::vector<ThreadState> m_threads;
+	int		m_numNicThreads;
+
+	int		m_memReadLat;
+	int		m_memWriteLat;
+	int		m_memNumSlots;
+	int		m_nicNumLoadSlots;
+	int		m_nicNumStoreSlots;
+	int		m_hostNumLoadSlots;
+	int		m_hostNumStoreSlots;
+
+	bool	m_useBusBridge;
+	double	m_busBandwidth;
+	int		m_busNumLinks;
+	int		m_busLatency;
+	int		m_TLP_overhead;
+	int		m_DLL_bytes;
+	int		m_cacheLineSize;
+	int		m_nicToHostMTU;
+
+	Cache*	m_hostCache;
+	int		m_hostCacheNumMSHR;
+	Cache*	m_tlb;
+	int		m_tlbPageSize;
+	int		m_tlbMissLat;
+	int		m_tlbNumWalkers;
+
+	double	m_memFree;
+	double	m_reqBusFree;
+	double	m_respBusFree;
+};
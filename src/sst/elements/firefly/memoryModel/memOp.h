@@ -112,6 +112,11 @@
 			}
 		}
 
+		// the op as posted, getOp() reports the phase a HostCopy is in
+		Op getType( ) {
+			return type;
+		}
+
 		int chunk;
         Hermes::Vaddr addr;
         Hermes::Vaddr src;
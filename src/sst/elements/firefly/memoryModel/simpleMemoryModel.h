@@ -74,6 +74,7 @@ public:
 		{"useHostCache",        "Sets whether or not to use a host cache","yes"},
 		{"useDetailedModel",    "Sets whether or not a detailed memory model is used","no"},
 		{"useBusBridge",        "Sets whether or not a bus is used between the NIC and host","yes"},
+		{"useAnalyticModel",    "Sets whether or not completion times are computed in closed form instead of by the unit network","no"},
 		{"printConfig",         "Print the config","no"},
     )
 
@@ -130,6 +131,7 @@ public:
 #include "memUnit.h"
 #include "cacheUnit.h"
 #include "detailedUnit.h"
+#include "analyticModel.h"
 
 
     class SelfEvent : public SST::Event {
@@ -151,7 +153,7 @@ public:
 	enum NIC_Thread { Send, Recv };
 
     SimpleMemoryModel( ComponentId_t compId, Params& params ) :
-		MemoryModel( compId ), m_hostCacheUnit(NULL), m_busBridgeUnit(NULL)
+		MemoryModel( compId ), m_hostCacheUnit(NULL), m_busBridgeUnit(NULL), m_nicUnit(NULL), m_sharedTlb(NULL), m_analytic(NULL)
 	{
 		int id = params.find<int32_t>( "id", -1 );
 		assert( id > -1 );
@@ -217,8 +219,41 @@ public:
 			m_dbg.fatal(CALL_INFO,0,"unknown value for parameter useBusBridge '%s'\n",tmp.c_str());
 		}
 
+		bool useAnalyticModel;
+		tmp = params.find<std::string>( "useAnalyticModel", "no" );
+		if ( 0 == tmp.compare("yes" ) ) {
+			useAnalyticModel = true;
+		} else if ( 0 == tmp.compare("no" ) ) {
+			useAnalyticModel = false;
+		} else {
+			m_dbg.fatal(CALL_INFO,0,"unknown value for parameter useAnalyticModel '%s'\n",tmp.c_str());
+		}
+
+		if ( useAnalyticModel && m_detailedUnit ) {
+			m_dbg.fatal(CALL_INFO,0,"useAnalyticModel and useDetailedModel can not both be set\n");
+		}
+
 		if ( 0 == params.find<std::string>( "printConfig", "no" ).compare("yes" ) ) {
-			m_dbg.output("Node id=%d is using SimpleMemoryModel, useBusBridge=%d, useHostCache=%d\n", id, useBusBridge, useHostCache);
+			m_dbg.output("Node id=%d is using SimpleMemoryModel, useBusBridge=%d, useHostCache=%d, useAnalyticModel=%d\n",
+					id, useBusBridge, useHostCache, useAnalyticModel);
+		}
+
+		m_selfLink = configureSelfLink("Nic::SimpleMemoryModel", "1 ns",
+        new Event::Handler<SimpleMemoryModel>(this,&SimpleMemoryModel::handleSelfEvent));
+
+		// the analytic model replaces the whole unit network, none of it is built
+		if ( useAnalyticModel ) {
+			m_analytic = new AnalyticModel( m_dbg, id, m_numNicThreads + numCores, m_numNicThreads,
+					memReadLat_ns, memWriteLat_ns, memNumSlots, nicNumLoadSlots, nicNumStoreSlots,
+					hostNumLoadSlots, hostNumStoreSlots, useBusBridge, busBandwidth, busNumLinks, busLatency,
+					TLP_overhead, DLL_bytes, hostCacheLineSize, nicToHostMTU );
+			if ( useHostCache ) {
+				m_analytic->setHostCache( hostCacheUnitSize, hostCacheNumMSHR );
+			}
+			if ( tlbSize > 0 ) {
+				m_analytic->setTlb( tlbSize, tlbPageSize, tlbMissLat_ns, numWalkers );
+			}
+			return;
 		}
 
 		if ( ! m_detailedUnit ) {
@@ -277,9 +312,6 @@ public:
 				)
 			);
 		}
-
-		m_selfLink = configureSelfLink("Nic::SimpleMemoryModel", "1 ns",
-        new Event::Handler<SimpleMemoryModel>(this,&SimpleMemoryModel::handleSelfEvent));
 	}
 
     virtual ~SimpleMemoryModel() {
@@ -291,6 +323,7 @@ public:
         }
 		delete m_sharedTlb;
 		delete m_nicUnit;
+		delete m_analytic;
     }
 
 	ThingHeap<SelfEvent> m_eventHeap;
@@ -352,7 +385,11 @@ public:
 		m_dbg.debug(CALL_INFO,3,SM_MASK,"now=%" PRIu64 "\n",now );
 
 		int id = m_numNicThreads + core;
-		addWork( id, new Work( core, ops, callback, now ) );
+		if ( m_analytic ) {
+			analyticWork( id, core, ops, callback );
+		} else {
+			addWork( id, new Work( core, ops, callback, now ) );
+		}
 	}
 
 	virtual void schedNicCallback( int unit, int pid, std::vector< MemOp >* ops, Callback callback ) {
@@ -360,7 +397,30 @@ public:
 		m_dbg.debug(CALL_INFO,3,SM_MASK,"now=%" PRIu64 " unit=%d\n", now, unit );
 		assert( unit >=0 );
 
-		addWork( unit, new Work( pid, ops, callback, now ) );
+		if ( m_analytic ) {
+			analyticWork( unit, pid, ops, callback );
+		} else {
+			addWork( unit, new Work( pid, ops, callback, now ) );
+		}
+	}
+
+	// cost the ops up front and send one event for each callback, the ops'
+	// own callbacks and then the caller's, at the time each completes
+	void analyticWork( int slot, int pid, std::vector< MemOp >* ops, Callback callback ) {
+		SimTime_t now = getCurrentSimTimeNano();
+		std::vector<SimTime_t> done;
+
+		m_analytic->cost( slot, pid, now, *ops, done );
+
+		for ( unsigned i = 0; i < ops->size(); i++ ) {
+			if ( (*ops)[i].callback ) {
+				schedCallback( done[i] - now, new Callback( (*ops)[i].callback ) );
+			}
+		}
+
+		m_dbg.debug(CALL_INFO,3,SM_MASK,"slot=%d numOps=%zu delay=%" PRIu64 "\n", slot, ops->size(), done.back() - now );
+		schedCallback( done.back() - now, new Callback( callback ) );
+		delete ops;
 	}
 
 	NicUnit& nicUnit() { return *m_nicUnit; }
@@ -400,6 +460,7 @@ public:
 	NicUnit* 		m_nicUnit;
 	CacheUnit* 		m_nicCacheUnit;
     SharedTlb*      m_sharedTlb;
+	AnalyticModel*  m_analytic;
 
 	std::vector<Thread*> m_threads;
 
@@ -19,6 +19,8 @@
 
 #include <sst/core/interfaces/simpleNetwork.h>
 
+#include "ioVec.h"
+
 namespace SST {
 namespace Firefly {
 
@@ -28,17 +30,31 @@ class FireflyNetworkEvent : public Event {
 
   public:
 
-    FireflyNetworkEvent( ) : offset(0), bufLen(0), m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(0) {
+    FireflyNetworkEvent( ) : offset(0), bufLen(0), sharedPtr(NULL), m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(0) {
         buf.reserve( 1000 );
         assert( 0 == buf.size() );
     }
 
-    FireflyNetworkEvent( int pktOverhead, size_t reserve = 1000 ) : offset(0), bufLen(0),
+    FireflyNetworkEvent( int pktOverhead, size_t reserve = 1000 ) : offset(0), bufLen(0), sharedPtr(NULL),
             m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(pktOverhead) {
         buf.reserve( reserve );
         assert( 0 == buf.size() );
     }
 
+    // Returns a recycled event to the state of a newly built one, the
+    // buffer keeps its capacity
+    void reset( int _pktOverhead ) {
+        offset = 0;
+        bufLen = 0;
+        buf.clear();
+        shared.reset();
+        sharedPtr = NULL;
+        m_isHdr = false;
+        m_isTail = false;
+        m_isCtrl = false;
+        pktOverhead = _pktOverhead;
+    }
+
     void setCtrl() { m_isCtrl = true; }
     bool isCtrl() { return m_isCtrl; }
     void setHdr() { m_isHdr = true; }
@@ -64,6 +80,9 @@ class FireflyNetworkEvent : public Event {
         return ( bufLen == offset );
     }
     void* bufPtr( size_t len = 0 ) {
+        if ( shared ) {
+            return offset + len < bufLen ? (void*) ( sharedPtr + offset + len ) : NULL;
+        }
         if ( offset + len < buf.size() ) {
             return &buf[offset + len];
         } else {
@@ -78,6 +97,9 @@ class FireflyNetworkEvent : public Event {
     }
 
     void bufAppend( const void* ptr , size_t len ) {
+        if ( shared ) {
+            unshare();
+        }
         if ( ptr ) {
             buf.resize( bufLen + len);
             memcpy( &buf[bufLen], (const char*) ptr, len );
@@ -85,10 +107,27 @@ class FireflyNetworkEvent : public Event {
         bufLen += len;
     }
 
+    // Appends data held in a shared buffer. While everything appended is
+    // one contiguous run of the same buffer the event only holds a
+    // reference, otherwise the data is copied in as bufAppend() would.
+    void bufAppendShared( const SharedBuf& owner, const void* ptr, size_t len ) {
+        if ( 0 == bufLen && ! shared ) {
+            shared = owner;
+            sharedPtr = (const unsigned char*) ptr;
+        } else if ( shared != owner || sharedPtr + bufLen != ptr ) {
+            bufAppend( ptr, len );
+            return;
+        }
+        bufLen += len;
+    }
+
     FireflyNetworkEvent(const FireflyNetworkEvent *me) :
         Event()
     {
         buf = me->buf;
+        bufLen = me->bufLen;
+        shared = me->shared;
+        sharedPtr = me->sharedPtr;
         seq = me->seq;
         srcNode = me->srcNode;
         srcPid = me->srcPid;
@@ -104,6 +143,9 @@ class FireflyNetworkEvent : public Event {
         Event()
     {
         buf = me.buf;
+        bufLen = me.bufLen;
+        shared = me.shared;
+        sharedPtr = me.sharedPtr;
         seq = me.seq;
         srcNode = me.srcNode;
         srcPid = me.srcPid;
@@ -145,10 +187,22 @@ class FireflyNetworkEvent : public Event {
     size_t          offset;
     size_t          bufLen;
     std::vector<unsigned char>     buf;
+    SharedBuf                      shared;
+    const unsigned char*           sharedPtr;
+
+    // take a private copy of the shared data
+    void unshare() {
+        buf.assign( sharedPtr, sharedPtr + bufLen );
+        shared.reset();
+        sharedPtr = NULL;
+    }
 
   public:
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
         Event::serialize_order(ser);
+        if ( shared ) {
+            unshare();
+        }
         ser & seq;
         ser & offset;
         ser & bufLen;
@@ -84,6 +84,8 @@ Nic::Nic(ComponentId_t id, Params &params) :
     m_shmemPutThresholdLength = params.find<size_t>( "shmemPutThresholdLength", 0 );
 
     m_sendPQ.resize( m_numVN );
+    m_maxPoolSize = params.find<size_t>( "maxPoolSize", 1024 );
+    m_networkEventPool.reserve( m_maxPoolSize );
 
     int rxMatchDelay = params.find<int>( "rxMatchDelay_ns", 100 );
     m_txDelay =      params.find<int>( "txDelay_ns", 50 );
@@ -258,7 +260,8 @@ Nic::Nic(ComponentId_t id, Params &params) :
                 params.find<uint32_t>("verboseMask",-1),
                 rxMatchDelay, hostReadDelay, maxRecvMachineQsize,
                 params.find<int>( "maxActiveRecvStreams", 16 ),
-                params.find<int>( "maxPendingRecvPkts", 64) ) );
+                params.find<int>( "maxPendingRecvPkts", 64),
+                params.find<bool>( "oldestFirstRecv", false ) ) );
     }
 
     m_recvCtxData.resize( m_num_vNics );
@@ -349,6 +352,14 @@ Nic::~Nic()
         delete m_vNicV[i];
     }
 	delete m_arbitrateDMA;
+
+	for ( size_t i = 0; i < m_networkEventPool.size(); i++ ) {
+		delete m_networkEventPool[i];
+	}
+	for ( size_t i = 0; i < m_priorityXPool.size(); i++ ) {
+		delete m_priorityXPool[i]->data();
+		delete m_priorityXPool[i];
+	}
 }
 
 void Nic::init( unsigned int phase )
@@ -612,9 +623,8 @@ void Nic::feedTheNetwork( int vn )
 
 			x.callback();
 
-			delete &x;
-			delete entry;
 			pq.pop();
+			freePriorityX( entry );
 		}
 	}
 }
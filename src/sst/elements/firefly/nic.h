@@ -20,6 +20,9 @@
 #include <math.h>
 #include <sstream>
 #include <queue>
+#include <deque>
+#include <map>
+#include <set>
 #include <sst/core/module.h>
 #include <sst/core/component.h>
 #include <sst/core/output.h>
@@ -111,6 +114,7 @@ class Nic : public SST::Component  {
 
         { "shmem.nicCmdLatency", "Latency for posting shmem command on NIC", "10"},
         { "shmem.hostCmdLatency", "Host latency for posting shmem command", "10"},
+        { "shmem.collRadix", "Sets the radix of the tree of nodes used by NIC collectives", "8"},
 
         { "FAM_memsize", "", "0"},
         { "FAM_backed", "Controls whether FAM memory is backed in the simlation", "yes"},
@@ -120,6 +124,8 @@ class Nic : public SST::Component  {
 
         { "maxActiveRecvStreams", "Set max number of active receive streams", "16" },
         { "maxPendingRecvPkts", "Set max number of pending receive packets", "64" },
+        { "oldestFirstRecv", "Service buffered receive packets in the order their source's oldest packet arrived rather than in hash order", "false" },
+        { "maxPoolSize", "Set max number of recycled network packets and send queue entries kept by the NIC", "1024" },
 
         { "dmaBW_GBs", "set the one way DMA bandwidth", "100"},
         { "dmaContentionMult", "set the DMA contention mult", "100"},
@@ -219,8 +225,8 @@ class Nic : public SST::Component  {
         ShmemMsgHdr() : op2(0) {}
         uint64_t vaddr;
         uint32_t length;
-        enum Op { Ack, Put, Get, GetResp, Add, Fadd, Swap, Cswap };
-        unsigned short op : 3;
+        enum Op { Ack, Put, Get, GetResp, Add, Fadd, Swap, Cswap, Coll };
+        unsigned short op : 4;
         unsigned short op2 : 3;
         unsigned short dataType : 3;
         uint32_t respKey : 24;
@@ -243,6 +249,8 @@ class Nic : public SST::Component  {
                 return "Swap";
             case Cswap:
                 return "Cswap";
+            case Coll:
+                return "Coll";
             default:
                 assert(0);
             }
@@ -292,6 +300,7 @@ class Nic : public SST::Component  {
 
  	  public:
     	Priority( SimTime_t p1, int p2 ) :  m_p1(p1), m_p2(p2) {}
+		void reset( SimTime_t p1, int p2 ) { m_p1 = p1; m_p2 = p2; }
 
     	SimTime_t p1() const { return m_p1; }
     	int p2() const { return m_p2; }
@@ -484,6 +493,57 @@ struct X {
 
 	typedef PriorityEntry<X*> PriorityX;
 
+	// Network packets and send queue entries are recycled through NIC local
+	// pools. Packets are freed by the receiving NIC so a pool only keeps up
+	// to m_maxPoolSize of them, the rest go back to the heap.
+	FireflyNetworkEvent* allocNetworkEvent( int pktOverhead ) {
+		if ( m_networkEventPool.empty() ) {
+			return new FireflyNetworkEvent( pktOverhead );
+		}
+		FireflyNetworkEvent* ev = m_networkEventPool.back();
+		m_networkEventPool.pop_back();
+		ev->reset( pktOverhead );
+		return ev;
+	}
+
+	void freeNetworkEvent( FireflyNetworkEvent* ev ) {
+		if ( m_networkEventPool.size() < m_maxPoolSize ) {
+			m_networkEventPool.push_back( ev );
+		} else {
+			delete ev;
+		}
+	}
+
+	PriorityX* allocPriorityX( SimTime_t p1, int p2, Callback callback, FireflyNetworkEvent* pkt, int dest ) {
+		if ( m_priorityXPool.empty() ) {
+			return new PriorityX( p1, p2, new X( callback, pkt, dest ) );
+		}
+		PriorityX* px = m_priorityXPool.back();
+		m_priorityXPool.pop_back();
+		px->reset( p1, p2 );
+		X& x = *px->data();
+		x.callback = callback;
+		x.pkt = pkt;
+		x.dest = dest;
+		return px;
+	}
+
+	void freePriorityX( PriorityX* px ) {
+		if ( m_priorityXPool.size() < m_maxPoolSize ) {
+			X& x = *px->data();
+			x.callback = NULL;
+			x.pkt = NULL;
+			m_priorityXPool.push_back( px );
+		} else {
+			delete px->data();
+			delete px;
+		}
+	}
+
+	std::vector<FireflyNetworkEvent*> m_networkEventPool;
+	std::vector<PriorityX*>           m_priorityXPool;
+	size_t                            m_maxPoolSize;
+
 	std::vector< std::priority_queue< PriorityX*,std::vector<PriorityX*>, Compare > > m_sendPQ;
 
     std::vector<SendMachine*>   m_sendMachineV;
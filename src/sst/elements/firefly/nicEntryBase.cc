@@ -22,7 +22,10 @@ using namespace SST::Firefly;
 
 static void print( Output& dbg, const char* buf, int len )
 {
-    std::string tmp;
+    // one debug call per byte, only pay for it when it will be printed
+    if ( dbg.getVerboseLevel() < 4 ) {
+        return;
+    }
     dbg.debug(CALL_INFO,4,NIC_DBG_RECV_MACHINE,"addr=%p len=%d\n",buf,len);
     for ( int i = 0; i < len; i++ ) {
         dbg.debug(CALL_INFO,4,NIC_DBG_RECV_MACHINE, "%#03x\n",(unsigned char)buf[i]);
@@ -117,7 +120,11 @@ void Nic::EntryBase::copyOut( Output& dbg, int numBytes,
 
             if ( ioVec()[currentVec()].addr.getBacking()) {
                 print( dbg, from, len );
-                event.bufAppend( from, len );
+                if ( ioVec()[currentVec()].owner ) {
+                    event.bufAppendShared( ioVec()[currentVec()].owner, from, len );
+                } else {
+                    event.bufAppend( from, len );
+                }
             } else {
                 event.bufAppend( NULL, len );
             }
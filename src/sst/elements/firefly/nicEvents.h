@@ -61,7 +61,8 @@ class NicCmdBaseEvent : public Event {
 class NicShmemCmdEvent : public NicCmdBaseEvent {
   public:
 
-    enum Type { Init, RegMem, Fence, Put, Putv, Get, Getv, Wait, Add, Fadd, Swap, Cswap } type;
+    enum Type { Init, RegMem, Fence, Put, Putv, Get, Getv, Wait, Add, Fadd, Swap, Cswap,
+                Barrier, Broadcast, Fcollect, Reduction } type;
     std::string getTypeStr( ) {
         switch( type ) {
             case Init:
@@ -88,6 +89,14 @@ class NicShmemCmdEvent : public NicCmdBaseEvent {
             return "Swap";
             case Cswap:
             return "Cswap";
+            case Barrier:
+            return "Barrier";
+            case Broadcast:
+            return "Broadcast";
+            case Fcollect:
+            return "Fcollect";
+            case Reduction:
+            return "Reduction";
         }
     }
 
@@ -372,6 +381,34 @@ class NicShmemOpCmdEvent : public NicShmemCmdEvent {
 };
 
 
+// a collective run by the NIC, members holds the node and core of each PE
+// in the active set, root and length (bytes per PE) are ignored where the
+// collective has no use for them
+class NicShmemCollCmdEvent : public NicShmemCmdEvent {
+  public:
+    typedef std::function<void()> Callback;
+    NicShmemCollCmdEvent( Type type, std::vector< std::pair<int,int> >& members, int root,
+            Hermes::Vaddr dest, Hermes::Vaddr src, size_t length, Hermes::Vaddr pSync,
+            Hermes::Shmem::ReduOp op, Hermes::Value::Type dataType, Callback callback ) :
+        NicShmemCmdEvent( type ), members(members), root(root), dest(dest), src(src),
+        length(length), pSync(pSync), op(op), dataType(dataType), callback(callback) {}
+
+    virtual int getNode() { return -1; }
+
+    std::vector< std::pair<int,int> > members;
+    int             root;
+    Hermes::Vaddr   dest;
+    Hermes::Vaddr   src;
+    size_t          length;
+    Hermes::Vaddr   pSync;
+    Hermes::Shmem::ReduOp op;
+    Hermes::Value::Type dataType;
+    Callback        callback;
+
+	NotSerializable(NicShmemCollCmdEvent)
+};
+
+
 class NicCmdEvent : public NicCmdBaseEvent {
   public:
     enum Type { PioSend, DmaSend, DmaRecv, Put, Get, RegMemRgn } type;
@@ -62,7 +62,7 @@ void Nic::RecvMachine::RdmaStream::processPktHdr( FireflyNetworkEvent* ev ) {
           callback = std::bind( &Nic::RecvMachine::StreamBase::qSend, this, entry );
           delay = m_ctx->getHostReadDelay();
 
-          delete ev;
+          m_ctx->nic().freeNetworkEvent( ev );
         }
         break;
 
@@ -155,3 +155,38 @@ class ShmemGetbRespRecvEntry : public ShmemGetRespRecvEntry {
         static_cast<ShmemGetbSendEntry*>(m_entry)->callback( );
     }
 };
+
+// a message of a NIC collective, gathered in NIC memory and handed to the
+// collective engine once it is complete
+class ShmemCollRecvEntry : public RecvEntryBase {
+  public:
+    ShmemCollRecvEntry( Shmem* shmem, Hermes::Vaddr pSync, uint32_t group, NicShmemCmdEvent::Type type,
+            size_t length ) :
+        RecvEntryBase(), m_shmem( shmem ), m_pSync( pSync ), m_group( group ), m_type( type ),
+        m_buffer( length )
+    {
+        m_shmemMove = new ShmemRecvMoveBuffer( m_buffer );
+    }
+    ~ShmemCollRecvEntry() {
+        delete m_shmemMove;
+    }
+
+    void notify( int src_vNic, int src_node, int tag, size_t length ) {
+        m_shmem->collArrival( src_node, m_pSync, m_group, m_type, m_buffer );
+    }
+
+    size_t totalBytes( ) { return m_shmemMove->totalBytes(); }
+    std::vector<IoVec>& ioVec() { assert(0); }
+
+    bool copyIn( Output& dbg, FireflyNetworkEvent& ev, std::vector<MemOp>& vec ) {
+        return m_shmemMove->copyIn( dbg, ev, vec );
+    }
+
+  private:
+    ShmemRecvMove*      m_shmemMove;
+    Shmem*              m_shmem;
+    Hermes::Vaddr       m_pSync;
+    uint32_t            m_group;
+    NicShmemCmdEvent::Type m_type;
+    std::vector<uint8_t> m_buffer;
+};
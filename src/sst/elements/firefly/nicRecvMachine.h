@@ -40,7 +40,8 @@ class RecvMachine {
 
         RecvMachine( Nic& nic, int vn, int numVnics,
                 int nodeId, int verboseLevel, int verboseMask,
-                int rxMatchDelay, int hostReadDelay, int maxQsize, int maxActiveStreams, int maxPendingPkts ) :
+                int rxMatchDelay, int hostReadDelay, int maxQsize, int maxActiveStreams, int maxPendingPkts,
+                bool oldestFirst ) :
             m_nic(nic),
             m_vn(vn),
             m_rxMatchDelay( rxMatchDelay ),
@@ -51,12 +52,30 @@ class RecvMachine {
             m_clockLat(1),
             m_clocking(false),
             m_numPendingPkts(0),
-            m_maxPendingPkts(maxPendingPkts)
+            m_maxPendingPkts(maxPendingPkts),
+            m_pkts( maxPendingPkts ),
+            m_freePkt( 0 ),
+            m_slots( maxPendingPkts ),
+            m_freeSlot( 0 ),
+            m_oldestFirst( oldestFirst )
         {
             char buffer[100];
             snprintf(buffer,100,"@t:%d:Nic::RecvMachine::@p():@l vn=%d ",nodeId,m_vn);
 
             m_dbg.init(buffer, verboseLevel, verboseMask, Output::STDOUT);
+
+            // every buffered packet is counted in m_numPendingPkts so neither
+            // packets nor the sources they came from can outnumber it
+            for ( int i = 0; i < maxPendingPkts; i++ ) {
+                m_pkts[i].next = i + 1 < maxPendingPkts ? i + 1 : -1;
+                m_slots[i].next = i + 1 < maxPendingPkts ? i + 1 : -1;
+            }
+            if ( 0 == maxPendingPkts ) {
+                m_freePkt = m_freeSlot = -1;
+            }
+            if ( m_oldestFirst ) {
+                m_activeSlots.reserve( maxPendingPkts );
+            }
             setNotify();
             for ( unsigned i=0; i < numVnics; i++) {
                 m_ctxMap.push_back( new Ctx( m_dbg, *this, i, maxQsize ) );
@@ -117,54 +136,33 @@ class RecvMachine {
                 if ( ev ) {
                     ++m_numPendingPkts;
                     m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "got packet numPendingPkts=%d\n", m_numPendingPkts );
-                    m_pktBuf[ getPPI(ev) ].push( ev );
+                    bufferPkt( ev );
                 }
             } else {
                 m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "reached max buffered packets, numPendingPkts=%d\n", m_numPendingPkts );
 			}
 
-			auto iter = m_pktBuf.begin();
-			while ( iter != m_pktBuf.end() ) {
-				FireflyNetworkEvent* ev = iter->second.front();
-
-				m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "packet from node=%d pid=%d for pid=%d %s %s PPI=0x%" PRIx64 "\n",
-						ev->getSrcNode(),ev->getSrcPid(),ev->getDestPid(),ev->isHdr() ? "hdr":"",ev->isTail() ? "tail":"",getPPI(ev));
-
-				if ( ev->isCtrl() ) {
-					++m_numActiveStreams;
-					m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "ctrl packet numActiveStreams=%d m_numPendingPkts=%d\n",m_numActiveStreams,m_numPendingPkts-1);
-					processPkt( ev );
-					--m_numPendingPkts;
-					iter->second.pop();
-				} else if ( m_streamMap.find(iter->first) == m_streamMap.end() ) {
-					if ( m_numActiveStreams < m_maxActiveStreams ) {
-						++m_numActiveStreams;
-						m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "new stream numActiveStreams=%d m_numPendingPkts=%d\n",m_numActiveStreams,m_numPendingPkts-1);
-						processPkt( ev );
-						--m_numPendingPkts;
-						iter->second.pop();
-					} else {
-						m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "can't start new stream numActiveStreams=%d\n",m_numActiveStreams);
+			if ( m_oldestFirst ) {
+				size_t numActive = 0;
+				for ( size_t i = 0; i < m_activeSlots.size(); i++ ) {
+					int slotNum = m_activeSlots[i];
+					if ( ! serviceSlot( slotNum ) ) {
+						m_activeSlots[numActive++] = slotNum;
 					}
-				} else {
-					if ( ! m_streamMap[iter->first]->isBlocked( ) ) {
-						processPkt( ev );
-						--m_numPendingPkts;
-						m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "stream consumed packet, m_numPendingPkts=%d\n",m_numPendingPkts);
-						iter->second.pop();
+				}
+				m_activeSlots.resize( numActive );
+			} else {
+				auto iter = m_hashSlots.begin();
+				while ( iter != m_hashSlots.end() ) {
+					if ( serviceSlot( iter->second ) ) {
+						iter = m_hashSlots.erase( iter );
 					} else {
-						m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "stream blocked\n");
+						++iter;
 					}
 				}
-				if ( iter->second.empty() ) {
-					m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "queue is empty clear pktBuf slot\n");
-					iter = m_pktBuf.erase( iter );
-				} else {
-					++iter;
-				}
 			}
 
-			if ( m_pktBuf.empty() && ! m_nic.m_linkControl->requestToReceive( m_vn )) {
+			if ( 0 == numActiveSlots() && ! m_nic.m_linkControl->requestToReceive( m_vn )) {
 				m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "pktBuf is empty\n");
                 setNotify();
                 m_clocking = false;
@@ -174,6 +172,144 @@ class RecvMachine {
 			}
         }
 
+        // Offers the oldest packet of a source to its stream, returns true
+        // if that emptied the source's FIFO, which is then freed
+        bool serviceSlot( int slotNum ) {
+			PktSlot& slot = m_slots[slotNum];
+			FireflyNetworkEvent* ev = m_pkts[slot.head].ev;
+
+			m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "packet from node=%d pid=%d for pid=%d %s %s PPI=0x%" PRIx64 "\n",
+					ev->getSrcNode(),ev->getSrcPid(),ev->getDestPid(),ev->isHdr() ? "hdr":"",ev->isTail() ? "tail":"",getPPI(ev));
+
+			if ( ev->isCtrl() ) {
+				++m_numActiveStreams;
+				m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "ctrl packet numActiveStreams=%d m_numPendingPkts=%d\n",m_numActiveStreams,m_numPendingPkts-1);
+				processPkt( ev );
+				--m_numPendingPkts;
+				popPkt( slot );
+			} else if ( m_streamMap.find(slot.ppi) == m_streamMap.end() ) {
+				if ( m_numActiveStreams < m_maxActiveStreams ) {
+					++m_numActiveStreams;
+					m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "new stream numActiveStreams=%d m_numPendingPkts=%d\n",m_numActiveStreams,m_numPendingPkts-1);
+					processPkt( ev );
+					--m_numPendingPkts;
+					popPkt( slot );
+				} else {
+					m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "can't start new stream numActiveStreams=%d\n",m_numActiveStreams);
+				}
+			} else {
+				if ( ! m_streamMap[slot.ppi]->isBlocked( ) ) {
+					processPkt( ev );
+					--m_numPendingPkts;
+					m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "stream consumed packet, m_numPendingPkts=%d\n",m_numPendingPkts);
+					popPkt( slot );
+				} else {
+					m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "stream blocked\n");
+				}
+			}
+			if ( -1 == slot.head ) {
+				m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "queue is empty clear pktBuf slot\n");
+				freeSlot( slotNum );
+				return true;
+			}
+			return false;
+        }
+
+        size_t numActiveSlots() {
+            return m_oldestFirst ? m_activeSlots.size() : m_hashSlots.size();
+        }
+
+
+        // Packets waiting to be processed are kept in FIFOs, one per
+        // (src node, src pid, dest pid), threaded through a fixed array of
+        // packet entries. A FIFO is found through a table indexed by source
+        // node which grows to the largest node heard from. By default sources
+        // are serviced in the iteration order of a hash map keyed by
+        // (src node, src pid, dest pid), the order the NIC has always used,
+        // with oldestFirst they are serviced in the order their oldest
+        // waiting packet arrived.
+        struct PktEntry {
+            FireflyNetworkEvent* ev;
+            int next;
+        };
+
+        struct PktSlot {
+            ProcessPairId ppi;
+            int srcNode;
+            int head;
+            int tail;
+            int next;   // next slot of the same source node, or next free slot
+        };
+
+        void bufferPkt( FireflyNetworkEvent* ev ) {
+            ProcessPairId ppi = getPPI( ev );
+            int srcNode = ev->getSrcNode();
+
+            if ( srcNode >= (int) m_nodeSlot.size() ) {
+                m_nodeSlot.resize( srcNode + 1, -1 );
+            }
+
+            int slotNum = m_nodeSlot[srcNode];
+            while ( -1 != slotNum && m_slots[slotNum].ppi != ppi ) {
+                slotNum = m_slots[slotNum].next;
+            }
+
+            if ( -1 == slotNum ) {
+                assert( -1 != m_freeSlot );
+                slotNum = m_freeSlot;
+                PktSlot& slot = m_slots[slotNum];
+                m_freeSlot = slot.next;
+
+                slot.ppi = ppi;
+                slot.srcNode = srcNode;
+                slot.head = slot.tail = -1;
+                slot.next = m_nodeSlot[srcNode];
+                m_nodeSlot[srcNode] = slotNum;
+                if ( m_oldestFirst ) {
+                    m_activeSlots.push_back( slotNum );
+                } else {
+                    m_hashSlots.insert( std::make_pair( ppi, slotNum ) );
+                }
+            }
+
+            assert( -1 != m_freePkt );
+            int pktNum = m_freePkt;
+            m_freePkt = m_pkts[pktNum].next;
+            m_pkts[pktNum].ev = ev;
+            m_pkts[pktNum].next = -1;
+
+            PktSlot& slot = m_slots[slotNum];
+            if ( -1 == slot.tail ) {
+                slot.head = pktNum;
+            } else {
+                m_pkts[slot.tail].next = pktNum;
+            }
+            slot.tail = pktNum;
+        }
+
+        void popPkt( PktSlot& slot ) {
+            int pktNum = slot.head;
+            slot.head = m_pkts[pktNum].next;
+            if ( -1 == slot.head ) {
+                slot.tail = -1;
+            }
+            m_pkts[pktNum].ev = NULL;
+            m_pkts[pktNum].next = m_freePkt;
+            m_freePkt = pktNum;
+        }
+
+        void freeSlot( int slotNum ) {
+            PktSlot& slot = m_slots[slotNum];
+
+            int* link = &m_nodeSlot[slot.srcNode];
+            while ( *link != slotNum ) {
+                link = &m_slots[*link].next;
+            }
+            *link = slot.next;
+
+            slot.next = m_freeSlot;
+            m_freeSlot = slotNum;
+        }
 
         FireflyNetworkEvent* getNetworkEvent(int vn ) {
             SST::Interfaces::SimpleNetwork::Request* req = m_nic.m_linkControl->recv(vn);
@@ -215,6 +351,13 @@ class RecvMachine {
         SimTime_t   m_clockLat;
         bool        m_clocking;
 
-        std::unordered_map<ProcessPairId, std::queue<FireflyNetworkEvent*> > m_pktBuf;
+        std::vector<PktEntry>   m_pkts;
+        int                     m_freePkt;
+        std::vector<PktSlot>    m_slots;
+        int                     m_freeSlot;
+        std::vector<int>        m_nodeSlot;
+        bool                    m_oldestFirst;
+        std::vector<int>        m_activeSlots;     // oldestFirst service order
+        std::unordered_map<ProcessPairId, int> m_hashSlots; // default service order
         std::unordered_map<ProcessPairId, StreamBase* >  m_streamMap;
 };
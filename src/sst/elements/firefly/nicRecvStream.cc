@@ -62,7 +62,7 @@ void Nic::RecvMachine::StreamBase::processPktBody( FireflyNetworkEvent* ev  ) {
 
     if ( 0 == ev->bufSize() ) {
         m_dbg.verbosePrefix(prefix(),CALL_INFO,2,NIC_DBG_RECV_STREAM, "network event is done\n");
-        delete ev;
+        m_ctx->nic().freeNetworkEvent( ev );
     }
 
     Callback callback = NULL;
@@ -34,7 +34,7 @@ void Nic::SendMachine::streamInit( SendEntryBase* entry )
         "%p setup hdr, srcPid=%d, destNode=%d dstPid=%d bytes=%lu\n", entry,
         entry->local_vNic(), entry->dest(), entry->dst_vNic(), entry->totalBytes() ) ;
 
-    FireflyNetworkEvent* ev = new FireflyNetworkEvent(m_pktOverhead );
+    FireflyNetworkEvent* ev = m_nic.allocNetworkEvent( m_pktOverhead );
     ev->setDestPid( entry->dst_vNic() );
     ev->setSrcPid( entry->local_vNic() );
     ev->setHdr();
@@ -64,7 +64,7 @@ void Nic::SendMachine::getPayload( SendEntryBase* entry, FireflyNetworkEvent* ev
             m_inQ->enque( m_unit, pid, vec, ev, entry->vn(), entry->dest(), std::bind( &Nic::SendMachine::streamFini, this, entry ) );
         } else {
             m_inQ->enque( m_unit, pid, vec, ev, entry->vn(), entry->dest() );
-            m_nic.schedCallback( std::bind( &Nic::SendMachine::getPayload, this, entry, new FireflyNetworkEvent(m_pktOverhead) ), 0);
+            m_nic.schedCallback( std::bind( &Nic::SendMachine::getPayload, this, entry, m_nic.allocNetworkEvent( m_pktOverhead ) ), 0);
         }
 
     } else {
@@ -165,7 +165,7 @@ void Nic::SendMachine::OutQ::enque( FireflyNetworkEvent* ev, int vn, int dest, C
 	}
 	++m_enqCnt;
 
-	PriorityX* px = new PriorityX( m_lastEnq, m_enqCnt, new X( std::bind( &Nic::SendMachine::OutQ::pop, this, callback ), ev, dest ) );
+	PriorityX* px = m_nic.allocPriorityX( m_lastEnq, m_enqCnt, std::bind( &Nic::SendMachine::OutQ::pop, this, callback ), ev, dest );
 
 	++m_qCnt;
 	m_dbg.verbosePrefix(prefix(),CALL_INFO,2,NIC_DBG_SEND_MACHINE, "qCnt=%d priority=%" PRIu64 ".%d\n", m_qCnt, m_lastEnq, m_enqCnt);
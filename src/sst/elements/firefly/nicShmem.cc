@@ -33,6 +33,10 @@ void Nic::Shmem::handleEvent( NicShmemCmdEvent* event, int id )
     case NicShmemCmdEvent::Cswap:
     case NicShmemCmdEvent::Swap:
     case NicShmemCmdEvent::Fence:
+    case NicShmemCmdEvent::Barrier:
+    case NicShmemCmdEvent::Broadcast:
+    case NicShmemCmdEvent::Fcollect:
+    case NicShmemCmdEvent::Reduction:
         handleNicEvent( event, id );
         break;
 
@@ -136,6 +140,10 @@ void Nic::Shmem::handleNicEvent( NicShmemCmdEvent* event, int id )
       case NicShmemCmdEvent::RegMem:
       case NicShmemCmdEvent::Wait:
       case NicShmemCmdEvent::Fence:
+      case NicShmemCmdEvent::Barrier:
+      case NicShmemCmdEvent::Broadcast:
+      case NicShmemCmdEvent::Fcollect:
+      case NicShmemCmdEvent::Reduction:
 		break;
 
       default:
@@ -226,6 +234,12 @@ void Nic::Shmem::handleNicEvent3( NicShmemCmdEvent* event, int id )
             swap( static_cast< NicShmemSwapCmdEvent*>(event), id );
         }
         break;
+    case NicShmemCmdEvent::Barrier:
+    case NicShmemCmdEvent::Broadcast:
+    case NicShmemCmdEvent::Fcollect:
+    case NicShmemCmdEvent::Reduction:
+        collective( static_cast< NicShmemCollCmdEvent*>(event), id );
+        break;
 
     default:
         assert(0);
@@ -706,31 +720,8 @@ void Nic::Shmem::doReduction( Hermes::Shmem::ReduOp op, int destCore, Hermes::Va
    		vec.push_back( MemOp( srcAddr, length, MemOp::Op::HostLoad ));
    		vec.push_back( MemOp( destAddr, length, MemOp::Op::HostStore ));
 
-       switch ( op ) {
-          case Hermes::Shmem::AND:
-            dest &= src;
-            break;
-          case Hermes::Shmem::OR:
-            dest |= src;
-            break;
-          case Hermes::Shmem::XOR:
-            dest ^= src;
-            break;
-          case Hermes::Shmem::SUM:
-            dest += src;
-            break;
-          case Hermes::Shmem::PROD:
-            dest *= src;
-            break;
-          case Hermes::Shmem::MIN:
-            if ( src < dest ) dest = src;
-            break;
-          case Hermes::Shmem::MAX:
-            if ( src > dest ) dest = src;
-            break;
-          default:
-            assert(0);
-        }
+        reduce( op, dest, src );
+
 		srcPtr += Hermes::Value::getLength(type);
 		destPtr += Hermes::Value::getLength(type);
 		srcAddr += Hermes::Value::getLength(type);
@@ -738,6 +729,35 @@ void Nic::Shmem::doReduction( Hermes::Shmem::ReduOp op, int destCore, Hermes::Va
 	}
 }
 
+void Nic::Shmem::reduce( Hermes::Shmem::ReduOp op, Hermes::Value& dest, Hermes::Value& src )
+{
+    switch ( op ) {
+      case Hermes::Shmem::AND:
+        dest &= src;
+        break;
+      case Hermes::Shmem::OR:
+        dest |= src;
+        break;
+      case Hermes::Shmem::XOR:
+        dest ^= src;
+        break;
+      case Hermes::Shmem::SUM:
+        dest += src;
+        break;
+      case Hermes::Shmem::PROD:
+        dest *= src;
+        break;
+      case Hermes::Shmem::MIN:
+        if ( src < dest ) dest = src;
+        break;
+      case Hermes::Shmem::MAX:
+        if ( src > dest ) dest = src;
+        break;
+      default:
+        assert(0);
+    }
+}
+
 void Nic::Shmem::checkWaitOps( int core, Hermes::Vaddr addr, size_t length )
 {
     m_dbg.verbosePrefix( prefix(),CALL_INFO,3,NIC_DBG_SHMEM,"core=%d addr=%" PRIx64" len=%lu\n", core, addr, length );
@@ -102,6 +102,10 @@ class Shmem {
 		m_pendingGets.resize( numVnics );
 		m_nicCmdLatency =    params.find<int>( "nicCmdLatency", 10 );
 		m_hostCmdLatency =   params.find<int>( "hostCmdLatency", 10 );
+		m_collRadix =        params.find<int>( "collRadix", 8 );
+		if ( m_collRadix < 1 ) {
+			m_dbg.fatal(CALL_INFO,-1,"shmem.collRadix must be at least 1, requested %d\n", m_collRadix );
+		}
 	}
     ~Shmem() {
         m_regMem.clear();
@@ -170,6 +174,8 @@ class Shmem {
 	}
 
     void checkWaitOps( int core, Hermes::Vaddr addr, size_t length );
+    void collArrival( int srcNode, Hermes::Vaddr pSync, uint32_t group, NicShmemCmdEvent::Type type,
+			std::vector<uint8_t>& data );
 
 private:
 	SimTime_t getNic2HostDelay_ns() { return m_nic2HostDelay_ns; }
@@ -197,6 +203,7 @@ private:
     void fadd( NicShmemFaddCmdEvent*, int id );
     void cswap( NicShmemCswapCmdEvent*, int id );
     void swap( NicShmemSwapCmdEvent*, int id );
+    void collective( NicShmemCollCmdEvent*, int id );
 
     void* getBacking( int core, Hermes::Vaddr addr, size_t length ) {
         m_dbg.verbosePrefix( prefix(), CALL_INFO,1,NIC_DBG_SHMEM,"core=%d addr=%#" PRIx64 "\n", core, addr );
@@ -205,6 +212,7 @@ private:
 	void doReduction( Hermes::Shmem::ReduOp op, int destCore, Hermes::Vaddr destAddr,
             int srcCore, Hermes::Vaddr srcAddr, size_t length, Hermes::Value::Type,
 			std::vector<MemOp>& vec );
+	void reduce( Hermes::Shmem::ReduOp op, Hermes::Value& dest, Hermes::Value& src );
 
 	Hermes::Value m_one;
 	std::vector< std::pair< Hermes::Vaddr, Hermes::Value > > m_pendingPuts;
@@ -246,4 +254,66 @@ private:
 		}
 	}
 	std::vector< ActivePuts > m_activePuts;
+
+	// One collective on this NIC. The members are grouped by node and the
+	// nodes form a tree, each NIC combines the contributions of its own PEs
+	// with those of its child nodes and sends one message to its parent, the
+	// result comes back down the tree and is written to every local member.
+	// Messages that arrive before any local PE has joined are held until the
+	// first local command tells us the shape of the tree.
+	struct CollOp {
+		CollOp() : type(NicShmemCmdEvent::Barrier), numLocal(0), pendingUp(0), numDelivered(0),
+			haveData(false), haveResult(false) {}
+		NicShmemCmdEvent::Type type;
+		std::vector< std::pair<int,int> > members;
+		int root;
+		size_t length;
+		Hermes::Shmem::ReduOp op;
+		Hermes::Value::Type dataType;
+
+		// nodes in tree order, the core messages to each node are sent to
+		std::vector<int> nodes;
+		std::vector<int> nodeCores;
+		std::map<int,int> nodeIndex;
+		int myIndex;
+		int myCore;
+		int numLocal;
+		int pendingUp;
+		int numDelivered;
+
+		std::map< int, NicShmemCollCmdEvent* > local;
+		std::set< int > heardFrom;
+		std::vector< std::pair< int, std::vector<uint8_t> > > early;
+
+		std::vector<uint8_t> buffer;
+		bool haveData;
+		bool haveResult;
+	};
+	struct CollKey {
+		CollKey( Hermes::Vaddr pSync, uint32_t group, NicShmemCmdEvent::Type type ) :
+			pSync( pSync ), group( group ), type( type ) {}
+		bool operator<( const CollKey& rhs ) const {
+			if ( pSync != rhs.pSync ) return pSync < rhs.pSync;
+			if ( group != rhs.group ) return group < rhs.group;
+			return type < rhs.type;
+		}
+		Hermes::Vaddr pSync;
+		uint32_t group;
+		NicShmemCmdEvent::Type type;
+	};
+
+	uint32_t collGroup( std::vector< std::pair<int,int> >& members );
+	void collTree( CollOp*, NicShmemCollCmdEvent* );
+	bool collInSubtree( CollOp*, int index, int member );
+	void collJoin( CollOp*, CollKey, NicShmemCollCmdEvent*, int id );
+	void collRecv( CollOp*, CollKey, int srcNode, std::vector<uint8_t>& data );
+	void collContribute( CollOp*, int member, unsigned char* data, size_t length, std::vector<MemOp>& vec );
+	void collCheckUp( CollOp*, CollKey );
+	void collDown( CollOp*, CollKey );
+	void collDeliver( CollOp*, CollKey, int core );
+	void collSend( CollOp*, CollKey, int node, std::vector<uint8_t>& data );
+	void collRetire( CollOp*, CollKey );
+
+	std::map< CollKey, std::deque< CollOp* > > m_collOps;
+	int m_collRadix;
 };
@@ -0,0 +1,448 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "nic.h"
+
+#include <algorithm>
+
+using namespace SST;
+using namespace SST::Firefly;
+
+// The PEs of a collective find each other by the address of the pSync array,
+// a hash of the active set and the kind of collective, all three travel in
+// the header of every message
+uint32_t Nic::Shmem::collGroup( std::vector< std::pair<int,int> >& members )
+{
+	uint32_t hash = 2166136261u;
+	for ( unsigned i = 0; i < members.size(); i++ ) {
+		hash = ( hash ^ members[i].first ) * 16777619u;
+		hash = ( hash ^ members[i].second ) * 16777619u;
+	}
+	return hash & 0xffffff;
+}
+
+void Nic::Shmem::collective( NicShmemCollCmdEvent* event, int id )
+{
+	CollKey key( event->pSync, collGroup( event->members ), event->type );
+
+	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d %s pSync=%#" PRIx64 " group=%#x members=%zu length=%zu\n",
+			id, event->getTypeStr().c_str(), key.pSync, key.group, event->members.size(), event->length );
+
+	// a PE can only be in one instance of a collective at a time, it joins
+	// the oldest one it has not joined
+	std::deque< CollOp* >& ops = m_collOps[key];
+	CollOp* op = NULL;
+	for ( unsigned i = 0; i < ops.size(); i++ ) {
+		if ( ops[i]->local.find( id ) == ops[i]->local.end() ) {
+			op = ops[i];
+			break;
+		}
+	}
+	if ( NULL == op ) {
+		op = new CollOp;
+		ops.push_back( op );
+	}
+
+	collJoin( op, key, event, id );
+}
+
+void Nic::Shmem::collArrival( int srcNode, Hermes::Vaddr pSync, uint32_t group, NicShmemCmdEvent::Type type,
+			std::vector<uint8_t>& data )
+{
+	CollKey key( pSync, group, type );
+
+	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"srcNode=%d pSync=%#" PRIx64 " group=%#x type=%d length=%zu\n",
+			srcNode, pSync, group, type, data.size() );
+
+	// each node sends us at most one message per instance
+	std::deque< CollOp* >& ops = m_collOps[key];
+	CollOp* op = NULL;
+	for ( unsigned i = 0; i < ops.size(); i++ ) {
+		if ( ops[i]->heardFrom.find( srcNode ) == ops[i]->heardFrom.end() ) {
+			op = ops[i];
+			break;
+		}
+	}
+	if ( NULL == op ) {
+		op = new CollOp;
+		ops.push_back( op );
+	}
+	op->heardFrom.insert( srcNode );
+
+	collRecv( op, key, srcNode, data );
+}
+
+// Nodes are placed in the order their first member appears in the active
+// set, starting with the node of the root, and form a tree of radix
+// m_collRadix. The first member on each node sends and receives for it.
+void Nic::Shmem::collTree( CollOp* op, NicShmemCollCmdEvent* event )
+{
+	op->type = event->type;
+	op->members = event->members;
+	op->root = event->root;
+	op->length = event->length;
+	op->op = event->op;
+	op->dataType = event->dataType;
+
+	int rootNode = op->members[ op->type == NicShmemCmdEvent::Broadcast ? op->root : 0 ].first;
+
+	for ( unsigned i = 0; i < op->members.size(); i++ ) {
+		if ( op->members[i].first == rootNode ) {
+			op->nodeIndex[rootNode] = 0;
+			op->nodes.push_back( rootNode );
+			op->nodeCores.push_back( op->members[i].second );
+			break;
+		}
+	}
+
+	for ( unsigned i = 0; i < op->members.size(); i++ ) {
+		int node = op->members[i].first;
+		if ( node == m_nic.getNodeId() ) {
+			++op->numLocal;
+		}
+		if ( op->nodeIndex.find( node ) == op->nodeIndex.end() ) {
+			op->nodeIndex[node] = op->nodes.size();
+			op->nodes.push_back( node );
+			op->nodeCores.push_back( op->members[i].second );
+		}
+	}
+
+	op->myIndex = op->nodeIndex[ m_nic.getNodeId() ];
+	op->myCore = op->nodeCores[ op->myIndex ];
+
+	int numChildren = 0;
+	for ( int i = op->myIndex * m_collRadix + 1; i <= op->myIndex * m_collRadix + m_collRadix && i < (int) op->nodes.size(); i++ ) {
+		++numChildren;
+	}
+
+	switch ( op->type ) {
+	  case NicShmemCmdEvent::Barrier:
+		break;
+	  case NicShmemCmdEvent::Broadcast:
+	  case NicShmemCmdEvent::Reduction:
+		op->buffer.resize( op->length );
+		break;
+	  case NicShmemCmdEvent::Fcollect:
+		op->buffer.resize( op->members.size() * op->length );
+		break;
+	  default:
+		assert(0);
+	}
+
+	if ( op->type != NicShmemCmdEvent::Broadcast ) {
+		op->pendingUp = op->numLocal + numChildren;
+	}
+
+	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"%s nodes=%zu index=%d numLocal=%d children=%d\n",
+			event->getTypeStr().c_str(), op->nodes.size(), op->myIndex, op->numLocal, numChildren );
+}
+
+// is the member on a node in the subtree rooted at node "index"
+bool Nic::Shmem::collInSubtree( CollOp* op, int index, int member )
+{
+	int i = op->nodeIndex[ op->members[member].first ];
+	while ( i > index ) {
+		i = ( i - 1 ) / m_collRadix;
+	}
+	return i == index;
+}
+
+void Nic::Shmem::collJoin( CollOp* op, CollKey key, NicShmemCollCmdEvent* event, int id )
+{
+	// the first local PE brings the shape of the tree, replay what arrived
+	// before it, this PE is not a member yet so the instance can't retire
+	if ( op->nodes.empty() ) {
+		collTree( op, event );
+
+		std::vector< std::pair< int, std::vector<uint8_t> > > early;
+		early.swap( op->early );
+		for ( unsigned i = 0; i < early.size(); i++ ) {
+			collRecv( op, key, early[i].first, early[i].second );
+		}
+	}
+
+	op->local[id] = event;
+
+	int member = 0;
+	while ( op->members[member] != std::make_pair( m_nic.getNodeId(), id ) ) {
+		++member;
+	}
+
+	switch ( op->type ) {
+
+	  case NicShmemCmdEvent::Barrier:
+		--op->pendingUp;
+		collCheckUp( op, key );
+		break;
+
+	  case NicShmemCmdEvent::Broadcast:
+		if ( member == op->root ) {
+			std::vector<MemOp>* vec = new std::vector<MemOp>;
+			if ( op->length ) {
+				void* src = getBacking( id, event->src, op->length );
+				if ( src ) {
+					memcpy( op->buffer.data(), src, op->length );
+				}
+				vec->push_back( MemOp( event->src, op->length, MemOp::Op::BusLoad ) );
+			}
+			m_nic.calcNicMemDelay( m_nic.allocNicSendUnit(), id, vec,
+				[=]() {
+					m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"collJoin",1,NIC_DBG_SHMEM,"core=%d root staged\n",id);
+					collDown( op, key );
+				}
+			);
+		} else if ( op->haveResult ) {
+			collDeliver( op, key, id );
+		}
+		break;
+
+	  case NicShmemCmdEvent::Fcollect:
+	  case NicShmemCmdEvent::Reduction:
+		{
+			std::vector<MemOp>* vec = new std::vector<MemOp>;
+			unsigned char* src = NULL;
+			if ( op->length ) {
+				src = (unsigned char*) getBacking( id, event->src, op->length );
+				vec->push_back( MemOp( event->src, op->length, MemOp::Op::BusLoad ) );
+			}
+			collContribute( op, member, src, op->length, *vec );
+
+			m_nic.calcNicMemDelay( m_nic.allocNicSendUnit(), id, vec,
+				[=]() {
+					m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"collJoin",1,NIC_DBG_SHMEM,"core=%d staged\n",id);
+					--op->pendingUp;
+					collCheckUp( op, key );
+				}
+			);
+		}
+		break;
+
+	  default:
+		assert(0);
+	}
+}
+
+void Nic::Shmem::collRecv( CollOp* op, CollKey key, int srcNode, std::vector<uint8_t>& data )
+{
+	if ( op->nodes.empty() ) {
+		m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"srcNode=%d held until a local PE joins\n", srcNode );
+		op->early.push_back( std::make_pair( srcNode, data ) );
+		return;
+	}
+
+	int index = op->nodeIndex[srcNode];
+
+	// from our parent, the result
+	if ( op->myIndex && index == ( op->myIndex - 1 ) / m_collRadix ) {
+		assert( data.size() == op->buffer.size() );
+		op->buffer = data;
+		collDown( op, key );
+		return;
+	}
+
+	// from a child, the combined contributions of its subtree
+	assert( ( index - 1 ) / m_collRadix == op->myIndex );
+
+	if ( op->type == NicShmemCmdEvent::Barrier ) {
+		--op->pendingUp;
+		collCheckUp( op, key );
+		return;
+	}
+
+	std::vector<MemOp>* vec = new std::vector<MemOp>;
+	if ( op->type == NicShmemCmdEvent::Reduction ) {
+		collContribute( op, -1, data.data(), op->length, *vec );
+	} else {
+		size_t offset = 0;
+		for ( unsigned i = 0; i < op->members.size(); i++ ) {
+			if ( collInSubtree( op, index, i ) ) {
+				assert( offset + op->length <= data.size() );
+				collContribute( op, i, data.data() + offset, op->length, *vec );
+				offset += op->length;
+			}
+		}
+	}
+
+	m_nic.calcNicMemDelay( m_nic.allocNicRecvUnit( op->myCore ), op->myCore, vec,
+		[=]() {
+			m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"collRecv",1,NIC_DBG_SHMEM,"srcNode=%d combined\n",srcNode);
+			--op->pendingUp;
+			collCheckUp( op, key );
+		}
+	);
+}
+
+// Adds a contribution to the buffer held in NIC memory. A reduction
+// combines it element by element, the first contribution is a copy.
+// Fcollect places the block of each member at its index in the active set.
+void Nic::Shmem::collContribute( CollOp* op, int member, unsigned char* data, size_t length, std::vector<MemOp>& vec )
+{
+	if ( 0 == length ) {
+		return;
+	}
+
+	if ( op->type == NicShmemCmdEvent::Fcollect ) {
+		if ( data ) {
+			memcpy( op->buffer.data() + member * op->length, data, length );
+		}
+		vec.push_back( MemOp( 0, length, MemOp::Op::LocalStore ) );
+		return;
+	}
+
+	if ( ! op->haveData ) {
+		if ( data ) {
+			memcpy( op->buffer.data(), data, length );
+		}
+		vec.push_back( MemOp( 0, length, MemOp::Op::LocalStore ) );
+		op->haveData = true;
+		return;
+	}
+
+	vec.push_back( MemOp( 0, length, MemOp::Op::LocalLoad ) );
+	vec.push_back( MemOp( 0, length, MemOp::Op::LocalStore ) );
+
+	if ( NULL == data ) {
+		return;
+	}
+
+	size_t width = Hermes::Value::getLength( op->dataType );
+	for ( size_t i = 0; i + width <= length; i += width ) {
+		Hermes::Value dest( op->dataType, op->buffer.data() + i );
+		Hermes::Value src( op->dataType, data + i );
+		reduce( op->op, dest, src );
+	}
+}
+
+void Nic::Shmem::collCheckUp( CollOp* op, CollKey key )
+{
+	m_dbg.verbosePrefix( prefix(),CALL_INFO,2,NIC_DBG_SHMEM,"pendingUp=%d\n", op->pendingUp );
+
+	if ( op->pendingUp ) {
+		return;
+	}
+
+	if ( 0 == op->myIndex ) {
+		collDown( op, key );
+		return;
+	}
+
+	int parent = op->nodes[ ( op->myIndex - 1 ) / m_collRadix ];
+
+	if ( op->type == NicShmemCmdEvent::Fcollect ) {
+		std::vector<uint8_t> data;
+		for ( unsigned i = 0; i < op->members.size(); i++ ) {
+			if ( collInSubtree( op, op->myIndex, i ) ) {
+				data.insert( data.end(), op->buffer.begin() + i * op->length,
+						op->buffer.begin() + ( i + 1 ) * op->length );
+			}
+		}
+		collSend( op, key, parent, data );
+	} else {
+		collSend( op, key, parent, op->buffer );
+	}
+}
+
+// the result is known, pass it on to our children and our own PEs
+void Nic::Shmem::collDown( CollOp* op, CollKey key )
+{
+	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"index=%d length=%zu\n", op->myIndex, op->buffer.size() );
+
+	op->haveResult = true;
+
+	for ( int i = op->myIndex * m_collRadix + 1; i <= op->myIndex * m_collRadix + m_collRadix && i < (int) op->nodes.size(); i++ ) {
+		collSend( op, key, op->nodes[i], op->buffer );
+	}
+
+	// the last delivery retires the instance
+	std::vector<int> cores;
+	std::map< int, NicShmemCollCmdEvent* >::iterator iter = op->local.begin();
+	for ( ; iter != op->local.end(); ++iter ) {
+		if ( iter->second ) {
+			cores.push_back( iter->first );
+		}
+	}
+	for ( unsigned i = 0; i < cores.size(); i++ ) {
+		collDeliver( op, key, cores[i] );
+	}
+}
+
+void Nic::Shmem::collDeliver( CollOp* op, CollKey key, int core )
+{
+	NicShmemCollCmdEvent* event = op->local[core];
+	op->local[core] = NULL;
+	++op->numDelivered;
+
+	size_t length = op->buffer.size();
+	if ( op->type == NicShmemCmdEvent::Broadcast &&
+			op->members[op->root] == std::make_pair( m_nic.getNodeId(), core ) ) {
+		length = 0;
+	}
+
+	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d dest=%#" PRIx64 " length=%zu\n", core, event->dest, length );
+
+	NicShmemCollCmdEvent::Callback callback = event->callback;
+
+	if ( length ) {
+		void* dest = getBacking( core, event->dest, length );
+		if ( dest ) {
+			memcpy( dest, op->buffer.data(), length );
+		}
+		checkWaitOps( core, event->dest, length );
+
+		std::vector<MemOp>* vec = new std::vector<MemOp>;
+		vec->push_back( MemOp( event->dest, length, MemOp::Op::BusStore ) );
+		m_nic.calcNicMemDelay( m_nic.allocNicRecvUnit( core ), core, vec,
+			[=]() {
+				m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"collDeliver",1,NIC_DBG_SHMEM,"core=%d finished\n",core);
+				m_nic.getVirtNic(core)->notifyShmem( getNic2HostDelay_ns(), callback );
+			}
+		);
+	} else {
+		m_nic.getVirtNic(core)->notifyShmem( getNic2HostDelay_ns(), callback );
+	}
+
+	delete event;
+
+	if ( op->numDelivered == op->numLocal ) {
+		collRetire( op, key );
+	}
+}
+
+void Nic::Shmem::collSend( CollOp* op, CollKey key, int node, std::vector<uint8_t>& data )
+{
+	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"node=%d length=%zu\n", node, data.size() );
+
+	int vn = m_nic.m_shmemPutSmallVN;
+	if ( data.size() > m_nic.m_shmemPutThresholdLength ) {
+		vn = m_nic.m_shmemPutLargeVN;
+	}
+
+	m_nic.qSendEntry( new ShmemCollSendEntry( op->myCore, node, op->nodeCores[ op->nodeIndex[node] ],
+				key.pSync, key.group, key.type, data, vn ) );
+}
+
+void Nic::Shmem::collRetire( CollOp* op, CollKey key )
+{
+	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"pSync=%#" PRIx64 " group=%#x\n", key.pSync, key.group );
+
+	std::deque< CollOp* >& ops = m_collOps[key];
+	ops.erase( std::find( ops.begin(), ops.end(), op ) );
+	if ( ops.empty() ) {
+		m_collOps.erase( key );
+	}
+	delete op;
+}
@@ -91,6 +91,27 @@ void Nic::ShmemSendMove2Value::copyOut( Output& dbg, int numBytes, FireflyNetwor
     event.bufAppend( m_value2.getPtr() , m_value2.getLength() );
 }
 
+void Nic::ShmemSendMoveBuffer::copyOut( Output& dbg, int numBytes, FireflyNetworkEvent& event, std::vector<MemOp>& vec )
+{
+    size_t bufSpace = numBytes - event.bufSize();
+    size_t left = m_buffer.size() - m_offset;
+    size_t len;
+
+    if ( left > bufSpace  ) {
+        len = bufSpace & ~( m_alignment - 1);
+    } else {
+        len = left;
+    }
+
+    dbg.debug(CALL_INFO,3,NIC_DBG_SEND_MACHINE,"pktSpace=%lu dataLeft=%lu xferSize=%lu\n", bufSpace, left, len );
+
+	vec.push_back( MemOp( 0, len, MemOp::Op::LocalLoad ));
+
+    event.bufAppend( m_buffer.data() + m_offset, len );
+
+    m_offset += len;
+}
+
 bool Nic::ShmemRecvMoveMem::copyIn( Output& dbg, FireflyNetworkEvent& event, std::vector<MemOp>& vec )
 {
     size_t length = event.bufSize();
@@ -206,3 +227,19 @@ bool Nic::ShmemRecvMoveValue::copyIn( Output& dbg, FireflyNetworkEvent& event, s
 
     return true;
 }
+
+bool Nic::ShmemRecvMoveBuffer::copyIn( Output& dbg, FireflyNetworkEvent& event, std::vector<MemOp>& vec )
+{
+    size_t length = event.bufSize();
+    dbg.debug(CALL_INFO,3,NIC_DBG_RECV_MOVE,"event.bufSize()=%lu offset=%lu\n",event.bufSize(),m_offset);
+
+    assert( length <= m_buffer.size() - m_offset );
+
+	vec.push_back( MemOp( 0, length, MemOp::Op::LocalStore ));
+    memcpy( &m_buffer[m_offset], event.bufPtr(), length );
+
+    event.bufPop(length);
+    m_offset += length;
+
+    return m_offset == m_buffer.size();
+}
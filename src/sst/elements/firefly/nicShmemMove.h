@@ -70,6 +70,22 @@ class ShmemRecvMoveValue : public ShmemRecvMove {
     size_t          m_offset;
 };
 
+// moves data into a buffer in NIC memory
+class ShmemRecvMoveBuffer : public ShmemRecvMove {
+
+  public:
+    ShmemRecvMoveBuffer( std::vector<uint8_t>& buffer ) :
+        m_buffer(buffer), m_offset(0)  {}
+
+    bool copyIn( Output& dbg, FireflyNetworkEvent&, std::vector<MemOp>& );
+    bool isDone() { return m_offset == m_buffer.size(); }
+    size_t totalBytes() { return m_buffer.size(); }
+
+  private:
+    std::vector<uint8_t>&   m_buffer;
+    size_t                  m_offset;
+};
+
 class ShmemSendMove {
   public:
     virtual ~ShmemSendMove() {}
@@ -112,6 +128,22 @@ class ShmemSendMoveValue : public ShmemSendMove {
     size_t m_offset;
 };
 
+// sends data held in NIC memory
+class ShmemSendMoveBuffer : public ShmemSendMove {
+
+  public:
+    ShmemSendMoveBuffer( std::vector<uint8_t>& buffer ) :
+        m_buffer( buffer ), m_offset(0)  { }
+
+    virtual void copyOut( Output& dbg, int numBytes,
+            FireflyNetworkEvent&, std::vector<MemOp>& );
+    bool isDone() { return m_offset == m_buffer.size(); }
+
+  private:
+    std::vector<uint8_t>& m_buffer;
+    size_t m_offset;
+};
+
 class ShmemSendMove2Value : public ShmemSendMove {
 
   public:
@@ -294,3 +294,41 @@ class ShmemPut2SendEntry: public ShmemSendEntryBase  {
     int m_node;
     Hermes::Value* m_value;
 };
+
+// a message between the collective engines of two NICs, the data travels
+// in a copy held by the entry so the engine is free to reuse its buffer
+class ShmemCollSendEntry: public ShmemSendEntryBase  {
+  public:
+    ShmemCollSendEntry( int local_vNic, int destNode, int dest_vNic, Hermes::Vaddr pSync,
+            uint32_t group, NicShmemCmdEvent::Type type, std::vector<uint8_t>& data, int vn ) :
+        ShmemSendEntryBase( local_vNic, vn ),
+        m_node( destNode ),
+        m_vnic( dest_vNic ),
+        m_data( data )
+    {
+        m_hdr.op = ShmemMsgHdr::Coll;
+        m_hdr.op2 = type - NicShmemCmdEvent::Barrier;
+        m_hdr.vaddr = pSync;
+        m_hdr.length = m_data.size();
+        m_hdr.respKey = group;
+        m_shmemMove = new ShmemSendMoveBuffer( m_data );
+    }
+
+    ~ShmemCollSendEntry() {
+        delete m_shmemMove;
+    }
+    int dst_vNic() { return m_vnic; }
+    int dest() { return m_node; }
+
+    size_t totalBytes() { return m_hdr.length; }
+    bool isDone() { return m_shmemMove->isDone(); }
+    void copyOut( Output& dbg, int numBytes,
+            FireflyNetworkEvent& ev, std::vector<MemOp>& vec ) {
+        m_shmemMove->copyOut( dbg, numBytes, ev, vec ); };
+
+  private:
+    int m_node;
+    int m_vnic;
+    std::vector<uint8_t> m_data;
+    ShmemSendMove* m_shmemMove;
+};
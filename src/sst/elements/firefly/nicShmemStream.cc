@@ -84,6 +84,10 @@ void Nic::RecvMachine::ShmemStream::processOp( FireflyNetworkEvent* ev )
         processAck( m_shmemHdr, ev, m_myPid, m_srcPid );
         break;
 
+      case ShmemMsgHdr::Coll:
+        processColl( m_shmemHdr, ev, m_myPid, m_srcPid );
+        break;
+
       default:
         assert(0);
         break;
@@ -95,7 +99,30 @@ void Nic::RecvMachine::ShmemStream::processAck( ShmemMsgHdr& hdr, FireflyNetwork
     m_ctx->nic().shmemDecPendingPuts( pid );
     m_ctx->deleteStream(this);
 
-    delete ev;
+    m_ctx->nic().freeNetworkEvent( ev );
+}
+
+void Nic::RecvMachine::ShmemStream::processColl( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int local_pid, int dest_pid )
+{
+    NicShmemCmdEvent::Type type = (NicShmemCmdEvent::Type) ( NicShmemCmdEvent::Barrier + hdr.op2 );
+
+    m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_STREAM,"srcNode=%d pSync=%#" PRIx64 " length=%u group=%#x type=%d\n",
+            ev->getSrcNode(), hdr.vaddr, hdr.length, hdr.respKey, type);
+
+    if ( 0 == hdr.length ) {
+        std::vector<uint8_t> data;
+        m_ctx->getShmem()->collArrival( ev->getSrcNode(), hdr.vaddr, hdr.respKey, type, data );
+        m_ctx->deleteStream(this);
+        m_ctx->nic().freeNetworkEvent( ev );
+        return;
+    }
+
+    m_recvEntry = new ShmemCollRecvEntry( m_ctx->getShmem(), hdr.vaddr, hdr.respKey, type, hdr.length );
+
+    m_matched_len = hdr.length;
+
+    ev->clearHdr();
+    processPktBody( ev );
 }
 
 void Nic::RecvMachine::ShmemStream::processPut( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int local_pid, int dest_pid )
@@ -169,7 +196,7 @@ void Nic::RecvMachine::ShmemStream::processGet( ShmemMsgHdr& hdr, FireflyNetwork
 			}
     );
 
-    delete ev;
+    m_ctx->nic().freeNetworkEvent( ev );
 }
 
 void Nic::RecvMachine::ShmemStream::processAdd( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int local_pid, int dest_pid )
@@ -209,7 +236,7 @@ void Nic::RecvMachine::ShmemStream::processAdd( ShmemMsgHdr& hdr, FireflyNetwork
                 m_ctx->deleteStream(this);
 			}
 		);
-    delete ev;
+    m_ctx->nic().freeNetworkEvent( ev );
 }
 
 void Nic::RecvMachine::ShmemStream::processFadd( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int local_pid, int dest_pid )
@@ -253,7 +280,7 @@ void Nic::RecvMachine::ShmemStream::processFadd( ShmemMsgHdr& hdr, FireflyNetwor
                 m_ctx->deleteStream( this );
 			}
 	);
-    delete ev;
+    m_ctx->nic().freeNetworkEvent( ev );
 }
 
 void Nic::RecvMachine::ShmemStream::processSwap( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int local_pid, int dest_pid )
@@ -289,7 +316,7 @@ void Nic::RecvMachine::ShmemStream::processSwap( ShmemMsgHdr& hdr, FireflyNetwor
                 m_ctx->deleteStream( this );
 			}
 	);
-    delete ev;
+    m_ctx->nic().freeNetworkEvent( ev );
 }
 
 void Nic::RecvMachine::ShmemStream::processCswap( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int local_pid, int dest_pid )
@@ -330,5 +357,5 @@ void Nic::RecvMachine::ShmemStream::processCswap( ShmemMsgHdr& hdr, FireflyNetwo
                 m_ctx->deleteStream( this );
 			}
 	);
-    delete ev;
+    m_ctx->nic().freeNetworkEvent( ev );
 }
@@ -41,6 +41,7 @@ class ShmemStream : public StreamBase {
     void processAdd( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
     void processCswap( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
     void processSwap( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
+    void processColl( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
     ShmemMsgHdr m_shmemHdr;
     bool m_blocked;
 };
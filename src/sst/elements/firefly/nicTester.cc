@@ -16,7 +16,6 @@
 #include "sst_config.h"
 
 #include <sst/core/params.h>
-#include <sst/core/link.h>
 
 #include "nicTester.h"
 #include "ioVec.h"
@@ -25,75 +24,53 @@
 using namespace SST;
 using namespace SST::Firefly;
 
-const char* NicTester::m_stateName[] = {
-    FOREACH_STATE(GENERATE_STRING)
-};
-
-struct Hdr {
-    int pid;
-};
-
-#define BODY_SIZE 1000
-
-struct DmaEntry {
-    Hdr hdr;
-    unsigned char body[BODY_SIZE];
-};
-
-typedef DmaEntry PioEntry;
-
-#define SHORT_MSG   0xdeadbee0
+#define TESTER_TAG 0xdeadbee0
 
 NicTester::NicTester(ComponentId_t id, Params &params) :
     Component( id ),
-    m_state( PostSend )
+    m_numSent(0),
+    m_numSendsDone(0),
+    m_numRecvsPosted(0),
+    m_numRecvd(0),
+    m_numNicEvents(0),
+    m_done(false)
 {
-    // this has to come first
-    registerTimeBase( "100 ns", true);
-
     m_dbg.init("@t:NicTester::@p():@l " + getName() + ": ",
-            params.find_integer("verboseLevel",0),0,
-            (Output::output_location_t)params.find_integer("debug", 0));
-
-    params.print_all_params( std::cout );
+            params.find<uint32_t>("verboseLevel",0), 0, Output::STDOUT );
 
-    std::string name = params.find_string("nicModule");
-    assert( ! name.empty() );
-
-    m_dbg.debug(CALL_INFO,1,0,"nicModule `%s`\n",name.c_str());
-
-    Params nicParams = params.find_prefix_params("nicParams." );
-
-    m_vNic = dynamic_cast<VirtNic*>(
-                loadModuleWithComponent( name, this, nicParams ));
-    assert( m_vNic );
+    m_numMessages = params.find<uint64_t>( "messages", 10000 );
+    m_messageSize = params.find<size_t>( "messageSize", 64 );
+    m_window = params.find<int>( "window", 16 );
+    m_peer = params.find<int>( "peer", -1 );
+    m_vn = params.find<int>( "vn", 0 );
 
+    if ( m_window < 1 ) {
+        m_dbg.fatal(CALL_INFO,-1,"Error: window must be at least 1, requested %d\n", m_window );
+    }
 
-    char buffer[100];
-    snprintf(buffer,100,"@t:%d:NicTester::@p():@l ", m_vNic->getVirtNicId() );
-    m_dbg.setPrefix(buffer);
+    m_sendBuf.resize( m_messageSize );
+    m_recvBuf.resize( m_messageSize );
+    for ( size_t i = 0; i < m_messageSize; i++ ) {
+        m_sendBuf[i] = i & 0xff;
+    }
 
+    m_vNic = loadUserSubComponent<VirtNic>( "virtNic", ComponentInfo::SHARE_NONE );
+    if ( ! m_vNic ) {
+        m_dbg.fatal(CALL_INFO,-1,"Error: nicTester requires a virtNic subcomponent\n");
+    }
 
     m_vNic->setNotifyOnSendPioDone(
         new VirtNic::Handler<NicTester,void*>(this, &NicTester::notifySendPioDone )
     );
-    m_vNic->setNotifyOnSendDmaDone(
-        new VirtNic::Handler<NicTester,void*>(this, &NicTester::notifySendDmaDone )
-    );
-
     m_vNic->setNotifyOnRecvDmaDone(
         new VirtNic::Handler4Args<NicTester,int,int,size_t,void*>(
                                 this, &NicTester::notifyRecvDmaDone )
     );
     m_vNic->setNotifyNeedRecv(
-        new VirtNic::Handler3Args<NicTester,int,int,size_t>(
+        new VirtNic::Handler2Args<NicTester,int,size_t>(
                     this, &NicTester::notifyNeedRecv)
     );
 
-    m_selfLink = configureSelfLink("NicTester::selfLink", "1 ps",
-        new Event::Handler<NicTester>(this,&NicTester::handleSelfEvent));
-    assert( m_selfLink );
-
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
 }
@@ -105,109 +82,107 @@ void NicTester::init( unsigned int phase )
 
 void NicTester::setup()
 {
-    m_dbg.debug(CALL_INFO,1,0,"\n");
-    m_selfLink->send(0,NULL);
-}
+    char buffer[100];
+    snprintf(buffer,100,"@t:%d:NicTester::@p():@l ", m_vNic->getNodeId() );
+    m_dbg.setPrefix(buffer);
 
-bool NicTester::notifySendDmaDone( void* key )
-{
-    m_dbg.debug(CALL_INFO,1,0,"\n");
-    handleSelfEvent(NULL);
-    return true;
-}
+    if ( -1 == m_peer ) {
+        m_peer = m_vNic->getNodeId() ^ 1;
+    }
+    m_dbg.debug(CALL_INFO,1,0,"peer=%d messages=%" PRIu64 " size=%zu window=%d\n",
+            m_peer, m_numMessages, m_messageSize, m_window );
 
-bool NicTester::notifyRecvDmaDone( int src, int tag, size_t len, void* key )
-{
-    DmaEntry* entry = static_cast<DmaEntry*>(key);
-    m_dbg.debug(CALL_INFO,1,0,"src=%d tag=%#x len=%lu pid=%d\n",src,
-            tag, len, entry->hdr.pid);
+    m_start = std::chrono::steady_clock::now();
 
-    for ( unsigned int i = 0; i < len - sizeof(entry->hdr); i++ ) {
-        if ( entry->body[i] != (i&0xff) ) {
-            printf("ERROR %d != %d\n",i,entry->body[i]);
+    for ( int i = 0; i < m_window; i++ ) {
+        if ( m_numRecvsPosted < m_numMessages ) {
+            postRecv();
+        }
+        if ( m_numSent < m_numMessages ) {
+            postSend();
         }
     }
-    primaryComponentOKToEndSim();
-    return true;
+    checkDone();
 }
 
-bool NicTester::notifySendPioDone( void* key)
+void NicTester::finish()
 {
-    m_dbg.debug(CALL_INFO,1,0,"\n");
-    handleSelfEvent(NULL);
-    return true;
+    double seconds = std::chrono::duration<double>( m_end - m_start ).count();
+
+    if ( ! m_done ) {
+        m_dbg.output("NicTester %d: did not finish, sent %" PRIu64 " received %" PRIu64 " of %" PRIu64 "\n",
+                m_vNic->getNodeId(), m_numSendsDone, m_numRecvd, m_numMessages );
+        return;
+    }
+
+    m_dbg.output("NicTester %d: %" PRIu64 " messages of %zu bytes in %" PRIu64 " ns simulated, "
+            "%.3f s wall, %.0f messages/s, %" PRIu64 " NIC events %.0f events/s\n", m_vNic->getNodeId(),
+            m_numRecvd, m_messageSize, (uint64_t) getCurrentSimTimeNano(), seconds,
+            seconds > 0 ? (double) m_numRecvd / seconds : 0.0,
+            m_numNicEvents, seconds > 0 ? (double) m_numNicEvents / seconds : 0.0 );
 }
 
-bool NicTester::notifyNeedRecv( int nid, int tag, size_t len )
+bool NicTester::notifySendPioDone( void* key )
 {
-    m_dbg.debug(CALL_INFO,1,0,"nid=%d tag=%d len=%lu\n",nid,tag,len);
-    postRecv();
+    m_dbg.debug(CALL_INFO,2,0,"\n");
+    ++m_numNicEvents;
+    ++m_numSendsDone;
+
+    if ( m_numSent < m_numMessages ) {
+        postSend();
+    }
+    checkDone();
     return true;
 }
 
-void NicTester::handleSelfEvent( SST::Event* e )
+bool NicTester::notifyRecvDmaDone( int src, int tag, size_t len, void* key )
 {
-    m_dbg.debug(CALL_INFO,1,0,"%s\n",m_stateName[m_state]);
+    m_dbg.debug(CALL_INFO,2,0,"src=%d tag=%#x len=%zu\n",src, tag, len);
+    ++m_numNicEvents;
+    ++m_numRecvd;
 
-    switch( m_state ) {
-      case PostRecv:
+    if ( m_numRecvsPosted < m_numMessages ) {
         postRecv();
-        break;
-      case PostSend:
-        postSend();
-        break;
-      case WaitSend:
-        waitSend();
-        break;
-      case WaitRecv:
-        break;
     }
+    checkDone();
+    return true;
 }
 
-void NicTester::postRecv()
+bool NicTester::notifyNeedRecv( int nid, size_t len )
 {
-    m_dbg.debug(CALL_INFO,1,0,"\n");
-
-    DmaEntry* entry = new DmaEntry;
-    std::vector<IoVec> iovec(2);
-
-    iovec[0].ptr = &entry->hdr;
-    iovec[0].len = sizeof(entry->hdr);
-    iovec[1].ptr = &entry->body;
-    iovec[1].len = sizeof(entry->body);
-    m_vNic->dmaRecv( -1, SHORT_MSG, iovec, entry );
+    m_dbg.debug(CALL_INFO,1,0,"nid=%d len=%zu\n",nid,len);
+    ++m_numNicEvents;
+    postRecv();
+    return true;
+}
 
-    m_state = PostSend;
+void NicTester::postRecv()
+{
+    std::vector<IoVec> iovec(1);
+    iovec[0].addr.setBacking( m_recvBuf.data() );
+    iovec[0].len = m_recvBuf.size();
 
-    m_selfLink->send(0,NULL);
+    ++m_numRecvsPosted;
+    ++m_numNicEvents;
+    m_vNic->dmaRecv( -1, TESTER_TAG, iovec, NULL );
 }
 
 void NicTester::postSend()
 {
-    m_dbg.debug(CALL_INFO,1,0,"\n");
-
-    PioEntry* entry = new PioEntry;
-    std::vector<IoVec> iovec(2);
+    std::vector<IoVec> iovec(1);
+    iovec[0].addr.setBacking( m_sendBuf.data() );
+    iovec[0].len = m_sendBuf.size();
 
-    iovec[0].ptr = &entry->hdr;
-    iovec[0].len = sizeof(entry->hdr);
-    iovec[1].ptr = &entry->body;
-    iovec[1].len = 10;//sizeof(entry->body);
-
-    entry->hdr.pid = 0xf00d;
-    for ( unsigned int i = 0; i < BODY_SIZE; i++ ) {
-        entry->body[i] = i;
-    }
-
-    m_vNic->pioSend( (m_vNic->getVirtNicId() + 1 ) % 2, SHORT_MSG, iovec, entry );
-
-    m_state = WaitSend;
-
-    m_selfLink->send(0,NULL);
+    ++m_numSent;
+    ++m_numNicEvents;
+    m_vNic->pioSend( m_vn, m_peer, TESTER_TAG, iovec, NULL );
 }
 
-void NicTester::waitSend()
+void NicTester::checkDone()
 {
-    m_dbg.debug(CALL_INFO,1,0,"\n");
-    m_state = WaitRecv;
+    if ( ! m_done && m_numSendsDone == m_numMessages && m_numRecvd == m_numMessages ) {
+        m_end = std::chrono::steady_clock::now();
+        m_done = true;
+        primaryComponentOKToEndSim();
+    }
 }
@@ -21,54 +21,82 @@
 
 #include <sst/core/output.h>
 
-class DmaEntry;
+#include <chrono>
+#include <vector>
 
 namespace SST {
 namespace Firefly {
 
-#define FOREACH_STATE(NAME) \
-    NAME(PostRecv)\
-    NAME(PostSend)\
-    NAME(WaitSend)\
-    NAME(WaitRecv)\
-
-#define GENERATE_ENUM(ENUM) ENUM,
-#define GENERATE_STRING(STRING) #STRING,
-
-
 class VirtNic;
 
+// Drives a firefly NIC directly through its VirtNic, without hermes or
+// ember above it, to measure how fast the NIC model itself runs. Each
+// tester streams short messages to a peer and keeps a window of sends and
+// receives outstanding, at the end it reports messages per second of wall
+// clock time and NIC events per second, counting every command sent to the
+// NIC and every notification it sends back.
 class NicTester : public SST::Component {
 
   public:
+    SST_ELI_REGISTER_COMPONENT(
+        NicTester,
+        "firefly",
+        "nicTester",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Streams messages through a firefly NIC to measure its throughput",
+        COMPONENT_CATEGORY_NETWORK
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verboseLevel","Sets the output level","0"},
+        {"messages","Sets the number of messages sent and received","10000"},
+        {"messageSize","Sets the size of each message in bytes","64"},
+        {"window","Sets the number of sends and of receives kept outstanding","16"},
+        {"peer","Sets the node sent to, -1 pairs node n with n^1","-1"},
+        {"vn","Sets the network virtual network used","0"},
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"virtNic", "Virtual NIC connecting the tester to the NIC", "SST::Firefly::VirtNic"}
+    )
+
     NicTester( SST::ComponentId_t id, SST::Params &params );
     ~NicTester() {};
-    void setup( void );
     void init( unsigned int phase );
-    void printStatus( Output& ) {};
-    void handleSelfEvent( SST::Event* );
+    void setup();
+    void finish();
 
   private:
-    enum {
-        FOREACH_STATE(GENERATE_ENUM)
-    } m_state;
-
-    static const char* m_stateName[];
     bool notifySendPioDone( void* );
-    bool notifySendDmaDone( void* );
     bool notifyRecvDmaDone( int, int, size_t, void* );
-    bool notifyNeedRecv( int, int, size_t );
+    bool notifyNeedRecv( int, size_t );
 
     void postRecv();
     void postSend();
-    void waitSend();
+    void checkDone();
 
-    SST::Link*  m_selfLink;
-    SST::Link*  m_hostLink;
     VirtNic*    m_vNic;
     Output      m_dbg;
-};
 
+    uint64_t    m_numMessages;
+    size_t      m_messageSize;
+    int         m_window;
+    int         m_peer;
+    int         m_vn;
+
+    uint64_t    m_numSent;
+    uint64_t    m_numSendsDone;
+    uint64_t    m_numRecvsPosted;
+    uint64_t    m_numRecvd;
+    uint64_t    m_numNicEvents;
+    bool        m_done;
+
+    std::vector<unsigned char> m_sendBuf;
+    std::vector<unsigned char> m_recvBuf;
+
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::time_point m_end;
+};
 
 }
 }
@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Throughput benchmark for the firefly NIC model. Pairs of firefly.nicTester
+# components stream short messages to each other through firefly.nic and a
+# single merlin router, each tester reports messages and NIC events per
+# second of wall clock time when it finishes.
+#
+#   sst nicThroughput.py --model-options="--nodes=16 --messages=100000 --size=64 --window=32"
+
+import sst
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--nodes", type=int, default=2)
+parser.add_argument("--messages", type=int, default=10000)
+parser.add_argument("--size", type=int, default=64)
+parser.add_argument("--window", type=int, default=16)
+parser.add_argument("--poolSize", type=int, default=1024)
+parser.add_argument("--oldestFirstRecv", type=int, default=0)
+args = parser.parse_args()
+
+if args.nodes < 2 or args.nodes % 2:
+    raise Exception("nodes must be an even number of at least 2")
+
+networkParams = {
+    "link_bw" : "4GB/s",
+    "xbar_bw" : "4GB/s",
+    "flit_size" : "8B",
+    "input_latency" : "50ns",
+    "output_latency" : "50ns",
+    "input_buf_size" : "14KB",
+    "output_buf_size" : "14KB",
+}
+linkLatency = "40ns"
+
+nicParams = {
+    "packetSize" : "2048B",
+    "link_bw" : networkParams["link_bw"],
+    "input_buf_size" : networkParams["input_buf_size"],
+    "output_buf_size" : networkParams["output_buf_size"],
+    "rxMatchDelay_ns" : 100,
+    "txDelay_ns" : 50,
+    "num_vNics" : 1,
+    "maxPoolSize" : args.poolSize,
+    "oldestFirstRecv" : args.oldestFirstRecv,
+}
+
+router = sst.Component("router", "merlin.hr_router")
+router.addParams(networkParams)
+router.addParams({
+    "id" : 0,
+    "num_ports" : args.nodes,
+    "num_vns" : 1,
+})
+router.setSubComponent("topology", "merlin.singlerouter")
+
+for node in range(args.nodes):
+    nic = sst.Component("nic%d" % node, "firefly.nic")
+    nic.addParams(nicParams)
+    nic.addParam("nid", node)
+
+    rtrLink = nic.setSubComponent("rtrLink", "merlin.linkcontrol")
+    rtrLink.addParams({
+        "link_bw" : networkParams["link_bw"],
+        "input_buf_size" : networkParams["input_buf_size"],
+        "output_buf_size" : networkParams["output_buf_size"],
+    })
+
+    link = sst.Link("rtr_link%d" % node)
+    link.connect((rtrLink, "rtr_port", linkLatency), (router, "port%d" % node, linkLatency))
+
+    tester = sst.Component("tester%d" % node, "firefly.nicTester")
+    tester.addParams({
+        "messages" : args.messages,
+        "messageSize" : args.size,
+        "window" : args.window,
+    })
+    virtNic = tester.setSubComponent("virtNic", "firefly.VirtNic")
+
+    link = sst.Link("nic_link%d" % node)
+    link.connect((virtNic, "nic", "1ns"), (nic, "core0", "1ns"))
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+sst.enableStatisticForComponentType("firefly.nic", "rcvdPkts", {"type" : "sst.AccumulatorStatistic"})
@@ -254,6 +254,41 @@ void VirtNic::shmemFadd( int node, Hermes::Vaddr dest, Hermes::Value& value, Cal
     sendCmd(0, new NicShmemFaddCmdEvent( calcCoreId(node), calcRealNicId(node), dest, value, callback ) );
 }
 
+void VirtNic::shmemBarrier( std::vector<int>& pes, Hermes::Vaddr pSync, Callback callback )
+{
+    m_dbg.debug(CALL_INFO,2,0,"size=%zu\n",pes.size());
+    std::vector< std::pair<int,int> > members = calcMembers( pes );
+    sendCmd(0, new NicShmemCollCmdEvent( NicShmemCmdEvent::Barrier, members, 0, 0, 0, 0, pSync,
+                Hermes::Shmem::MOVE, Hermes::Value::Long, callback ) );
+}
+
+void VirtNic::shmemBroadcast( std::vector<int>& pes, int root, Hermes::Vaddr dest, Hermes::Vaddr src, size_t len,
+            Hermes::Vaddr pSync, Callback callback )
+{
+    m_dbg.debug(CALL_INFO,2,0,"size=%zu root=%d len=%zu\n",pes.size(),root,len);
+    std::vector< std::pair<int,int> > members = calcMembers( pes );
+    sendCmd(0, new NicShmemCollCmdEvent( NicShmemCmdEvent::Broadcast, members, root, dest, src, len, pSync,
+                Hermes::Shmem::MOVE, Hermes::Value::Long, callback ) );
+}
+
+void VirtNic::shmemFcollect( std::vector<int>& pes, Hermes::Vaddr dest, Hermes::Vaddr src, size_t len,
+            Hermes::Vaddr pSync, Callback callback )
+{
+    m_dbg.debug(CALL_INFO,2,0,"size=%zu len=%zu\n",pes.size(),len);
+    std::vector< std::pair<int,int> > members = calcMembers( pes );
+    sendCmd(0, new NicShmemCollCmdEvent( NicShmemCmdEvent::Fcollect, members, 0, dest, src, len, pSync,
+                Hermes::Shmem::MOVE, Hermes::Value::Long, callback ) );
+}
+
+void VirtNic::shmemReduction( std::vector<int>& pes, Hermes::Vaddr dest, Hermes::Vaddr src, size_t len,
+            Hermes::Vaddr pSync, Hermes::Shmem::ReduOp op, Hermes::Value::Type dataType, Callback callback )
+{
+    m_dbg.debug(CALL_INFO,2,0,"size=%zu len=%zu op=%d\n",pes.size(),len,op);
+    std::vector< std::pair<int,int> > members = calcMembers( pes );
+    sendCmd(0, new NicShmemCollCmdEvent( NicShmemCmdEvent::Reduction, members, 0, dest, src, len, pSync,
+                op, dataType, callback ) );
+}
+
 void VirtNic::setNotifyOnRecvDmaDone(
                 VirtNic::HandlerBase4Args<int,int,size_t,void*>* functor)
 {
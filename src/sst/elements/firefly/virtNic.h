@@ -196,6 +196,15 @@ class VirtNic : public SST::SubComponent {
     void shmemAdd( int node, Hermes::Vaddr dest, Hermes::Value& );
     void shmemFadd( int node, Hermes::Vaddr dest, Hermes::Value&, CallbackV );
 
+    // collectives run by the NIC, pes holds the network PE of each member of the active set
+    void shmemBarrier( std::vector<int>& pes, Hermes::Vaddr pSync, Callback );
+    void shmemBroadcast( std::vector<int>& pes, int root, Hermes::Vaddr dest, Hermes::Vaddr src, size_t len,
+            Hermes::Vaddr pSync, Callback );
+    void shmemFcollect( std::vector<int>& pes, Hermes::Vaddr dest, Hermes::Vaddr src, size_t len,
+            Hermes::Vaddr pSync, Callback );
+    void shmemReduction( std::vector<int>& pes, Hermes::Vaddr dest, Hermes::Vaddr src, size_t len,
+            Hermes::Vaddr pSync, Hermes::Shmem::ReduOp, Hermes::Value::Type, Callback );
+
     void setNotifyOnRecvDmaDone(
         VirtNic::HandlerBase4Args<int,int,size_t,void*>* functor);
     void setNotifyOnSendPioDone(VirtNic::HandlerBase<void*>* functor);
@@ -238,6 +247,14 @@ class VirtNic : public SST::SubComponent {
         m_toNicLink->send( delay, ev );
     }
 
+	std::vector< std::pair<int,int> > calcMembers( std::vector<int>& pes ) {
+		std::vector< std::pair<int,int> > members;
+		for ( unsigned i = 0; i < pes.size(); i++ ) {
+			members.push_back( std::make_pair( calcRealNicId( pes[i] ), calcCoreId( pes[i] ) ) );
+		}
+		return members;
+	}
+
 	int calcRealNicId( int nodeId ) {
 		if ( -1 == nodeId ) {
 			return -1;
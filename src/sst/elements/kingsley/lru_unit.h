@@ -17,6 +17,8 @@
 #ifndef COMPONENTS_KINGSLEY_LRU_UNIT_H
 #define COMPONENTS_KINGSLEY_LRU_UNIT_H
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
 using namespace SST;
@@ -100,6 +102,68 @@ public:
 
 };
 
+
+// LRU arbiter for up to 32 entries kept as a priority matrix of
+// bitsets.  Bit j of priority[i] is set if entry i has priority over
+// entry j.  Unlike lru_unit, callers only need to visit the entries
+// that are actually requesting.
+class lru_bitset {
+
+    uint32_t priority[32];
+    uint32_t members;
+
+public:
+    lru_bitset() : members(0)
+    {
+        for ( int i = 0; i < 32; ++i ) priority[i] = 0;
+    }
+
+    // New entries get the lowest priority
+    void insert(int id) {
+        if ( id < 0 || id >= 32 ) throw std::string("lru_bitset: Entry id must be in the range [0,32).\n");
+        uint32_t bit = 1u << id;
+        uint32_t others = members;
+        while ( others ) {
+            int j = __builtin_ctz(others);
+            others &= others - 1;
+            priority[j] |= bit;
+        }
+        priority[id] = 0;
+        members |= bit;
+    }
+
+    inline uint32_t mask() const { return members; }
+
+    // Returns the highest priority entry in req, or -1 if req is
+    // empty.  req must only contain members of the unit.
+    int top(uint32_t req) const {
+        uint32_t search = req;
+        while ( search ) {
+            int i = __builtin_ctz(search);
+            search &= search - 1;
+            uint32_t others = req & ~(1u << i);
+            if ( (priority[i] & others) == others ) return i;
+        }
+        return -1;
+    }
+
+    // Entry was granted, so it moves to the lowest priority
+    void satisfied(int id) {
+        uint32_t bit = 1u << id;
+        priority[id] = 0;
+        uint32_t others = members & ~bit;
+        while ( others ) {
+            int j = __builtin_ctz(others);
+            others &= others - 1;
+            priority[j] |= bit;
+        }
+    }
+
+    size_t size() const {
+        return __builtin_popcount(members);
+    }
+};
+
 }
 }
 
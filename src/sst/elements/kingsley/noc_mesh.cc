@@ -47,6 +47,11 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     edge_status(0),
     endpoint_locations(0),
     use_dense_map(false),
+    use_bitset_arb(false),
+    ready_ports(0),
+    busy_ports(0),
+    idle_count(0),
+    busy_count(0),
     output(Simulation::getSimulation()->getSimulationOutput())
 {
     // Get the options for the router
@@ -92,8 +97,33 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
 
     route_y_first = params.find<bool>("route_y_first",false);
 
+    std::string arbitration = params.find<std::string>("arbitration","lru");
+    if ( arbitration == "bitset" ) {
+        use_bitset_arb = true;
+    }
+    else if ( arbitration != "lru" ) {
+        output.fatal(CALL_INFO, -1, "noc_mesh: unknown arbitration scheme: %s\n", arbitration.c_str());
+    }
+
+    // Edge and endpoint state keeps one bit per port
+    if ( local_port_start + local_ports > 64 ) {
+        output.fatal(CALL_INFO, -1, "noc_mesh: at most %d local_ports are supported, %d requested\n",
+                     64 - local_port_start, local_ports);
+    }
+
+    // The bitset arbiter keeps one bit per port
+    if ( use_bitset_arb && local_port_start + local_ports > 32 ) {
+        output.fatal(CALL_INFO, -1, "noc_mesh: bitset arbitration supports at most %d local_ports, %d requested\n",
+                     32 - local_port_start, local_ports);
+    }
+
     // Register the clock
-    my_clock_handler = new Clock::Handler<noc_mesh>(this,&noc_mesh::clock_handler);
+    if ( use_bitset_arb ) {
+        my_clock_handler = new Clock::Handler<noc_mesh>(this,&noc_mesh::clock_handler_bitset);
+    }
+    else {
+        my_clock_handler = new Clock::Handler<noc_mesh>(this,&noc_mesh::clock_handler);
+    }
     clock_tc = registerClock( clock_freq, my_clock_handler);
     clock_is_off = false;
 
@@ -109,6 +139,7 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     send_bit_count = new Statistic<uint64_t>*[local_ports + 4];
     output_port_stalls = new Statistic<uint64_t>*[local_ports + 4];
     xbar_stalls = new Statistic<uint64_t>*[local_ports + 4];
+    idle_cycles = registerStatistic<uint64_t>("idle_cycles");
 
 
     // North port
@@ -156,8 +187,13 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     }
 
 
-    // Allocate space for all the input buffers
+    // Allocate space for all the input buffers.  Every packet is at
+    // least one flit, so a queue never holds more packets than the
+    // credits we hand out for it.
     port_queues = new port_queue_t[local_port_start + local_ports];
+    for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+        port_queues[i].reserve(std::max(1, input_buf_size / flit_size));
+    }
     port_busy = new int[local_port_start + local_ports];
     for ( int i = 0; i < local_port_start + local_ports; ++i ) {
         port_busy[i] = 0;
@@ -239,6 +275,7 @@ noc_mesh::handle_input_r2r(Event* ev, int port)
 
         // Put the event into the proper queue
         port_queues[port].push(event);
+        if ( use_bitset_arb ) ready_ports |= 1u << port;
         if (clock_is_off)
             clock_wakeup();
         break;
@@ -332,6 +369,7 @@ noc_mesh::handle_input_ep2r(Event* ev, int port)
 
         // Need to put the event into the proper queue
         port_queues[port].push(event);
+        if ( use_bitset_arb ) ready_ports |= 1u << port;
         if (clock_is_off)
             clock_wakeup();
         break;
@@ -356,9 +394,13 @@ void noc_mesh::clock_wakeup() {
     Cycle_t time = reregisterClock(clock_tc, my_clock_handler);
     Cycle_t cyclesOff = time - last_time - 1;
     // Update busy values
+    busy_ports = 0;
     for ( int i = 0; i < local_port_start + local_ports; ++i) {
         port_busy[i] = (port_busy[i] < cyclesOff) ? 0 : port_busy[i] - cyclesOff;
+        if ( use_bitset_arb && port_busy[i] > 0 ) busy_ports |= 1u << i;
     }
+    // Router was idle the whole time the clock was off
+    if ( cyclesOff > 0 ) idle_cycles->addDataNTimes(cyclesOff, 1);
 
     // unsigned int local_progress = (cyclesOff * local_lru.size()) % (local_lru.size() * 2);
     // unsigned int mesh_progress = (cyclesOff * mesh_lru.size()) % (mesh_lru.size() * 2);
@@ -371,6 +413,67 @@ void noc_mesh::clock_wakeup() {
     clock_is_off = false;
 }
 
+noc_mesh::ForwardResult
+noc_mesh::forward(int in_port)
+{
+    noc_mesh_event* event = port_queues[in_port].front();
+
+    // Get the next port
+    int port = event->next_port;
+
+    // Check to see if the port is busy
+    if ( port_busy[port] > 0 ) {
+        xbar_stalls[port]->addData(1);
+        return PORT_BUSY;
+    }
+
+    // Check to see if there are enough credits to send on that port
+    // output.output("(%d,%d): clock_handler(): port_credits[%d] = %d\n",my_x,my_y,port,port_credits[port]);
+    if ( port_credits[port] < event->encap_ev->getSizeInFlits() ) {
+        output_port_stalls[port]->addData(1);
+        return NO_CREDITS;
+    }
+
+    int trace_id = event->encap_ev->request->getTraceID();
+    int vn = event->encap_ev->vn;
+    SST::Interfaces::SimpleNetwork::nid_t src = event->encap_ev->request->src;
+    SST::Interfaces::SimpleNetwork::nid_t dest = event->encap_ev->request->dest;
+    SST::Interfaces::SimpleNetwork::Request::TraceType ttype = event->encap_ev->request->getTraceType();
+    int flits = event->encap_ev->getSizeInFlits();
+
+    port_queues[in_port].pop();
+    if ( use_bitset_arb && port_queues[in_port].empty() ) ready_ports &= ~(1u << in_port);
+
+    port_credits[port] -= flits;
+    port_busy[port] = flits;
+    if ( use_bitset_arb ) busy_ports |= 1u << port;
+    if ( edge_status & ( 1ull << port) ) {
+        ports[port]->send(event->encap_ev);
+        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
+        event->encap_ev = NULL;
+        delete event;
+    }
+    else {
+        ports[port]->send(event);
+        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
+    }
+    if ( ttype == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Sent an event to router from router: (%d,%d)"
+                      " (%s) on VC %d from src %" PRIu64 " to dest %" PRIu64 ".\n",
+                      trace_id,
+                      getCurrentSimTimeNano(),
+                      my_x, my_y,
+                      getName().c_str(),
+                      vn,
+                      src,
+                      dest);
+    }
+    // Need to send credit event back to last router
+    credit_event* cr_ev = new credit_event(0, flits);
+    ports[in_port]->send(cr_ev);
+    return FORWARDED;
+}
+
 bool
 noc_mesh::clock_handler(Cycle_t cycle)
 {
@@ -383,6 +486,7 @@ noc_mesh::clock_handler(Cycle_t cycle)
     }
 
     bool keepClockOn = false;
+    bool forwarded = false;
     // Progress all the messages
 
 
@@ -392,65 +496,18 @@ noc_mesh::clock_handler(Cycle_t cycle)
         for ( unsigned int i = 0; i < lru.size(); i++ ) {
             int lru_port = lru.top();
             if ( !port_queues[lru_port].empty() ) {
-                // noc_mesh_event* event = port_queues[local_port_start + i].front();
-                noc_mesh_event* event = port_queues[lru_port].front();
-
-                // Get the next port
-                int port = event->next_port;
-
-                // Check to see if the port is busy
-                if ( port_busy[port] > 0 ) {
-                    xbar_stalls[port]->addData(1);
+                switch ( forward(lru_port) ) {
+                case FORWARDED:
+                    lru.satisfied(true);
+                    forwarded = true;
+                    break;
+                case PORT_BUSY:
                     lru.satisfied(false);
                     keepClockOn = true;
-                    continue;
-                }
-
-                // Check to see if there are enough credits to send on
-                // that port
-                // output.output("(%d,%d): clock_handler(): port_credits[%d] = %d\n",my_x,my_y,port,port_credits[port]);
-                if ( port_credits[port] >= event->encap_ev->getSizeInFlits() ) {
-                    int trace_id = event->encap_ev->request->getTraceID();
-                    int vn = event->encap_ev->vn;
-                    SST::Interfaces::SimpleNetwork::nid_t src = event->encap_ev->request->src;
-                    SST::Interfaces::SimpleNetwork::nid_t dest = event->encap_ev->request->dest;
-                    SST::Interfaces::SimpleNetwork::Request::TraceType ttype = event->encap_ev->request->getTraceType();
-                    int flits = event->encap_ev->getSizeInFlits();
-
-                    // port_queues[local_port_start + i].pop();
-                    port_queues[lru_port].pop();
-                    port_credits[port] -= event->encap_ev->getSizeInFlits();
-                    port_busy[port] = event->encap_ev->getSizeInFlits();
-                    if ( edge_status & ( 1 << port) ) {
-                        ports[port]->send(event->encap_ev);
-                        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
-                        event->encap_ev = NULL;
-                        delete event;
-                    }
-                    else {
-                        ports[port]->send(event);
-                        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
-                    }
-                    if ( ttype == SimpleNetwork::Request::FULL ) {
-                        output.output("TRACE(%d): %" PRIu64 " ns: Sent an event to router from router: (%d,%d)"
-                                      " (%s) on VC %d from src %" PRIu64 " to dest %" PRIu64 ".\n",
-                                      trace_id,
-                                      getCurrentSimTimeNano(),
-                                      my_x, my_y,
-                                      getName().c_str(),
-                                      vn,
-                                      src,
-                                      dest);
-                    }
-                    // Need to send credit event back to last router
-                    credit_event* cr_ev = new credit_event(0, flits);
-                    // ports[local_port_start + i]->send(cr_ev);
-                    ports[lru_port]->send(cr_ev);
-                    lru.satisfied(true);
-                }
-                else {
-                    output_port_stalls[port]->addData(1);
+                    break;
+                case NO_CREDITS:
                     lru.satisfied(false);
+                    break;
                 }
                 if (!port_queues[lru_port].empty())
                     keepClockOn = true;
@@ -461,13 +518,62 @@ noc_mesh::clock_handler(Cycle_t cycle)
         }
     }
 
+    if ( forwarded ) busy_count++;
+    else idle_count++;
+
     // }
     clock_is_off = !keepClockOn;
+    if ( clock_is_off ) reportIdleCycles();
 
     // Stay on clock list
     return !keepClockOn;
 }
 
+bool
+noc_mesh::clock_handler_bitset(Cycle_t cycle)
+{
+    last_time = cycle;
+
+    // Decrement the busy values, but only for ports that are still
+    // sending
+    uint32_t busy = busy_ports;
+    while ( busy ) {
+        int i = __builtin_ctz(busy);
+        busy &= busy - 1;
+        port_busy[i]--;
+        if ( port_busy[i] <= 0 ) {
+            port_busy[i] = 0;
+            busy_ports &= ~(1u << i);
+        }
+    }
+
+    bool forwarded = false;
+
+    // Same priority order as the lru_units, but each unit only visits
+    // the ports that have packets waiting.  Ports that can't forward
+    // keep their priority for the next cycle.
+    for ( auto& lru : lru_bitsets ) {
+        uint32_t requests = ready_ports & lru.mask();
+        while ( requests ) {
+            int in_port = lru.top(requests);
+            requests &= ~(1u << in_port);
+            if ( forward(in_port) == FORWARDED ) {
+                lru.satisfied(in_port);
+                forwarded = true;
+            }
+        }
+    }
+
+    if ( forwarded ) busy_count++;
+    else idle_count++;
+
+    // Turn the clock off if there is nothing left to forward
+    bool keepClockOn = ready_ports != 0;
+    clock_is_off = !keepClockOn;
+    if ( clock_is_off ) reportIdleCycles();
+    return !keepClockOn;
+}
+
 void noc_mesh::setup()
 {
     // if ( use_dense_map ) {
@@ -503,10 +609,42 @@ void noc_mesh::setup()
         }
     }
     lru_units.back().finalize();
+
+    // Bitset arbitration uses the same priority classes
+    if ( !use_bitset_arb ) return;
+
+    lru_bitsets.resize(port_priority_equal ? 1 : 2);
+    for ( int i = local_port_start; i < local_port_start + local_ports; ++i ) {
+        if ( ports[i] != NULL ) {
+            lru_bitsets[0].insert(i);
+        }
+    }
+    for ( int i = 0; i < local_port_start; ++i ) {
+        if ( ports[i] != NULL ) {
+            lru_bitsets.back().insert(i);
+        }
+    }
+}
+
+// Clock handlers count cycles locally, they are added to idle_cycles
+// when the clock turns off and at the end of simulation
+void noc_mesh::reportIdleCycles()
+{
+    if ( idle_count > 0 ) idle_cycles->addDataNTimes(idle_count, 1);
+    if ( busy_count > 0 ) idle_cycles->addDataNTimes(busy_count, 0);
+    idle_count = 0;
+    busy_count = 0;
 }
 
 void noc_mesh::finish()
 {
+    reportIdleCycles();
+
+    // Count the cycles since the clock was last turned off
+    if ( clock_is_off ) {
+        Cycle_t now = getCurrentSimTime(clock_tc);
+        if ( now > last_time ) idle_cycles->addDataNTimes(now - last_time, 1);
+    }
 }
 
 void
@@ -565,15 +703,15 @@ noc_mesh::init(unsigned int phase)
         // attached or have no links attached
         for ( int i = 0; i < local_port_start + local_ports; ++i ) {
             if ( ports[i] == NULL ) {
-                edge_status |=  ( 1 << i );
+                edge_status |=  ( 1ull << i );
             }
             else {
                 ev = ports[i]->recvInitData();
                 if ( ev != NULL ) {
                     nie = static_cast<NocInitEvent*>(ev);
                     if ( nie->command == NocInitEvent::REPORT_ENDPOINT ) {
-                        edge_status |=  ( 1 << i );
-                        endpoint_locations |= ( 1 << i );
+                        edge_status |=  ( 1ull << i );
+                        endpoint_locations |= ( 1ull << i );
                         endpoint_start++;
                         delete nie;
                         // Endpoint to router link
@@ -627,7 +765,7 @@ noc_mesh::init(unsigned int phase)
 
         // Pass flit size to the endpoints
         for ( int i = 0; i < local_port_start + local_ports; ++i ) {
-            if ( (1 << i) & endpoint_locations ) {
+            if ( (1ull << i) & endpoint_locations ) {
                 nie = new NocInitEvent();
                 nie->command = NocInitEvent::REPORT_FLIT_SIZE;
                 nie->ua_value = UnitAlgebra("1b") * flit_size;
@@ -1010,7 +1148,7 @@ noc_mesh::init(unsigned int phase)
 
         // Now for local ports
         for ( int i = 0; i < local_ports; ++i ) {
-            if ( endpoint_locations & ( 1 << (i + local_port_start) ) ) {
+            if ( endpoint_locations & ( 1ull << (i + local_port_start) ) ) {
                 int endpoint_id = (((my_y * x_size) + my_x) * local_ports) + i;
                 ep_ids.push_back(std::make_pair(endpoint_id,local_port_start + i));
             }
@@ -1075,7 +1213,7 @@ noc_mesh::init(unsigned int phase)
         // Simply route messages that are sent by the endpoints
         for ( int i = 0; i < local_port_start + local_ports; ++i ) {
             if ( ports[i] != NULL ) {
-                bool endpoint = (1 << i) & endpoint_locations;
+                bool endpoint = (1ull << i) & endpoint_locations;
                 while ( true ) { // Go until there are no more events
                     Event* ev = ports[i]->recvInitData();
                     if ( NULL == ev ) break;
@@ -1112,7 +1250,7 @@ noc_mesh::init(unsigned int phase)
 
                         // Send east.  We send east if this came from
                         // an endpoint or from the west.
-                        if ( endpoint || ( (1 << i ) & west_mask ) ) {
+                        if ( endpoint || ( (1ull << i ) & west_mask ) ) {
                             // No need to send east if this is the
                             // eastern edge
                             if ( !(edge_status & east_mask) ) {
@@ -1122,7 +1260,7 @@ noc_mesh::init(unsigned int phase)
 
                         // Send west.  We send west if this came from
                         // an endpoint or from the east.
-                        if ( endpoint || ( (1 << i ) & east_mask ) ) {
+                        if ( endpoint || ( (1ull << i ) & east_mask ) ) {
                             // No need to send east if this is the
                             // eastern edge
                             if ( !(edge_status & west_mask) ) {
@@ -1133,8 +1271,8 @@ noc_mesh::init(unsigned int phase)
                         // Send north.  We send north if this came
                         // from an endpoint, or from the east, west or
                         // south.
-                        if ( endpoint || ( (1 << i ) & west_mask ) ||
-                            ( (1 << i ) & east_mask ) || ( (1 << i ) & south_mask )) {
+                        if ( endpoint || ( (1ull << i ) & west_mask ) ||
+                            ( (1ull << i ) & east_mask ) || ( (1ull << i ) & south_mask )) {
                             // No need to send north if this is the
                             // northern edge
                             if ( !(edge_status & north_mask) ) {
@@ -1145,8 +1283,8 @@ noc_mesh::init(unsigned int phase)
                         // Send south.  We send south if this came
                         // from an endpoint, or from the east, west or
                         // north.
-                        if ( endpoint || ( (1 << i ) & west_mask ) ||
-                            ( (1 << i ) & east_mask ) || ( (1 << i ) & north_mask )) {
+                        if ( endpoint || ( (1ull << i ) & west_mask ) ||
+                            ( (1ull << i ) & east_mask ) || ( (1ull << i ) & north_mask )) {
                             // No need to send south if this is the
                             // southern edge
                             if ( !(edge_status & south_mask) ) {
@@ -1161,7 +1299,7 @@ noc_mesh::init(unsigned int phase)
                         delete nme;
                         for ( int j = 0; j < local_port_start + local_ports; ++j ) {
                             if ( endpoint && ( i == j ) ) continue;  // No need to send back to src
-                            if ( (1 << j) & endpoint_locations ) {
+                            if ( (1ull << j) & endpoint_locations ) {
                                 if (!sent) {
                                     ports[j]->sendInitData(packet);
                                     sent = true;
@@ -1176,7 +1314,7 @@ noc_mesh::init(unsigned int phase)
                     }
                     else { // Not a broadcast
                         route(nme);
-                        if ( (1 << nme->next_port) & endpoint_locations ) {
+                        if ( (1ull << nme->next_port) & endpoint_locations ) {
                             ports[nme->next_port]->sendInitData(nme->encap_ev);
                             nme->encap_ev = NULL;
                             delete nme;
@@ -1203,7 +1341,7 @@ noc_mesh::complete(unsigned int phase)
     // Simply route messages that are sent by the endpoints
     for ( int i = 0; i < local_port_start + local_ports; ++i ) {
         if ( ports[i] != NULL ) {
-            bool endpoint = (1 << i) & endpoint_locations;
+            bool endpoint = (1ull << i) & endpoint_locations;
             while ( true ) { // Go until there are no more events
                 Event* ev = ports[i]->recvInitData();
                 if ( NULL == ev ) break;
@@ -1240,7 +1378,7 @@ noc_mesh::complete(unsigned int phase)
 
                     // Send east.  We send east if this came from
                     // an endpoint or from the west.
-                    if ( endpoint || ( (1 << i ) & west_mask ) ) {
+                    if ( endpoint || ( (1ull << i ) & west_mask ) ) {
                         // No need to send east if this is the
                         // eastern edge
                         if ( !(edge_status & east_mask) ) {
@@ -1250,7 +1388,7 @@ noc_mesh::complete(unsigned int phase)
 
                     // Send west.  We send west if this came from
                     // an endpoint or from the east.
-                    if ( endpoint || ( (1 << i ) & east_mask ) ) {
+                    if ( endpoint || ( (1ull << i ) & east_mask ) ) {
                         // No need to send east if this is the
                         // eastern edge
                         if ( !(edge_status & west_mask) ) {
@@ -1261,8 +1399,8 @@ noc_mesh::complete(unsigned int phase)
                     // Send north.  We send north if this came
                     // from an endpoint, or from the east, west or
                     // south.
-                    if ( endpoint || ( (1 << i ) & west_mask ) ||
-                         ( (1 << i ) & east_mask ) || ( (1 << i ) & south_mask )) {
+                    if ( endpoint || ( (1ull << i ) & west_mask ) ||
+                         ( (1ull << i ) & east_mask ) || ( (1ull << i ) & south_mask )) {
                         // No need to send north if this is the
                         // northern edge
                         if ( !(edge_status & north_mask) ) {
@@ -1273,8 +1411,8 @@ noc_mesh::complete(unsigned int phase)
                     // Send south.  We send south if this came
                     // from an endpoint, or from the east, west or
                     // north.
-                    if ( endpoint || ( (1 << i ) & west_mask ) ||
-                         ( (1 << i ) & east_mask ) || ( (1 << i ) & north_mask )) {
+                    if ( endpoint || ( (1ull << i ) & west_mask ) ||
+                         ( (1ull << i ) & east_mask ) || ( (1ull << i ) & north_mask )) {
                         // No need to send south if this is the
                         // southern edge
                         if ( !(edge_status & south_mask) ) {
@@ -1289,7 +1427,7 @@ noc_mesh::complete(unsigned int phase)
                     delete nme;
                     for ( int j = 0; j < local_port_start + local_ports; ++j ) {
                         if ( endpoint && ( i == j ) ) continue;  // No need to send back to src
-                        if ( (1 << j) & endpoint_locations ) {
+                        if ( (1ull << j) & endpoint_locations ) {
                             if (!sent) {
                                 ports[j]->sendInitData(packet);
                                 sent = true;
@@ -1304,7 +1442,7 @@ noc_mesh::complete(unsigned int phase)
                 }
                 else { // Not a broadcast
                     route(nme);
-                    if ( (1 << nme->next_port) & endpoint_locations ) {
+                    if ( (1ull << nme->next_port) & endpoint_locations ) {
                         ports[nme->next_port]->sendInitData(nme->encap_ev);
                         nme->encap_ev = NULL;
                         delete nme;
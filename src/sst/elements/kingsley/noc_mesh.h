@@ -31,6 +31,7 @@
 
 #include "sst/elements/kingsley/nocEvents.h"
 #include "sst/elements/kingsley/lru_unit.h"
+#include "sst/elements/kingsley/ring_buffer.h"
 
 using namespace SST;
 
@@ -60,6 +61,9 @@ public:
         {"port_priority_equal","Set to true to have all port have equal priority (usually endpoint ports have higher priority).","false"},
         {"route_y_first",      "Set to true to rout Y-dimension first.","false"},
         {"use_dense_map",      "Set to true to have a dense network id map instead of the sparse map normally used.","false"},
+        {"arbitration",        "Crossbar arbitration scheme.  lru visits every port each cycle.  bitset uses bitset based LRU "
+                               "units and only visits ports that have packets waiting, which is faster for large, lightly "
+                               "loaded meshes but gives a different (still fair) grant order.  bitset supports at most 28 local_ports.","lru"},
         // {"network_inspectors", "Comma separated list of network inspectors to put on output ports.", ""},
     )
 
@@ -76,6 +80,7 @@ public:
         // { "send_packet_count",  "Count number of packets sent on link", "packets", 1},
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
+        { "idle_cycles",        "Adds 1 for each router cycle in which no packet was forwarded and 0 otherwise, so the mean is the fraction of idle cycles", "cycles", 1},
         // { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
     )
 
@@ -96,8 +101,8 @@ private:
     int init_count;
     int endpoint_start;
     int total_endpoints;
-    unsigned int edge_status;
-    unsigned int endpoint_locations;
+    uint64_t edge_status;
+    uint64_t endpoint_locations;
 
     int flit_size;
     int input_buf_size;
@@ -111,7 +116,7 @@ private:
     bool route_y_first;
 
 
-    typedef std::queue<noc_mesh_event*> port_queue_t;
+    typedef ring_buffer<noc_mesh_event*> port_queue_t;
 
     Clock::Handler<noc_mesh>* my_clock_handler;
     TimeConverter* clock_tc;
@@ -129,10 +134,30 @@ private:
     Shared::SharedArray<int> dense_map;
 
     std::vector< lru_unit<int> > lru_units;
+
+    // Used for bitset arbitration.  ready_ports has a bit set for
+    // each port with packets waiting and busy_ports has a bit set for
+    // each port that is still sending, so a cycle only touches
+    // active ports.
+    bool use_bitset_arb;
+    std::vector<lru_bitset> lru_bitsets;
+    uint32_t ready_ports;
+    uint32_t busy_ports;
+
+    // Cycles since idle_cycles was last updated
+    uint64_t idle_count;
+    uint64_t busy_count;
+    void reportIdleCycles();
+
+    // Result of trying to forward the packet at the head of an input
+    // port
+    enum ForwardResult { FORWARDED, PORT_BUSY, NO_CREDITS };
+    ForwardResult forward(int in_port);
     // lru_unit<int> local_lru;
     // lru_unit<int> mesh_lru;
 
     bool clock_handler(Cycle_t cycle);
+    bool clock_handler_bitset(Cycle_t cycle);
     // Statistic<uint64_t>** xbar_stalls;
 
     Output& output;
@@ -147,6 +172,7 @@ private:
     Statistic<uint64_t>** send_bit_count;
     Statistic<uint64_t>** output_port_stalls;
     Statistic<uint64_t>** xbar_stalls;
+    Statistic<uint64_t>* idle_cycles;
     // Statistic<uint64_t>** xbar_stalls_prioirty;
     // Statistic<uint64_t>** xbar_stalls_normal;
     // Statistic<uint64_t>** output_idle;
@@ -0,0 +1,86 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_KINGSLEY_RING_BUFFER_H
+#define COMPONENTS_KINGSLEY_RING_BUFFER_H
+
+#include <vector>
+
+using namespace SST;
+
+namespace SST {
+namespace Kingsley {
+
+// FIFO backed by a power of two sized ring.  Port queues are bounded
+// by the credits given to the other side of the link, so after
+// reserve() is called with that bound the ring never has to grow.
+template<typename T>
+class ring_buffer {
+
+    std::vector<T> data;
+    size_t head;
+    size_t count;
+    size_t mask;
+
+    void grow(size_t capacity) {
+        size_t new_size = 1;
+        while ( new_size < capacity ) new_size <<= 1;
+        if ( new_size <= data.size() ) return;
+
+        std::vector<T> new_data(new_size);
+        for ( size_t i = 0; i < count; ++i ) {
+            new_data[i] = data[(head + i) & mask];
+        }
+        data.swap(new_data);
+        head = 0;
+        mask = new_size - 1;
+    }
+
+public:
+    ring_buffer() : head(0), count(0), mask(0)
+    {
+        data.resize(1);
+    }
+
+    void reserve(size_t capacity) {
+        grow(capacity);
+    }
+
+    inline void push(const T& item) {
+        if ( count == data.size() ) grow(count * 2);
+        data[(head + count) & mask] = item;
+        count++;
+    }
+
+    inline T& front() {
+        return data[head];
+    }
+
+    inline void pop() {
+        head = (head + 1) & mask;
+        count--;
+    }
+
+    inline bool empty() const { return count == 0; }
+
+    inline size_t size() const { return count; }
+
+};
+
+}
+}
+
+#endif // COMPONENTS_KINGSLEY_RING_BUFFER_H
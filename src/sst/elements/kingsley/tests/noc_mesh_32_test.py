@@ -1,5 +1,6 @@
 # Automatically generated SST Python input
 import sst
+import sys,getopt
 
 sst.setProgramOption("timebase", "1ps")
 #sst.setProgramOption("stopAtCycle", "1000ns")
@@ -17,6 +18,16 @@ def getLink(name1, name2):
     return links[name]
 
 num_endpoints = 1
+arbitration = "lru"
+
+# --arbitration=bitset and --endpoints=N select the router arbitration
+# scheme and the number of endpoints on each router
+opts, args = getopt.getopt(sys.argv[1:], "", ["arbitration=","endpoints="])
+for o, a in opts:
+    if o == "--arbitration":
+        arbitration = a
+    elif o == "--endpoints":
+        num_endpoints = int(a)
 
 num_peers = (num_endpoints * (x_size * y_size)) + (2*x_size) + (2*y_size)
 #num_peers = x_size * y_size
@@ -39,7 +50,8 @@ for y in range(y_size):
             "link_bw" : link_bw,
             "input_buf_size" : input_buf_size,
             "flit_size" : flit_size,
-            "use_dense_map" : "true"
+            "use_dense_map" : "true",
+            "arbitration" : arbitration
             #"port_priority_equal" : "true"
         })
         # wire up mesh connections.  Any index that would be -1 will
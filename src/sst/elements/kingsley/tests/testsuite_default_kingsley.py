@@ -46,6 +46,38 @@ class testcase_kingsley_Component(SSTTestCase):
     def test_kingsly_noc_mesh_32(self):
         self.kingsley_test_template("noc_mesh_32_test")
 
+    def test_kingsley_noc_mesh_bitset(self):
+        self.kingsley_delivery_template("noc_mesh_bitset", "--arbitration=bitset", 1)
+
+    def test_kingsley_noc_mesh_34_ports(self):
+        self.kingsley_delivery_template("noc_mesh_34_ports", "--endpoints=30", 30)
+
+    # The grant order differs between configurations, so these only check
+    # that every NIC received all of its packets
+    def kingsley_delivery_template(self, testcase, options, endpoints):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_kingsley_{0}".format(testcase)
+
+        sdlfile = "{0}/noc_mesh_32_test.py".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        otherargs = '--model-options="{0}"'.format(options)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+        # endpoints on each of the 4x4 routers plus one on each edge port
+        num_nics = endpoints * 16 + 16
+        with open(outfile) as f:
+            out = f.read()
+        received = out.count("received all packets")
+
+        self.assertTrue("Simulation is complete" in out, "Simulation did not complete, see {0}".format(outfile))
+        self.assertEqual(received, num_nics, "{0} of {1} NICs received all packets, see {2}".format(
+            received, num_nics, outfile))
+
 #####
 
     def kingsley_test_template(self, testcase):
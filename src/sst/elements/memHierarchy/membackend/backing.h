@@ -18,6 +18,9 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -34,6 +37,36 @@ public:
 
     virtual uint8_t get( Addr addr) = 0;
     virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+
+    /* Checkpoint support. Contents are saved as a magic string followed by
+     * (address, size, bytes) records covering everything that may have been written */
+    virtual void saveContents( FILE* out ) = 0;
+
+    bool loadContents( FILE* in ) {
+        char magic[checkpointMagicSize];
+        if (fread(magic, 1, checkpointMagicSize, in) != checkpointMagicSize || 0 != memcmp(magic, checkpointMagic(), checkpointMagicSize))
+            return false;
+
+        uint64_t record[2];
+        std::vector<uint8_t> data;
+        while (fread(record, sizeof(uint64_t), 2, in) == 2) {
+            data.resize(record[1]);
+            if (fread(data.data(), 1, record[1], in) != record[1])
+                return false;
+            set(record[0], record[1], data);
+        }
+        return true;
+    }
+
+protected:
+    static const size_t checkpointMagicSize = 8;
+    static const char* checkpointMagic() { return "MHBACK01"; }
+
+    static void saveRecord( FILE* out, Addr addr, uint64_t size, const uint8_t* data ) {
+        uint64_t record[2] = { addr, size };
+        fwrite(record, sizeof(uint64_t), 2, out);
+        fwrite(data, 1, size, out);
+    }
 };
 
 class BackingMMAP : public Backing {
@@ -80,6 +113,21 @@ public:
             data[i] = m_buffer[addr + i];
     }
 
+    /* The mapping does not record which pages were touched, so skip pages that are still all zero */
+    void saveContents( FILE* out ) {
+        const size_t chunk = 4096;
+        fwrite(checkpointMagic(), 1, checkpointMagicSize, out);
+        for (size_t start = 0; start < (size_t)m_size; start += chunk) {
+            const size_t len = std::min(chunk, (size_t)m_size - start);
+            for (size_t i = 0; i < len; i++) {
+                if (m_buffer[start + i] != 0) {
+                    saveRecord(out, start, len, m_buffer + start);
+                    break;
+                }
+            }
+        }
+    }
+
 private:
     uint8_t* m_buffer;
     int m_fd;
@@ -153,13 +201,22 @@ public:
         return m_buffer[bAddr][offset];
     }
 
+    void saveContents( FILE* out ) {
+        fwrite(checkpointMagic(), 1, checkpointMagicSize, out);
+        for (auto& unit : m_buffer) {
+            saveRecord(out, unit.first << m_shift, m_allocUnit, unit.second);
+        }
+    }
+
 private:
     void allocIfNeeded(Addr bAddr) {
         if (m_buffer.find(bAddr) == m_buffer.end()) {
-            uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
+            // Pages are zeroed when first touched so untouched memory (e.g., .bss
+            // of a loaded executable) reads as zero without being written
+            uint8_t* data = (uint8_t*) calloc(m_allocUnit, sizeof(uint8_t));
             if (!data) {
                 Output out("", 1, 0, Output::STDOUT);
-                out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
+                out.fatal(CALL_INFO, -1, "BackingMalloc: Error - calloc failed.\n");
             }
             m_buffer[bAddr] = data;
         }
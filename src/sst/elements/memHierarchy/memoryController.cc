@@ -311,6 +311,28 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         backing_ = new Backend::BackingMalloc(sizeBytes);
     }
 
+    /* Checkpointed memory contents */
+    std::string backingInFile = params.find<std::string>("backing_in_file", "");
+    backingOutFile_ = params.find<std::string>("backing_out_file", "");
+    backingRestored_ = false;
+
+    if (!backing_ && (!backingInFile.empty() || !backingOutFile_.empty())) {
+        out.fatal(CALL_INFO, -1, "%s, Error - backing_in_file and backing_out_file require a backing store but 'backing' is 'none'\n",
+                getName().c_str());
+    }
+
+    if (!backingInFile.empty()) {
+        FILE* backingIn = fopen(backingInFile.c_str(), "rb");
+        if (!backingIn) {
+            out.fatal(CALL_INFO, -1, "%s, Error - unable to open backing_in_file. You specified '%s'.\n", getName().c_str(), backingInFile.c_str());
+        }
+        if (!backing_->loadContents(backingIn)) {
+            out.fatal(CALL_INFO, -1, "%s, Error - backing_in_file '%s' is not a backing store checkpoint or is truncated.\n", getName().c_str(), backingInFile.c_str());
+        }
+        fclose(backingIn);
+        backingRestored_ = true;
+    }
+
     /* Custom command handler */
     using std::placeholders::_3;
     customCommandHandler_ = loadUserSubComponent<CustomCmdMemHandler>("customCmdHandler", ComponentInfo::SHARE_NONE,
@@ -554,6 +576,15 @@ void MemController::finish(void) {
     }
     memBackendConvertor_->finish();
     link_->finish();
+
+    if (!backingOutFile_.empty()) {
+        FILE* backingOut = fopen(backingOutFile_.c_str(), "wb");
+        if (!backingOut) {
+            out.fatal(CALL_INFO, -1, "%s, Error - unable to open backing_out_file. You specified '%s'.\n", getName().c_str(), backingOutFile_.c_str());
+        }
+        backing_->saveContents(backingOut);
+        fclose(backingOut);
+    }
 }
 
 void MemController::writeData(MemEvent* event) {
@@ -670,7 +701,8 @@ void MemController::processInitEvent( MemEventInit* me ) {
         me->setAddr(translateToLocal(me->getAddr()));
         Addr addr = me->getAddr();
         if (is_debug_event(me)) { Debug(_L9_,"Memory init %s - Received Write for %" PRIx64 " size %zu\n", getName().c_str(), me->getAddr(),me->getPayload().size()); }
-        if ( isRequestAddressValid(addr) && backing_ ) {
+        /* A restored checkpoint already holds everything written during initialization */
+        if ( isRequestAddressValid(addr) && backing_ && !backingRestored_ ) {
             backing_->set(addr, me->getPayload().size(), me->getPayload());
         }
     } else if (Command::NULLCMD == me->getCmd()) {
@@ -53,6 +53,8 @@ public:
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_in_file",     "(string) Optional checkpoint of the backing store (see backing_out_file) to restore memory from. Initialization writes are ignored when set", ""},\
+            {"backing_out_file",    "(string) Optional file to checkpoint the backing store contents to at the end of simulation", ""},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
@@ -127,6 +129,8 @@ protected:
 
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
+    std::string             backingOutFile_;    // Checkpoint the backing store here at finish
+    bool                    backingRestored_;   // Backing store was loaded from a checkpoint
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy
     bool clockLink_;            // Flag - should we call clock() on this link or not
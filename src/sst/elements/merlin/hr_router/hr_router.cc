@@ -244,6 +244,10 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     if (pc_params.contains("network_inspectors")) pc_params.insert("network_inspectors", params.find<std::string>("network_inspectors", ""));
     pc_params.insert("oql_track_port", params.find<std::string>("oql_track_port","false"));
     pc_params.insert("oql_track_remote", params.find<std::string>("oql_track_remote","false"));
+    if (params.contains("credit_batch_threshold")) pc_params.insert("credit_batch_threshold", params.find<std::string>("credit_batch_threshold"));
+    if (params.contains("credit_batch_window")) pc_params.insert("credit_batch_window", params.find<std::string>("credit_batch_window"));
+    if (params.contains("aggregate_links")) pc_params.insert("aggregate_links", params.find<std::string>("aggregate_links"));
+    if (params.contains("aggregate_window")) pc_params.insert("aggregate_window", params.find<std::string>("aggregate_window"));
 
     for ( int i = 0; i < num_ports; i++ ) {
         in_port_busy[i] = 0;
@@ -68,6 +68,14 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
+        {"credit_batch_threshold", "Number of flits that must drain from an input VC before credits are returned.  A value "
+                                   "of 1 returns credits for every packet.", "1"},
+        {"credit_batch_window", "Maximum time credits are held waiting for credit_batch_threshold to be reached.", "0ns"},
+        {"aggregate_links",    "Which router to router links bundle packets into a single event: none, remote (links that "
+                               "cross an MPI rank boundary) or all.", "none"},
+        {"aggregate_window",   "Length of time packets are collected into a bundle on aggregated links.  Delivery times "
+                               "are unchanged while it is no longer than output_latency, beyond that packets can arrive "
+                               "up to the difference late.", "0ns"},
         {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
     )
 
@@ -77,7 +85,10 @@ public:
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
         { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
-        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1}
+        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1},
+        { "credit_events_sent", "Number of credit events sent back on the link", "events", 1},
+        { "credit_events_saved", "Number of credit events avoided by credit batching", "events", 1},
+        { "bundle_size",        "Number of packets in each bundle sent on an aggregated link", "packets", 1}
     )
 
     SST_ELI_DOCUMENT_PORTS(
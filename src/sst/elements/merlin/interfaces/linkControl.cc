@@ -34,6 +34,8 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     req_vns(vns), used_vns(0), total_vns(0), vn_out_map(nullptr),
     vn_remap_out(nullptr), output_queues(nullptr), router_credits(nullptr),
     router_return_credits(nullptr), input_queues(nullptr),
+    credit_batch_threshold(1), credit_batch_timing(nullptr),
+    credit_flush_pending(nullptr), credit_batch_packets(nullptr),
     id(-1), logical_nid(-1), use_nid_map(false), job_id(0),
     curr_out_vn(0), waiting(true), have_packets(false), start_block(0),
     idle_start(0), is_idle(true),
@@ -81,6 +83,20 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     output_timing = configureSelfLink(port_name + "_output_timing", "1GHz",
             new Event::Handler<LinkControl>(this,&LinkControl::handle_output));
 
+    // Set up credit batching
+    credit_batch_threshold = params.find<int>("credit_batch_threshold", 1);
+    if ( credit_batch_threshold < 1 ) credit_batch_threshold = 1;
+    if ( credit_batch_threshold > 1 ) {
+        UnitAlgebra window = params.find<UnitAlgebra>("credit_batch_window", "0ns");
+        if ( !window.hasUnits("s") || window <= UnitAlgebra("0s") ) {
+            merlin_abort.fatal(CALL_INFO,1,"LinkControl: credit_batch_window must be specified as a non-zero "
+                               "time when credit_batch_threshold is greater than 1: %s\n",
+                               window.toStringBestSI().c_str());
+        }
+        credit_batch_timing = configureSelfLink(port_name + "_credit_batch_timing", window.toStringBestSI(),
+                new Event::Handler<LinkControl>(this,&LinkControl::handle_credit_flush));
+    }
+
     congestion_timing = configureSelfLink(port_name = "_congestion_timing", Simulation::getTimeLord()->getTimeBase().toString(),
             new Event::Handler<LinkControl>(this,&LinkControl::handle_congestion));
 
@@ -151,6 +167,8 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     output_port_stalls = registerStatistic<uint64_t>("output_port_stalls");
     idle_time = registerStatistic<uint64_t>("idle_time");
     // recv_bit_count = registerStatistic<uint64_t>("recv_bit_count");
+    credit_events_sent = registerStatistic<uint64_t>("credit_events_sent");
+    credit_events_saved = registerStatistic<uint64_t>("credit_events_saved");
 
     last_time = 0;
     last_recv_time = 0;
@@ -163,6 +181,8 @@ LinkControl::~LinkControl()
     delete [] router_credits;
     delete [] router_return_credits;
     delete [] input_queues;
+    delete [] credit_flush_pending;
+    delete [] credit_batch_packets;
 }
 
 void LinkControl::setup()
@@ -283,11 +303,20 @@ void LinkControl::init(unsigned int phase)
         // total_vns
         router_return_credits = new int[total_vns];
         router_credits = new int[total_vns];
+        credit_flush_pending = new bool[total_vns];
+        credit_batch_packets = new int[total_vns];
         for ( int i = 0; i < total_vns; ++i ) {
             router_return_credits[i] = 0;
             router_credits[i] = 0;
+            credit_flush_pending[i] = false;
+            credit_batch_packets[i] = 0;
         }
 
+        // A threshold larger than the input buffer can never be
+        // reached without waiting for the window to expire
+        int inbuf_flits = (inbuf_size / flit_size_ua).getRoundedValue();
+        if ( credit_batch_threshold > inbuf_flits ) credit_batch_threshold = inbuf_flits;
+
 
         int* vn_count = new int[total_vns];
         for ( int i = 0; i < total_vns; ++i ) vn_count[i] = 0;
@@ -486,17 +515,9 @@ SST::Interfaces::SimpleNetwork::Request* LinkControl::recv(int vn) {
     RtrEvent* event = input_queues[vn].front();
     input_queues[vn].pop();
 
-    // Figure out how many credits to return
-    int flits = event->getSizeInFlits();
-    router_return_credits[vn] += flits;
-
-    // For now, we're just going to send the credits back to the
-    // other side.  The required BW to do this will not be taken
-    // into account.
-    // rtr_link->send(1,new credit_event(event->request->vn,in_ret_credits[event->request->vn]));
-    // in_ret_credits[event->request->vn] = 0;
-    rtr_link->send(1,new credit_event(event->getRouteVN(),router_return_credits[vn]));
-    router_return_credits[vn] = 0;
+    // Return the credits (may be held for batching).  Credits are
+    // tracked by the VN used in the network, not the endpoint VN.
+    returnCredits(event->getRouteVN(), event->getSizeInFlits());
 
     if ( event->getTraceType() != SimpleNetwork::Request::NONE ) {
         output.output("TRACE(%d): %" PRIu64 " ns: recv called on LinkControl in NIC: %s\n",event->getTraceID(),
@@ -792,5 +813,53 @@ void LinkControl::handle_congestion(Event* ev)
     waiting = false;
 }
 
+void LinkControl::returnCredits(int vn, int flits)
+{
+    router_return_credits[vn] += flits;
+    credit_batch_packets[vn]++;
+
+    // The required BW to send credits back to the other side will
+    // not be taken into account.
+    if ( router_return_credits[vn] >= credit_batch_threshold ) {
+        sendCredits(vn);
+        return;
+    }
+
+    // Not enough credits yet, make sure they get flushed by the end
+    // of the batch window
+    if ( !credit_flush_pending[vn] ) {
+        credit_flush_pending[vn] = true;
+        credit_batch_timing->send(1,new credit_event(vn,0));
+    }
+}
+
+void LinkControl::sendCredits(int vn, credit_event* ev)
+{
+    if ( ev == nullptr ) ev = new credit_event(vn,0);
+    ev->credits = router_return_credits[vn];
+    rtr_link->send(1,ev);
+
+    credit_events_sent->addData(1);
+    credit_events_saved->addData(credit_batch_packets[vn] - 1);
+    router_return_credits[vn] = 0;
+    credit_batch_packets[vn] = 0;
+}
+
+void LinkControl::handle_credit_flush(Event* ev)
+{
+    credit_event* ce = static_cast<credit_event*>(ev);
+    int vn = ce->vc;
+    credit_flush_pending[vn] = false;
+
+    // Credits may have already been sent because the threshold was
+    // reached
+    if ( router_return_credits[vn] == 0 ) {
+        delete ce;
+        return;
+    }
+    // Reuse the timer event as the credit event
+    sendCredits(vn,ce);
+}
+
 } // namespace Merlin
 } // namespace SST
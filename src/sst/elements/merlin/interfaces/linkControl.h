@@ -68,6 +68,11 @@ public:
         {"use_nid_remap",      "If true, will remap logical nids in job to physical ids", "false" },
         {"nid_map_name",       "Base name of shared region where my NID map will be located.  If empty, no NID map will be used.",""},
         {"vn_remap",           "Remap VNs onto/off of the network.  If empty, no vn remapping is done", "" },
+        {"credit_batch_threshold", "Number of flits that must be received on a VN before credits are returned to the "
+                                   "router.  A value of 1 returns credits for every packet.", "1" },
+        {"credit_batch_window", "Maximum time credits are held waiting for credit_batch_threshold to be reached.  This "
+                                "bounds the extra latency credit batching can add.  Required if credit_batch_threshold "
+                                "is greater than 1.", "0ns" },
 
     )
 
@@ -76,6 +81,8 @@ public:
         { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "idle_time",          "Number of (in unites of core timebas) that port was idle", "time spent idle", 1},
+        { "credit_events_sent", "Number of credit events sent to the router", "events", 1},
+        { "credit_events_saved", "Number of credit events avoided by credit batching", "events", 1},
         // { "recv_bit_count",     "Count number of bits received on the link", "bits", 1},
     )
 
@@ -147,6 +154,15 @@ private:
     // Input queues.  Size is req_vn
     network_queue_t* input_queues;
 
+    // Credit batching.  Credits are held until credit_batch_threshold
+    // flits have been received on a VN, or until credit_batch_window
+    // has passed since the first held credit.  Arrays are size
+    // total_vns.
+    int credit_batch_threshold;
+    Link* credit_batch_timing;
+    bool* credit_flush_pending;
+    int* credit_batch_packets;
+
     SimTime_t last_time;
     SimTime_t last_recv_time;
 
@@ -210,6 +226,8 @@ private:
     Statistic<uint64_t>* output_port_stalls;
     Statistic<uint64_t>* idle_time;
     Statistic<uint64_t>* recv_bit_count;
+    Statistic<uint64_t>* credit_events_sent;
+    Statistic<uint64_t>* credit_events_saved;
 
     RtrInitEvent* checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func);
 
@@ -269,6 +287,10 @@ private:
     void handle_input(Event* ev);
     void handle_output(Event* ev);
     void handle_congestion(Event* ev);
+    void handle_credit_flush(Event* ev);
+
+    void returnCredits(int vn, int flits);
+    void sendCredits(int vn, credit_event* ev = nullptr);
 
     int sent;
 
@@ -130,14 +130,8 @@ PortControl::recv(int vc)
 	}
 
     int vc_return = topo->isHostPort(port_number) ? event->getCreditReturnVC() : vc;
-	// Figure out how many credits to return
-	port_ret_credits[vc_return] += event->getFlitCount();
-
-	// For now, we're just going to send the credits back to the
-	// other side.  The required BW to do this will not be taken
-	// into account.
-	port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return]));
-	port_ret_credits[vc_return] = 0;
+	// Return the credits (may be held for batching)
+	returnCredits(vc_return, event->getFlitCount());
 
 #if TRACK
     if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
@@ -237,6 +231,16 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     output_buf_count(NULL),
     port_ret_credits(NULL),
     port_out_credits(NULL),
+    credit_batch_threshold(1),
+    credit_batch_timing(NULL),
+    credit_flush_pending(NULL),
+    credit_batch_packets(NULL),
+    aggregate(false),
+    aggregate_timing(NULL),
+    bundle_timing(NULL),
+    current_bundle(NULL),
+    bundle_start(0),
+    output_latency_cycles(0),
     idle_start(0),
 	sai_win_start(0),
 	sai_port_disabled(false),
@@ -409,6 +413,44 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     output_port_stalls = registerStatistic<uint64_t>("output_port_stalls", port_name);
     idle_time = registerStatistic<uint64_t>("idle_time", port_name);
     width_adj_count = registerStatistic<uint64_t>("width_adj_count", port_name);
+    credit_events_sent = registerStatistic<uint64_t>("credit_events_sent", port_name);
+    credit_events_saved = registerStatistic<uint64_t>("credit_events_saved", port_name);
+    bundle_size = registerStatistic<uint64_t>("bundle_size", port_name);
+
+    // Set up credit batching
+    credit_batch_threshold = params.find<int>("credit_batch_threshold", 1);
+    if ( credit_batch_threshold < 1 ) credit_batch_threshold = 1;
+    if ( credit_batch_threshold > 1 ) {
+        UnitAlgebra window = params.find<UnitAlgebra>("credit_batch_window", "0ns");
+        if ( !window.hasUnits("s") || window <= UnitAlgebra("0s") ) {
+            merlin_abort.fatal(CALL_INFO_LONG, 1, "PortControl: credit_batch_window must be specified as a "
+                               "non-zero time when credit_batch_threshold is greater than 1: %s\n",
+                               window.toStringBestSI().c_str());
+        }
+        credit_batch_timing = configureSelfLink(link_port_name + "_credit_batch_timing", window.toStringBestSI(),
+                                                new Event::Handler<PortControl>(this,&PortControl::handle_credit_flush));
+    }
+
+    // Set up packet aggregation.  Whether this particular link
+    // aggregates is decided during init once we know the rank of the
+    // other side.
+    aggregate_mode = params.find<std::string>("aggregate_links", "none");
+    if ( aggregate_mode != "none" && aggregate_mode != "remote" && aggregate_mode != "all" ) {
+        merlin_abort.fatal(CALL_INFO_LONG, 1, "PortControl: unknown value for aggregate_links: %s\n", aggregate_mode.c_str());
+    }
+    if ( aggregate_mode != "none" && !host_port ) {
+        UnitAlgebra window = params.find<UnitAlgebra>("aggregate_window", "0ns");
+        if ( !window.hasUnits("s") || window <= UnitAlgebra("0s") ) {
+            merlin_abort.fatal(CALL_INFO_LONG, 1, "PortControl: aggregate_window must be specified as a "
+                               "non-zero time when aggregate_links is set: %s\n",
+                               window.toStringBestSI().c_str());
+        }
+        aggregate_timing = configureSelfLink(link_port_name + "_aggregate_timing", window.toStringBestSI(),
+                                             new Event::Handler<PortControl>(this,&PortControl::handle_aggregate_flush));
+        bundle_timing = configureSelfLink(link_port_name + "_bundle_timing", Simulation::getTimeLord()->getTimeBase().toString(),
+                                          new Event::Handler<PortControl>(this,&PortControl::handle_input_r2r));
+        output_latency_cycles = (UnitAlgebra(output_latency_timebase) / Simulation::getTimeLord()->getTimeBase()).getRoundedValue();
+    }
 
 	// set the SAI metrics to 0
 	stalled = 0;
@@ -534,6 +576,18 @@ PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_
         port_out_credits[i] = 0;
     }
 
+    // A threshold larger than the input buffer can never be reached
+    // without waiting for the window to expire
+    if ( credit_batch_threshold > ibs.getRoundedValue() ) {
+        credit_batch_threshold = ibs.getRoundedValue();
+    }
+    credit_flush_pending = new bool[num_vcs];
+    credit_batch_packets = new int[num_vcs];
+    for ( int i = 0; i < num_vcs; i++ ) {
+        credit_flush_pending[i] = false;
+        credit_batch_packets[i] = 0;
+    }
+
 
     // Need to start the timer for links that never send data
     idle_start = Simulation::getSimulation()->getCurrentSimCycle();
@@ -549,6 +603,8 @@ PortControl::~PortControl() {
     if ( output_buf_count != NULL ) delete [] output_buf_count;
     if ( port_ret_credits != NULL ) delete [] port_ret_credits;
     if ( port_out_credits != NULL ) delete [] port_out_credits;
+    if ( credit_flush_pending != NULL ) delete [] credit_flush_pending;
+    if ( credit_batch_packets != NULL ) delete [] credit_batch_packets;
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
         delete network_inspectors[i];
     }
@@ -591,6 +647,10 @@ PortControl::finish() {
             output_buf[i].pop();
         }
     }
+    if ( current_bundle != NULL ) {
+        delete current_bundle;
+        current_bundle = NULL;
+    }
 
     // finish any inspectors
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
@@ -657,6 +717,13 @@ PortControl::init(unsigned int phase) {
             init_ev->command = RtrInitEvent::REPORT_PORT;
             init_ev->int_value = port_number;
             port_link->sendInitData(init_ev);
+
+            // Report the rank so the other side knows if the link
+            // crosses a partition boundary
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_RANK;
+            init_ev->int_value = Simulation::getSimulation()->getRank().rank;
+            port_link->sendInitData(init_ev);
         }
         break;
     case 1:
@@ -729,6 +796,16 @@ PortControl::init(unsigned int phase) {
             remote_port_number = init_ev->int_value;
             delete init_ev;
 
+            ev = port_link->recvInitData();
+            init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_RANK, CALL_INFO);
+            if ( aggregate_mode == "all" ) {
+                aggregate = true;
+            }
+            else if ( aggregate_mode == "remote" ) {
+                aggregate = init_ev->int_value != (int)Simulation::getSimulation()->getRank().rank;
+            }
+            delete init_ev;
+
             remote_rdy_for_credits = true;
 
         }
@@ -1038,6 +1115,23 @@ PortControl::handle_input_r2r(Event* ev)
 	case BaseRtrEvent::PACKET:
 	    // This shouldn't happen
 	    break;
+	case BaseRtrEvent::BUNDLE:
+    {
+        packet_bundle_event* bundle = static_cast<packet_bundle_event*>(ev);
+        if ( bundle_timing == NULL ) {
+            merlin_abort.fatal(CALL_INFO_LONG, 1, "PortControl: received a packet bundle on a port that is not "
+                               "set up for aggregation.  aggregate_links must be set the same on both ends of a link.\n");
+        }
+        // Deliver each packet at the time it would have arrived had
+        // it been sent by itself
+        for ( size_t i = 0; i < bundle->size(); ++i ) {
+            if ( bundle->offsets[i] == 0 ) handle_input_r2r(bundle->events[i]);
+            else bundle_timing->send(bundle->offsets[i], bundle->events[i]);
+        }
+        bundle->events.clear();
+        delete bundle;
+    }
+    break;
 	case BaseRtrEvent::INTERNAL:
     {
 	    internal_router_event* event = static_cast<internal_router_event*>(ev);
@@ -1175,6 +1269,17 @@ PortControl::handle_output(Event* ev) {
             send_event->setEncapsulatedEvent(NULL);
             delete send_event;
 	    }
+	    else if ( aggregate ) {
+            // Start a new bundle if needed.  The bundle is sent when
+            // the aggregation window closes.
+            if ( current_bundle == NULL ) {
+                current_bundle = new packet_bundle_event();
+                bundle_start = Simulation::getSimulation()->getCurrentSimCycle();
+                aggregate_timing->send(1,NULL);
+            }
+            current_bundle->add(Simulation::getSimulation()->getCurrentSimCycle() - bundle_start + output_latency_cycles,
+                                send_event);
+	    }
 	    else {
             port_link->send(1,send_event);
 	    }
@@ -1227,6 +1332,72 @@ PortControl::reenablePort(Event* ev) {
 	sai_port_disabled = false;
 }
 
+void
+PortControl::returnCredits(int vc, int flits)
+{
+    port_ret_credits[vc] += flits;
+    credit_batch_packets[vc]++;
+
+    // The required BW to send credits back to the other side will
+    // not be taken into account.
+    if ( port_ret_credits[vc] >= credit_batch_threshold ) {
+        sendCredits(vc);
+        return;
+    }
+
+    // Not enough credits yet, make sure they get flushed by the end
+    // of the batch window
+    if ( !credit_flush_pending[vc] ) {
+        credit_flush_pending[vc] = true;
+        credit_batch_timing->send(1,new credit_event(vc,0));
+    }
+}
+
+void
+PortControl::sendCredits(int vc, credit_event* ev)
+{
+    if ( ev == NULL ) ev = new credit_event(vc,0);
+    ev->credits = port_ret_credits[vc];
+    port_link->send(1,ev);
+
+    credit_events_sent->addData(1);
+    credit_events_saved->addData(credit_batch_packets[vc] - 1);
+    port_ret_credits[vc] = 0;
+    credit_batch_packets[vc] = 0;
+}
+
+void
+PortControl::handle_credit_flush(Event* ev)
+{
+    credit_event* ce = static_cast<credit_event*>(ev);
+    int vc = ce->vc;
+    credit_flush_pending[vc] = false;
+
+    // Credits may have already been sent because the threshold was
+    // reached
+    if ( port_ret_credits[vc] == 0 ) {
+        delete ce;
+        return;
+    }
+    // Reuse the timer event as the credit event
+    sendCredits(vc,ce);
+}
+
+void
+PortControl::handle_aggregate_flush(Event* ev)
+{
+    bundle_size->addData(current_bundle->size());
+    // The bundle was held at this end for the window, which comes out
+    // of each packet's output latency.  A packet only arrives late if
+    // it was held for longer than output_latency.
+    SimTime_t held = Simulation::getSimulation()->getCurrentSimCycle() - bundle_start;
+    for ( auto& offset : current_bundle->offsets ) {
+        offset = offset > held ? offset - held : 0;
+    }
+    port_link->send(0,current_bundle);
+    current_bundle = NULL;
+}
+
 // Triggered every window duration of time
 // This resets SAI metrics and calls increase/decreaseLinkWidth
 void
@@ -73,7 +73,17 @@ public:
         {"enable_congestion_management", "Turn on congestion management","false"},
         {"cm_outstanding_threshold", "Threshold for the amount of data outstanding to a host before congestion management can trigger","2*output_buf_size"},
         {"cm_pktsize_threshold", "Minimum size of a packet to be considered part of a stream with regards to congestion management","128B"},
-        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"}
+        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"},
+        {"aggregate_links",    "Which router to router links bundle packets into a single event.  Options are none, remote "
+                               "(only links that cross an MPI rank boundary) and all.", "none"},
+        {"aggregate_window",   "Length of time packets are collected into a bundle on aggregated links.  The bundle is "
+                               "held at the sending port and the wait is taken out of output_latency, so packet delivery "
+                               "times are unchanged while the window is no longer than output_latency.  Beyond that "
+                               "packets can arrive up to (aggregate_window - output_latency) late.", "0ns"},
+        {"credit_batch_threshold", "Number of flits that must drain from a VC before credits are returned.  A value of 1 "
+                               "returns credits for every packet.", "1"},
+        {"credit_batch_window", "Maximum time credits are held waiting for credit_batch_threshold to be reached.  This bounds "
+                                "the extra latency credit batching can add.  Required if credit_batch_threshold is greater than 1.", "0ns"}
     )
 
     // SST_ELI_DOCUMENT_STATISTICS(
@@ -185,6 +195,16 @@ private:
     int* port_ret_credits;
     int* port_out_credits;
 
+    // Credit batching.  Returned credits are held until
+    // credit_batch_threshold flits have drained from a VC, or until
+    // credit_batch_window has passed since the first held credit,
+    // whichever comes first.
+    int credit_batch_threshold;
+    Link* credit_batch_timing;
+    bool* credit_flush_pending;
+    // Number of packets covered by the credits currently held
+    int* credit_batch_packets;
+
     // Represents the start of when a port was idle
     // If the buffer was empty we instantiate this to the current time
     SimTime_t idle_start;
@@ -210,12 +230,28 @@ private:
     Router* parent;
     bool connected;
 
+    // Packet aggregation for router to router links.  Packets are
+    // collected into current_bundle for aggregate_window, then sent as
+    // a single event.
+    std::string aggregate_mode;
+    bool aggregate;
+    Link* aggregate_timing;
+    // Used on the receive side to deliver packets from a bundle at
+    // their original arrival times
+    Link* bundle_timing;
+    packet_bundle_event* current_bundle;
+    SimTime_t bundle_start;
+    SimTime_t output_latency_cycles;
+
     // Statistics
     Statistic<uint64_t>* send_bit_count;
     Statistic<uint64_t>* send_packet_count;
     Statistic<uint64_t>* output_port_stalls;
     Statistic<uint64_t>* idle_time;
     Statistic<uint64_t>* width_adj_count;
+    Statistic<uint64_t>* credit_events_sent;
+    Statistic<uint64_t>* credit_events_saved;
+    Statistic<uint64_t>* bundle_size;
 
 	// SAI Metrics (S+A+I=1) corresponds to
 	// sai_win_start to (sai_win_start + sai_win_length)
@@ -358,6 +394,11 @@ private:
     void handle_failed(Event* ev);
     void handleSAIWindow(Event* ev);
     void reenablePort(Event* ev);
+    void handle_credit_flush(Event* ev);
+    void handle_aggregate_flush(Event* ev);
+
+    void returnCredits(int vc, int flits);
+    void sendCredits(int vc, credit_event* ev = NULL);
 
 	uint64_t increaseActive();
 
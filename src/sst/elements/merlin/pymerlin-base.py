@@ -603,6 +603,12 @@ class TemplateBase(_AttributeManager):
 """
 
 # Classes implementing topology
+# Topologies build every router, link and endpoint of the network in python
+# on the rank that runs the config, so configuration time and memory grow
+# with the whole network, not with the partition each rank simulates.  The
+# SST core this is built against has no way for an element to create only
+# its partition's components, the builders only keep the per router cost
+# low (shared topology params, links dropped once both ends are connected).
 class Topology(TemplateBase):
     def __init__(self):
         TemplateBase.__init__(self)
@@ -710,7 +716,8 @@ class hr_router(RouterTemplate):
         RouterTemplate.__init__(self)
 
         self._declareParams("params",["link_bw","flit_size","xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size",
-                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm"])
+                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm",
+                                      "credit_batch_threshold","credit_batch_window","aggregate_links","aggregate_window"])
 
         self._declareParams("params",["qos_settings"],"portcontrol.arbitration.")
         self._declareParams("params",["output_arb", "enable_congestion_management", "cm_outstanding_threshold", "cm_incast_threshold"],"portcontrol.")
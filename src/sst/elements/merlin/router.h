@@ -28,6 +28,7 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Merlin {
@@ -82,7 +83,7 @@ public:
 class BaseRtrEvent : public Event {
 
 public:
-    enum RtrEventType {CREDIT, PACKET, INTERNAL, INITIALIZATION, CTRL};
+    enum RtrEventType {CREDIT, PACKET, INTERNAL, INITIALIZATION, CTRL, BUNDLE};
 
     inline RtrEventType getType() const { return type; }
 
@@ -373,7 +374,7 @@ private:
 class RtrInitEvent : public BaseRtrEvent {
 public:
 
-    enum Commands { REQUEST_VNS, SET_VNS, REPORT_ID, REPORT_BW, REPORT_FLIT_SIZE, REPORT_PORT };
+    enum Commands { REQUEST_VNS, SET_VNS, REPORT_ID, REPORT_BW, REPORT_FLIT_SIZE, REPORT_PORT, REPORT_RANK };
 
     // int num_vns;
     // int id;
@@ -478,6 +479,46 @@ private:
     ImplementSerializable(SST::Merlin::internal_router_event)
 };
 
+// Container used to send several packets across a router to router
+// link as a single event.  Each packet carries the delay, in core
+// time units, from the arrival of the bundle to the time the packet
+// would have arrived had it been sent on its own.
+class packet_bundle_event : public BaseRtrEvent {
+public:
+    std::vector<SimTime_t> offsets;
+    std::vector<internal_router_event*> events;
+
+    packet_bundle_event() :
+        BaseRtrEvent(BaseRtrEvent::BUNDLE)
+    {}
+
+    ~packet_bundle_event() {
+        for ( auto ev : events ) delete ev;
+    }
+
+    inline void add(SimTime_t offset, internal_router_event* ev) {
+        offsets.push_back(offset);
+        events.push_back(ev);
+    }
+
+    inline size_t size() const { return events.size(); }
+
+    virtual void print(const std::string& header, Output &out) const  override {
+        out.output("%s packet_bundle_event to be delivered at %" PRIu64 " with priority %d, %zu packets\n",
+                   header.c_str(), getDeliveryTime(), getPriority(), events.size());
+        for ( auto ev : events ) ev->print(header + "  ", out);
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser)  override {
+        BaseRtrEvent::serialize_order(ser);
+        ser & offsets;
+        ser & events;
+    }
+
+private:
+    ImplementSerializable(SST::Merlin::packet_bundle_event)
+};
+
 class Topology : public SubComponent {
 public:
 
@@ -536,6 +577,13 @@ public:
     // Method used to set endpoint ID
     virtual int getEndpointID(int port) {return -1;}
 
+    // Returns the router id and port number on the other end of a
+    // router to router port, or (-1,-1) if unknown.  Routers discover
+    // this during init, so this is only needed by offline tools such
+    // as merlin.route_check that exercise the routing logic without
+    // building links.
+    virtual std::pair<int,int> getRemoteRouterPort(int port) { return std::make_pair(-1,-1); }
+
     // Sets the array that holds the credit values for all the output
     // buffers.  Format is:
     // For port=n, VC=x, location in array is n*num_vcs + x.
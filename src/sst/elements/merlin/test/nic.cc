@@ -58,6 +58,7 @@ nic::nic(ComponentId_t cid, Params& params) :
     num_msg = params.find<int>("num_messages",10);
 
     send_untimed_bcast = params.find<bool>("send_untimed_data","false");
+    check_order = params.find<bool>("check_order","false");
 
     UnitAlgebra message_size = params.find<std::string>("message_size","64b");
     if ( message_size.hasUnits("B") ) message_size  *= UnitAlgebra("8b/B");
@@ -382,6 +383,11 @@ nic::clock_handler(Cycle_t cycle)
             output.fatal(CALL_INFO,-1,"%d received packet intended for %d\n",net_id,(int)req->dest);
         }
 
+        if ( check_order && ev->seq != next_seq[src] ) {
+            output.fatal(CALL_INFO,-1,"%d received packet %d from %d out of order, expected %d\n",
+                         net_id,ev->seq,src,next_seq[src]);
+        }
+
         next_seq[src]++;
         delete ev;
         delete req;
@@ -49,6 +49,8 @@ public:
         {"num_messages", "Total number of messages to send to each endpoint."},
         {"message_size", "Size of each message to be sent specified in either b or B (can include SI prefix)."},
         {"send_untimed_broadcast",   "Controls whether data is sent in init and complete.","false"},
+        {"check_order",  "Fail if packets from a source arrive out of the order they were sent in.  Only valid for "
+                         "networks with deterministic routing.","false"},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -83,6 +85,7 @@ private:
     int init_broadcast_count;
 
     bool send_untimed_bcast;
+    bool check_order;
 
     SST::Interfaces::SimpleNetwork* link_control;
 
@@ -0,0 +1,476 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+#include "sst/elements/merlin/test/route_test/route_check.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <sst/core/params.h>
+#include <sst/core/simulation.h>
+
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include "sst/elements/merlin/merlin.h"
+
+namespace SST {
+using namespace SST::Interfaces;
+
+namespace Merlin {
+
+
+route_check::route_check(ComponentId_t cid, Params& params) :
+    Component(cid)
+{
+    std::string topo_name = params.find<std::string>("topology");
+    if ( topo_name == "" ) {
+        merlin_abort.fatal(CALL_INFO, -1, "route_check requires topology to be specified\n");
+    }
+
+    num_routers = params.find<int>("num_routers",-1);
+    if ( num_routers <= 0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "route_check requires num_routers to be specified\n");
+    }
+
+    num_ports = params.find<int>("num_ports",-1);
+    if ( num_ports <= 0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "route_check requires num_ports to be specified\n");
+    }
+
+    num_vns = params.find<int>("num_vns",1);
+    samples = params.find<int>("samples",1);
+    max_hops = params.find<int>("max_hops",64);
+    max_cycles_reported = params.find<int>("max_cycles_reported",10);
+    ignore_vcs = params.find<bool>("ignore_vcs",false);
+    int init_credits = params.find<int>("credits",32);
+
+    std::string output_file = params.find<std::string>("output_file","");
+    if ( output_file == "" ) {
+        report = new Output("",0,0,Output::STDOUT);
+    }
+    else {
+        report = new Output("",0,0,Output::FILE,output_file);
+    }
+
+    // Load a topology object for every router.  Router 0 is loaded
+    // first since some topologies (e.g. dragonfly) have router 0
+    // write the shared data used by the other routers.
+    Params topo_params = params.get_scoped_params("topology");
+    topos.resize(num_routers);
+    for ( int i = 0; i < num_routers; ++i ) {
+        topos[i] = loadAnonymousSubComponent<Topology>(topo_name, "topology", i, ComponentInfo::SHARE_NONE,
+                                                       topo_params, num_ports, i, num_vns);
+        if ( !topos[i] ) {
+            merlin_abort.fatal(CALL_INFO, -1, "route_check: unable to load topology %s\n",topo_name.c_str());
+        }
+    }
+
+    vcs_per_vn.resize(num_vns);
+    topos[0]->getVCsPerVN(vcs_per_vn);
+    num_vcs = 0;
+    for ( int i = 0; i < num_vns; ++i ) {
+        vn_start_vc.push_back(num_vcs);
+        num_vcs += vcs_per_vn[i];
+    }
+
+    credits.resize(num_ports * num_vcs, init_credits);
+    queue_lengths.resize(num_ports * num_vcs, 0);
+    for ( int i = 0; i < num_routers; ++i ) {
+        topos[i]->setOutputBufferCreditArray(credits.data(), num_vcs);
+        topos[i]->setOutputQueueLengthsArray(queue_lengths.data(), num_vcs);
+    }
+
+    registerAsPrimaryComponent();
+    primaryComponentDoNotEndSim();
+}
+
+
+route_check::~route_check()
+{
+    for ( auto x : topos ) delete x;
+    delete report;
+}
+
+
+void route_check::setup()
+{
+    discoverNetwork();
+    checkRoutes();
+    primaryComponentOKToEndSim();
+}
+
+
+void route_check::discoverNetwork()
+{
+    remote.resize(num_routers * num_ports, std::make_pair(-1,-1));
+
+    int missing = 0;
+    int mismatched = 0;
+    for ( int r = 0; r < num_routers; ++r ) {
+        for ( int p = 0; p < num_ports; ++p ) {
+            switch ( topos[r]->getPortState(p) ) {
+            case Topology::R2N:
+            {
+                int ep = topos[r]->getEndpointID(p);
+                if ( ep < 0 ) break;
+                if ( ep >= (int)endpoints.size() ) endpoints.resize(ep + 1, std::make_pair(-1,-1));
+                if ( endpoints[ep].first != -1 ) {
+                    report->output("ERROR: endpoint %d reported by both router %d, port %d and router %d, port %d\n",
+                                   ep, endpoints[ep].first, endpoints[ep].second, r, p);
+                }
+                endpoints[ep] = std::make_pair(r,p);
+                break;
+            }
+            case Topology::R2R:
+                remote[r * num_ports + p] = topos[r]->getRemoteRouterPort(p);
+                if ( remote[r * num_ports + p].first == -1 ) missing++;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    // Make sure the links are symmetric
+    for ( int r = 0; r < num_routers; ++r ) {
+        for ( int p = 0; p < num_ports; ++p ) {
+            const std::pair<int,int>& rp = remote[r * num_ports + p];
+            if ( rp.first == -1 ) continue;
+            if ( rp.first >= num_routers || rp.second >= num_ports ||
+                 remote[rp.first * num_ports + rp.second] != std::make_pair(r,p) ) {
+                if ( mismatched < max_cycles_reported ) {
+                    report->output("ERROR: router %d, port %d connects to router %d, port %d, which does not connect back\n",
+                                   r, p, rp.first, rp.second);
+                }
+                mismatched++;
+            }
+        }
+    }
+
+    report->output("route_check: %d routers, %d ports, %d endpoints, %d VNs (%d VCs)\n",
+                   num_routers, num_ports, (int)endpoints.size(), num_vns, num_vcs);
+    if ( missing ) {
+        report->output("WARNING: %d router to router ports have no known remote port and will be treated as unconnected\n",
+                       missing);
+    }
+    if ( mismatched ) {
+        report->output("ERROR: %d asymmetric router to router links\n", mismatched);
+    }
+}
+
+
+void route_check::checkRoutes()
+{
+    ChannelDeps deps;
+    std::vector<uint64_t> hop_hist(max_hops + 2, 0);
+    std::vector<uint64_t> link_load(num_routers * num_ports, 0);
+
+    uint64_t routes = 0;
+    uint64_t unreachable = 0;
+    uint64_t misdelivered = 0;
+    uint64_t loops = 0;
+    uint64_t vn_violations = 0;
+
+    int num_eps = endpoints.size();
+    for ( int vn = 0; vn < num_vns; ++vn ) {
+        int vc_low = vn_start_vc[vn];
+        int vc_high = vc_low + vcs_per_vn[vn];
+        for ( int src = 0; src < num_eps; ++src ) {
+            if ( endpoints[src].first == -1 ) continue;
+            for ( int dest = 0; dest < num_eps; ++dest ) {
+                if ( endpoints[dest].first == -1 ) continue;
+                for ( int s = 0; s < samples; ++s ) {
+                    SimpleNetwork::Request* req = new SimpleNetwork::Request(dest, src, 64, true, true);
+                    req->vn = vn;
+                    RtrEvent* rtr_ev = new RtrEvent(req, src, vn);
+                    rtr_ev->computeSizeInFlits(64);
+
+                    int rtr = endpoints[src].first;
+                    int in_port = endpoints[src].second;
+                    internal_router_event* ev = topos[rtr]->process_input(rtr_ev);
+                    ev->setCreditReturnVC(vn);
+
+                    uint64_t prev_channel = (uint64_t)-1;
+                    int hops = 0;
+                    routes++;
+                    while ( true ) {
+                        topos[rtr]->route_packet(in_port, ev->getVC(), ev);
+                        int out_port = ev->getNextPort();
+                        int out_vc = ev->getVC();
+
+                        if ( out_port < 0 || out_port >= num_ports ) {
+                            unreachable++;
+                            if ( unreachable <= (uint64_t)max_cycles_reported ) {
+                                report->output("ERROR: %d -> %d (vn %d): router %d returned invalid port %d\n",
+                                               src, dest, vn, rtr, out_port);
+                            }
+                            break;
+                        }
+                        if ( out_vc < vc_low || out_vc >= vc_high ) {
+                            vn_violations++;
+                            if ( vn_violations <= (uint64_t)max_cycles_reported ) {
+                                report->output("ERROR: %d -> %d (vn %d): router %d moved packet to VC %d outside of the VN\n",
+                                               src, dest, vn, rtr, out_vc);
+                            }
+                        }
+
+                        Topology::PortState state = topos[rtr]->getPortState(out_port);
+                        if ( state == Topology::R2N ) {
+                            if ( topos[rtr]->getEndpointID(out_port) != dest ) {
+                                misdelivered++;
+                                if ( misdelivered <= (uint64_t)max_cycles_reported ) {
+                                    report->output("ERROR: %d -> %d (vn %d): delivered to endpoint %d\n",
+                                                   src, dest, vn, topos[rtr]->getEndpointID(out_port));
+                                }
+                            }
+                            else {
+                                hop_hist[hops]++;
+                            }
+                            break;
+                        }
+
+                        const std::pair<int,int>& next = remote[rtr * num_ports + out_port];
+                        if ( state != Topology::R2R || next.first == -1 ) {
+                            unreachable++;
+                            if ( unreachable <= (uint64_t)max_cycles_reported ) {
+                                report->output("ERROR: %d -> %d (vn %d): router %d routed to unconnected port %d\n",
+                                               src, dest, vn, rtr, out_port);
+                            }
+                            break;
+                        }
+
+                        uint64_t channel = channelID(rtr, out_port, out_vc);
+                        if ( prev_channel != (uint64_t)-1 ) {
+                            deps[prev_channel].insert(channel);
+                        }
+                        prev_channel = channel;
+                        link_load[rtr * num_ports + out_port]++;
+
+                        rtr = next.first;
+                        in_port = next.second;
+                        hops++;
+                        if ( hops > max_hops ) {
+                            loops++;
+                            if ( loops <= (uint64_t)max_cycles_reported ) {
+                                report->output("ERROR: %d -> %d (vn %d): route exceeded %d hops\n",
+                                               src, dest, vn, max_hops);
+                            }
+                            break;
+                        }
+                    }
+                    delete ev;
+                }
+            }
+        }
+    }
+
+    report->output("\nRoutes checked: %" PRIu64 "\n", routes);
+    report->output("  unreachable:        %" PRIu64 "\n", unreachable);
+    report->output("  misdelivered:       %" PRIu64 "\n", misdelivered);
+    report->output("  routing loops:      %" PRIu64 "\n", loops);
+    report->output("  VN violations:      %" PRIu64 "\n", vn_violations);
+
+    report->output("\nPath length histogram (router to router hops):\n");
+    double total_hops = 0;
+    uint64_t delivered = 0;
+    for ( int i = 0; i <= max_hops; ++i ) {
+        if ( hop_hist[i] == 0 ) continue;
+        report->output("  %3d: %" PRIu64 "\n", i, hop_hist[i]);
+        total_hops += (double)i * hop_hist[i];
+        delivered += hop_hist[i];
+    }
+    if ( delivered ) report->output("  average: %.3f\n", total_hops / delivered);
+
+    // Link load balance over all connected router to router links
+    uint64_t min_load = (uint64_t)-1;
+    uint64_t max_load = 0;
+    uint64_t unused = 0;
+    double sum = 0;
+    double sum_sq = 0;
+    int links = 0;
+    for ( int i = 0; i < num_routers * num_ports; ++i ) {
+        if ( remote[i].first == -1 ) continue;
+        uint64_t load = link_load[i];
+        if ( load < min_load ) min_load = load;
+        if ( load > max_load ) max_load = load;
+        if ( load == 0 ) unused++;
+        sum += load;
+        sum_sq += (double)load * load;
+        links++;
+    }
+    if ( links ) {
+        double mean = sum / links;
+        double stddev = std::sqrt(std::max(0.0, sum_sq / links - mean * mean));
+        report->output("\nLink load (routes per router to router link, %d links):\n", links);
+        report->output("  min = %" PRIu64 ", max = %" PRIu64 ", mean = %.2f, stddev = %.2f, max/mean = %.3f, unused = %" PRIu64 "\n",
+                       min_load, max_load, mean, stddev, mean > 0 ? max_load / mean : 0.0, unused);
+    }
+
+    findCycles(deps);
+}
+
+
+void route_check::findCycles(const ChannelDeps& deps)
+{
+    // Give every channel that appears in the dependency graph a dense
+    // index.  Channels are sorted so the report does not depend on
+    // the hash order.
+    std::unordered_set<uint64_t> seen;
+    std::vector<uint64_t> channels;
+    for ( auto& x : deps ) {
+        if ( seen.insert(x.first).second ) channels.push_back(x.first);
+        for ( auto y : x.second ) {
+            if ( seen.insert(y).second ) channels.push_back(y);
+        }
+    }
+    std::sort(channels.begin(), channels.end());
+
+    std::unordered_map<uint64_t,int> index;
+    for ( size_t i = 0; i < channels.size(); ++i ) index[channels[i]] = i;
+
+    int n = channels.size();
+    std::vector<std::vector<int> > adj(n);
+    std::vector<bool> self_loop(n, false);
+    uint64_t num_edges = 0;
+    for ( int from = 0; from < n; ++from ) {
+        auto dep = deps.find(channels[from]);
+        if ( dep == deps.end() ) continue;
+        for ( auto y : dep->second ) {
+            int to = index[y];
+            if ( to == from ) self_loop[from] = true;
+            adj[from].push_back(to);
+            num_edges++;
+        }
+        std::sort(adj[from].begin(), adj[from].end());
+    }
+
+    report->output("\nChannel dependency graph: %d channels, %" PRIu64 " dependencies\n", n, num_edges);
+
+    // Iterative Tarjan's algorithm to find the strongly connected
+    // components.  Any component with more than one channel (or a
+    // channel that depends on itself) is a potential deadlock.
+    std::vector<int> order(n, -1);
+    std::vector<int> low(n, 0);
+    std::vector<int> comp(n, -1);
+    std::vector<bool> on_stack(n, false);
+    std::vector<int> stack;
+    std::vector<std::pair<int,size_t> > call_stack;
+    int next_order = 0;
+    int num_comps = 0;
+    std::vector<int> cyclic_comps;
+
+    for ( int start = 0; start < n; ++start ) {
+        if ( order[start] != -1 ) continue;
+        call_stack.push_back(std::make_pair(start, 0));
+        order[start] = low[start] = next_order++;
+        stack.push_back(start);
+        on_stack[start] = true;
+
+        while ( !call_stack.empty() ) {
+            int v = call_stack.back().first;
+            size_t& edge = call_stack.back().second;
+            if ( edge < adj[v].size() ) {
+                int w = adj[v][edge++];
+                if ( order[w] == -1 ) {
+                    order[w] = low[w] = next_order++;
+                    stack.push_back(w);
+                    on_stack[w] = true;
+                    call_stack.push_back(std::make_pair(w, 0));
+                }
+                else if ( on_stack[w] ) {
+                    low[v] = std::min(low[v], order[w]);
+                }
+                continue;
+            }
+
+            // Done with v
+            call_stack.pop_back();
+            if ( !call_stack.empty() ) {
+                int parent = call_stack.back().first;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+            if ( low[v] != order[v] ) continue;
+
+            int size = 0;
+            int w;
+            do {
+                w = stack.back();
+                stack.pop_back();
+                on_stack[w] = false;
+                comp[w] = num_comps;
+                size++;
+            } while ( w != v );
+
+            if ( size > 1 || self_loop[v] ) cyclic_comps.push_back(v);
+            num_comps++;
+        }
+    }
+
+    if ( cyclic_comps.empty() ) {
+        report->output("No channel dependency cycles found.  Routing is deadlock free.\n");
+        return;
+    }
+
+    report->output("ERROR: found %d strongly connected components with dependency cycles.  Routing may deadlock.\n",
+                   (int)cyclic_comps.size());
+
+    // Print one cycle from each cyclic component using a BFS
+    // restricted to the component
+    int printed = 0;
+    for ( int root : cyclic_comps ) {
+        if ( printed++ >= max_cycles_reported ) break;
+        std::vector<int> parent(n, -2);
+        std::vector<int> queue;
+        queue.push_back(root);
+        parent[root] = -1;
+        int last = -1;
+        for ( size_t q = 0; q < queue.size() && last == -1; ++q ) {
+            int v = queue[q];
+            for ( int w : adj[v] ) {
+                if ( comp[w] != comp[root] ) continue;
+                if ( w == root ) {
+                    last = v;
+                    break;
+                }
+                if ( parent[w] == -2 ) {
+                    parent[w] = v;
+                    queue.push_back(w);
+                }
+            }
+        }
+
+        std::vector<int> cycle;
+        for ( int v = last; v != -1; v = parent[v] ) cycle.push_back(v);
+        report->output("  Cycle %d (%d channels):\n", printed, (int)cycle.size());
+        for ( auto it = cycle.rbegin(); it != cycle.rend(); ++it ) {
+            printChannel(channels[*it]);
+        }
+    }
+}
+
+
+void route_check::printChannel(uint64_t channel)
+{
+    int vc = channel % num_vcs;
+    uint64_t rp = channel / num_vcs;
+    int port = rp % num_ports;
+    int rtr = rp / num_ports;
+    const std::pair<int,int>& next = remote[rtr * num_ports + port];
+    report->output("    router %d, port %d, vc %d -> router %d, port %d\n", rtr, port, vc, next.first, next.second);
+}
+
+
+} // namespace Merlin
+} // namespace SST
@@ -0,0 +1,125 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TEST_ROUTE_CHECK_H
+#define COMPONENTS_MERLIN_TEST_ROUTE_CHECK_H
+
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+
+namespace SST {
+namespace Merlin {
+
+// Offline routing validator.  Instantiates the topology object for
+// every router in the network inside a single component, then walks
+// every src/dest route on every VN using only the topology's routing
+// logic.  No routers, links or endpoints are created, so the whole
+// check runs during setup() and the simulation ends at time zero.
+class route_check : public Component {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        route_check,
+        "merlin",
+        "route_check",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Offline routing validator.  Routes every src/dest pair through the topology objects, without "
+        "simulating traffic, and reports unreachable endpoints, channel dependency cycles, path lengths "
+        "and link load balance.",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"topology",        "Name of the topology subcomponent to check (e.g. merlin.dragonfly).  Parameters for "
+                            "the topology are passed using the topology. prefix."},
+        {"num_routers",     "Total number of routers in the network."},
+        {"num_ports",       "Number of ports on each router."},
+        {"num_vns",         "Number of VNs to check.", "1"},
+        {"samples",         "Number of times to route each src/dest pair.  Values greater than 1 are useful for "
+                            "routing algorithms that make random choices.", "1"},
+        {"max_hops",        "Routes longer than this number of router to router hops are reported as routing loops.", "64"},
+        {"credits",         "Number of credits to report in each output buffer to adaptive routing algorithms.", "32"},
+        {"max_cycles_reported", "Maximum number of channel dependency cycles to print.", "10"},
+        {"ignore_vcs",      "Treat all the VCs of a link as one channel when looking for dependency cycles.  Shows "
+                            "the cycles that the topology's VC assignment (e.g. torus datelines) breaks.", "false"},
+        {"output_file",     "File to write the report to.  Report is written to stdout if empty.", ""}
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"topology", "Topology objects, one per router.  Loaded anonymously.", "SST::Merlin::Topology" }
+    )
+
+private:
+
+    int num_routers;
+    int num_ports;
+    int num_vns;
+    int num_vcs;
+    int samples;
+    int max_hops;
+    int max_cycles_reported;
+    bool ignore_vcs;
+
+    std::vector<Topology*> topos;
+    std::vector<int> vcs_per_vn;
+    std::vector<int> vn_start_vc;
+
+    // Output buffer state given to the topology objects.  These never
+    // change, so adaptive algorithms see an idle network.
+    std::vector<int> credits;
+    std::vector<int> queue_lengths;
+
+    // Location of each endpoint: router id and port
+    std::vector<std::pair<int,int> > endpoints;
+
+    // Remote router and port for each router port
+    std::vector<std::pair<int,int> > remote;
+
+    Output* report;
+
+    // Channels each channel has a packet wait on
+    typedef std::unordered_map<uint64_t, std::unordered_set<uint64_t> > ChannelDeps;
+
+    inline uint64_t channelID(int rtr, int port, int vc) const {
+        return ((uint64_t)rtr * num_ports + port) * num_vcs + (ignore_vcs ? 0 : vc);
+    }
+
+    void discoverNetwork();
+    void checkRoutes();
+    void findCycles(const ChannelDeps& deps);
+    void printChannel(uint64_t channel);
+
+public:
+    route_check(ComponentId_t cid, Params& params);
+    ~route_check();
+
+    void setup();
+    void finish() {}
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TEST_ROUTE_CHECK_H
@@ -0,0 +1,30 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+
+# Same 4x4 torus, but with the two dateline VCs treated as one channel.
+# Minimal routing uses up to two hops in the positive direction of each
+# ring, so every row and column has a four channel dependency cycle:
+# 8 cycles in all.
+
+check = sst.Component("route_check", "merlin.route_check")
+check.addParams({
+    "topology" : "merlin.torus",
+    "num_routers" : 16,
+    "num_ports" : 5,
+    "topology.shape" : "4x4",
+    "topology.width" : "1x1",
+    "topology.local_ports" : 1,
+    "ignore_vcs" : "true",
+})
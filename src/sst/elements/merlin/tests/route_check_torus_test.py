@@ -0,0 +1,27 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+
+# Check every route on a 4x4 torus.  The dateline VCs make the routing
+# deadlock free, so no dependency cycles should be reported.
+
+check = sst.Component("route_check", "merlin.route_check")
+check.addParams({
+    "topology" : "merlin.torus",
+    "num_routers" : 16,
+    "num_ports" : 5,
+    "topology.shape" : "4x4",
+    "topology.width" : "1x1",
+    "topology.local_ports" : 1,
+})
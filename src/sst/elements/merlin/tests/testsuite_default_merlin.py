@@ -64,6 +64,9 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_torus_64(self):
          self.merlin_test_template("torus_64_test")
 
+    def test_merlin_torus_64_aggregate(self):
+         self.merlin_test_template("torus_64_aggregate_test", reftest="torus_64_test")
+
     def test_merlin_hyperx_128(self):
          self.merlin_test_template("hyperx_128_test")
 
@@ -76,10 +79,40 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_dragon_128_fl(self):
         self.merlin_test_template("dragon_128_test_fl")
 
+    def test_merlin_torus_64_credit_batch(self):
+        outdir = self.get_test_output_run_dir()
+
+        # A threshold of 1 must not change anything
+        self.merlin_test_template("torus_64_credit_batch_1_test", cwd=outdir, reftest="torus_64_test")
+        self.credit_batch_template("torus_64_credit_batch_8_test", cwd=outdir)
+
+        sent_1, saved_1 = self.credit_batch_stats("{0}/credit_batch_1.csv".format(outdir))
+        sent_8, saved_8 = self.credit_batch_stats("{0}/credit_batch_8.csv".format(outdir))
+
+        self.assertEqual(saved_1, 0, "credit_batch_threshold=1 saved {0} credit events".format(saved_1))
+        self.assertTrue(saved_8 > 0, "credit_batch_threshold=8 saved no credit events")
+        self.assertTrue(sent_8 < sent_1, "credit_batch_threshold=8 sent {0} credit events, threshold=1 sent {1}".format(sent_8, sent_1))
+
+    def test_merlin_route_check_torus(self):
+        self.route_check_template("route_check_torus_test",
+                                  ["Routes checked: 256",
+                                   "  unreachable:        0",
+                                   "  misdelivered:       0",
+                                   "  routing loops:      0",
+                                   "  VN violations:      0",
+                                   "No channel dependency cycles found."])
+
+    def test_merlin_route_check_torus_novc(self):
+        self.route_check_template("route_check_torus_novc_test",
+                                  ["Routes checked: 256",
+                                   "  unreachable:        0",
+                                   "Channel dependency graph: 64 channels, 96 dependencies",
+                                   "ERROR: found 8 strongly connected components with dependency cycles."])
+
 
 #####
 
-    def merlin_test_template(self, testcase, cwd=False):
+    def merlin_test_template(self, testcase, cwd=False, reftest=None):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -89,13 +122,15 @@ class testcase_merlin_Component(SSTTestCase):
         testDataFileName="test_merlin_{0}".format(testcase)
 
         sdlfile = "{0}/{1}.py".format(test_path, testcase)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        reffile = "{0}/refFiles/test_merlin_{1}.out".format(test_path, reftest if reftest else testcase)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
 
         if cwd:
-            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=test_path)
+            # True runs in the test directory, a path runs there instead
+            run_dir = test_path if cwd is True else cwd
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=run_dir)
         else:
             self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
 
@@ -113,3 +148,60 @@ class testcase_merlin_Component(SSTTestCase):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+    # Every NIC must get all of its packets, the timing is allowed to change
+    def credit_batch_template(self, testcase, cwd):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=cwd)
+
+        with open(outfile, 'r') as f:
+            output = f.read()
+
+        self.assertEqual(output.count("received all packets"), 64, "Not every NIC received all of its packets in {0}".format(outfile))
+        self.assertFalse("didn't receive" in output, "A NIC reported missing packets in {0}".format(outfile))
+
+    # Totals of the credit_events_sent and credit_events_saved router statistics
+    def credit_batch_stats(self, csvfile):
+        sent = 0
+        saved = 0
+        with open(csvfile, 'r') as f:
+            header = [x.strip() for x in f.readline().split(",")]
+            name_col = header.index("StatisticName")
+            sum_col = header.index("Sum.u64")
+            for line in f:
+                fields = [x.strip() for x in line.split(",")]
+                if len(fields) <= sum_col:
+                    continue
+                if fields[name_col] == "credit_events_sent":
+                    sent += int(fields[sum_col])
+                elif fields[name_col] == "credit_events_saved":
+                    saved += int(fields[sum_col])
+        return sent, saved
+
+    # route_check prints a report rather than simulating traffic, so the
+    # parts that matter are checked instead of comparing a reference file
+    def route_check_template(self, testcase, expected):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile)
+
+        with open(outfile, 'r') as f:
+            output = f.read()
+
+        for line in expected:
+            self.assertTrue(line in output, "route_check output {0} is missing '{1}'".format(outfile, line))
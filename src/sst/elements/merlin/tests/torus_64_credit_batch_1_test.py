@@ -0,0 +1,59 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+from sst.merlin import *
+
+if __name__ == "__main__":
+
+    topo = topoTorus()
+    endPoint = TestEndPoint()
+
+
+    sst.merlin._params["torus.shape"] = "4x4x4"
+    sst.merlin._params["torus.width"] = "1x1x1"
+    sst.merlin._params["torus.local_ports"] = "1"
+    sst.merlin._params["num_dims"] = "3"
+
+
+    sst.merlin._params["link_bw"] = "4GB/s"
+    sst.merlin._params["link_lat"] = "20ns"
+    sst.merlin._params["flit_size"] = "8B"
+    sst.merlin._params["xbar_bw"] = "4GB/s"
+    sst.merlin._params["input_latency"] = "20ns"
+    sst.merlin._params["output_latency"] = "20ns"
+    sst.merlin._params["input_buf_size"] = "4kB"
+    sst.merlin._params["output_buf_size"] = "4kB"
+
+    #sst.merlin._params["checkerboard"] = "1"
+    sst.merlin._params["xbar_arb"] = "merlin.xbar_arb_lru"
+
+    # A threshold of 1 returns a credit for every packet, exactly as when
+    # batching is not configured, so the output must match torus_64_test.
+    sst.merlin._params["credit_batch_threshold"] = "1"
+    topo.topoOptKeys.extend(["credit_batch_threshold"])
+
+    topo.prepParams()
+    endPoint.prepParams()
+    topo.setEndPoint(endPoint)
+    topo.build()
+
+    # Credit event counts for the router ports, compared against the other
+    # threshold by the test suite
+    sst.setStatisticLoadLevel(1)
+    sst.setStatisticOutput("sst.statOutputCSV", {
+        "filepath" : "credit_batch_1.csv",
+        "separator" : ", "
+    })
+    sst.enableStatisticsForComponentType("merlin.hr_router", ["credit_events_sent", "credit_events_saved"],
+                                         {"type":"sst.AccumulatorStatistic","rate":"0ns"})
@@ -1048,6 +1048,34 @@ topo_dragonfly::getEndpointID(int port)
         (router_id * params.p /*hosts_per_rtr*/) + port;
 }
 
+std::pair<int,int>
+topo_dragonfly::getRemoteRouterPort(int port)
+{
+    if ( is_port_endpoint(port) ) return std::make_pair(-1,-1);
+
+    if ( is_port_local_group(port) ) {
+        uint32_t router = port - params.p;
+        if ( router >= router_id ) router++;
+        int remote_port = params.p + router_id;
+        if ( router_id > router ) remote_port--;
+        return std::make_pair(group_id * params.a + router, remote_port);
+    }
+
+    // Global port.  Search the global link map for the group and
+    // slice that uses this port, then look up the port used for the
+    // same slice in the other direction.
+    for ( uint32_t group = 0; group < params.g; group++ ) {
+        if ( group == group_id ) continue;
+        for ( uint32_t slice = 0; slice < params.n; slice++ ) {
+            const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,slice);
+            if ( pair.router != router_id || pair.port != port ) continue;
+            const RouterPortPair& remote = group_to_global_port.getRouterPortPairForGroup(group, group_id, slice);
+            return std::make_pair(group * params.a + remote.router, remote.port);
+        }
+    }
+    return std::make_pair(-1,-1);
+}
+
 void
 topo_dragonfly::setOutputBufferCreditArray(int const* array, int vcs)
 {
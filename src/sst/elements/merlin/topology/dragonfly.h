@@ -270,6 +270,7 @@ public:
     }
 
     virtual int getEndpointID(int port);
+    virtual std::pair<int,int> getRemoteRouterPort(int port);
 
     virtual void setOutputBufferCreditArray(int const* array, int vcs);
     virtual void setOutputQueueLengthsArray(int const* array, int vcs);
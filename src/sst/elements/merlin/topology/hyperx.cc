@@ -347,6 +347,32 @@ topo_hyperx::getEndpointID(int port)
     return (router_id * num_local_ports) + (port - local_port_start);
 }
 
+std::pair<int,int>
+topo_hyperx::getRemoteRouterPort(int port)
+{
+    if ( port >= local_port_start ) return std::make_pair(-1,-1);
+
+    int dim = dimensions - 1;
+    while ( port < port_start[dim] ) dim--;
+
+    // Ports in a dimension are ordered by the location of the router
+    // they connect to (skipping our own), with width links to each
+    int offset = port - port_start[dim];
+    int remote_loc = offset / dim_width[dim];
+    int link = offset % dim_width[dim];
+    if ( remote_loc >= id_loc[dim] ) remote_loc++;
+
+    int remote_id = 0;
+    int mult = 1;
+    for ( int i = 0; i < dimensions; i++ ) {
+        remote_id += (i == dim ? remote_loc : id_loc[i]) * mult;
+        mult *= dim_size[i];
+    }
+
+    int my_index = id_loc[dim] - ((id_loc[dim] > remote_loc) ? 1 : 0);
+    return std::make_pair(remote_id, port_start[dim] + my_index * dim_width[dim] + link);
+}
+
 void
 topo_hyperx::setOutputBufferCreditArray(int const* array, int vcs)
 {
@@ -224,6 +224,7 @@ public:
 
     virtual PortState getPortState(int port) const;
     virtual int getEndpointID(int port);
+    virtual std::pair<int,int> getRemoteRouterPort(int port);
 
     virtual void setOutputBufferCreditArray(int const* array, int vcs);
     virtual void setOutputQueueLengthsArray(int const* array, int vcs);
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <stdlib.h>
+#include <vector>
 
 
 
@@ -248,6 +249,18 @@ topo_mesh::idToLocation(int run_id, int *location) const
 	location[0] = run_id;
 }
 
+int
+topo_mesh::locationToId(const int *location) const
+{
+    int id = 0;
+    int mult = 1;
+    for ( int i = 0; i < dimensions; i++ ) {
+        id += location[i] * mult;
+        mult *= dim_size[i];
+    }
+    return id;
+}
+
 void
 topo_mesh::parseDimString(const std::string &shape, int *output) const
 {
@@ -293,3 +306,34 @@ topo_mesh::getEndpointID(int port)
     return (router_id * num_local_ports) + (port - local_port_start);
 }
 
+std::pair<int,int>
+topo_mesh::getRemoteRouterPort(int port)
+{
+    std::pair<int,int> ret(-1,-1);
+    if ( port >= local_port_start ) return ret;
+
+    // Positive links connect to the matching negative link on the
+    // next router in the dimension and vice versa
+    std::vector<int> loc(dimensions);
+    for ( int dim = 0; dim < dimensions; dim++ ) {
+        for ( int dir = 0; dir < 2; dir++ ) {
+            int offset = port - port_start[dim][dir];
+            if ( offset < 0 || offset >= dim_width[dim] ) continue;
+
+            loc.assign(id_loc, id_loc + dimensions);
+            if ( dir == 0 ) {
+                if ( loc[dim] == dim_size[dim] - 1 ) break;
+                loc[dim]++;
+            }
+            else {
+                if ( loc[dim] == 0 ) break;
+                loc[dim]--;
+            }
+            ret.first = locationToId(loc.data());
+            ret.second = port_start[dim][dir ^ 1] + offset;
+            break;
+        }
+        if ( ret.first != -1 ) break;
+    }
+    return ret;
+}
@@ -151,6 +151,7 @@ public:
 
     virtual PortState getPortState(int port) const;
     virtual int getEndpointID(int port);
+    virtual std::pair<int,int> getRemoteRouterPort(int port);
 
     virtual void getVCsPerVN(std::vector<int>& vcs_per_vn) {
         for ( int i = 0; i < num_vns; ++i ) {
@@ -163,6 +164,7 @@ protected:
 
 private:
     void idToLocation(int id, int *location) const;
+    int locationToId(const int *location) const;
     void parseDimString(const std::string &shape, int *output) const;
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
@@ -81,13 +81,16 @@ class topoDragonFly(Topology):
         num_ports = self.routers_per_group - 1 + self.hosts_per_router + intergroup_per_router
 
 
+        # A link is dropped from the dict once both of its routers have it
         links = dict()
 
         #####################
         def getLink(name):
-            if name not in links:
-                links[name] = sst.Link(name)
-            return links[name]
+            link = links.pop(name,None)
+            if link is None:
+                link = sst.Link(name)
+                links[name] = link
+            return link
         #####################
 
         rpg = self.routers_per_group
@@ -153,18 +156,26 @@ class topoDragonFly(Topology):
         #########################
 
 
+        # Attribute reads go through __getattr__, so keep them out of
+        # the loops
+        hosts_per_router = self.hosts_per_router
+        link_latency = self.link_latency
+        host_link_latency = self.host_link_latency
+        slot_name = self.router.getTopologySlotName()
+        param_set = "params_%s"%self._instance_name
+
         router_num = 0
         nic_num = 0
         # GROUPS
         for g in range(self.num_groups):
             # GROUP ROUTERS
-            for r in range(self.routers_per_group):
+            for r in range(rpg):
                 rtr = self._instanceRouter(num_ports,router_num)
 
                 # Insert the topology object
-                sub = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.dragonfly",0)
+                sub = rtr.setSubComponent(slot_name,"merlin.dragonfly",0)
                 self._applyStatisticsSettings(sub)
-                sub.addGlobalParamSet("params_%s"%self._instance_name)
+                sub.addGlobalParamSet(param_set)
                 sub.addParam("intergroup_per_router",intergroup_per_router)
                 if router_num == 0:
                     # Need to send in the global_port_map
@@ -173,29 +184,29 @@ class topoDragonFly(Topology):
                     sub.addParam("global_link_map",self.global_link_map)
 
                 port = 0
-                for p in range(self.hosts_per_router):
+                for p in range(hosts_per_router):
                     #(nic, port_name) = endpoint.build(nic_num, {"num_peers":num_peers})
                     (nic, port_name) = endpoint.build(nic_num, {})
                     if nic:
                         link = sst.Link("link_g%dr%dh%d"%(g, r, p))
                         #network_interface.build(nic,slot,0,link,self.host_link_latency)
-                        link.connect( (nic, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
+                        link.connect( (nic, port_name, host_link_latency), (rtr, "port%d"%port, host_link_latency) )
                         #link.setNoCut()
                         #rtr.addLink(link,"port%d"%port,self.host_link_latency)
                     nic_num = nic_num + 1
                     port = port + 1
 
-                for p in range(self.routers_per_group):
+                for p in range(rpg):
                     if p != r:
                         src = min(p,r)
                         dst = max(p,r)
-                        rtr.addLink(getLink("link_g%dr%dr%d"%(g, src, dst)), "port%d"%port, self.link_latency)
+                        rtr.addLink(getLink("link_g%dr%dr%d"%(g, src, dst)), "port%d"%port, link_latency)
                         port = port + 1
 
                 for p in range(igpr):
                     link = getGlobalLink(g,r,p)
                     if link is not None:
-                        rtr.addLink(link,"port%d"%port, self.link_latency)
+                        rtr.addLink(link,"port%d"%port, link_latency)
                     port = port +1
 
                 router_num = router_num + 1
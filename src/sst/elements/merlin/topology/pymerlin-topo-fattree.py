@@ -114,9 +114,12 @@ class topoFatTree(Topology):
     
     
     def build(self, endpoint):
+        if self._check_first_build():
+            sst.addGlobalParams("params_%s"%self._instance_name, self._getGroupParams("main"))
 
         if not self.host_link_latency:
             self.host_link_latency = self.link_latency
+        param_set = "params_%s"%self._instance_name
         
         #Recursive function to build levels
         def fattree_rb(self, level, group, links):
@@ -143,7 +146,7 @@ class topoFatTree(Topology):
                 
                 topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.fattree")
                 self._applyStatisticsSettings(topology)
-                topology.addParams(self._getGroupParams("main"))
+                topology.addGlobalParamSet(param_set)
                 # Add links
                 for l in range(len(host_links)):
                     rtr.addLink(host_links[l],"port%d"%l, self.link_latency)
@@ -178,7 +181,7 @@ class topoFatTree(Topology):
 
                 topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.fattree")
                 self._applyStatisticsSettings(topology)
-                topology.addParams(self._getGroupParams("main"))
+                topology.addGlobalParamSet(param_set)
                 # Add links
                 for l in range(len(rtr_links[i])):
                     rtr.addLink(rtr_links[i][l],"port%d"%l, self.link_latency)
@@ -213,7 +216,7 @@ class topoFatTree(Topology):
 
                 topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.fattree",0)
                 self._applyStatisticsSettings(topology)
-                topology.addParams(self._getGroupParams("main"))
+                topology.addGlobalParamSet(param_set)
 
                 for l in range(len(rtr_links[i])):
                     rtr.addLink(rtr_links[i][l], "port%d"%l, self.link_latency)
@@ -108,12 +108,22 @@ class topoHyperX(Topology):
         
     
     def build(self, endpoint):
+        if self._check_first_build():
+            sst.addGlobalParams("params_%s"%self._instance_name, self._getGroupParams("main"))
+
         if self.host_link_latency is None:
             self.host_link_latency = self.link_latency
 
-        # get some local variables from the parameters
+        # get some local variables from the parameters.  Attribute
+        # reads go through __getattr__, so keep them out of the loops
         local_ports = int(self.local_ports)
         num_dims = len(self._dim_size)
+        dim_size = self._dim_size
+        dim_width = self._dim_width
+        link_latency = self.link_latency
+        host_link_latency = self.host_link_latency
+        slot_name = self.router.getTopologySlotName()
+        param_set = "params_%s"%self._instance_name
         
         
         # Calculate number of routers and endpoints
@@ -127,6 +137,7 @@ class topoHyperX(Topology):
         for x in range(num_dims):
             radix += (self._dim_width[x] * (self._dim_size[x]-1))
         
+        # A link is dropped from the dict once both of its routers have it
         links = dict()
         def getLink(name1, name2, num):
             # Sort name1 and name2 so order doesn't matter
@@ -134,10 +145,12 @@ class topoHyperX(Topology):
                 name = "link_%s_%s_%d"%(name1, name2, num)
             else:
                 name = "link_%s_%s_%d"%(name2, name1, num)
-            if name not in links:
-                links[name] = sst.Link(name)
+            link = links.pop(name,None)
+            if link is None:
+                link = sst.Link(name)
+                links[name] = link
             #print("Getting link with name: %s"%name)
-            return links[name]
+            return link
 
         # loop through the routers to hook up links
         for i in range(num_routers):
@@ -149,9 +162,9 @@ class topoHyperX(Topology):
 
             rtr = self._instanceRouter(radix,i)
 
-            topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.hyperx")
+            topology = rtr.setSubComponent(slot_name,"merlin.hyperx")
             self._applyStatisticsSettings(topology)
-            topology.addParams(self._getGroupParams("main"))
+            topology.addGlobalParamSet(param_set)
 
             port = 0
             # Connect to all routers that only differ in one location index
@@ -159,13 +172,13 @@ class topoHyperX(Topology):
                 theirdims = mydims[:]
 
                 # We have links to every other router in each dimension
-                for router in range(self._dim_size[dim]):
+                for router in range(dim_size[dim]):
                     if router != mydims[dim]: # no link to ourselves
                         theirdims[dim] = router
                         theirlocstr = self._formatShape(theirdims)
                         # Hook up "width" number of links for this dimension
-                        for num in range(self._dim_width[dim]):
-                            rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, self.link_latency)
+                        for num in range(dim_width[dim]):
+                            rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, link_latency)
                             #print("Wired up port %d"%port)
                             port = port + 1
 
@@ -177,7 +190,7 @@ class topoHyperX(Topology):
                     nicLink = sst.Link("nic_%d_%d"%(i, n))
                     if self.bundleEndpoints:
                        nicLink.setNoCut()
-                    nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
+                    nicLink.connect( (ep, port_name, host_link_latency), (rtr, "port%d"%port, host_link_latency) )
                 port = port+1
 
 
@@ -107,12 +107,24 @@ class _topoMeshBase(Topology):
         return sst.findComponentByName(self.getRouterNameForLocation(location))
         
     def build(self, endpoint):
+        if self._check_first_build():
+            sst.addGlobalParams("params_%s"%self._instance_name, self._getGroupParams("main"))
+
         if self.host_link_latency is None:
             self.host_link_latency = self.link_latency
         
-        # get some local variables from the parameters
+        # get some local variables from the parameters.  Attribute
+        # reads go through __getattr__, so keep them out of the loops
         local_ports = int(self.local_ports)
         num_dims = len(self._dim_size)
+        dim_size = self._dim_size
+        dim_width = self._dim_width
+        link_latency = self.link_latency
+        host_link_latency = self.host_link_latency
+        include_wrap = self._includeWrapLinks()
+        topo_name = self._getTopologyName()
+        slot_name = self.router.getTopologySlotName()
+        param_set = "params_%s"%self._instance_name
 
         
 
@@ -128,12 +140,17 @@ class _topoMeshBase(Topology):
             radix = radix + (self._dim_width[x] * 2)
             
         
+        # Each link is requested once by each of the two routers it
+        # connects.  It is dropped on the second request so that only
+        # the links on the frontier of the build are held in the dict.
         links = dict()
         def getLink(leftName, rightName, num):
             name = "link_%s_%s_%d"%(leftName, rightName, num)
-            if name not in links:
-                links[name] = sst.Link(name)
-            return links[name]
+            link = links.pop(name,None)
+            if link is None:
+                link = sst.Link(name)
+                links[name] = link
+            return link
 
         
         for i in range(num_routers):
@@ -143,33 +160,33 @@ class _topoMeshBase(Topology):
 
             rtr = self._instanceRouter(radix,i)
             
-            topology = rtr.setSubComponent(self.router.getTopologySlotName(),self._getTopologyName())
+            topology = rtr.setSubComponent(slot_name,topo_name)
             self._applyStatisticsSettings(topology)
-            topology.addParams(self._getGroupParams("main"))
+            topology.addGlobalParamSet(param_set)
 
             port = 0
             for dim in range(num_dims):
                 theirdims = mydims[:]
 
                 # Positive direction
-                if mydims[dim]+1 < self._dim_size[dim] or self._includeWrapLinks():
-                    theirdims[dim] = (mydims[dim] +1 ) % self._dim_size[dim]
+                if mydims[dim]+1 < dim_size[dim] or include_wrap:
+                    theirdims[dim] = (mydims[dim] +1 ) % dim_size[dim]
                     theirlocstr = self._formatShape(theirdims)
-                    for num in range(self._dim_width[dim]):
-                        rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, self.link_latency)
+                    for num in range(dim_width[dim]):
+                        rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, link_latency)
                         port = port+1
                 else:
-                    port += self._dim_width[dim]
+                    port += dim_width[dim]
 
                 # Negative direction
-                if mydims[dim] > 0 or self._includeWrapLinks():
-                    theirdims[dim] = ((mydims[dim] -1) + self._dim_size[dim]) % self._dim_size[dim]
+                if mydims[dim] > 0 or include_wrap:
+                    theirdims[dim] = ((mydims[dim] -1) + dim_size[dim]) % dim_size[dim]
                     theirlocstr = self._formatShape(theirdims)
-                    for num in range(self._dim_width[dim]):
-                        rtr.addLink(getLink(theirlocstr, mylocstr, num), "port%d"%port, self.link_latency)
+                    for num in range(dim_width[dim]):
+                        rtr.addLink(getLink(theirlocstr, mylocstr, num), "port%d"%port, link_latency)
                         port = port+1
                 else:
-                    port += self._dim_width[dim]
+                    port += dim_width[dim]
 
             for n in range(local_ports):
                 nodeID = local_ports * i + n
@@ -178,7 +195,7 @@ class _topoMeshBase(Topology):
                     nicLink = sst.Link("nic.%d:%d"%(i, n))
                     if self.bundleEndpoints:
                        nicLink.setNoCut()
-                    nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
+                    nicLink.connect( (ep, port_name, host_link_latency), (rtr, "port%d"%port, host_link_latency) )
                 port = port+1
 
 
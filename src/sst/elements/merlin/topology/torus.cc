@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <stdlib.h>
+#include <vector>
 
 
 
@@ -239,6 +240,18 @@ topo_torus::idToLocation(int run_id, int *location) const
 	location[0] = run_id;
 }
 
+int
+topo_torus::locationToId(const int *location) const
+{
+    int id = 0;
+    int mult = 1;
+    for ( int i = 0; i < dimensions; i++ ) {
+        id += location[i] * mult;
+        mult *= dim_size[i];
+    }
+    return id;
+}
+
 void
 topo_torus::parseDimString(const std::string &shape, int *output) const
 {
@@ -284,4 +297,28 @@ topo_torus::getEndpointID(int port)
     return (router_id * num_local_ports) + (port - local_port_start);
 }
 
-
+std::pair<int,int>
+topo_torus::getRemoteRouterPort(int port)
+{
+    std::pair<int,int> ret(-1,-1);
+    if ( port >= local_port_start ) return ret;
+
+    // Positive links connect to the matching negative link on the
+    // next router in the dimension and vice versa
+    std::vector<int> loc(dimensions);
+    for ( int dim = 0; dim < dimensions; dim++ ) {
+        for ( int dir = 0; dir < 2; dir++ ) {
+            int offset = port - port_start[dim][dir];
+            if ( offset < 0 || offset >= dim_width[dim] ) continue;
+
+            loc.assign(id_loc, id_loc + dimensions);
+            if ( dir == 0 ) loc[dim] = (loc[dim] + 1) % dim_size[dim];
+            else loc[dim] = (loc[dim] + dim_size[dim] - 1) % dim_size[dim];
+            ret.first = locationToId(loc.data());
+            ret.second = port_start[dim][dir ^ 1] + offset;
+            break;
+        }
+        if ( ret.first != -1 ) break;
+    }
+    return ret;
+}
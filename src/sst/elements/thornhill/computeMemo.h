@@ -0,0 +1,132 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_THORNHILL_COMPUTE_MEMO
+#define _H_THORNHILL_COMPUTE_MEMO
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sst/core/params.h>
+#include <sst/core/rng/marsaglia.h>
+
+namespace SST {
+namespace Thornhill {
+
+// Durations measured by running a detailed compute model, keyed by the
+// work that was run. Once a key has been measured often enough the recorded
+// durations are replayed instead of running the model again. The table is
+// either private to one model or shared by every model in the process that
+// asks for it, so identical work on different cores calibrates once. A
+// shared table is filled in whatever order the process's threads run the
+// models, so it is only deterministic for a given rank and thread layout.
+class ComputeMemo {
+
+  public:
+	typedef std::deque< std::pair< std::string, SST::Params > > Work;
+
+	ComputeMemo( bool shared, uint32_t samples, bool variance, uint32_t seed ) :
+		m_table( shared ? sharedTable() : &m_privateTable ),
+		m_lock( shared ? sharedLock() : m_privateLock ),
+		m_samples( samples ), m_variance( variance ),
+		m_rng( seed + 1, 200009011 )
+	{}
+
+	// Name the work, including the cache state it starts from: warm when
+	// this model last ran the same work, cold otherwise
+	std::string key( const Work& work ) {
+		std::stringstream ss;
+
+		for ( Work::const_iterator iter = work.begin(); iter != work.end(); ++iter ) {
+			ss << iter->first << '{';
+
+			std::set<std::string> keys = iter->second.getKeys();
+			for ( std::set<std::string>::iterator key = keys.begin(); key != keys.end(); ++key ) {
+				ss << *key << '=' << iter->second.find<std::string>( *key ) << ';';
+			}
+			ss << '}';
+		}
+
+		std::string work_key = ss.str();
+		bool warm = ( work_key == m_lastWork );
+		m_lastWork = work_key;
+
+		return work_key + ( warm ? "warm" : "cold" );
+	}
+
+	// Returns true, with the duration to replay, once the key has enough samples
+	bool lookup( const std::string& key, uint64_t& duration ) {
+		std::lock_guard<std::mutex> lock( m_lock );
+
+		std::map< std::string, std::vector<uint64_t> >::iterator iter = m_table->find( key );
+		if ( iter == m_table->end() || iter->second.size() < m_samples ) {
+			return false;
+		}
+
+		std::vector<uint64_t>& measured = iter->second;
+
+		if ( m_variance ) {
+			duration = measured[ m_rng.generateNextUInt32() % measured.size() ];
+		} else {
+			uint64_t total = 0;
+			for ( size_t i = 0; i < measured.size(); i++ ) {
+				total += measured[i];
+			}
+			duration = total / measured.size();
+		}
+		return true;
+	}
+
+	void record( const std::string& key, uint64_t duration ) {
+		std::lock_guard<std::mutex> lock( m_lock );
+
+		std::vector<uint64_t>& measured = (*m_table)[key];
+		if ( measured.size() < m_samples ) {
+			measured.push_back( duration );
+		}
+	}
+
+  private:
+	typedef std::map< std::string, std::vector<uint64_t> > Table;
+
+	static Table* sharedTable() {
+		static Table table;
+		return &table;
+	}
+
+	static std::mutex& sharedLock() {
+		static std::mutex lock;
+		return lock;
+	}
+
+	Table			m_privateTable;
+	std::mutex		m_privateLock;
+	Table*			m_table;
+	std::mutex&		m_lock;
+	uint32_t		m_samples;
+	bool			m_variance;
+	SST::RNG::MarsagliaRNG m_rng;
+	std::string		m_lastWork;
+};
+
+}
+}
+
+#endif
@@ -28,7 +28,7 @@ using namespace SST::Thornhill;
 
 SingleThread::SingleThread( ComponentId_t id,
         Params& params )
-        : DetailedCompute( id ), m_link(NULL), m_busy(false)
+        : DetailedCompute( id ), m_busy(false), m_link(NULL), m_replayLink(NULL), m_memo(NULL)
 {
     std::string portName = params.find<std::string>( "portName", "detailed0" );
 
@@ -38,6 +38,20 @@ SingleThread::SingleThread( ComponentId_t id,
                     this,&SingleThread::eventHandler ) );
     }
     assert(m_link);
+
+    if ( params.find<bool>( "memoize", false ) ) {
+        m_memo = new ComputeMemo( params.find<bool>( "memoize.shared", false ),
+                    params.find<uint32_t>( "memoize.samples", 3 ),
+                    params.find<bool>( "memoize.variance", false ),
+                    params.find<uint32_t>( "memoize.seed", 0 ) );
+
+        m_replayLink = configureSelfLink( "MemoReplay", "1ps",
+            new Event::Handler<SingleThread>(
+                    this,&SingleThread::replayHandler ) );
+    }
+
+    m_statMemoHits = registerStatistic<uint64_t>( "memo_hits" );
+    m_statMemoMisses = registerStatistic<uint64_t>( "memo_misses" );
 }
 
 void SingleThread::eventHandler( SST::Event* ev )
@@ -45,6 +59,25 @@ void SingleThread::eventHandler( SST::Event* ev )
     MirandaRspEvent* event = static_cast<MirandaRspEvent*>(ev);
 
 	Entry* entry = static_cast<Entry*>((void*)event->key);
+	delete event;
+
+	if ( ! entry->memoKey.empty() ) {
+		m_memo->record( entry->memoKey, getCurrentSimTime( "1ps" ) - entry->start );
+	}
+	finished( entry );
+}
+
+void SingleThread::replayHandler( SST::Event* ev )
+{
+	ReplayEvent* event = static_cast<ReplayEvent*>(ev);
+	Entry* entry = event->entry;
+	delete event;
+
+	finished( entry );
+}
+
+void SingleThread::finished( Entry* entry )
+{
 	entry->finiHandler();
 	delete entry;
 	m_busy = false;
@@ -59,15 +92,32 @@ void SingleThread::start2( const std::deque< std::pair< std::string, SST::Params
                  std::function<int()> retHandler, std::function<int()> finiHandler )
 {
 	m_busy = true;
-	MirandaReqEvent* event = new MirandaReqEvent;
 
+	Entry* entry;
 	if ( finiHandler ) {
 		retHandler();
-		event->key = (uint64_t) new Entry( finiHandler );
+		entry = new Entry( finiHandler );
 	} else {
-		event->key = (uint64_t) new Entry( retHandler );
+		entry = new Entry( retHandler );
 	}
 
+	if ( m_memo ) {
+		std::string key = m_memo->key( generators );
+		uint64_t duration;
+
+		if ( m_memo->lookup( key, duration ) ) {
+			m_statMemoHits->addData(1);
+			m_replayLink->send( duration, new ReplayEvent( entry ) );
+			return;
+		}
+
+		m_statMemoMisses->addData(1);
+		entry->memoKey = key;
+		entry->start = getCurrentSimTime( "1ps" );
+	}
+
+	MirandaReqEvent* event = new MirandaReqEvent;
+	event->key = (uint64_t) entry;
 	event->generators = generators;
 
 	m_link->send( 0, event );
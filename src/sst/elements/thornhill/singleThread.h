@@ -18,6 +18,7 @@
 
 #include <queue>
 #include "detailedCompute.h"
+#include "computeMemo.h"
 
 namespace SST {
 namespace Thornhill {
@@ -35,19 +36,31 @@ class SingleThread : public DetailedCompute {
        	SST::Thornhill::SingleThread
     )
 	SST_ELI_DOCUMENT_PARAMS( 
-		{"portName","Sets the portname of the detailed compute model","detailed0"}
+		{"portName","Sets the portname of the detailed compute model","detailed0"},
+		{"memoize","Replay measured durations of repeated work instead of running the detailed model","false"},
+		{"memoize.samples","Number of detailed runs of a piece of work before its duration is replayed","3"},
+		{"memoize.variance","Replay a randomly chosen measured duration rather than their mean","false"},
+		{"memoize.shared","Share measured durations with every model in the process. Which models fill the table "
+			"depends on how components are placed on ranks and threads, so results can change with -n","false"},
+		{"memoize.seed","Seed for choosing a measured duration","0"},
+	)
+	SST_ELI_DOCUMENT_STATISTICS(
+		{ "memo_hits", "Work whose duration was replayed", "count", 1 },
+		{ "memo_misses", "Work run on the detailed model", "count", 1 },
 	)
 
 	struct Entry {
-      Entry( std::function<int()>& _finiHandler ) : finiHandler( _finiHandler ) {}
+      Entry( std::function<int()>& _finiHandler ) : finiHandler( _finiHandler ), start(0) {}
     	std::function<int()> finiHandler;
+		std::string memoKey;
+		uint64_t start;
 	};
 
   public:
 
     SingleThread( ComponentId_t id, Params& params );
 
-    ~SingleThread(){};
+    ~SingleThread(){ if ( m_memo ) delete m_memo; };
 
 	struct Pending {
 		Pending( std::deque< std::pair< std::string, SST::Params > >& work,
@@ -72,12 +85,26 @@ class SingleThread : public DetailedCompute {
 	}
 
   private:
+	class ReplayEvent : public SST::Event {
+	  public:
+		ReplayEvent( Entry* entry ) : Event(), entry( entry ) {}
+		Entry* entry;
+
+		NotSerializable(ReplayEvent)
+	};
+
 	bool m_busy;
 	std::queue<Pending> m_pendingQ;
     void eventHandler( SST::Event* ev );
+    void replayHandler( SST::Event* ev );
+    void finished( Entry* );
     void start2( const std::deque< std::pair< std::string, SST::Params > >&,
                  std::function<int()>, std::function<int()> );
     Link*  m_link;
+    Link*  m_replayLink;
+	ComputeMemo* m_memo;
+	Statistic<uint64_t>* m_statMemoHits;
+	Statistic<uint64_t>* m_statMemoMisses;
 };
 
 
@@ -73,6 +73,25 @@ public:
         }
     }
 
+    // Look up without changing the LRU order
+    T peek(const I& key) const { return data_values.find(key)->second; }
+
+    void erase(const I& key) {
+        auto find_key = data_values.find(key);
+
+        if (find_key != data_values.end()) {
+            delete find_key->second;
+            data_values.erase(find_key);
+
+            for (auto order_itr = ordering_q.begin(); order_itr != ordering_q.end(); order_itr++) {
+                if (key == (*order_itr)) {
+                    ordering_q.erase(order_itr);
+                    break;
+                }
+            }
+        }
+    }
+
     size_t size() const { return data_values.size(); }
     size_t capacity() const { return max_entries; }
 
@@ -0,0 +1,107 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_INST_POOL
+#define _H_VANADIS_INST_POOL
+
+#include <cstddef>
+#include <new>
+
+namespace SST {
+namespace Vanadis {
+
+// Recycles the memory used by dynamic instructions and their register
+// lists.  Every dynamic instruction is cloned from a decoded (or
+// cached) instruction and deleted at retire or on a pipeline flush,
+// so the same few object sizes are allocated and freed every cycle.
+// Freed blocks are kept on per-size free lists instead of going back
+// to malloc.  Lists are thread local so SST threads never share them.
+// Each list holds at most POOL_MAX_FREE blocks and anything freed past
+// that goes back to the heap, so a thread that frees blocks allocated
+// by another thread cannot make its pool grow without bound.
+class VanadisInstructionPool
+{
+public:
+    static void* allocate(const size_t size)
+    {
+        const size_t size_class = sizeClass(size);
+
+        if ( size_class >= POOL_SIZE_CLASSES ) { return ::operator new(size); }
+
+        FreeList& list = freeLists()[size_class];
+
+        if ( nullptr != list.head ) {
+            FreeBlock* block = list.head;
+            list.head        = block->next;
+            list.count--;
+            return block;
+        }
+
+        return ::operator new(size_class * POOL_GRANULE);
+    }
+
+    static void release(void* ptr, const size_t size)
+    {
+        if ( nullptr == ptr ) { return; }
+
+        const size_t size_class = sizeClass(size);
+
+        if ( size_class >= POOL_SIZE_CLASSES ) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        FreeList& list = freeLists()[size_class];
+
+        if ( list.count >= POOL_MAX_FREE ) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next      = list.head;
+        list.head        = block;
+        list.count++;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct FreeList
+    {
+        FreeBlock* head  = nullptr;
+        size_t     count = 0;
+    };
+
+    static constexpr size_t POOL_GRANULE      = 16;
+    static constexpr size_t POOL_SIZE_CLASSES = 64;
+    static constexpr size_t POOL_MAX_FREE     = 4096;
+
+    static size_t sizeClass(const size_t size) { return (size + POOL_GRANULE - 1) / POOL_GRANULE; }
+
+    static FreeList* freeLists()
+    {
+        static thread_local FreeList lists[POOL_SIZE_CLASSES];
+        return lists;
+    }
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
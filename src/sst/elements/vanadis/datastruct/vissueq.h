@@ -0,0 +1,329 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_ISSUE_QUEUE
+#define _H_VANADIS_ISSUE_QUEUE
+
+#include "datastruct/cqueue.h"
+#include "inst/vinst.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Wakeup/select view of a hardware thread's ROB.
+ *
+ * Every ROB entry is given a sequence number when it is dispatched, so the
+ * entry at ROB index i always has sequence number (head + i). For each ISA
+ * register the queue keeps the sequence numbers of the in-flight writers and
+ * of the readers which had not issued at the start of the cycle. An entry is
+ * blocked by a RAW hazard if the oldest writer of one of its sources is older
+ * than itself and by a WAR hazard if the oldest un-issued reader of one of its
+ * destinations is older than itself; these are exactly the conditions the ROB
+ * scan in performIssue computes with its per-cycle register temps.
+ *
+ * Entries which fail a hazard check park themselves on the register tag which
+ * blocked them and drop out of the ready bitmap. They are woken when the tag
+ * changes (the writer retires or the reader issues), so select only looks at
+ * entries which may be able to issue.
+ */
+class VanadisIssueQueue
+{
+public:
+    VanadisIssueQueue(VanadisCircularQueue<VanadisInstruction*>* thr_rob, const uint16_t isa_int_regs,
+        const uint16_t isa_fp_regs) :
+        rob(thr_rob),
+        slots(thr_rob->capacity()),
+        head_seq(0),
+        next_seq(0),
+        ready((thr_rob->capacity() + 63) / 64, 0),
+        issued_at_cycle_start(thr_rob->capacity(), false),
+        int_writers(isa_int_regs),
+        int_readers(isa_int_regs),
+        int_write_waiters(isa_int_regs),
+        int_read_waiters(isa_int_regs),
+        fp_writers(isa_fp_regs),
+        fp_readers(isa_fp_regs),
+        fp_write_waiters(isa_fp_regs),
+        fp_read_waiters(isa_fp_regs)
+    {}
+
+    // Pull in any entries the decoder has pushed on to the ROB since the
+    // last call.
+    void dispatch()
+    {
+        while ( (next_seq - head_seq) < rob->size() ) {
+            VanadisInstruction* ins = rob->peekAt(next_seq - head_seq);
+            const uint64_t      seq = next_seq++;
+
+            for ( uint16_t i = 0; i < ins->countISAIntRegOut(); ++i ) {
+                int_writers[ins->getISAIntRegOut(i)].push_back(seq);
+            }
+
+            for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+                fp_writers[ins->getISAFPRegOut(i)].push_back(seq);
+            }
+
+            for ( uint16_t i = 0; i < ins->countISAIntRegIn(); ++i ) {
+                int_readers[ins->getISAIntRegIn(i)].push_back(seq);
+            }
+
+            for ( uint16_t i = 0; i < ins->countISAFPRegIn(); ++i ) {
+                fp_readers[ins->getISAFPRegIn(i)].push_back(seq);
+            }
+
+            switch ( ins->getInstFuncType() ) {
+            case INST_LOAD:
+            case INST_STORE:
+                mem_ops.push_back(seq);
+                break;
+            case INST_FENCE:
+                fences.push_back(seq);
+                break;
+            default:
+                break;
+            }
+
+            issued_at_cycle_start[seq % slots] = ins->completedIssue();
+
+            if ( !ins->completedIssue() ) { setReady(seq); }
+        }
+    }
+
+    // The front of the ROB has been popped
+    void retire(VanadisInstruction* ins)
+    {
+        const uint64_t seq = head_seq++;
+
+        for ( uint16_t i = 0; i < ins->countISAIntRegOut(); ++i ) {
+            const uint16_t reg = ins->getISAIntRegOut(i);
+            assert(int_writers[reg].front() == seq);
+            int_writers[reg].pop_front();
+            wake(int_write_waiters[reg]);
+        }
+
+        for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+            const uint16_t reg = ins->getISAFPRegOut(i);
+            assert(fp_writers[reg].front() == seq);
+            fp_writers[reg].pop_front();
+            wake(fp_write_waiters[reg]);
+        }
+
+        if ( !fences.empty() && (fences.front() == seq) ) { fences.pop_front(); }
+
+        clearReady(seq);
+    }
+
+    // The ROB has been cleared after a misspeculation
+    void clear()
+    {
+        head_seq = next_seq;
+
+        std::fill(ready.begin(), ready.end(), 0);
+
+        for ( size_t i = 0; i < int_writers.size(); ++i ) {
+            int_writers[i].clear();
+            int_readers[i].clear();
+            int_write_waiters[i].clear();
+            int_read_waiters[i].clear();
+        }
+
+        for ( size_t i = 0; i < fp_writers.size(); ++i ) {
+            fp_writers[i].clear();
+            fp_readers[i].clear();
+            fp_write_waiters[i].clear();
+            fp_read_waiters[i].clear();
+        }
+
+        mem_ops.clear();
+        fences.clear();
+        issued_this_cycle.clear();
+    }
+
+    // Oldest ready entry with a sequence number of at least seq, returns
+    // end() if there are none
+    uint64_t nextReady(uint64_t seq) const
+    {
+        while ( seq < next_seq ) {
+            const size_t   slot = seq % slots;
+            const uint64_t bits = ready[slot / 64] >> (slot % 64);
+
+            if ( bits != 0 ) { return seq + __builtin_ctzll(bits); }
+
+            seq += std::min(64 - (slot % 64), slots - slot);
+        }
+
+        return next_seq;
+    }
+
+    uint64_t begin() const { return head_seq; }
+    uint64_t end() const { return next_seq; }
+
+    VanadisInstruction* getInstruction(const uint64_t seq) { return rob->peekAt(seq - head_seq); }
+
+    // Check register hazards against older ROB entries. If there is one
+    // the entry is parked on the register tag and leaves the ready set.
+    bool checkDependencies(const uint64_t seq, VanadisInstruction* ins)
+    {
+        for ( uint16_t i = 0; i < ins->countISAIntRegIn(); ++i ) {
+            const uint16_t reg = ins->getISAIntRegIn(i);
+            if ( !int_writers[reg].empty() && (int_writers[reg].front() < seq) ) {
+                park(seq, int_write_waiters[reg]);
+                return false;
+            }
+        }
+
+        for ( uint16_t i = 0; i < ins->countISAFPRegIn(); ++i ) {
+            const uint16_t reg = ins->getISAFPRegIn(i);
+            if ( !fp_writers[reg].empty() && (fp_writers[reg].front() < seq) ) {
+                park(seq, fp_write_waiters[reg]);
+                return false;
+            }
+        }
+
+        for ( uint16_t i = 0; i < ins->countISAIntRegOut(); ++i ) {
+            const uint16_t reg = ins->getISAIntRegOut(i);
+            if ( oldestReader(int_readers[reg]) < seq ) {
+                park(seq, int_read_waiters[reg]);
+                return false;
+            }
+        }
+
+        for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+            const uint16_t reg = ins->getISAFPRegOut(i);
+            if ( oldestReader(fp_readers[reg]) < seq ) {
+                park(seq, fp_read_waiters[reg]);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Loads and stores must not pass an older load or store which has not
+    // been issued to the LSQ yet, nor any fence still in the ROB
+    bool memoryOrderBlocked(const uint64_t seq)
+    {
+        if ( !fences.empty() && (fences.front() < seq) ) { return true; }
+
+        while ( !mem_ops.empty() &&
+                ((mem_ops.front() < head_seq) || getInstruction(mem_ops.front())->completedIssue()) ) {
+            mem_ops.pop_front();
+        }
+
+        return !mem_ops.empty() && (mem_ops.front() < seq);
+    }
+
+    void markIssued(const uint64_t seq)
+    {
+        clearReady(seq);
+        issued_this_cycle.push_back(seq);
+    }
+
+    // Make this cycle's issues visible to the WAR checks of later cycles
+    void endCycle()
+    {
+        for ( const uint64_t seq : issued_this_cycle ) {
+            issued_at_cycle_start[seq % slots] = true;
+
+            VanadisInstruction* ins = getInstruction(seq);
+
+            for ( uint16_t i = 0; i < ins->countISAIntRegIn(); ++i ) {
+                wake(int_read_waiters[ins->getISAIntRegIn(i)]);
+            }
+
+            for ( uint16_t i = 0; i < ins->countISAFPRegIn(); ++i ) {
+                wake(fp_read_waiters[ins->getISAFPRegIn(i)]);
+            }
+        }
+
+        issued_this_cycle.clear();
+    }
+
+private:
+    void setReady(const uint64_t seq)
+    {
+        const size_t slot = seq % slots;
+        ready[slot / 64] |= (UINT64_C(1) << (slot % 64));
+    }
+
+    void clearReady(const uint64_t seq)
+    {
+        const size_t slot = seq % slots;
+        ready[slot / 64] &= ~(UINT64_C(1) << (slot % 64));
+    }
+
+    void park(const uint64_t seq, std::vector<uint64_t>& waiters)
+    {
+        clearReady(seq);
+        waiters.push_back(seq);
+    }
+
+    void wake(std::vector<uint64_t>& waiters)
+    {
+        for ( const uint64_t seq : waiters ) {
+            // entries may have left the ROB since they were parked
+            if ( (seq >= head_seq) && (seq < next_seq) && !getInstruction(seq)->completedIssue() ) {
+                setReady(seq);
+            }
+        }
+
+        waiters.clear();
+    }
+
+    uint64_t oldestReader(std::deque<uint64_t>& readers)
+    {
+        while ( !readers.empty() &&
+                ((readers.front() < head_seq) || issued_at_cycle_start[readers.front() % slots]) ) {
+            readers.pop_front();
+        }
+
+        return readers.empty() ? UINT64_MAX : readers.front();
+    }
+
+    VanadisCircularQueue<VanadisInstruction*>* rob;
+    const size_t                               slots;
+
+    uint64_t head_seq;
+    uint64_t next_seq;
+
+    std::vector<uint64_t> ready;
+    std::vector<bool>     issued_at_cycle_start;
+    std::vector<uint64_t> issued_this_cycle;
+
+    std::vector<std::deque<uint64_t>>  int_writers;
+    std::vector<std::deque<uint64_t>>  int_readers;
+    std::vector<std::vector<uint64_t>> int_write_waiters;
+    std::vector<std::vector<uint64_t>> int_read_waiters;
+
+    std::vector<std::deque<uint64_t>>  fp_writers;
+    std::vector<std::deque<uint64_t>>  fp_readers;
+    std::vector<std::vector<uint64_t>> fp_write_waiters;
+    std::vector<std::vector<uint64_t>> fp_read_waiters;
+
+    std::deque<uint64_t> mem_ops;
+    std::deque<uint64_t> fences;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
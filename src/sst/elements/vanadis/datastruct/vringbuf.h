@@ -0,0 +1,119 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_RING_BUFFER
+#define _H_VANADIS_RING_BUFFER
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Fixed capacity FIFO held in a single power-of-two sized allocation.
+ * Entries can be cleared in place (set to T()) rather than erased, which
+ * leaves a hole; holes at the front are dropped by pop_front and the rest
+ * are squeezed out by compact() when the buffer needs the space.
+ */
+template <typename T>
+class VanadisRingBuffer
+{
+public:
+    VanadisRingBuffer(const size_t size) : max_capacity(size), head(0), count(0)
+    {
+        size_t storage_size = 1;
+        while ( storage_size < size ) {
+            storage_size <<= 1;
+        }
+
+        data.resize(storage_size, T());
+        mask = storage_size - 1;
+    }
+
+    bool empty() const { return 0 == count; }
+
+    bool full() const { return max_capacity == count; }
+
+    size_t size() const { return count; }
+
+    size_t capacity() const { return max_capacity; }
+
+    void push(T item)
+    {
+        assert(!full());
+        data[(head + count) & mask] = item;
+        count++;
+    }
+
+    T& peekAt(const size_t index) { return data[(head + index) & mask]; }
+
+    T& peek() { return data[head]; }
+
+    void pop()
+    {
+        assert(!empty());
+        data[head] = T();
+        head       = (head + 1) & mask;
+        count--;
+    }
+
+    // Drop holes from the front of the buffer
+    void popEmpty()
+    {
+        while ( (count > 0) && (data[head] == T()) ) {
+            pop();
+        }
+    }
+
+    // Remove every hole, keeping the order of the remaining entries
+    void compact()
+    {
+        size_t kept = 0;
+
+        for ( size_t i = 0; i < count; ++i ) {
+            T& next = data[(head + i) & mask];
+
+            if ( next != T() ) {
+                T tmp                      = next;
+                next                       = T();
+                data[(head + kept) & mask] = tmp;
+                kept++;
+            }
+        }
+
+        count = kept;
+    }
+
+    void clear()
+    {
+        while ( !empty() ) {
+            pop();
+        }
+    }
+
+private:
+    const size_t   max_capacity;
+    size_t         mask;
+    size_t         head;
+    size_t         count;
+    std::vector<T> data;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -24,6 +24,9 @@
 #include "lsq/vlsq.h"
 #include "os/vcpuos.h"
 #include "vbranch/vbranchbasic.h"
+#include "vbranch/vbranchbtb.h"
+#include "vbranch/vbranchgshare.h"
+#include "vbranch/vbranchtage.h"
 #include "vbranch/vbranchunit.h"
 #include "velf/velfinfo.h"
 #include "vinsloader.h"
@@ -49,6 +52,10 @@
           "micro-ops",                                                                                \
           "uops", 1 },                                                                                \
         { "ins_bytes_loaded", "Count the number of bytes loaded for decode operations", "bytes", 1 }, \
+        { "uop_cache_shared_hit",                                                                     \
+          "Count number of decodes avoided because another decoder had already "                      \
+          "decoded the instruction into the shared decode cache",                                     \
+          "bundles", 1 },                                                                             \
     {                                                                                                 \
         "uops_generated",                                                                             \
             "Count number of micro-ops generated by decoder that are transfered to "                  \
@@ -77,7 +84,12 @@ public:
                               "Number of cache lines to store in the local L0 cache for instructions "
                               "pending decoding." },
                             { "branch_predictor_entries", "Number of entries in the branch predictor, "
-                                                          "an entry is a branch instruction address" })
+                                                          "an entry is a branch instruction address" },
+                            { "shared_uop_cache",
+                              "Share decoded instructions with every other decoder on the node (see the core's "
+                              "node_id) running the same executable and ISA, the micro-op cache then holds "
+                              "references rather than copies",
+                              "0" })
 
     SST_ELI_DOCUMENT_STATISTICS( 
 				VANADIS_DECODER_ELI_STATISTICS
@@ -97,6 +109,7 @@ public:
         const size_t predecode_cache_entries = params.find<size_t>("predecode_cache_entries", 4);
 
         ins_loader = new VanadisInstructionLoader(uop_cache_size, predecode_cache_entries, icache_line_width);
+        share_decoded_bundles = params.find<bool>("shared_uop_cache", false);
 
         branch_predictor = loadUserSubComponent<SST::Vanadis::VanadisBranchUnit>("branch_unit");
         os_handler       = loadUserSubComponent<SST::Vanadis::VanadisCPUOSHandler>("os_handler");
@@ -114,6 +127,7 @@ public:
         stat_uop_generated    = registerStatistic<uint64_t>("uops_generated", "1");
         stat_decode_fault     = registerStatistic<uint64_t>("decode_faults", "1");
         stat_ins_bytes_loaded = registerStatistic<uint64_t>("ins_bytes_loaded", "1");
+        stat_uop_shared_hit   = registerStatistic<uint64_t>("uop_cache_shared_hit", "1");
     }
 
     virtual ~VanadisDecoder()
@@ -201,6 +215,7 @@ public:
     uint32_t getHardwareThread() const { return hw_thr; }
 
     VanadisInstructionLoader* getInstructionLoader() { return ins_loader; }
+    bool                      sharesDecodedBundles() const { return share_decoded_bundles; }
     VanadisBranchUnit*        getBranchPredictor() { return branch_predictor; }
 
     virtual void configureApplicationLaunch(
@@ -212,6 +227,17 @@ public:
 protected:
     virtual void clearDecoderAfterMisspeculate(SST::Output* output) {};
 
+    // Copy of a cached instruction for the ROB, with a shared decode cache the
+    // bundle may have been decoded by another thread
+    VanadisInstruction* cloneForPipeline(VanadisInstruction* cached_ins)
+    {
+        VanadisInstruction* new_ins = cached_ins->clone();
+
+        if ( ins_loader->hasSharedCache() ) { new_ins->bindToThread(hw_thr, getDecoderOptions(), fpflags); }
+
+        return new_ins;
+    }
+
     uint64_t ip;
     uint64_t icache_line_width;
     uint32_t hw_thr;
@@ -230,6 +256,7 @@ protected:
 
     bool canIssueStores;
     bool canIssueLoads;
+    bool share_decoded_bundles;
 
     Statistic<uint64_t>* stat_uop_hit;
     Statistic<uint64_t>* stat_predecode_hit;
@@ -237,6 +264,7 @@ protected:
     Statistic<uint64_t>* stat_decode_fault;
     Statistic<uint64_t>* stat_uop_generated;
     Statistic<uint64_t>* stat_ins_bytes_loaded;
+    Statistic<uint64_t>* stat_uop_shared_hit;
 };
 
 } // namespace Vanadis
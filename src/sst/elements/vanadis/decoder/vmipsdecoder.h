@@ -179,6 +179,8 @@ public:
                             { "predecode_cache_entries",
                               "Number of cache lines that a cached prior to decoding (these support "
                               "loading from cache prior to decode)" },
+                            { "shared_uop_cache",
+                              "Share decoded instructions with other decoders running the same executable", "0" },
                             { "stack_start_address", "Sets the start of the stack and dynamic program segments" })
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -772,20 +774,34 @@ public:
                                 CALL_INFO, 16, 0,
                                 "-----> Branch delay slot is not currently "
                                 "decoded into a bundle.\n");
-                            if ( ins_loader->hasPredecodeAt(ip + 4, 4) ) {
+                            if ( ins_loader->hasPredecodeAt(ip + 4, 4) && ins_loader->cacheSharedBundle(ip + 4) ) {
+                                output->verbose(
+                                    CALL_INFO, 16, 0,
+                                    "-----> Branch delay slot was already decoded in the "
+                                    "shared decode cache.\n");
+                                stat_predecode_hit->addData(1);
+                                stat_uop_shared_hit->addData(1);
+
+                                delay_bundle = ins_loader->getBundleAt(ip + 4);
+                            }
+                            else if ( ins_loader->hasPredecodeAt(ip + 4, 4) ) {
                                 output->verbose(
                                     CALL_INFO, 16, 0,
                                     "-----> Branch delay slot is a pre-decode "
                                     "cache item, decode it and keep bundle.\n");
-                                delay_bundle = new VanadisInstructionBundle(ip + 4);
+                                VanadisInstructionBundle* new_delay_bundle = new VanadisInstructionBundle(ip + 4);
 
                                 if ( ins_loader->getPredecodeBytes(
                                          output, ip + 4, (uint8_t*)&temp_delay, sizeof(temp_delay)) ) {
                                     stat_predecode_hit->addData(1);
 
-                                    decode(output, ip + 4, temp_delay, delay_bundle);
-                                    ins_loader->cacheDecodedBundle(delay_bundle);
+                                    decode(output, ip + 4, temp_delay, new_delay_bundle);
+                                    ins_loader->cacheDecodedBundle(new_delay_bundle);
                                     decodes_performed++;
+
+                                    // With a shared decode cache the bundle kept may not be the
+                                    // one just decoded
+                                    delay_bundle = ins_loader->getBundleAt(ip + 4);
                                 }
                                 else {
                                     output->fatal(
@@ -817,7 +833,7 @@ public:
                                     "delay slot...\n");
 
                                 for ( uint32_t i = 0; i < bundle->getInstructionCount(); ++i ) {
-                                    VanadisInstruction* next_ins = bundle->getInstructionByIndex(i)->clone();
+                                    VanadisInstruction* next_ins = cloneForPipeline(bundle->getInstructionByIndex(i));
 
                                     output->verbose(
                                         CALL_INFO, 16, 0, "---> --> issuing ins addr: 0x0%llx, %s...\n",
@@ -885,7 +901,8 @@ public:
                                 }
 
                                 for ( uint32_t i = 0; i < delay_bundle->getInstructionCount(); ++i ) {
-                                    VanadisInstruction* next_ins = delay_bundle->getInstructionByIndex(i)->clone();
+                                    VanadisInstruction* next_ins =
+                                        cloneForPipeline(delay_bundle->getInstructionByIndex(i));
 
                                     output->verbose(
                                         CALL_INFO, 16, 0, "---> --> issuing ins addr: 0x0%llx, %s...\n",
@@ -919,7 +936,7 @@ public:
                                 output->verbose(
                                     CALL_INFO, 16, 0, "---> --> issuing ins addr: 0x0%llx, %s...\n",
                                     next_ins->getInstructionAddress(), next_ins->getInstCode());
-                                thread_rob->push(next_ins->clone());
+                                thread_rob->push(cloneForPipeline(next_ins));
                             }
 
                             uop_bundles_used++;
@@ -951,6 +968,14 @@ public:
                         (void*)ip);
                     stat_predecode_hit->addData(1);
 
+                    if ( ins_loader->cacheSharedBundle(ip) ) {
+                        output->verbose(
+                            CALL_INFO, 16, 0, "---> ip=%p already decoded in the shared decode cache\n", (void*)ip);
+                        stat_uop_shared_hit->addData(1);
+
+                        break;
+                    }
+
                     uint32_t                  temp_ins       = 0;
                     VanadisInstructionBundle* decoded_bundle = new VanadisInstructionBundle(ip);
 
@@ -43,6 +43,8 @@ public:
       {"predecode_cache_entries",
        "Number of cache lines that a cached prior to decoding (these support "
        "loading from cache prior to decode)"},
+      {"shared_uop_cache",
+       "Share decoded instructions with other decoders running the same executable", "0"},
       {"halt_on_decode_fault",
 		"Fatal error if a decode fault occurs, used for debugging and not recommmended default is 0 (false)", "0"},
       {"stack_start_address",
@@ -442,7 +444,9 @@ public:
                         bool bundle_has_branch = false;
 
                         for ( uint32_t i = 0; i < bundle->getInstructionCount(); ++i ) {
-                            VanadisInstruction* next_ins = bundle->getInstructionByIndex(i);
+                            // Speculation is recorded on the copy, the cached bundle may be
+                            // shared with other decoders
+                            VanadisInstruction* next_ins = cloneForPipeline(bundle->getInstructionByIndex(i));
 
                             if ( next_ins->getInstFuncType() == INST_BRANCH ) {
                                 VanadisSpeculatedInstruction* next_spec_ins =
@@ -479,7 +483,7 @@ public:
                                 }
                             }
 
-                            thread_rob->push(next_ins->clone());
+                            thread_rob->push(next_ins);
                         }
 
                         // Move to the next address, if we had a branch we should have
@@ -502,6 +506,16 @@ public:
                         "---> uop not found, but is located in the predecode "
                         "i0-icache (ip=0x%llx)\n",
                         ip);
+
+                    if ( ins_loader->cacheSharedBundle(ip) ) {
+                        output->verbose(
+                            CALL_INFO, 16, 0, "---> ip=0x%llx already decoded in the shared decode cache\n", ip);
+                        stat_uop_shared_hit->addData(1);
+
+                        // Available next cycle, as if it had been decoded
+                        break;
+                    }
+
                     VanadisInstructionBundle* decoded_bundle = new VanadisInstructionBundle(ip);
 
                     uint32_t temp_ins = 0;
@@ -517,12 +531,12 @@ public:
                             CALL_INFO, 16, 0, "---> bundle generates %" PRIu32 " micro-ops\n",
                             (uint32_t)decoded_bundle->getInstructionCount());
 
-                        ins_loader->cacheDecodedBundle(decoded_bundle);
-
                         if ( 0 == decoded_bundle->getInstructionCount() ) {
                             output->fatal(CALL_INFO, -1, "Error - bundle at: 0x%llx generates no micro-ops.\n", ip);
                         }
 
+                        ins_loader->cacheDecodedBundle(decoded_bundle);
+
                         // Exit this cycle because results saved to cache are available next
                         // cycle
                         break;
@@ -126,6 +126,7 @@ public:
     uint32_t getHWThread() const { return hw_thread; }
     uint16_t countIntRegs() const { return count_int_regs; }
     uint16_t countFPRegs() const { return count_fp_regs; }
+    uint32_t getFPRegWidth() const { return fp_reg_width; }
 
     void print(SST::Output* output)
     {
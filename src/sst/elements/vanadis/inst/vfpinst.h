@@ -53,6 +53,13 @@ public:
 		  pipeline_fpflags(copy_me.pipeline_fpflags)
     {}
 
+    void bindToThread(
+        const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, VanadisFloatingPointFlags* fp_flags) override
+    {
+        VanadisInstruction::bindToThread(hw_thr, isa_opts, fp_flags);
+        pipeline_fpflags = fp_flags;
+    }
+
     virtual bool updatesFPFlags() const { return update_fp_flags; }
     virtual void performFPFlagsUpdate() const {
 		pipeline_fpflags->copy(fpflags);
@@ -16,17 +16,21 @@
 #ifndef _H_VANADIS_INSTRUCTION
 #define _H_VANADIS_INSTRUCTION
 
+#include "datastruct/vinstpool.h"
 #include "decoder/visaopts.h"
 #include "inst/regfile.h"
 #include "inst/vinsttype.h"
 #include "inst/vregfmt.h"
 
+#include <algorithm>
 #include <cstring>
 #include <sst/core/output.h>
 
 namespace SST {
 namespace Vanadis {
 
+class VanadisFloatingPointFlags;
+
 class VanadisInstruction
 {
 public:
@@ -48,29 +52,8 @@ public:
         count_isa_fp_reg_out(c_isa_fp_reg_out)
     {
 
-        phys_int_regs_in = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        std::memset(phys_int_regs_in, 0, count_phys_int_reg_in);
-
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-        std::memset(phys_int_regs_out, 0, count_phys_int_reg_out);
-
-        isa_int_regs_in = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        std::memset(isa_int_regs_in, 0, count_isa_int_reg_in);
-
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-        std::memset(isa_int_regs_out, 0, count_isa_int_reg_out);
-
-        phys_fp_regs_in = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        std::memset(phys_fp_regs_in, 0, count_phys_fp_reg_in);
-
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-        std::memset(phys_fp_regs_out, 0, count_phys_fp_reg_out);
-
-        isa_fp_regs_in = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        std::memset(isa_fp_regs_in, 0, count_isa_fp_reg_in);
-
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-        std::memset(isa_fp_regs_out, 0, count_isa_fp_reg_out);
+        allocateRegisterLists();
+        if ( nullptr != reg_storage ) { std::memset(reg_storage, 0, countAllRegisters() * sizeof(uint16_t)); }
 
         trapError             = false;
         hasExecuted           = false;
@@ -81,17 +64,12 @@ public:
         hasROBSlot            = false;
     }
 
-    virtual ~VanadisInstruction()
-    {
-        if ( phys_int_regs_in != nullptr ) delete[] phys_int_regs_in;
-        if ( phys_int_regs_out != nullptr ) delete[] phys_int_regs_out;
-        if ( isa_int_regs_in != nullptr ) delete[] isa_int_regs_in;
-        if ( isa_int_regs_out != nullptr ) delete[] isa_int_regs_out;
-        if ( phys_fp_regs_in != nullptr ) delete[] phys_fp_regs_in;
-        if ( phys_fp_regs_out != nullptr ) delete[] phys_fp_regs_out;
-        if ( isa_fp_regs_in != nullptr ) delete[] isa_fp_regs_in;
-        if ( isa_fp_regs_out != nullptr ) delete[] isa_fp_regs_out;
-    }
+    virtual ~VanadisInstruction() { VanadisInstructionPool::release(reg_storage, countAllRegisters() * sizeof(uint16_t)); }
+
+    // Dynamic instructions are created and destroyed at a very high
+    // rate, so recycle their memory rather than going to the heap
+    static void* operator new(size_t size) { return VanadisInstructionPool::allocate(size); }
+    static void  operator delete(void* ptr, size_t size) { VanadisInstructionPool::release(ptr, size); }
 
     VanadisInstruction(const VanadisInstruction& copy_me) :
         ins_address(copy_me.ins_address),
@@ -115,48 +93,11 @@ public:
         isFrontOfROB          = false;
         hasROBSlot            = false;
 
-        phys_int_regs_in  = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-
-        isa_int_regs_in  = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-
-        phys_fp_regs_in  = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-
-        isa_fp_regs_in  = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-
-        for ( uint16_t i = 0; i < count_phys_int_reg_in; ++i ) {
-            phys_int_regs_in[i] = copy_me.phys_int_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_int_reg_out; ++i ) {
-            phys_int_regs_out[i] = copy_me.phys_int_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_int_reg_in; ++i ) {
-            isa_int_regs_in[i] = copy_me.isa_int_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_int_reg_out; ++i ) {
-            isa_int_regs_out[i] = copy_me.isa_int_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_fp_reg_in; ++i ) {
-            phys_fp_regs_in[i] = copy_me.phys_fp_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_fp_reg_out; ++i ) {
-            phys_fp_regs_out[i] = copy_me.phys_fp_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_fp_reg_in; ++i ) {
-            isa_fp_regs_in[i] = copy_me.isa_fp_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_fp_reg_out; ++i ) {
-            isa_fp_regs_out[i] = copy_me.isa_fp_regs_out[i];
+        // All of the register lists live in one block so a copy only
+        // needs a single allocation
+        allocateRegisterLists();
+        if ( nullptr != reg_storage ) {
+            std::memcpy(reg_storage, copy_me.reg_storage, countAllRegisters() * sizeof(uint16_t));
         }
     }
 
@@ -314,6 +255,16 @@ public:
     uint64_t getInstructionAddress() const { return ins_address; }
     uint32_t getHWThread() const { return hw_thread; }
 
+    // Decoded bundles can be shared by decoders on other threads and cores
+    // (see vdecodecache.h), the copy given to a pipeline is re-targeted at
+    // the thread which will execute it
+    virtual void bindToThread(
+        const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, VanadisFloatingPointFlags* fp_flags)
+    {
+        hw_thread   = hw_thr;
+        isa_options = isa_opts;
+    }
+
     virtual const char* getInstCode() const = 0;
     virtual void printToBuffer(char* buffer, size_t buffer_size) { snprintf(buffer, buffer_size, "%s", getInstCode()); }
     virtual VanadisFunctionalUnitType getInstFuncType() const                                    = 0;
@@ -351,8 +302,75 @@ public:
     virtual void performFPFlagsUpdate() const {}
 
 protected:
+    uint32_t countAllRegisters() const
+    {
+        return (uint32_t)count_phys_int_reg_in + count_phys_int_reg_out + count_isa_int_reg_in +
+               count_isa_int_reg_out + count_phys_fp_reg_in + count_phys_fp_reg_out + count_isa_fp_reg_in +
+               count_isa_fp_reg_out;
+    }
+
+    // Carves each register list out of a single pooled block.  Lists
+    // with no entries are set to nullptr.
+    void allocateRegisterLists()
+    {
+        const uint32_t total = countAllRegisters();
+        reg_storage = (total > 0)
+                          ? static_cast<uint16_t*>(VanadisInstructionPool::allocate(total * sizeof(uint16_t)))
+                          : nullptr;
+
+        uint16_t* next = reg_storage;
+        auto      carve = [&next](const uint16_t count) -> uint16_t* {
+            uint16_t* list = (count > 0) ? next : nullptr;
+            next += count;
+            return list;
+        };
+
+        phys_int_regs_in  = carve(count_phys_int_reg_in);
+        phys_int_regs_out = carve(count_phys_int_reg_out);
+        isa_int_regs_in   = carve(count_isa_int_reg_in);
+        isa_int_regs_out  = carve(count_isa_int_reg_out);
+        phys_fp_regs_in   = carve(count_phys_fp_reg_in);
+        phys_fp_regs_out  = carve(count_phys_fp_reg_out);
+        isa_fp_regs_in    = carve(count_isa_fp_reg_in);
+        isa_fp_regs_out   = carve(count_isa_fp_reg_out);
+    }
+
+    // Used by instructions that need more integer input registers than
+    // their base class provides.  Existing register entries are kept.
+    void resizeIntRegIn(const uint16_t c_phys_int_reg_in, const uint16_t c_isa_int_reg_in)
+    {
+        const uint32_t old_total   = countAllRegisters();
+        uint16_t*      old_storage = reg_storage;
+
+        uint16_t* old_lists[8]  = { phys_int_regs_in, phys_int_regs_out, isa_int_regs_in, isa_int_regs_out,
+                                   phys_fp_regs_in,  phys_fp_regs_out,  isa_fp_regs_in,  isa_fp_regs_out };
+        uint16_t  old_counts[8] = { count_phys_int_reg_in, count_phys_int_reg_out, count_isa_int_reg_in,
+                                   count_isa_int_reg_out, count_phys_fp_reg_in,   count_phys_fp_reg_out,
+                                   count_isa_fp_reg_in,   count_isa_fp_reg_out };
+
+        count_phys_int_reg_in = c_phys_int_reg_in;
+        count_isa_int_reg_in  = c_isa_int_reg_in;
+        allocateRegisterLists();
+        if ( nullptr != reg_storage ) { std::memset(reg_storage, 0, countAllRegisters() * sizeof(uint16_t)); }
+
+        uint16_t* new_lists[8]  = { phys_int_regs_in, phys_int_regs_out, isa_int_regs_in, isa_int_regs_out,
+                                   phys_fp_regs_in,  phys_fp_regs_out,  isa_fp_regs_in,  isa_fp_regs_out };
+        uint16_t  new_counts[8] = { count_phys_int_reg_in, count_phys_int_reg_out, count_isa_int_reg_in,
+                                   count_isa_int_reg_out, count_phys_fp_reg_in,   count_phys_fp_reg_out,
+                                   count_isa_fp_reg_in,   count_isa_fp_reg_out };
+
+        for ( int i = 0; i < 8; ++i ) {
+            const uint16_t keep = std::min(old_counts[i], new_counts[i]);
+            for ( uint16_t j = 0; j < keep; ++j ) {
+                new_lists[i][j] = old_lists[i][j];
+            }
+        }
+
+        VanadisInstructionPool::release(old_storage, old_total * sizeof(uint16_t));
+    }
+
     const uint64_t ins_address;
-    const uint32_t hw_thread;
+    uint32_t       hw_thread;
 
     uint16_t count_phys_int_reg_in;
     uint16_t count_phys_int_reg_out;
@@ -374,6 +392,9 @@ protected:
     uint16_t* isa_fp_regs_in;
     uint16_t* isa_fp_regs_out;
 
+    // Backing storage for all of the register lists above
+    uint16_t* reg_storage;
+
     bool trapError;
     bool hasExecuted;
     bool hasIssued;
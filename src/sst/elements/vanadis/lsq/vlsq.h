@@ -22,6 +22,8 @@
 #include "inst/regfile.h"
 #include "inst/vload.h"
 #include "inst/vstore.h"
+#include "vcheckpoint.h"
+#include "vdecodecache.h"
 
 #include <cassert>
 #include <cinttypes>
@@ -51,6 +53,9 @@ public:
         address_mask = params.find<uint64_t>("address_mask", 0xFFFFFFFFFFFFFFFF);
 
         registerFiles = nullptr;
+        written_pages = nullptr;
+        code_pages = nullptr;
+        pending_flushes = 0;
 
         stat_load_issued = registerStatistic<uint64_t>("loads_issued", "1");
         stat_store_issued = registerStatistic<uint64_t>("stores_issued", "1");
@@ -68,6 +73,14 @@ public:
         registerFiles = reg_f;
     }
 
+    // Stores are recorded in the core's written pages once it is set, the
+    // core sets it when it will take a checkpoint
+    void setWrittenPages(VanadisWrittenPages* pages) { written_pages = pages; }
+
+    // Stores are reported to the node's code pages once set, the core sets
+    // them when its decoders share decoded instructions
+    void setCodePages(VanadisCodePageVersions* pages) { code_pages = pages; }
+
     virtual bool storeFull() = 0;
     virtual bool loadFull() = 0;
 
@@ -85,11 +98,24 @@ public:
     virtual void init(unsigned int phase) = 0;
     virtual void setInitialMemory(const uint64_t address, std::vector<uint8_t>& payload) = 0;
 
+    // Zero filled memory (e.g., .bss) is not written, the backing store
+    // reads as zero until first touched. LSQs which check loads against
+    // written memory count the range as initialized.
+    virtual void setInitialZeroMemory(const uint64_t address, const uint64_t length) {}
+
+    // Write back every line of the given pages so the memory backing store
+    // holds their current contents, used before taking a checkpoint
+    virtual void flushPages(const std::vector<uint64_t>& pages, const uint64_t line_width) = 0;
+    bool flushPending() const { return pending_flushes > 0; }
+
     virtual void printStatus(SST::Output& output) {}
 
 protected:
     uint64_t address_mask;
+    uint64_t pending_flushes;
     std::vector<VanadisRegisterFile*>* registerFiles;
+    VanadisWrittenPages* written_pages;
+    VanadisCodePageVersions* code_pages;
     SST::Output* output;
 
     Statistic<uint64_t>* stat_load_issued;
@@ -405,6 +405,15 @@ public:
                         }
 
                         writeTrace(store_ins, "STORE", store_type, store_addr, store_width);
+
+                        // Decoded copies of this address are no longer valid
+                        if (nullptr != code_pages) {
+                            code_pages->notifyStore(store_addr, store_width);
+                        }
+
+                        if (nullptr != written_pages) {
+                            written_pages->record(store_addr, store_width);
+                        }
                         memInterface->send(store_req);
 
                         stat_store_issued->addData(1);
@@ -738,6 +747,12 @@ public:
             delete ev;
         }
 
+        virtual void handle(StandardMem::FlushResp* ev) override {
+            out->verbose(CALL_INFO, 16, 0, "recv flush response, addr: 0x%llx\n", ev->pAddr);
+            lsq->pending_flushes--;
+            delete ev;
+        }
+
         VanadisSequentialLoadStoreQueue* lsq;
     };
 
@@ -779,6 +794,24 @@ public:
         }
     }
 
+    virtual void setInitialZeroMemory(const uint64_t addr, const uint64_t length) {
+        output->verbose(CALL_INFO, 2, 0, "zero filled initial memory at address 0x%llx / size: %" PRIu64 "\n", addr,
+                        length);
+
+        if (fault_on_memory_not_written) {
+            memory_check_table->markRange(addr, length);
+        }
+    }
+
+    virtual void flushPages(const std::vector<uint64_t>& pages, const uint64_t line_width) {
+        for (const uint64_t page_start : pages) {
+            for (uint64_t line = page_start; line < (page_start + VANADIS_CHECKPOINT_PAGE_SIZE); line += line_width) {
+                memInterface->send(new StandardMem::FlushAddr(line, line_width, false, 10));
+                pending_flushes++;
+            }
+        }
+    }
+
 protected:
     // TODO should we use getString() here or does it need to be terse?
     void writeTrace(VanadisInstruction* ins, std::string req_type, std::string sub_type, uint64_t address, uint64_t size) {
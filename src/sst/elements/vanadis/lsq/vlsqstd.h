@@ -25,11 +25,13 @@
 #include "lsq/vlsq.h"
 
 #include "datastruct/cqueue.h"
+#include "datastruct/vringbuf.h"
 #include "util/vsignx.h"
 
 #include <cassert>
 #include <map>
 #include <set>
+#include <vector>
 
 using namespace SST::Interfaces;
 
@@ -40,32 +42,57 @@ enum VanadisAddressOverlapType { OVERLAP_FREE, PARTIAL_COVERAGE, STORE_COVERS_LO
 
 enum VanadisLoadIssueEvaluation { FORWARD_STORE, STALL_PROCESSING, REQUIRE_LOAD };
 
-class VanadisStoreRecord {
+class VanadisLoadRecord {
 
 public:
-    VanadisStoreRecord(VanadisStoreInstruction* genIns) : gen_ins(genIns) {}
+    VanadisLoadRecord(VanadisLoadInstruction* genIns, const uint64_t seq = 0) : gen_ins(genIns), seq(seq) {}
 
-    bool predates(VanadisInstruction* check) {
-        assert(0);
-        return true;
-    }
-    bool checkIssueToMemory() { return gen_ins->checkFrontOfROB(); }
+    VanadisLoadInstruction* getAssociatedInstruction() { return gen_ins; }
 
-    VanadisStoreInstruction* getAssociatedInstruction() { return gen_ins; }
+    // Order in which the load entered the LSQ relative to other loads and stores
+    uint64_t getSequence() const { return seq; }
 
 protected:
-    VanadisStoreInstruction* gen_ins;
+    VanadisLoadInstruction* gen_ins;
+    uint64_t seq;
 };
 
-class VanadisLoadRecord {
+class VanadisStoreRecord {
 
 public:
-    VanadisLoadRecord(VanadisLoadInstruction* genIns) : gen_ins(genIns) {}
+    VanadisStoreRecord(VanadisStoreInstruction* genIns, const uint64_t seq = 0)
+        : gen_ins(genIns), seq(seq), indexed(false), store_address(0), first_line(0), last_line(0) {}
 
-    VanadisLoadInstruction* getAssociatedInstruction() { return gen_ins; }
+    // Loads and stores enter the LSQ in program order, so a store which
+    // entered before the load is older than it
+    bool predates(VanadisLoadRecord* check) { return seq < check->getSequence(); }
+    bool checkIssueToMemory() { return gen_ins->checkFrontOfROB(); }
+
+    VanadisStoreInstruction* getAssociatedInstruction() { return gen_ins; }
+
+    uint64_t getSequence() const { return seq; }
+
+    // The store address is computed once, the first time the LSQ ticks after the
+    // store was pushed (its registers are not assigned at push time)
+    void setAddress(const uint64_t address, const uint64_t line_first, const uint64_t line_last) {
+        store_address = address;
+        first_line = line_first;
+        last_line = line_last;
+        indexed = true;
+    }
+
+    bool isIndexed() const { return indexed; }
+    uint64_t getStoreAddress() const { return store_address; }
+    uint64_t getFirstLine() const { return first_line; }
+    uint64_t getLastLine() const { return last_line; }
 
 protected:
-    VanadisLoadInstruction* gen_ins;
+    VanadisStoreInstruction* gen_ins;
+    uint64_t seq;
+    bool indexed;
+    uint64_t store_address;
+    uint64_t first_line;
+    uint64_t last_line;
 };
 
 class VanadisStandardLoadStoreQueue : public VanadisLoadStoreQueue {
@@ -88,10 +115,13 @@ public:
                             { "max_store_issue_per_cycle",
                               "Set the maximum number of stores that can be issued per cycle", "2" },
                             { "max_load_issue_per_cycle",
-                              "Set the maximum number of loads that can be issued per cycle", "2" })
+                              "Set the maximum number of loads that can be issued per cycle", "2" },
+                            { "store_index_line_width",
+                              "Width in bytes of the address blocks used to index queued stores for load forwarding "
+                              "checks, must be a power of 2", "64" })
 
     VanadisStandardLoadStoreQueue(ComponentId_t id, Params& params)
-        : VanadisLoadStoreQueue(id, params), processingLLSC(false) {
+        : VanadisLoadStoreQueue(id, params), processingLLSC(false), next_mem_op_seq(0) {
 
         max_mem_issued_stores = params.find<uint32_t>("lsq_store_pending", 8);
         max_mem_issued_loads = params.find<uint32_t>("lsq_load_pending", 8);
@@ -102,13 +132,39 @@ public:
         max_stores_issue_per_cycle = params.find<uint32_t>("max_store_issue_per_cycle", 2);
         max_load_issue_per_cycle = params.find<uint32_t>("max_load_issue_per_cycle", 2);
 
+        pending_queued_loads = 0;
+        pending_mem_issued_stores = 0;
+        pending_mem_issued_loads = 0;
+
         memInterface = loadUserSubComponent<Interfaces::StandardMem>(
             "memory_interface", ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS, getTimeConverter("1ps"),
             new StandardMem::Handler<SST::Vanadis::VanadisStandardLoadStoreQueue>(
                 this, &VanadisStandardLoadStoreQueue::processIncomingDataCacheEvent));
 
         store_q = new VanadisCircularQueue<VanadisStoreRecord*>(max_mem_issued_stores);
-        
+        load_q = new VanadisRingBuffer<VanadisLoadRecord*>(max_queued_loads);
+
+        const uint64_t line_width = params.find<uint64_t>("store_index_line_width", 64);
+
+        if ((0 == line_width) || (0 != (line_width & (line_width - 1)))) {
+            output->fatal(CALL_INFO, -1, "Error: store_index_line_width must be a power of 2, got %" PRIu64 "\n",
+                          line_width);
+        }
+
+        store_index_line_shift = 0;
+        while ((UINT64_C(1) << store_index_line_shift) < line_width) {
+            store_index_line_shift++;
+        }
+
+        // Keep the table sparse so buckets rarely hold stores to more than one line
+        size_t bucket_count = 1;
+        while (bucket_count < (4 * (size_t)max_mem_issued_stores)) {
+            bucket_count <<= 1;
+        }
+
+        store_index.resize(bucket_count);
+        store_index_mask = bucket_count - 1;
+
         std_mem_handlers = new StandardMemHandlers(this, output);
 
         output->verbose(CALL_INFO, 2, 0, "LSQ Store Queue Length:               %" PRIu32 "\n", max_mem_issued_stores);
@@ -123,6 +179,7 @@ public:
 
     ~VanadisStandardLoadStoreQueue() {
         delete store_q;
+        delete load_q;
         delete memInterface;
     }
 
@@ -136,11 +193,17 @@ public:
     virtual void push(VanadisStoreInstruction* store_me) {
         assert(!(store_q->full()));
 
-        store_q->push(new VanadisStoreRecord(store_me));
+        VanadisStoreRecord* store_record = new VanadisStoreRecord(store_me, next_mem_op_seq++);
+        store_q->push(store_record);
+        unindexed_stores.push_back(store_record);
     }
 
     virtual void push(VanadisLoadInstruction* load_me) {
-        load_q.push_back(new VanadisLoadRecord(load_me));
+        if (load_q->full()) {
+            load_q->compact();
+        }
+
+        load_q->push(new VanadisLoadRecord(load_me, next_mem_op_seq++));
         pending_queued_loads++;
     }
 
@@ -152,6 +215,15 @@ public:
         memInterface->sendUntimedData(new StandardMem::Write(address, payload.size(), payload));
     }
 
+    virtual void flushPages(const std::vector<uint64_t>& pages, const uint64_t line_width) {
+        for (const uint64_t page_start : pages) {
+            for (uint64_t line = page_start; line < (page_start + VANADIS_CHECKPOINT_PAGE_SIZE); line += line_width) {
+                memInterface->send(new StandardMem::FlushAddr(line, line_width, false, 10));
+                pending_flushes++;
+            }
+        }
+    }
+
     VanadisAddressOverlapType evaluateAddressOverlap(const uint64_t loadAddress, const uint16_t loadLen,
                                                      const uint64_t storeAddress, const uint16_t storeLen) const {
 
@@ -175,6 +247,84 @@ public:
         return overlap;
     }
 
+    uint64_t storeIndexBucket(const uint64_t line) const { return line & store_index_mask; }
+
+    // Compute the addresses of stores pushed since the last tick and add them
+    // to every bucket of the lines they touch. The range includes the byte
+    // just past the store so the index agrees with evaluateAddressOverlap,
+    // which treats adjacent accesses as overlapping.
+    void indexNewStores() {
+        for (VanadisStoreRecord* store_record : unindexed_stores) {
+            VanadisStoreInstruction* store_ins = store_record->getAssociatedInstruction();
+
+            uint64_t store_address = 0;
+            uint16_t store_width = 0;
+
+            store_ins->computeStoreAddress(output, registerFiles->at(store_ins->getHWThread()), &store_address,
+                                           &store_width);
+
+            const uint64_t first_line = store_address >> store_index_line_shift;
+            const uint64_t last_line = (store_address + store_ins->getStoreWidth()) >> store_index_line_shift;
+
+            store_record->setAddress(store_address, first_line, last_line);
+
+            for (uint64_t line = first_line; line <= last_line; ++line) {
+                store_index[storeIndexBucket(line)].push_back(store_record);
+            }
+        }
+
+        unindexed_stores.clear();
+    }
+
+    void removeFromStoreIndex(VanadisStoreRecord* store_record) {
+        if (!store_record->isIndexed()) {
+            for (auto store_itr = unindexed_stores.begin(); store_itr != unindexed_stores.end(); store_itr++) {
+                if ((*store_itr) == store_record) {
+                    unindexed_stores.erase(store_itr);
+                    break;
+                }
+            }
+            return;
+        }
+
+        for (uint64_t line = store_record->getFirstLine(); line <= store_record->getLastLine(); ++line) {
+            std::vector<VanadisStoreRecord*>& bucket = store_index[storeIndexBucket(line)];
+
+            for (auto bucket_itr = bucket.begin(); bucket_itr != bucket.end(); bucket_itr++) {
+                if ((*bucket_itr) == store_record) {
+                    bucket.erase(bucket_itr);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Find the youngest store older than the load which overlaps it, only
+    // the buckets of the lines the load touches are searched
+    VanadisStoreRecord* findOverlappingStore(VanadisLoadRecord* load_record, const uint64_t load_address) {
+        VanadisLoadInstruction* load_ins = load_record->getAssociatedInstruction();
+        VanadisStoreRecord* youngest = nullptr;
+
+        const uint64_t first_line = load_address >> store_index_line_shift;
+        const uint64_t last_line = (load_address + load_ins->getLoadWidth()) >> store_index_line_shift;
+
+        for (uint64_t line = first_line; line <= last_line; ++line) {
+            for (VanadisStoreRecord* check_store : store_index[storeIndexBucket(line)]) {
+                VanadisStoreInstruction* check_store_ins = check_store->getAssociatedInstruction();
+
+                if ((load_ins->getHWThread() == check_store_ins->getHWThread()) && check_store->predates(load_record) &&
+                    ((nullptr == youngest) || (check_store->getSequence() > youngest->getSequence())) &&
+                    (OVERLAP_FREE != evaluateAddressOverlap(load_address, load_ins->getLoadWidth(),
+                                                            check_store->getStoreAddress(),
+                                                            check_store_ins->getStoreWidth()))) {
+                    youngest = check_store;
+                }
+            }
+        }
+
+        return youngest;
+    }
+
     virtual void tick(uint64_t cycle) {
         output->verbose(CALL_INFO, 16, 0, "-> Ticking Load/Store Queue Processors...\n");
         output->verbose(CALL_INFO, 16, 0, "---> LSQ contains: %" PRIu32 " queued loads / %" PRIu32 " queued stores.\n",
@@ -190,6 +340,7 @@ public:
                         "---> LSQ contains: %" PRIu32 " loads in flight / %" PRIu32 " stores in flight\n",
                         pending_mem_issued_loads, pending_mem_issued_stores);
         output->verbose(CALL_INFO, 16, 0, "-> Ticking Load Queue Handling...\n");
+        indexNewStores();
         tick_loads(cycle);
         output->verbose(CALL_INFO, 16, 0, "---> Ticking Store Queue Handling (max stores per cycle = %" PRIu32 ")\n",
                         max_stores_issue_per_cycle);
@@ -216,8 +367,15 @@ public:
     }
 
     void tick_loads(const uint64_t cycle) {
-        for (auto next_load = load_q.begin(); next_load != load_q.end();) {
-            VanadisLoadInstruction* load_ins = (*next_load)->getAssociatedInstruction();
+        for (size_t next_load = 0; next_load < load_q->size(); next_load++) {
+            VanadisLoadRecord* load_record = load_q->peekAt(next_load);
+
+            // Skip entries already removed from the middle of the queue
+            if (nullptr == load_record) {
+                continue;
+            }
+
+            VanadisLoadInstruction* load_ins = load_record->getAssociatedInstruction();
 
             output->verbose(CALL_INFO, 16, 0,
                             "-> LSQ inspect load record: (ins: 0x%0llx, thr: %" PRIu32 ") executed? %s\n",
@@ -241,72 +399,56 @@ public:
             output->verbose(CALL_INFO, 16, 0, "-> LSQ attempt process for load at: %p / %" PRIu64 "\n",
                             (void*)load_address, load_address);
 
-            // iterate over store queue, do we find any with the same address?
-            const size_t store_q_count = store_q->size();
-
             VanadisLoadIssueEvaluation load_eval = REQUIRE_LOAD;
 
-            // Must check in reverse order, we need the most up to date version of
-            // the address if multiple stores hit the same place
-            for (int i = store_q_count - 1; i >= 0; i--) {
-                VanadisStoreRecord* check_store = store_q->peekAt(i);
+            // Only stores to the lines this load touches can overlap it, the
+            // youngest of those has the most up to date version of the data
+            VanadisStoreRecord* check_store = findOverlappingStore(load_record, load_address);
+
+            if (nullptr != check_store) {
                 VanadisStoreInstruction* check_store_ins = check_store->getAssociatedInstruction();
+                const uint64_t store_address = check_store->getStoreAddress();
 
-                // Are load/store in the same HW thread and does the load predate the
-                // store we cannot use stores which would have occured *after* we are
-                // supposed to be issued
-                if ((load_ins->getHWThread() == check_store_ins->getHWThread()) && check_store->predates(load_ins)) {
+                output->verbose(CALL_INFO, 16, 0,
+                                "-> LSQ compare load (0x%0llx, width=%" PRIu16 ") to store at (0x%0llx, width=%" PRIu16
+                                ")\n",
+                                load_address, load_width, store_address, check_store_ins->getStoreWidth());
 
-                    uint64_t store_address = 0;
-                    uint16_t store_width = 0;
+                switch (evaluateAddressOverlap(load_address, load_ins->getLoadWidth(), store_address,
+                                               check_store_ins->getStoreWidth())) {
 
-                    check_store_ins->computeStoreAddress(output, registerFiles->at(load_ins->getHWThread()),
-                                                         &store_address, &store_width);
+                case OVERLAP_FREE:
+                    // Nothing to do here, load must be issued still.
+                    output->verbose(CALL_INFO, 16, 0, "-> LSQ compare -> require load, overlap-free\n");
+                    load_eval = REQUIRE_LOAD;
+                    break;
 
+                case PARTIAL_COVERAGE:
+                    // This is a stop condition for searching, we need to wait
+                    // for the store to retire as we can only get *some* of the
+                    // data we need from the register
                     output->verbose(CALL_INFO, 16, 0,
-                                    "-> LSQ compare load (0x%0llx, width=%" PRIu16
-                                    ") to store at (0x%0llx, width=%" PRIu16 ")\n",
-                                    load_address, load_width, store_address, store_width);
-
-                    switch (evaluateAddressOverlap(load_address, load_ins->getLoadWidth(), store_address,
-                                                   check_store_ins->getStoreWidth())) {
-
-                    case OVERLAP_FREE:
-                        // Nothing to do here, load must be issued still.
-                        output->verbose(CALL_INFO, 16, 0, "-> LSQ compare -> require load, overlap-free\n");
-                        load_eval = REQUIRE_LOAD;
-                        break;
-
-                    case PARTIAL_COVERAGE:
-                        // This is a stop condition for searching, we need to wait
-                        // for the store to retire as we can only get *some* of the
-                        // data we need from the register
-                        output->verbose(CALL_INFO, 16, 0,
-                                        "-> LSQ compare -> partial store coverage, requires stall and "
-                                        "re-eval when store completed.\n");
-                        load_eval = STALL_PROCESSING;
-                        break;
-
-                    case STORE_COVERS_LOAD: {
-                        output->verbose(CALL_INFO, 16, 0,
-                                        "-> LSQ compare -> load can be forwarded from associated "
-                                        "store, process load from existing register contents...\n");
-                        // We can forward result from register back to load
-                        VanadisRegisterFile* reg_file = registerFiles->at(load_ins->getHWThread());
+                                    "-> LSQ compare -> partial store coverage, requires stall and "
+                                    "re-eval when store completed.\n");
+                    load_eval = STALL_PROCESSING;
+                    break;
 
-                        const uint64_t store_value
-                            = reg_file->getIntReg<uint64_t>(check_store_ins->getPhysIntRegIn()[1]);
+                case STORE_COVERS_LOAD: {
+                    output->verbose(CALL_INFO, 16, 0,
+                                    "-> LSQ compare -> load can be forwarded from associated "
+                                    "store, process load from existing register contents...\n");
+                    // We can forward result from register back to load
+                    VanadisRegisterFile* reg_file = registerFiles->at(load_ins->getHWThread());
 
-                        reg_file->setIntReg(load_ins->getPhysIntRegOut()[0], store_value);
+                    const uint64_t store_value = reg_file->getIntReg<uint64_t>(check_store_ins->getPhysIntRegIn()[1]);
 
-                        output->verbose(CALL_INFO, 16, 0, "---> load marked executed, load contents forwarded.\n");
-                        load_ins->markExecuted();
-                        load_eval = FORWARD_STORE;
-                    } break;
-                    default:
-                        break;
-                    }
+                    reg_file->setIntReg(load_ins->getPhysIntRegOut()[0], store_value);
 
+                    output->verbose(CALL_INFO, 16, 0, "---> load marked executed, load contents forwarded.\n");
+                    load_ins->markExecuted();
+                    load_eval = FORWARD_STORE;
+                } break;
+                default:
                     break;
                 }
             }
@@ -379,8 +521,10 @@ public:
                         load_ins->markExecuted();
                     }
 
-                    // Remove this load from the queue and fix up the iterator
-                    next_load = load_q.erase(next_load);
+                    // Remove this load from the queue, the slot is reclaimed once it
+                    // reaches the front
+                    delete load_record;
+                    load_q->peekAt(next_load) = nullptr;
                     pending_queued_loads--;
                 } else {
                     output->verbose(CALL_INFO, 16, 0,
@@ -392,12 +536,13 @@ public:
                 // Store forwarding has already been done, load record is cleared to be
                 // removed as we have satisfied the data request
                 output->verbose(CALL_INFO, 16, 0, "-> LSQ load is resolved by store forward, clear from queue\n");
-                next_load = load_q.erase(next_load);
+                delete load_record;
+                load_q->peekAt(next_load) = nullptr;
                 pending_queued_loads--;
-            } else {
-                next_load++;
             }
         }
+
+        load_q->popEmpty();
     }
 
     int tick_stores(const uint64_t cycle) {
@@ -508,6 +653,15 @@ public:
                                     " bytes\n",
                                     (void*)store_address, store_address, store_width);
 
+                    // Decoded copies of this address are no longer valid
+                    if (nullptr != code_pages) {
+                        code_pages->notifyStore(store_address, payload.size());
+                    }
+
+                    if (nullptr != written_pages) {
+                        written_pages->record(store_address, payload.size());
+                    }
+
                     memInterface->send(new_store_req);
                     pending_stores.insert(new_store_req->getID());
 
@@ -517,6 +671,7 @@ public:
                         // Mark the instruction as executed and clear it from our queue
                         front_store->markExecuted();
                         store_q->pop();
+                        removeFromStoreIndex(front_record);
 
                         // delete the record, but not the instruction
                         // the main core ROB engine will do that for us
@@ -698,6 +853,7 @@ public:
                 } else {
                     VanadisStoreRecord* front_record = lsq->store_q->pop();
                     VanadisStoreInstruction* front_store = front_record->getAssociatedInstruction();
+                    lsq->removeFromStoreIndex(front_record);
 
                     if (front_store->getTransactionType() != MEM_TRANSACTION_LLSC_STORE) {
                         out->fatal(CALL_INFO, -1,
@@ -743,6 +899,12 @@ public:
             lsq->pending_stores.erase(check_ev_exists);
             lsq->pending_mem_issued_stores--;
         }
+
+        virtual void handle(StandardMem::FlushResp* ev) {
+            out->verbose(CALL_INFO, 16, 0, "-> LSQ flush of 0x%llx complete.\n", ev->pAddr);
+            lsq->pending_flushes--;
+            delete ev;
+        }
     
         VanadisStandardLoadStoreQueue* lsq;
     };
@@ -763,23 +925,26 @@ public:
             }
         }
 
-        for (auto load_q_itr = load_q.begin(); load_q_itr != load_q.end();) {
-            if ((*load_q_itr)->getAssociatedInstruction()->getHWThread() == thr) {
-                delete (*load_q_itr);
-                load_q_itr = load_q.erase(load_q_itr);
+        for (size_t load_q_itr = 0; load_q_itr < load_q->size(); load_q_itr++) {
+            VanadisLoadRecord*& load_record = load_q->peekAt(load_q_itr);
+
+            if ((nullptr != load_record) && (load_record->getAssociatedInstruction()->getHWThread() == thr)) {
+                delete load_record;
+                load_record = nullptr;
                 pending_queued_loads--;
-            } else {
-                load_q_itr++;
             }
         }
 
+        load_q->compact();
+
         VanadisCircularQueue<VanadisStoreRecord*>* sq_tmp
-            = new VanadisCircularQueue<VanadisStoreRecord*>(max_queued_stores);
+            = new VanadisCircularQueue<VanadisStoreRecord*>(store_q->capacity());
 
-        for (size_t sq_itr = 0; sq_itr < store_q->size(); sq_itr++) {
+        while (!store_q->empty()) {
             VanadisStoreRecord* tmp_srec = store_q->pop();
 
             if (tmp_srec->getAssociatedInstruction()->getHWThread() == thr) {
+                removeFromStoreIndex(tmp_srec);
                 delete tmp_srec;
             } else {
                 sq_tmp->push(tmp_srec);
@@ -793,7 +958,13 @@ public:
 
 protected:
     VanadisCircularQueue<VanadisStoreRecord*>* store_q;
-    std::list<VanadisLoadRecord*> load_q;
+    VanadisRingBuffer<VanadisLoadRecord*>* load_q;
+
+    // Queued stores by the address blocks they touch
+    std::vector<std::vector<VanadisStoreRecord*>> store_index;
+    std::vector<VanadisStoreRecord*> unindexed_stores;
+    uint64_t store_index_mask;
+    uint32_t store_index_line_shift;
 
     StandardMem* memInterface;
 
@@ -817,6 +988,7 @@ protected:
     std::map<StandardMem::Request::id_t, VanadisLoadRecord*> pending_loads;
 
     bool processingLLSC;
+    uint64_t next_mem_op_seq;
 
     StandardMemHandlers* std_mem_handlers;
 
@@ -56,6 +56,25 @@ public:
         memory_state[line] = line_value;
     }
 
+    // Whole lines are marked a line at a time, the partial lines at either
+    // end a byte at a time
+    void markRange(uint64_t byte_addr, uint64_t length) {
+        const uint64_t end = byte_addr + length;
+
+        while ((byte_addr < end) && ((byte_addr % 64) != 0)) {
+            markByte(byte_addr++);
+        }
+
+        while ((byte_addr + 64) <= end) {
+            memory_state[byte_addr / 64] = ~((uint64_t)0);
+            byte_addr += 64;
+        }
+
+        while (byte_addr < end) {
+            markByte(byte_addr++);
+        }
+    }
+
     bool isMarked(uint64_t byte_addr) {
         uint64_t line = byte_addr / 64;
         uint64_t line_offset = byte_addr % 64;
@@ -18,6 +18,7 @@
 
 #include "os/callev/voscallaccessev.h"
 #include "os/callev/voscallbrk.h"
+#include "os/callev/voscallcheckpoint.h"
 #include "os/callev/voscallclose.h"
 #include "os/callev/voscallexitgrp.h"
 #include "os/callev/voscallfstat.h"
@@ -19,6 +19,7 @@
 #include <cassert>
 #include <cinttypes>
 #include <cstdint>
+#include <cstdio>
 #include <unordered_set>
 
 namespace SST {
@@ -139,6 +140,56 @@ public:
         }
     }
 
+    // Records the pages handed out so far, the free set is usually much
+    // larger so it is rebuilt from the region on restore
+    void writeCheckpoint(FILE* out) const {
+        uint64_t allocated_count = 0;
+
+        for (uint64_t page_start = region_start; page_start < region_end; page_start += region_page_size) {
+            if (free_pages.find(page_start) == free_pages.end()) {
+                allocated_count++;
+            }
+        }
+
+        fprintf(out, "mmap 0x%" PRIx64 " 0x%" PRIx64 " %" PRIu64 " %" PRIu64 " %" PRIu64 "\n", region_start,
+                region_end, region_page_size, region_pages_in_use_count, allocated_count);
+
+        for (uint64_t page_start = region_start; page_start < region_end; page_start += region_page_size) {
+            if (free_pages.find(page_start) == free_pages.end()) {
+                fprintf(out, "0x%" PRIx64 "\n", page_start);
+            }
+        }
+    }
+
+    // Returns false if the checkpoint is malformed or was taken with a
+    // different heap region
+    bool restoreCheckpoint(FILE* in) {
+        uint64_t ckpt_start = 0;
+        uint64_t ckpt_end = 0;
+        uint64_t ckpt_page_size = 0;
+        uint64_t ckpt_in_use = 0;
+        uint64_t allocated_count = 0;
+
+        if ((5 != fscanf(in, " mmap 0x%" SCNx64 " 0x%" SCNx64 " %" SCNu64 " %" SCNu64 " %" SCNu64, &ckpt_start,
+                         &ckpt_end, &ckpt_page_size, &ckpt_in_use, &allocated_count)) ||
+            (ckpt_start != region_start) || (ckpt_end != region_end) || (ckpt_page_size != region_page_size)) {
+            return false;
+        }
+
+        for (uint64_t i = 0; i < allocated_count; ++i) {
+            uint64_t page_start = 0;
+
+            if (1 != fscanf(in, " 0x%" SCNx64, &page_start)) {
+                return false;
+            }
+
+            free_pages.erase(page_start);
+        }
+
+        region_pages_in_use_count = ckpt_in_use;
+        return true;
+    }
+
 protected:
     SST::Output* output;
     std::unordered_set<uint64_t> free_pages;
@@ -25,7 +25,7 @@ namespace Vanadis {
 
 class VanadisOSFileDescriptor {
 public:
-    VanadisOSFileDescriptor(uint32_t desc_id, const char* file_path) : file_id(desc_id) {
+    VanadisOSFileDescriptor(uint32_t desc_id, const char* file_path) : file_id(desc_id), open_mode("w+") {
 
         if (nullptr != file_path) {
             file_handle = fopen(file_path, "w+");
@@ -36,8 +36,8 @@ public:
         path = file_path;
     }
 
-    VanadisOSFileDescriptor(uint32_t desc_id, const char* file_path, FILE* f_handle)
-        : file_id(desc_id), file_handle(f_handle) {
+    VanadisOSFileDescriptor(uint32_t desc_id, const char* file_path, FILE* f_handle, const char* f_mode)
+        : file_id(desc_id), open_mode(f_mode), file_handle(f_handle) {
 
         path = file_path;
     }
@@ -54,6 +54,11 @@ public:
         }
     }
 
+    // Mode the file was opened with, used to reopen it from a checkpoint
+    const char* getOpenMode() const { return open_mode.c_str(); }
+
+    int64_t getOffset() const { return (nullptr == file_handle) ? 0 : (int64_t)ftell(file_handle); }
+
     FILE* getFileHandle() {
         if (nullptr == file_handle) {
             file_handle = fopen(path.c_str(), "rw");
@@ -71,6 +76,7 @@ public:
 protected:
     const uint32_t file_id;
     std::string path;
+    std::string open_mode;
     FILE* file_handle;
 };
 
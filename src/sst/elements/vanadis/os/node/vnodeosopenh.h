@@ -56,16 +56,20 @@ public:
             }
 
             FILE* file_ptr = nullptr;
+            const char* fopen_mode = "";
 
             switch (open_mode) {
             case 0: {
-                file_ptr = fopen(open_path_cstr, "r");
+                fopen_mode = "r";
+                file_ptr = fopen(open_path_cstr, fopen_mode);
             } break;
             case 1: {
-                file_ptr = fopen(open_path_cstr, "w");
+                fopen_mode = "w";
+                file_ptr = fopen(open_path_cstr, fopen_mode);
             } break;
             case 2: {
-                file_ptr = fopen(open_path_cstr, "rw");
+                fopen_mode = "rw";
+                file_ptr = fopen(open_path_cstr, fopen_mode);
             } break;
             default: {
                 // set return code to invalid flags (EINVAL)
@@ -87,7 +91,7 @@ public:
                 output->verbose(CALL_INFO, 16, 0, "[syscall-open] new descriptor at %" PRIu32 "\n", opened_fd_handle);
 
                 file_descriptors->insert(std::pair<uint32_t, VanadisOSFileDescriptor*>(
-                    opened_fd_handle, new VanadisOSFileDescriptor(opened_fd_handle, open_path_cstr, file_ptr)));
+                    opened_fd_handle, new VanadisOSFileDescriptor(opened_fd_handle, open_path_cstr, file_ptr, fopen_mode)));
             }
 
             markComplete();
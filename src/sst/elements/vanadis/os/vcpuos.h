@@ -67,6 +67,9 @@ public:
 
     virtual void registerInitParameter(VanadisCPUOSInitParameter paramType, void* param_val) = 0;
 
+    // Tells the node OS this core has written its checkpoint and stopped
+    virtual void notifyCheckpoint() = 0;
+
     void setThreadID(int64_t new_tid) { tid = new_tid; }
     int64_t getThreadID() const { return tid; }
 
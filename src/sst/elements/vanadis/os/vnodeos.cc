@@ -62,6 +62,17 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
 
     memory_mgr = new VanadisMemoryManager(heap_verbose, heap_start, heap_end, heap_page_size);
 
+    checkpoint_path = params.find<std::string>("checkpoint_file", "");
+    restore_path = params.find<std::string>("restore_file", "");
+    checkpointed_cores = 0;
+
+    if (checkpoint_path != "") {
+        // The OS flushes the pages it wrote once every core has checkpointed,
+        // the simulation cannot end until those flushes complete
+        registerAsPrimaryComponent();
+        primaryComponentDoNotEndSim();
+    }
+
     for (uint32_t i = 0; i < core_count; ++i) {
         snprintf(port_name_buffer, 128, "core%" PRIu32 "", i);
         output->verbose(CALL_INFO, 1, 0, "---> processing link %s...\n", port_name_buffer);
@@ -113,6 +124,98 @@ VanadisNodeOSComponent::init(unsigned int phase) {
     }
 }
 
+void
+VanadisNodeOSComponent::setup() {
+    if (restore_path == "") {
+        return;
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Restoring OS state from checkpoint %s...\n", restore_path.c_str());
+    FILE* restore_file = fopen(restore_path.c_str(), "rt");
+
+    if (nullptr == restore_file) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open OS checkpoint file %s\n", restore_path.c_str());
+    }
+
+    uint32_t version = 0;
+    uint64_t core_count = 0;
+
+    if ((2 != fscanf(restore_file, " vanadis-node-os-checkpoint %" SCNu32 " cores %" SCNu64, &version, &core_count)) ||
+        (VANADIS_CHECKPOINT_VERSION != version) || (core_count != core_handlers.size())) {
+        output->fatal(CALL_INFO, -1,
+                      "Error: %s is not a version %d OS checkpoint for %" PRIu64 " cores.\n", restore_path.c_str(),
+                      VANADIS_CHECKPOINT_VERSION, (uint64_t)core_handlers.size());
+    }
+
+    if (!memory_mgr->restoreCheckpoint(restore_file)) {
+        output->fatal(CALL_INFO, -1, "Error: mmap state in %s is malformed or does not match the heap parameters.\n",
+                      restore_path.c_str());
+    }
+
+    for (VanadisNodeOSCoreHandler* next_handler : core_handlers) {
+        if (!next_handler->restoreCheckpoint(restore_file)) {
+            output->fatal(CALL_INFO, -1, "Error: state for core %" PRIu32 " in %s is malformed.\n",
+                          next_handler->getCoreID(), restore_path.c_str());
+        }
+    }
+
+    fclose(restore_file);
+}
+
+void
+VanadisNodeOSComponent::finish() {
+    // A core stops once it has checkpointed, the OS state only matches the
+    // core checkpoints if every core stopped that way
+    if ((checkpoint_path != "") && (checkpointed_cores < core_handlers.size())) {
+        output->fatal(CALL_INFO, -1,
+                      "Error: OS checkpoint %s not written, only %" PRIu32 " of %" PRIu64 " cores wrote a checkpoint. "
+                      "Every core needs checkpoint_file and a fast-forward point.\n",
+                      checkpoint_path.c_str(), checkpointed_cores, (uint64_t)core_handlers.size());
+    }
+}
+
+void
+VanadisNodeOSComponent::flushWrittenPages() {
+    const uint64_t line_width = (mem_if->getLineSize() > 0) ? mem_if->getLineSize() : 64;
+
+    for (const uint64_t page_start : written_pages.take()) {
+        for (uint64_t line = page_start; line < (page_start + VANADIS_CHECKPOINT_PAGE_SIZE); line += line_width) {
+            StandardMem::Request* flush_req = new StandardMem::FlushAddr(line, line_width, false, 10);
+            pending_flushes.insert(flush_req->getID());
+            mem_if->send(flush_req);
+        }
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Flushing %" PRIu64 " lines written by the OS before checkpointing...\n",
+                    (uint64_t)pending_flushes.size());
+
+    // Otherwise the checkpoint is written when the last flush completes
+    if (pending_flushes.empty()) {
+        writeCheckpoint();
+    }
+}
+
+void
+VanadisNodeOSComponent::writeCheckpoint() {
+    output->verbose(CALL_INFO, 1, 0, "Writing OS checkpoint to %s...\n", checkpoint_path.c_str());
+    FILE* checkpoint_file = fopen(checkpoint_path.c_str(), "wt");
+
+    if (nullptr == checkpoint_file) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open OS checkpoint file %s\n", checkpoint_path.c_str());
+    }
+
+    fprintf(checkpoint_file, "vanadis-node-os-checkpoint %d cores %" PRIu64 "\n", VANADIS_CHECKPOINT_VERSION,
+            (uint64_t)core_handlers.size());
+    memory_mgr->writeCheckpoint(checkpoint_file);
+
+    for (VanadisNodeOSCoreHandler* next_handler : core_handlers) {
+        next_handler->writeCheckpoint(checkpoint_file);
+    }
+
+    fclose(checkpoint_file);
+    primaryComponentOKToEndSim();
+}
+
 void
 VanadisNodeOSComponent::handleIncomingSysCall(SST::Event* ev) {
     VanadisSyscallEvent* sys_ev = dynamic_cast<VanadisSyscallEvent*>(ev);
@@ -123,6 +226,17 @@ VanadisNodeOSComponent::handleIncomingSysCall(SST::Event* ev) {
                       "a system-call event.\n");
     }
 
+    if (SYSCALL_OP_CHECKPOINT == sys_ev->getOperation()) {
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " has written its checkpoint\n", sys_ev->getCoreID());
+
+        if ((checkpoint_path != "") && (++checkpointed_cores == core_handlers.size())) {
+            flushWrittenPages();
+        }
+
+        delete sys_ev;
+        return;
+    }
+
     output->verbose(CALL_INFO, 16, 0, "Call from core: %" PRIu32 ", thr: %" PRIu32 " -> calling handler...\n",
                     sys_ev->getCoreID(), sys_ev->getThreadID());
 
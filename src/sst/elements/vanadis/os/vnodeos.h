@@ -25,6 +25,7 @@
 #include "os/vnodeoshandler.h"
 
 #include "os/memmgr/vmemmgr.h"
+#include "vcheckpoint.h"
 
 using namespace SST::Interfaces;
 
@@ -40,7 +41,12 @@ public:
     SST_ELI_DOCUMENT_PARAMS({ "verbose", "Set the output verbosity, 0 is no output, higher is more." },
                             { "cores", "Number of cores that can request OS services via a link." },
                             { "stdout", "File path to place stdout" }, { "stderr", "File path to place stderr" },
-                            { "stdin", "File path to place stdin" })
+                            { "stdin", "File path to place stdin" },
+                            { "checkpoint_file", "Write the brk, mmap and open file state of the OS to this file once "
+                                                 "every core has written its checkpoint_file, empty disables "
+                                                 "checkpointing", "" },
+                            { "restore_file", "Restore the OS state from a file written by checkpoint_file before "
+                                              "simulation starts, empty disables restoring", "" })
 
     SST_ELI_DOCUMENT_PORTS({ "core%(cores)d", "Connects to a CPU core", {} })
 
@@ -51,9 +57,21 @@ public:
     ~VanadisNodeOSComponent();
 
     virtual void init(unsigned int phase);
+    void setup();
+    void finish();
     void handleIncomingSysCall(SST::Event* ev);
 
     void handleIncomingMemory(StandardMem::Request* ev) {
+        if (pending_flushes.erase(ev->getID()) > 0) {
+            delete ev;
+
+            if (pending_flushes.empty()) {
+                writeCheckpoint();
+            }
+
+            return;
+        }
+
         auto lookup_result = ev_core_map.find(ev->getID());
 
         if (lookup_result == ev_core_map.end()) {
@@ -66,6 +84,15 @@ public:
     }
 
     void sendMemoryEvent(StandardMem::Request* ev, uint32_t core) {
+        // Pages written by the OS are flushed before it checkpoints
+        if (checkpoint_path != "") {
+            StandardMem::Write* write_req = dynamic_cast<StandardMem::Write*>(ev);
+
+            if (nullptr != write_req) {
+                written_pages.record(write_req->pAddr, write_req->size);
+            }
+        }
+
         ev_core_map.insert(std::pair<StandardMem::Request::id_t, uint32_t>(ev->getID(), core));
         mem_if->send(ev);
     }
@@ -77,6 +104,9 @@ private:
     VanadisNodeOSComponent(const VanadisNodeOSComponent&); // do not implement
     void operator=(const VanadisNodeOSComponent&);         // do not implement
 
+    void flushWrittenPages();
+    void writeCheckpoint();
+
     std::function<uint64_t()> get_sim_nano;
     std::unordered_map<StandardMem::Request::id_t, uint32_t> ev_core_map;
     std::vector<SST::Link*> core_links;
@@ -85,6 +115,12 @@ private:
     StandardMem* mem_if;
     VanadisMemoryManager* memory_mgr;
 
+    std::string checkpoint_path;
+    std::string restore_path;
+    uint32_t checkpointed_cores;
+    VanadisWrittenPages written_pages;
+    std::unordered_set<StandardMem::Request::id_t> pending_flushes;
+
     SST::Output* output;
 };
 
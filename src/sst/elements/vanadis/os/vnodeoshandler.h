@@ -23,6 +23,9 @@
 #include <sst/core/link.h>
 #include <sst/core/output.h>
 
+#include <climits>
+#include <cstdio>
+#include <cstring>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -796,6 +799,80 @@ public:
 
     void setSimTimeNano(std::function<uint64_t()>& sim_time) { getSimTimeNano = sim_time; }
 
+    void writeCheckpoint(FILE* out) {
+        fprintf(out, "core %" PRIu32 " brk 0x%" PRIx64 " files %" PRIu64 "\n", core_id, current_brk_point,
+                (uint64_t)file_descriptors.size());
+
+        // Path goes last as it runs to the end of the line
+        for (auto next_file = file_descriptors.begin(); next_file != file_descriptors.end(); next_file++) {
+            fprintf(out, "fd %" PRIu32 " %" PRId64 " %s %s\n", next_file->first, next_file->second->getOffset(),
+                    next_file->second->getOpenMode(), next_file->second->getPath());
+        }
+    }
+
+    // Descriptors which are already open (stdin/stdout/stderr from the
+    // component parameters) are kept, the rest are reopened at the offset
+    // they had when the checkpoint was taken. Files opened for writing are
+    // not truncated again.
+    bool restoreCheckpoint(FILE* in) {
+        uint32_t ckpt_core = 0;
+        uint64_t ckpt_brk = 0;
+        uint64_t file_count = 0;
+
+        if ((3 != fscanf(in, " core %" SCNu32 " brk 0x%" SCNx64 " files %" SCNu64, &ckpt_core, &ckpt_brk,
+                         &file_count)) ||
+            (ckpt_core != core_id)) {
+            return false;
+        }
+
+        current_brk_point = ckpt_brk;
+
+        for (uint64_t i = 0; i < file_count; ++i) {
+            uint32_t fd = 0;
+            int64_t offset = 0;
+            char mode[16];
+            char path[PATH_MAX + 2];
+
+            if ((3 != fscanf(in, " fd %" SCNu32 " %" SCNd64 " %15s", &fd, &offset, mode)) ||
+                (nullptr == fgets(path, sizeof(path), in))) {
+                return false;
+            }
+
+            const size_t path_len = strlen(path);
+
+            if ((path_len > 0) && (path[path_len - 1] == '\n')) {
+                path[path_len - 1] = '\0';
+            }
+
+            // Skip the separating space, the path may itself contain spaces
+            const char* path_start = (path[0] == ' ') ? (path + 1) : path;
+
+            if (file_descriptors.find(fd) != file_descriptors.end()) {
+                output->verbose(CALL_INFO, 8, 0, "checkpoint descriptor %" PRIu32 " is already open, keeping it\n",
+                                fd);
+                continue;
+            }
+
+            FILE* file_ptr = fopen(path_start, (mode[0] == 'w') ? "r+" : mode);
+
+            if ((nullptr == file_ptr) && (mode[0] == 'w')) {
+                file_ptr = fopen(path_start, mode);
+            }
+
+            if (nullptr == file_ptr) {
+                output->fatal(CALL_INFO, -1, "Error: unable to reopen \'%s\' for checkpoint descriptor %" PRIu32 "\n",
+                              path_start, fd);
+            }
+
+            fseek(file_ptr, (long)offset, SEEK_SET);
+
+            file_descriptors.insert(std::pair<uint32_t, VanadisOSFileDescriptor*>(
+                fd, new VanadisOSFileDescriptor(fd, path_start, file_ptr, mode)));
+        }
+
+        return true;
+    }
+
     void setMemoryManager(VanadisMemoryManager* mem_m) { memory_mgr = mem_m; }
 
 protected:
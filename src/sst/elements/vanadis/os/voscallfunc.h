@@ -38,7 +38,8 @@ enum VanadisSyscallOp {
     SYSCALL_OP_MMAP,
     SYSCALL_OP_UNMAP,
     SYSCALL_OP_EXIT_GROUP,
-    SYSCALL_OP_GETTIME64
+    SYSCALL_OP_GETTIME64,
+    SYSCALL_OP_CHECKPOINT
 };
 
 }
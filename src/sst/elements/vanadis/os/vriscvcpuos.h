@@ -84,6 +84,10 @@ public:
         }
     }
 
+    virtual void notifyCheckpoint() {
+        os_link->send(new VanadisSyscallCheckpointEvent(core_id, hw_thr, VanadisOSBitType::VANADIS_OS_64B));
+    }
+
     virtual void handleSysCall(VanadisSysCallInstruction* syscallIns) {
         const uint16_t call_link_reg = isaTable->getIntPhysReg(31);
         uint64_t call_link_value = regFile->getIntReg<uint64_t>(call_link_reg);
@@ -12,6 +12,7 @@ verbosity = int(os.getenv("VANADIS_VERBOSE", 0))
 os_verbosity = os.getenv("VANADIS_OS_VERBOSE", verbosity)
 pipe_trace_file = os.getenv("VANADIS_PIPE_TRACE", "")
 lsq_entries = os.getenv("VANADIS_LSQ_ENTRIES", 32)
+lsq_type = os.getenv("VANADIS_LSQ", "vanadis.VanadisSequentialLoadStoreQueue")
 
 rob_slots = os.getenv("VANADIS_ROB_SLOTS", 64)
 retires_per_cycle = os.getenv("VANADIS_RETIRES_PER_CYCLE", 4)
@@ -28,6 +29,14 @@ auto_clock_sys = os.getenv("VANADIS_AUTO_CLOCK_SYSCALLS", "no")
 
 cpu_clock = os.getenv("VANADIS_CPU_CLOCK", "2.3GHz")
 
+# Checkpoint and restore. Run once with VANADIS_FAST_FORWARD and
+# VANADIS_CHECKPOINT_DIR set to write the core, OS and memory state to that
+# directory when fast-forwarding ends, then again with VANADIS_RESTORE_DIR
+# pointing at it to continue from there in detailed mode.
+fast_forward = int(os.getenv("VANADIS_FAST_FORWARD", 0))
+checkpoint_dir = os.getenv("VANADIS_CHECKPOINT_DIR", "")
+restore_dir = os.getenv("VANADIS_RESTORE_DIR", "")
+
 vanadis_cpu_type = "vanadisdbg.VanadisCPU"
 
 #if (verbosity > 0):
@@ -83,6 +92,15 @@ v_cpu_0.addParams({
 #       "retires_per_cycle" : 1
 })
 
+if fast_forward > 0:
+	v_cpu_0.addParams({ "fast_forward_instructions" : fast_forward })
+
+if checkpoint_dir != "":
+	v_cpu_0.addParams({ "checkpoint_file" : checkpoint_dir + "/core0.ckpt" })
+
+if restore_dir != "":
+	v_cpu_0.addParams({ "restore_file" : restore_dir + "/core0.ckpt" })
+
 app_args = os.getenv("VANADIS_EXE_ARGS", "")
 
 if app_args != "":
@@ -124,8 +142,9 @@ branch_pred.addParams({
 
 icache_if = v_cpu_0.setSubComponent( "mem_interface_inst", "memHierarchy.standardInterface" )
 
-#v_cpu_0_lsq = v_cpu_0.setSubComponent( "lsq", "vanadis.VanadisStandardLoadStoreQueue" )
-v_cpu_0_lsq = v_cpu_0.setSubComponent( "lsq", "vanadis.VanadisSequentialLoadStoreQueue" )
+# VANADIS_LSQ=vanadis.VanadisStandardLoadStoreQueue selects the out of
+# order LSQ, which forwards queued stores to loads
+v_cpu_0_lsq = v_cpu_0.setSubComponent( "lsq", lsq_type )
 v_cpu_0_lsq.addParams({
 	"verbose" : verbosity,
 	"address_mask" : 0xFFFFFFFF,
@@ -150,6 +169,12 @@ node_os.addParams({
 	"heap_verbose" : 0 #verbosity
 })
 
+if checkpoint_dir != "":
+	node_os.addParams({ "checkpoint_file" : checkpoint_dir + "/os.ckpt" })
+
+if restore_dir != "":
+	node_os.addParams({ "restore_file" : restore_dir + "/os.ckpt" })
+
 node_os_mem_if = node_os.setSubComponent( "mem_interface", "memHierarchy.standardInterface" )
 
 os_l1dcache = sst.Component("node_os.l1dcache", "memHierarchy.Cache")
@@ -256,6 +281,12 @@ memctrl.addParams({
       "backend.mem_size" : "4GiB",
       "backing" : "malloc"
 })
+
+if checkpoint_dir != "":
+	memctrl.addParams({ "backing_out_file" : checkpoint_dir + "/memory.ckpt" })
+
+if restore_dir != "":
+	memctrl.addParams({ "backing_in_file" : restore_dir + "/memory.ckpt" })
 memToDir = memctrl.setSubComponent("cpulink", "memHierarchy.MemLink")
 
 memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
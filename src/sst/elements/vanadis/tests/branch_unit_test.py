@@ -0,0 +1,44 @@
+import os
+import sst
+
+# Runs each branch unit against a synthetic branch trace with a known number
+# of mispredictions. Nothing is simulated after setup, each tester checks its
+# own unit and stops the run with an error if the count is wrong.
+
+verbosity = int(os.getenv("VANADIS_VERBOSE", 0))
+
+iterations = 1000
+warmup = 100
+loop_trip = 8
+call_sites = 4
+
+measured = iterations - warmup
+
+tests = [
+    # A two bit counter mispredicts every loop exit
+    ("btb_loop", "vanadis.VanadisBTBBranchUnit", {}, "loop", measured, measured),
+    # A 12 bit history covers the whole trip, so every outcome is learnt
+    ("gshare_loop", "vanadis.VanadisGShareBranchUnit", {}, "loop", 0, 0),
+    ("tage_loop", "vanadis.VanadisTAGEBranchUnit", {}, "loop", 0, 0),
+    # The return address stack predicts every return
+    ("btb_calls", "vanadis.VanadisBTBBranchUnit", {}, "calls", 0, 0),
+    # Without it each return goes to the previous call site
+    ("btb_calls_no_ras", "vanadis.VanadisBTBBranchUnit", { "ras_entries" : 0 }, "calls",
+        measured * call_sites, measured * call_sites),
+]
+
+for name, unit_type, unit_params, trace, min_mispredicts, max_mispredicts in tests:
+    tester = sst.Component(name, "vanadis.VanadisBranchTester")
+    tester.addParams({
+        "verbose" : verbosity,
+        "trace" : trace,
+        "iterations" : iterations,
+        "warmup" : warmup,
+        "loop_trip" : loop_trip,
+        "call_sites" : call_sites,
+        "min_mispredicts" : min_mispredicts,
+        "max_mispredicts" : max_mispredicts,
+    })
+
+    branch_unit = tester.setSubComponent("branch_unit", unit_type)
+    branch_unit.addParams(unit_params)
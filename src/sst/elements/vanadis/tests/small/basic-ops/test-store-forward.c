@@ -0,0 +1,77 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Loads that closely follow stores to the same bytes, so the load/store
+// queue has to forward the store data, or hold the load back until the
+// store has been written, to get the right answer.
+
+union line {
+	uint64_t d[8];
+	uint32_t w[16];
+	uint16_t h[32];
+	uint8_t  b[64];
+};
+
+static volatile union line buffer[4];
+
+int main( int argc, char* argv[] ) {
+
+	uint64_t exact = 0;
+	uint64_t narrow = 0;
+	uint64_t wide = 0;
+	uint64_t unaligned = 0;
+	uint64_t youngest = 0;
+
+	for( int i = 0; i < 256; ++i ) {
+		const int slot = i % 8;
+		volatile union line* l = &buffer[i % 4];
+
+		// Load the same bytes as the store
+		l->w[slot] = 0x01010101u * (uint32_t) i;
+		exact += l->w[slot];
+
+		// Load part of a wider store
+		l->d[slot] = 0x0102030405060708ull * (uint64_t) (i + 1);
+		narrow += l->h[(slot * 4) + 1] + l->b[(slot * 8) + 5];
+
+		// Load over several narrower stores
+		l->b[(slot * 8) + 0] = (uint8_t) i;
+		l->b[(slot * 8) + 1] = (uint8_t) (i + 1);
+		l->h[(slot * 4) + 1] = (uint16_t) (i * 3);
+		wide += l->w[slot * 2];
+
+		// Bytes either side of a word boundary
+		volatile uint8_t* p = &l->b[(slot * 8) + 3];
+		p[0] = (uint8_t) (i * 5);
+		p[1] = (uint8_t) (i * 7);
+		unaligned += p[0] + (p[1] << 8);
+
+		// Two stores to the same word, the load must see the second
+		l->w[(slot * 2) + 1] = (uint32_t) i;
+		l->w[(slot * 2) + 1] = (uint32_t) (i << 4);
+		youngest += l->w[(slot * 2) + 1];
+	}
+
+	printf("exact: %llu\n", (unsigned long long) exact);
+	printf("narrow: %llu\n", (unsigned long long) narrow);
+	printf("wide: %llu\n", (unsigned long long) wide);
+	printf("unaligned: %llu\n", (unsigned long long) unaligned);
+	printf("youngest: %llu\n", (unsigned long long) youngest);
+
+	return 0;
+}
@@ -27,6 +27,9 @@ def build_vanadis_test_matrix():
     testlist.append(["basic_vanadis.py", "small/basic-math", "sqrt-float", 300])
     testlist.append(["basic_vanadis.py", "small/basic-ops", "test-branch", 300])
     testlist.append(["basic_vanadis.py", "small/basic-ops", "test-shift", 300])
+    testlist.append(["basic_vanadis.py", "small/basic-ops", "test-store-forward", 300])
+    # Same program through the LSQ which forwards queued stores to loads
+    testlist.append(["basic_vanadis.py", "small/basic-ops", "test-store-forward", 300, "vanadis.VanadisStandardLoadStoreQueue"])
 
     # Process each line and crack up into an index, hash, options and sdl file
     for testnum, test_info in enumerate(testlist):
@@ -36,10 +39,13 @@ def build_vanadis_test_matrix():
         elftestdir = test_info[1]
         elffile = test_info[2]
         timeout_sec = test_info[3]
+        lsq_type = test_info[4] if len(test_info) > 4 else "vanadis.VanadisSequentialLoadStoreQueue"
         testname = "{0}_{1}".format(elftestdir.replace("/", "_"), elffile)
+        if len(test_info) > 4:
+            testname = "{0}_{1}".format(testname, lsq_type.split(".")[-1])
 
         # Build the test_data structure
-        test_data = (testnum, testname, sdlfile, elftestdir, elffile, timeout_sec)
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, lsq_type)
         vanadis_test_matrix.append(test_data)
 
 ################################################################################
@@ -95,18 +101,33 @@ class testcase_vanadis(SSTTestCase):
 #####
 
     @parameterized.expand(vanadis_test_matrix, name_func=gen_custom_name)
-    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, timeout_sec):
+    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, lsq_type):
         self._checkSkipConditions()
 
         log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec))
-        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec)
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, lsq_type)
+
+    def test_vanadis_branch_units(self):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/branch_unit_test.py".format(test_path)
+        outfile = "{0}/test_vanadis_branch_units.out".format(outdir)
+
+        self.run_sst(sdlfile, outfile)
+
+        # Each tester prints PASS once its misprediction count has been checked
+        with open(outfile, 'r') as f:
+            passed = f.read().count("PASS")
+
+        self.assertEqual(passed, 5, "Vanadis branch unit test output {0} has {1} of 5 passing traces".format(outfile, passed))
 
 #####
 
-    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, testtimeout=120):
+    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, testtimeout=120, lsq_type="vanadis.VanadisSequentialLoadStoreQueue"):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
-        outdir = "{0}/vanadis_tests/{1}/{2}".format(self.get_test_output_run_dir(), elftestdir,elffile)
+        outdir = "{0}/vanadis_tests/{1}".format(self.get_test_output_run_dir(), testname)
         tmpdir = self.get_test_output_tmp_dir()
         os.makedirs(outdir)
 
@@ -124,6 +145,7 @@ class testcase_vanadis(SSTTestCase):
         # Set the Vanadis EXE path
         testfilepath = "{0}/{1}/{2}".format(test_path, elftestdir, elffile)
         os.environ['VANADIS_EXE'] = testfilepath
+        os.environ['VANADIS_LSQ'] = lsq_type
 
         oscmd = self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=outdir, timeout_sec=testtimeout)
 
@@ -21,8 +21,10 @@
 #include "inst/vinstall.h"
 #include "velf/velfinfo.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <sst/core/output.h>
+#include <string>
 #include <vector>
 
 using namespace SST::Vanadis;
@@ -46,6 +48,10 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     std::string binary_img = params.find<std::string>("executable", "");
 
+    // Decoded instructions are only shared with cores of the same node, a
+    // core without a node_id shares with nobody else
+    const std::string node_id = params.find<std::string>("node_id", getName());
+
     if ( "" == binary_img ) {
         output->verbose(CALL_INFO, 2, 0, "No executable specified, will not perform any binary load.\n");
         binary_elf_info = nullptr;
@@ -98,6 +104,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     const uint16_t issue_queue_len = params.find<uint16_t>("issue_queue_length", 4);
 
     halted_masks = new bool[hw_threads];
+    thread_ins_retired.resize(hw_threads, 0);
 
     //////////////////////////////////////////////////////////////////////////////////////
 
@@ -127,6 +134,16 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         thr_decoder->setHardwareThread(i);
         thread_decoders.push_back(thr_decoder);
 
+        if ( thr_decoder->sharesDecodedBundles() ) {
+            // Bundles are only interchangeable between decoders with the same
+            // ISA and register configuration
+            const std::string isa_key = std::string(thr_decoder->getISAName()) + "/fp-mode-" +
+                                        std::to_string((int)thr_decoder->getFPRegisterMode());
+
+            thr_decoder->getInstructionLoader()->setSharedCache(
+                VanadisSharedDecodeCache::get(output, node_id, isa_key, binary_img));
+        }
+
         output->verbose(CALL_INFO, 8, 0, "Registering SYSCALL return interface...\n");
         std::function<void(uint32_t)> sys_callback =
             std::bind(&VANADIS_COMPONENT::syscallReturnCallback, this, std::placeholders::_1);
@@ -274,6 +291,13 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     lsq->setRegisterFiles(&register_files);
 
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        if ( thread_decoders[i]->sharesDecodedBundles() ) {
+            lsq->setCodePages(VanadisSharedDecodeCache::codePages(node_id));
+            break;
+        }
+    }
+
     if ( 0 == core_id ) {
         halted_masks[0]            = false;
         uint64_t initial_config_ip = thread_decoders[0]->getInstructionPointer();
@@ -439,10 +463,25 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     issues_per_cycle  = params.find<uint32_t>("issues_per_cycle", 2);
     retires_per_cycle = params.find<uint32_t>("retires_per_cycle", 2);
 
+    const std::string issue_scheduler = params.find<std::string>("issue_scheduler", "scan");
+
+    if ( issue_scheduler == "wakeup" ) {
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            issue_queues.push_back(new VanadisIssueQueue(
+                rob[i], thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg()));
+        }
+    }
+    else if ( issue_scheduler != "scan" ) {
+        output->fatal(
+            CALL_INFO, -1, "Error: unknown issue_scheduler \"%s\", must be scan or wakeup.\n",
+            issue_scheduler.c_str());
+    }
+
     output->verbose(CALL_INFO, 8, 0, "Configuring hardware parameters:\n");
     output->verbose(CALL_INFO, 8, 0, "-> Fetches/cycle:                %" PRIu32 "\n", fetches_per_cycle);
     output->verbose(CALL_INFO, 8, 0, "-> Decodes/cycle:                %" PRIu32 "\n", decodes_per_cycle);
     output->verbose(CALL_INFO, 8, 0, "-> Retires/cycle:                %" PRIu32 "\n", retires_per_cycle);
+    output->verbose(CALL_INFO, 8, 0, "-> Issue scheduler:              %s\n", issue_scheduler.c_str());
     //        output->verbose(CALL_INFO, 8, 0, "-> LSQ Store Entries: %" PRIu32
     //        "\n", (uint32_t) lsq_store_size ); output->verbose(CALL_INFO, 8, 0,
     //        "-> LSQ Stores In-flight:         %" PRIu32 "\n", (uint32_t)
@@ -465,6 +504,116 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     pause_on_retire_address = params.find<uint64_t>("pause_when_retire_address", 0);
 
+    fast_forward_remaining   = params.find<uint64_t>("fast_forward_instructions", 0);
+    fast_forward_marker      = params.find<uint64_t>("fast_forward_marker_syscall", 0);
+    functional_ins_per_cycle = params.find<uint32_t>("functional_ins_per_cycle", 256);
+    functional_mode          = (fast_forward_remaining > 0) || (fast_forward_marker > 0);
+    functional_draining      = false;
+
+    if ( 0 == fast_forward_remaining ) { fast_forward_remaining = UINT64_MAX; }
+
+    detailed_draining  = false;
+    total_ins_retired  = 0;
+    in_simpoint_sample = false;
+    sample_start_cycle = 0;
+    sample_start_ins   = 0;
+    simpoints          = nullptr;
+
+    simpoint_interval = params.find<uint64_t>("simpoint_interval", 100000000);
+
+    const std::string bbv_path              = params.find<std::string>("bbv_file", "");
+    const std::string simpoint_path         = params.find<std::string>("simpoint_file", "");
+    const std::string simpoint_weights_path = params.find<std::string>("simpoint_weights_file", "");
+
+    if ( ((bbv_path != "") || (simpoint_path != "")) && (0 == simpoint_interval) ) {
+        output->fatal(CALL_INFO, -1, "Error: simpoint_interval must be at least 1.\n");
+    }
+
+    if ( bbv_path != "" ) {
+        // Hardware threads interleave at retire, each has its own vector so
+        // their basic blocks are not merged. Thread 0 writes to bbv_file,
+        // thread N to bbv_file.N
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            const std::string thr_path = (0 == i) ? bbv_path : (bbv_path + "." + std::to_string(i));
+            output->verbose(CALL_INFO, 8, 0, "Opening a basic block vector output at: %s\n", thr_path.c_str());
+            FILE* bbv_file = fopen(thr_path.c_str(), "wt");
+
+            if ( bbv_file == nullptr ) {
+                output->fatal(CALL_INFO, -1, "Failed to open basic block vector file %s.\n", thr_path.c_str());
+            }
+
+            bbvs.push_back(new VanadisBasicBlockVector(bbv_file, simpoint_interval));
+        }
+    }
+
+    if ( simpoint_path != "" ) {
+        if ( simpoint_weights_path == "" ) {
+            output->fatal(CALL_INFO, -1, "Error: simpoint_file requires simpoint_weights_file to be set.\n");
+        }
+
+        if ( functional_mode ) {
+            output->fatal(
+                CALL_INFO, -1,
+                "Error: simpoint_file cannot be combined with fast_forward_instructions or "
+                "fast_forward_marker_syscall.\n");
+        }
+
+        simpoints = new VanadisSimPointSchedule(output, simpoint_path, simpoint_weights_path);
+
+        // Execute functionally up to the first sample, if there are no
+        // samples the whole run is functional
+        functional_mode = true;
+
+        if ( simpoints->complete() ) { fast_forward_remaining = UINT64_MAX; }
+        else if ( simpoints->nextInterval() > 0 ) {
+            fast_forward_remaining = simpoints->nextInterval() * simpoint_interval;
+        }
+        else {
+            functional_mode    = false;
+            in_simpoint_sample = true;
+        }
+
+        output->verbose(
+            CALL_INFO, 8, 0, "-> SimPoint sampling:             enabled (interval: %" PRIu64 " instructions)\n",
+            simpoint_interval);
+    }
+
+    if ( functional_mode && (0 == functional_ins_per_cycle) ) {
+        output->fatal(CALL_INFO, -1, "Error: functional_ins_per_cycle must be at least 1.\n");
+    }
+
+    output->verbose(
+        CALL_INFO, 8, 0, "-> Functional fast-forward:       %s\n", functional_mode ? "enabled" : "disabled");
+
+    profiler = nullptr;
+
+    const std::string profile_path = params.find<std::string>("profile_file", "");
+
+    if ( profile_path != "" ) {
+        output->verbose(CALL_INFO, 8, 0, "Opening a CPI stack profile output at: %s\n", profile_path.c_str());
+        FILE* profile_file = fopen(profile_path.c_str(), "wt");
+
+        if ( profile_file == nullptr ) { output->fatal(CALL_INFO, -1, "Failed to open CPI stack profile file.\n"); }
+
+        profiler = new VanadisCPIProfiler(profile_file, hw_threads);
+    }
+
+    checkpoint_path    = params.find<std::string>("checkpoint_file", "");
+    restore_path       = params.find<std::string>("restore_file", "");
+    checkpoint_pending = false;
+
+    if ( checkpoint_path != "" ) {
+        if ( !functional_mode || (nullptr != simpoints) ) {
+            output->fatal(
+                CALL_INFO, -1,
+                "Error: checkpoint_file requires fast_forward_instructions or fast_forward_marker_syscall, the "
+                "checkpoint is taken when functional mode ends.\n");
+        }
+
+        // Track written pages from the start so all of them can be flushed
+        lsq->setWrittenPages(&written_pages);
+    }
+
     // Register statistics ///////////////////////////////////////////////////////
     stat_ins_retired          = registerStatistic<uint64_t>("instructions_retired", "1");
     stat_ins_decoded          = registerStatistic<uint64_t>("instructions_decoded", "1");
@@ -479,6 +628,8 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     stat_syscall_cycles       = registerStatistic<uint64_t>("syscall-cycles", "1");
     stat_int_phys_regs_in_use = registerStatistic<uint64_t>("phys_int_reg_in_use", "1");
     stat_fp_phys_regs_in_use  = registerStatistic<uint64_t>("phys_fp_reg_in_use", "1");
+    stat_ins_fast_forwarded   = registerStatistic<uint64_t>("instructions_fast_forwarded", "1");
+    stat_functional_cycles    = registerStatistic<uint64_t>("functional_cycles", "1");
 
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -491,6 +642,17 @@ VANADIS_COMPONENT::~VANADIS_COMPONENT()
 
     if ( pipelineTrace != nullptr ) { fclose(pipelineTrace); }
 
+    for ( VanadisIssueQueue* next_queue : issue_queues ) {
+        delete next_queue;
+    }
+
+    for ( VanadisBasicBlockVector* next_bbv : bbvs ) {
+        delete next_bbv;
+    }
+
+    delete simpoints;
+    delete profiler;
+
 	 for( VanadisFloatingPointFlags* next_fp_flags : fp_flags ) {
 		delete next_fp_flags;
 	 }
@@ -722,6 +884,84 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, uint32_t& rob_start, bool&
     return issued_an_ins ? 0 : 1;
 }
 
+// Issue using the per-thread wakeup/select queues. Walks only the entries in
+// each thread's ready set, oldest first, applying the same resource checks as
+// performIssue.
+void
+VANADIS_COMPONENT::performIssueWakeup(const uint64_t cycle)
+{
+    const int output_verbosity = output->getVerboseLevel();
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        VanadisIssueQueue* queue = issue_queues[i];
+        queue->dispatch();
+
+        if ( halted_masks[i] ) {
+            output->verbose(
+                CALL_INFO, 8, 0, "thread %" PRIu32 " is halted, did not process for issue this cycle.\n", i);
+            continue;
+        }
+
+        VanadisRegisterStack* int_regs  = int_register_stacks[i];
+        VanadisRegisterStack* fp_regs   = fp_register_stacks[i];
+        VanadisISATable*      isa_table = issue_isa_tables[i];
+        uint32_t              issued    = 0;
+
+        for ( uint64_t seq = queue->nextReady(queue->begin()); (seq < queue->end()) && (issued < issues_per_cycle);
+              seq = queue->nextReady(seq + 1) ) {
+            VanadisInstruction* ins = queue->getInstruction(seq);
+
+            if ( !queue->checkDependencies(seq, ins) ) { continue; }
+
+            // We need places to store our output registers
+            if ( (int_regs->unused() < ins->countISAIntRegOut()) || (fp_regs->unused() < ins->countISAFPRegOut()) ) {
+                continue;
+            }
+
+            bool pending_writes = false;
+
+            for ( uint16_t k = 0; k < ins->countISAIntRegIn(); ++k ) {
+                pending_writes |= isa_table->pendingIntWrites(ins->getISAIntRegIn(k));
+            }
+
+            for ( uint16_t k = 0; k < ins->countISAFPRegIn(); ++k ) {
+                pending_writes |= isa_table->pendingFPWrites(ins->getISAFPRegIn(k));
+            }
+
+            if ( pending_writes ) { continue; }
+
+            if ( ((INST_STORE == ins->getInstFuncType()) || (INST_LOAD == ins->getInstFuncType())) &&
+                 queue->memoryOrderBlocked(seq) ) {
+                continue;
+            }
+
+            if ( 0 != allocateFunctionalUnit(ins) ) { continue; }
+
+            const int status = assignRegistersToInstruction(
+                thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg(), ins, int_regs, fp_regs,
+                isa_table);
+#ifdef VANADIS_BUILD_DEBUG
+            if ( output_verbosity >= 8 ) {
+                ins->printToBuffer(instPrintBuffer, 1024);
+                output->verbose(
+                    CALL_INFO, 8, 0, "----> Issued for: %s / 0x%llx / status: %d\n", instPrintBuffer,
+                    ins->getInstructionAddress(), status);
+            }
+#endif
+            ins->markIssued();
+            queue->markIssued(seq);
+            ins_issued_this_cycle++;
+            issued++;
+        }
+
+        queue->endCycle();
+
+        if ( (issued > 0) && (output_verbosity >= 8) ) {
+            isa_table->print(output, register_files[i], print_int_reg, print_fp_reg);
+        }
+    }
+}
+
 int
 VANADIS_COMPONENT::performExecute(const uint64_t cycle)
 {
@@ -884,8 +1124,8 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                     "(new addr: 0x%llx)\n",
                     pipeline_reset_addr);
 #endif
-                thread_decoders[rob_front->getHWThread()]->getBranchPredictor()->push(
-                    spec_ins->getInstructionAddress(), pipeline_reset_addr);
+                thread_decoders[rob_front->getHWThread()]->getBranchPredictor()->retireBranch(
+                    spec_ins, pipeline_reset_addr);
 
                 if ( (pause_on_retire_address > 0) &&
                      (rob_front->getInstructionAddress() == pause_on_retire_address) ) {
@@ -918,6 +1158,8 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
         if ( perform_cleanup ) {
             rob->pop();
 
+            if ( !issue_queues.empty() ) { issue_queues[rob_front->getHWThread()]->retire(rob_front); }
+
 #ifdef VANADIS_BUILD_DEBUG
             if ( output->getVerboseLevel() >= 8 ) {
                 char* inst_asm_buffer = new char[32768];
@@ -950,10 +1192,18 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
 
 
             ins_retired_this_cycle++;
+            thread_ins_retired[rob_front->getHWThread()]++;
+
+            if ( !bbvs.empty() ) { bbvs[rob_front->getHWThread()]->retire(rob_front->getInstructionAddress()); }
+            if ( nullptr != profiler ) {
+                profiler->retire(rob_front->getHWThread(), rob_front->getInstructionAddress());
+            }
 
             if ( perform_delay_cleanup ) {
 
                 VanadisInstruction* delay_ins = rob->pop();
+
+                if ( !issue_queues.empty() ) { issue_queues[delay_ins->getHWThread()]->retire(delay_ins); }
 #ifdef VANADIS_BUILD_DEBUG
                 output->verbose(
                     CALL_INFO, 8, 0, "----> Retire delay: 0x%llx / %s\n", delay_ins->getInstructionAddress(),
@@ -981,11 +1231,21 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                 //					if( delay_ins->endsMicroOpGroup() )
                 //{ 						stat_ins_retired->addData(1);
                 ins_retired_this_cycle++;
+                thread_ins_retired[delay_ins->getHWThread()]++;
                 //					}
 
+                if ( !bbvs.empty() ) { bbvs[delay_ins->getHWThread()]->retire(delay_ins->getInstructionAddress()); }
+                if ( nullptr != profiler ) {
+                    profiler->retire(delay_ins->getHWThread(), delay_ins->getInstructionAddress());
+                }
+
                 delete delay_ins;
             }
 
+            if ( !bbvs.empty() && (INST_BRANCH == rob_front->getInstFuncType()) ) {
+                bbvs[rob_front->getHWThread()]->endBlock();
+            }
+
             if ( output->getVerboseLevel() > 0 ) {
                 retire_isa_tables[rob_front->getHWThread()]->print(
                     output, register_files[rob_front->getHWThread()], print_int_reg, print_fp_reg);
@@ -1019,6 +1279,10 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                 handleMisspeculate(rob_front->getHWThread(), pipeline_reset_addr);
 
                 stat_branch_mispredicts->addData(1);
+
+                if ( nullptr != profiler ) {
+                    profiler->mispredict(rob_front->getHWThread(), rob_front->getInstructionAddress());
+                }
             }
 
             delete rob_front;
@@ -1039,6 +1303,20 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                             "sys-call instruction.\n");
                     }
 
+                    // The fast-forward marker is consumed here, it never reaches the OS
+                    if ( UNLIKELY(isFastForwardMarker(the_syscall_ins)) ) {
+                        output->verbose(
+                            CALL_INFO, 1, 0, "Fast-forward marker system call retired at 0x%llx (thread %" PRIu32 ")\n",
+                            the_syscall_ins->getInstructionAddress(), the_syscall_ins->getHWThread());
+
+                        rob_front->markFrontOfROB();
+                        the_syscall_ins->markExecuted();
+
+                        if ( functional_mode ) { functional_draining = true; }
+
+                        return 0;
+                    }
+
 #ifdef VANADIS_BUILD_DEBUG
                     output->verbose(
                         CALL_INFO, 8, 0,
@@ -1073,6 +1351,467 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
     return 0;
 }
 
+bool
+VANADIS_COMPONENT::isFastForwardMarker(VanadisSysCallInstruction* syscall_ins)
+{
+    if ( 0 == fast_forward_marker ) { return false; }
+
+    const uint32_t hw_thr   = syscall_ins->getHWThread();
+    const uint16_t code_reg = retire_isa_tables[hw_thr]->getIntPhysReg(isa_options[hw_thr]->getISASysCallCodeReg());
+
+    return register_files[hw_thr]->getIntReg<uint64_t>(code_reg) == fast_forward_marker;
+}
+
+// Start the oldest instruction on the thread which has not executed, provided
+// everything older than it has. Arithmetic and branches are executed right
+// away, memory operations, fences and system calls go through the usual paths
+// and complete when the LSQ or OS returns.
+bool
+VANADIS_COMPONENT::performFunctionalIssue(const uint32_t hw_thr)
+{
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[hw_thr];
+
+    for ( size_t j = 0; j < thr_rob->size(); ++j ) {
+        VanadisInstruction* ins = thr_rob->peekAt(j);
+
+        if ( ins->completedExecution() ) { continue; }
+
+        // Still waiting on memory or the OS
+        if ( ins->completedIssue() ) { return false; }
+
+        if ( (int_register_stacks[hw_thr]->unused() < ins->countISAIntRegOut()) ||
+             (fp_register_stacks[hw_thr]->unused() < ins->countISAFPRegOut()) ) {
+            return false;
+        }
+
+        bool execute_now = false;
+
+        switch ( ins->getInstFuncType() ) {
+        case INST_INT_ARITH:
+        case INST_INT_DIV:
+        case INST_FP_ARITH:
+        case INST_FP_DIV:
+        case INST_BRANCH:
+            execute_now = true;
+            break;
+        default:
+            if ( 0 != allocateFunctionalUnit(ins) ) { return false; }
+            break;
+        }
+
+        assignRegistersToInstruction(
+            thread_decoders[hw_thr]->countISAIntReg(), thread_decoders[hw_thr]->countISAFPReg(), ins,
+            int_register_stacks[hw_thr], fp_register_stacks[hw_thr], issue_isa_tables[hw_thr]);
+
+        ins->markIssued();
+        ins_issued_this_cycle++;
+
+        if ( execute_now ) { ins->execute(output, register_files[hw_thr]); }
+
+        return true;
+    }
+
+    return false;
+}
+
+bool
+VANADIS_COMPONENT::tickFunctional(const uint64_t cycle)
+{
+    stat_functional_cycles->addData(1);
+    ins_issued_this_cycle  = 0;
+    ins_retired_this_cycle = 0;
+    ins_decoded_this_cycle = 0;
+
+    bool declock = false;
+
+    for ( uint32_t step = 0; step < functional_ins_per_cycle; ++step ) {
+        const uint32_t issued_before  = ins_issued_this_cycle;
+        const uint32_t retired_before = ins_retired_this_cycle;
+
+        performDecode(cycle);
+
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            if ( !issue_queues.empty() ) { issue_queues[i]->dispatch(); }
+
+            // Writes to the zero register land in a fresh physical register,
+            // clear it before the next instruction can read it
+            const uint16_t zero_reg = isa_options[i]->getRegisterIgnoreWrites();
+
+            if ( zero_reg < isa_options[i]->countISAIntRegisters() ) {
+                register_files[i]->setIntReg<uint64_t>(issue_isa_tables[i]->getIntPhysReg(zero_reg), 0);
+            }
+
+            // When draining only finish groups already started at the ROB front
+            // (e.g. a branch waiting on its delay slot)
+            const bool front_started = !rob[i]->empty() && rob[i]->peek()->completedIssue();
+
+            if ( !halted_masks[i] && (!functional_draining || front_started) ) { performFunctionalIssue(i); }
+        }
+
+        lsq->tick((uint64_t)cycle);
+
+        // Retire everything that has completed, performRetire returns zero
+        // for some calls which do not retire anything so watch the count
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            while ( true ) {
+                const uint32_t retired_thr = ins_retired_this_cycle;
+                const int      retire_rc   = performRetire(rob[i], cycle);
+
+                if ( INT_MAX == retire_rc ) { declock = true; }
+
+                if ( (0 != retire_rc) || (retired_thr == ins_retired_this_cycle) ) { break; }
+            }
+        }
+
+        const uint32_t retired_step = ins_retired_this_cycle - retired_before;
+
+        // Instructions retired while draining are not part of the fast
+        // forward count
+        if ( !functional_draining ) {
+            fast_forward_remaining -= std::min((uint64_t)retired_step, fast_forward_remaining);
+
+            if ( 0 == fast_forward_remaining ) { functional_draining = true; }
+        }
+
+        if ( declock || ((ins_issued_this_cycle == issued_before) && (retired_step == 0)) ) { break; }
+    }
+
+    stat_ins_fast_forwarded->addData(ins_retired_this_cycle);
+    total_ins_retired += ins_retired_this_cycle;
+
+    if ( functional_draining ) {
+        bool drained = true;
+
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            drained &= rob[i]->empty() || !rob[i]->peek()->completedIssue();
+        }
+
+        if ( drained ) { endFunctionalMode(); }
+    }
+
+    current_cycle++;
+
+    if ( current_cycle >= max_cycle ) {
+        output->verbose(CALL_INFO, 1, 0, "Reached maximum cycle %" PRIu64 ". Core stops processing.\n", current_cycle);
+        primaryComponentOKToEndSim();
+        return true;
+    }
+
+    return declock;
+}
+
+void
+VANADIS_COMPONENT::endFunctionalMode()
+{
+    output->verbose(
+        CALL_INFO, 1, 0, "Fast-forward complete at cycle %" PRIu64 ", switching to detailed timing.\n",
+        current_cycle);
+
+    functional_mode     = false;
+    functional_draining = false;
+
+    if ( (nullptr != simpoints) && !simpoints->complete() ) {
+        // Detailed timing starts with the next cycle
+        in_simpoint_sample = true;
+        sample_start_cycle = current_cycle + 1;
+        sample_start_ins   = total_ins_retired;
+    }
+
+    if ( checkpoint_path != "" ) {
+        // Caches may hold the only copy of recently written data, push it
+        // out to memory before the checkpoint is written
+        lsq->flushPages(written_pages.take(), dCacheLineWidth);
+        checkpoint_pending = true;
+    }
+}
+
+bool
+VANADIS_COMPONENT::tickCheckpoint()
+{
+    if ( lsq->flushPending() ) { return false; }
+
+    writeCheckpoint();
+    checkpoint_pending = false;
+
+    // The OS writes its own checkpoint once every core on the node has
+    // written theirs
+    thread_decoders[0]->getOSHandler()->notifyCheckpoint();
+
+    output->verbose(
+        CALL_INFO, 1, 0, "Checkpoint written to %s at cycle %" PRIu64 ". Core stops processing.\n",
+        checkpoint_path.c_str(), current_cycle);
+    primaryComponentOKToEndSim();
+    return true;
+}
+
+void
+VANADIS_COMPONENT::writeCheckpoint()
+{
+    FILE* checkpoint_file = fopen(checkpoint_path.c_str(), "wt");
+
+    if ( nullptr == checkpoint_file ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open checkpoint file %s\n", checkpoint_path.c_str());
+    }
+
+    fprintf(
+        checkpoint_file, "vanadis-core-checkpoint %d core %" PRIu16 " threads %" PRIu32 " retired %" PRIu64 "\n",
+        VANADIS_CHECKPOINT_VERSION, core_id, hw_threads, total_ins_retired);
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        // Anything left in the ROB has not started, so execution resumes
+        // from the oldest entry
+        const uint64_t resume_ip = rob[i]->empty() ? thread_decoders[i]->getInstructionPointer()
+                                                   : rob[i]->peek()->getInstructionAddress();
+
+        fprintf(
+            checkpoint_file, "thread %" PRIu32 " halted %d pc 0x%" PRIx64 " tls 0x%" PRIx64 "\n", i,
+            halted_masks[i] ? 1 : 0, resume_ip, thread_decoders[i]->getThreadLocalStoragePointer());
+
+        const uint16_t int_reg_count = isa_options[i]->countISAIntRegisters();
+        fprintf(checkpoint_file, "int %" PRIu16, int_reg_count);
+
+        for ( uint16_t j = 0; j < int_reg_count; ++j ) {
+            fprintf(
+                checkpoint_file, " 0x%" PRIx64,
+                register_files[i]->getIntReg<uint64_t>(retire_isa_tables[i]->getIntPhysReg(j)));
+        }
+
+        const uint16_t fp_reg_count = isa_options[i]->countISAFPRegisters();
+        const uint32_t fp_reg_width = register_files[i]->getFPRegWidth();
+        fprintf(checkpoint_file, "\nfp %" PRIu16 " %" PRIu32, fp_reg_count, fp_reg_width);
+
+        for ( uint16_t j = 0; j < fp_reg_count; ++j ) {
+            const uint16_t phys_reg = retire_isa_tables[i]->getFPPhysReg(j);
+            const uint64_t value    = (8 == fp_reg_width) ? register_files[i]->getFPReg<uint64_t>(phys_reg)
+                                                          : register_files[i]->getFPReg<uint32_t>(phys_reg);
+            fprintf(checkpoint_file, " 0x%" PRIx64, value);
+        }
+
+        const VanadisFloatingPointFlags* thr_flags = fp_flags[i];
+        fprintf(
+            checkpoint_file, "\nfpflags %d %d %d %d %d %d\n", thr_flags->invalidOp() ? 1 : 0,
+            thr_flags->divZero() ? 1 : 0, thr_flags->overflow() ? 1 : 0, thr_flags->underflow() ? 1 : 0,
+            thr_flags->inexact() ? 1 : 0, (int)thr_flags->getRoundingMode());
+    }
+
+    fclose(checkpoint_file);
+}
+
+// Runs in setup so it overrides the launch state configured at construction,
+// memory is restored separately by the memory controller
+void
+VANADIS_COMPONENT::restoreCheckpoint()
+{
+    output->verbose(CALL_INFO, 1, 0, "Restoring architectural state from %s...\n", restore_path.c_str());
+    FILE* restore_file = fopen(restore_path.c_str(), "rt");
+
+    if ( nullptr == restore_file ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open checkpoint file %s\n", restore_path.c_str());
+    }
+
+    uint32_t version      = 0;
+    uint16_t ckpt_core    = 0;
+    uint32_t ckpt_threads = 0;
+    uint64_t ckpt_retired = 0;
+
+    if ( (4 != fscanf(
+                   restore_file, " vanadis-core-checkpoint %" SCNu32 " core %" SCNu16 " threads %" SCNu32
+                                 " retired %" SCNu64,
+                   &version, &ckpt_core, &ckpt_threads, &ckpt_retired)) ||
+         (VANADIS_CHECKPOINT_VERSION != version) || (ckpt_core != core_id) || (ckpt_threads != hw_threads) ) {
+        output->fatal(
+            CALL_INFO, -1,
+            "Error: %s is not a version %d checkpoint of core %" PRIu16 " with %" PRIu32 " hardware threads.\n",
+            restore_path.c_str(), VANADIS_CHECKPOINT_VERSION, core_id, hw_threads);
+    }
+
+    total_ins_retired = ckpt_retired;
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        uint32_t ckpt_thread   = 0;
+        int      halted        = 0;
+        uint64_t resume_ip     = 0;
+        uint64_t tls_ptr       = 0;
+        uint16_t int_reg_count = 0;
+        uint16_t fp_reg_count  = 0;
+        uint32_t fp_reg_width  = 0;
+        int      flags[6]      = { 0, 0, 0, 0, 0, 0 };
+
+        bool thread_valid = (4 == fscanf(
+                                      restore_file, " thread %" SCNu32 " halted %d pc 0x%" SCNx64 " tls 0x%" SCNx64,
+                                      &ckpt_thread, &halted, &resume_ip, &tls_ptr)) &&
+                            (ckpt_thread == i);
+
+        thread_valid = thread_valid && (1 == fscanf(restore_file, " int %" SCNu16, &int_reg_count)) &&
+                       (int_reg_count == isa_options[i]->countISAIntRegisters());
+
+        for ( uint16_t j = 0; thread_valid && (j < int_reg_count); ++j ) {
+            uint64_t value = 0;
+            thread_valid   = (1 == fscanf(restore_file, " 0x%" SCNx64, &value));
+            register_files[i]->setIntReg<uint64_t>(issue_isa_tables[i]->getIntPhysReg(j), value);
+        }
+
+        thread_valid = thread_valid &&
+                       (2 == fscanf(restore_file, " fp %" SCNu16 " %" SCNu32, &fp_reg_count, &fp_reg_width)) &&
+                       (fp_reg_count == isa_options[i]->countISAFPRegisters()) &&
+                       (fp_reg_width == register_files[i]->getFPRegWidth());
+
+        for ( uint16_t j = 0; thread_valid && (j < fp_reg_count); ++j ) {
+            uint64_t       value    = 0;
+            const uint16_t phys_reg = issue_isa_tables[i]->getFPPhysReg(j);
+            thread_valid            = (1 == fscanf(restore_file, " 0x%" SCNx64, &value));
+
+            if ( 8 == fp_reg_width ) { register_files[i]->setFPReg<uint64_t>(phys_reg, value); }
+            else {
+                register_files[i]->setFPReg<uint32_t>(phys_reg, (uint32_t)value);
+            }
+        }
+
+        thread_valid = thread_valid && (6 == fscanf(
+                                                 restore_file, " fpflags %d %d %d %d %d %d", &flags[0], &flags[1],
+                                                 &flags[2], &flags[3], &flags[4], &flags[5]));
+
+        if ( !thread_valid ) {
+            output->fatal(
+                CALL_INFO, -1, "Error: state for thread %" PRIu32 " in %s is malformed or does not match this core.\n",
+                i, restore_path.c_str());
+        }
+
+        halted_masks[i] = (0 != halted);
+        thread_decoders[i]->setInstructionPointer(resume_ip);
+        thread_decoders[i]->setThreadLocalStoragePointer(tls_ptr);
+
+        VanadisFloatingPointFlags* thr_flags = fp_flags[i];
+        thr_flags->copy(VanadisFloatingPointFlags());
+
+        if ( flags[0] ) { thr_flags->setInvalidOp(); }
+        if ( flags[1] ) { thr_flags->setDivZero(); }
+        if ( flags[2] ) { thr_flags->setOverflow(); }
+        if ( flags[3] ) { thr_flags->setUnderflow(); }
+        if ( flags[4] ) { thr_flags->setInexact(); }
+
+        thr_flags->setRoundingMode((VanadisFPRoundingMode)flags[5]);
+
+        // Force retire table to sync with issue table
+        retire_isa_tables[i]->reset(issue_isa_tables[i]);
+
+        output->verbose(
+            CALL_INFO, 8, 0, "-> thread %" PRIu32 ": %s, resumes at 0x%" PRIx64 "\n", i,
+            halted_masks[i] ? "halted" : "running", resume_ip);
+    }
+
+    fclose(restore_file);
+}
+
+void
+VANADIS_COMPONENT::beginFunctionalMode()
+{
+    output->verbose(
+        CALL_INFO, 1, 0, "Detailed timing complete at cycle %" PRIu64 ", switching to functional execution.\n",
+        current_cycle);
+
+    functional_mode   = true;
+    detailed_draining = false;
+}
+
+// Called at the end of every detailed cycle when SimPoint sampling is
+// enabled, closes the current sample once it has covered an interval
+void
+VANADIS_COMPONENT::updateSimPointSample()
+{
+    if ( detailed_draining ) {
+        bool drained = true;
+
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            for ( size_t j = 0; j < rob[i]->size(); ++j ) {
+                VanadisInstruction* next_ins = rob[i]->peekAt(j);
+                drained &= !(next_ins->completedIssue() && !next_ins->completedExecution());
+            }
+        }
+
+        if ( drained ) { beginFunctionalMode(); }
+
+        return;
+    }
+
+    if ( !in_simpoint_sample || ((total_ins_retired - sample_start_ins) < simpoint_interval) ) { return; }
+
+    simpoints->recordSample(total_ins_retired - sample_start_ins, current_cycle - sample_start_cycle);
+    in_simpoint_sample = false;
+
+    if ( simpoints->complete() ) {
+        // No samples left, execute the rest of the run functionally
+        fast_forward_remaining = UINT64_MAX;
+    }
+    else {
+        const uint64_t next_start = simpoints->nextInterval() * simpoint_interval;
+
+        if ( next_start <= total_ins_retired ) {
+            // Back to back intervals stay in detailed mode
+            in_simpoint_sample = true;
+            sample_start_cycle = current_cycle;
+            sample_start_ins   = total_ins_retired;
+            return;
+        }
+
+        fast_forward_remaining = next_start - total_ins_retired;
+    }
+
+    detailed_draining = true;
+}
+
+// Charge this cycle to one CPI stack category. Cycles which retire nothing
+// are blamed on the oldest instruction of the first running thread.
+void
+VANADIS_COMPONENT::profileCycle()
+{
+    if ( ins_retired_this_cycle > 0 ) {
+        profiler->cycle(VANADIS_CPI_RETIRING);
+        return;
+    }
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        if ( halted_masks[i] ) { continue; }
+
+        if ( profiler->isRecovering(i) ) {
+            profiler->cycle(VANADIS_CPI_MISSPECULATION);
+        }
+        else if ( rob[i]->empty() ) {
+            profiler->cycle(VANADIS_CPI_FRONTEND);
+        }
+        else {
+            VanadisInstruction*             rob_front  = rob[i]->peek();
+            const VanadisFunctionalUnitType front_type = rob_front->getInstFuncType();
+
+            if ( (INST_LOAD == front_type) || (INST_STORE == front_type) ) {
+                // Not yet issued because the queue it needs is full, otherwise waiting
+                // on the memory system
+                const bool lsq_full = (INST_LOAD == front_type) ? lsq->loadFull() : lsq->storeFull();
+                profiler->stall(
+                    (!rob_front->completedIssue() && lsq_full) ? VANADIS_CPI_LSQ_FULL : VANADIS_CPI_MEMORY,
+                    rob_front->getInstructionAddress());
+            }
+            else if ( !rob_front->completedIssue() ) {
+                // Waiting on operands or a free functional unit
+                profiler->stall(VANADIS_CPI_ISSUE, rob_front->getInstructionAddress());
+            }
+            else if ( INST_BRANCH == front_type ) {
+                profiler->stall(VANADIS_CPI_BRANCH, rob_front->getInstructionAddress());
+            }
+            else if ( rob[i]->full() ) {
+                profiler->stall(VANADIS_CPI_ROB_FULL, rob_front->getInstructionAddress());
+            }
+            else {
+                profiler->stall(VANADIS_CPI_EXECUTE, rob_front->getInstructionAddress());
+            }
+        }
+
+        return;
+    }
+
+    profiler->cycle(VANADIS_CPI_IDLE);
+}
+
 bool
 VANADIS_COMPONENT::mapInstructiontoFunctionalUnit(
     VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units)
@@ -1208,6 +1947,10 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         return true;
     }
 
+    if ( checkpoint_pending ) { return tickCheckpoint(); }
+
+    if ( functional_mode ) { return tickFunctional(cycle); }
+
     stat_cycles->addData(1);
     ins_issued_this_cycle  = 0;
     ins_retired_this_cycle = 0;
@@ -1280,19 +2023,27 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         "=> Issue Stage  "
         "<==========================================================\n");
 #endif
-    // Clear our temps on a per-thread basis
-    for ( uint32_t i = 0; i < hw_threads; ++i ) {
-        resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
-    }
+    // Nothing new is issued while the pipeline drains ahead of functional mode
+    if ( !detailed_draining ) {
+        if ( issue_queues.empty() ) {
+            // Clear our temps on a per-thread basis
+            for ( uint32_t i = 0; i < hw_threads; ++i ) {
+                resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
+            }
 
-    uint32_t rob_start   = 0;
-    bool     found_store = false;
-    bool     found_load  = false;
+            uint32_t rob_start   = 0;
+            bool     found_store = false;
+            bool     found_load  = false;
 
-    // Attempt to perform issues, cranking through the entire ROB call by call or until we
-    // reach the max issues this cycle
-    for ( uint32_t i = 0; i < issues_per_cycle; ++i ) {
-        if ( performIssue(cycle, rob_start, found_store, found_load) != 0 ) { break; }
+            // Attempt to perform issues, cranking through the entire ROB call by call or until we
+            // reach the max issues this cycle
+            for ( uint32_t i = 0; i < issues_per_cycle; ++i ) {
+                if ( performIssue(cycle, rob_start, found_store, found_load) != 0 ) { break; }
+            }
+        }
+        else {
+            performIssueWakeup(cycle);
+        }
     }
 
     // Record how many instructions we issued this cycle
@@ -1336,6 +2087,9 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 
     // Record how many instructions we retired this cycle
     stat_ins_retired->addData(ins_retired_this_cycle);
+    total_ins_retired += ins_retired_this_cycle;
+
+    if ( nullptr != profiler ) { profileCycle(); }
 
     uint64_t rob_total_count = 0;
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
@@ -1352,6 +2106,8 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 
     current_cycle++;
 
+    if ( nullptr != simpoints ) { updateSimPointSample(); }
+
     uint64_t used_phys_int = 0;
     uint64_t used_phys_fp  = 0;
 
@@ -1762,11 +2518,44 @@ VANADIS_COMPONENT::recoverRetiredRegisters(
 
 void
 VANADIS_COMPONENT::setup()
-{}
+{
+    if ( restore_path != "" ) { restoreCheckpoint(); }
+}
 
 void
 VANADIS_COMPONENT::finish()
-{}
+{
+    for ( VanadisBasicBlockVector* next_bbv : bbvs ) {
+        next_bbv->flush();
+    }
+
+    if ( nullptr != simpoints ) { simpoints->report(output, core_id); }
+
+    if ( nullptr != profiler ) { profiler->write(core_id); }
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        if ( thread_decoders[i]->sharesDecodedBundles() ) {
+            VanadisSharedDecodeCache::reportAll(output);
+            break;
+        }
+    }
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        VanadisBranchUnit* branch_unit = thread_decoders[i]->getBranchPredictor();
+
+        if ( (nullptr == branch_unit) || (0 == branch_unit->getBranchCount()) ) { continue; }
+
+        const double mpki = (thread_ins_retired[i] > 0) ? ((double)branch_unit->getMispredictCount() * 1000.0 /
+                                                           (double)thread_ins_retired[i])
+                                                        : 0;
+
+        output->verbose(
+            CALL_INFO, 1, 0,
+            "Core %" PRIu16 " thread %" PRIu32 " branch unit: %" PRIu64 " branches / %" PRIu64
+            " mispredicted / MPKI: %8.4f\n",
+            core_id, i, branch_unit->getBranchCount(), branch_unit->getMispredictCount(), mpki);
+    }
+}
 
 void
 VANADIS_COMPONENT::printStatus(SST::Output& output)
@@ -1826,185 +2615,54 @@ VANADIS_COMPONENT::init(unsigned int phase)
         if ( nullptr != binary_elf_info ) {
             if ( 0 == core_id ) {
                 output->verbose(
-                    CALL_INFO, 2, 0, "-> Loading %s, to locate program sections ...\n",
+                    CALL_INFO, 2, 0, "-> Loading %s, to locate program segments ...\n",
                     binary_elf_info->getBinaryPath());
-                FILE* exec_file = fopen(binary_elf_info->getBinaryPath(), "rb");
-
-                if ( nullptr == exec_file ) {
-                    output->fatal(CALL_INFO, -1, "Error: unable to open %s\n", binary_elf_info->getBinaryPath());
-                }
-
-                std::vector<uint8_t> initial_mem_contents;
-                uint64_t             max_content_address = 0;
 
-                // Find the max value we think we are going to need to place entries up
-                // to
+                const VanadisELFImage* exec_image          = binary_elf_info->getImage();
+                uint64_t               max_content_address = 0;
 
+                // Only loadable segments are placed in memory, each at its own virtual
+                // address. The part of a segment beyond its file contents (.bss) is not
+                // sent, the backing store zero fills pages when they are first touched.
                 for ( size_t i = 0; i < binary_elf_info->countProgramHeaders(); ++i ) {
                     const VanadisELFProgramHeaderEntry* next_prog_hdr = binary_elf_info->getProgramHeader(i);
-                    max_content_address                               = std::max(
-                        max_content_address,
-                        (uint64_t)next_prog_hdr->getVirtualMemoryStart() + next_prog_hdr->getHeaderImageLength());
-                }
 
-                for ( size_t i = 0; i < binary_elf_info->countProgramSections(); ++i ) {
-                    const VanadisELFProgramSectionEntry* next_sec = binary_elf_info->getProgramSection(i);
-                    max_content_address                           = std::max(
-                        max_content_address, (uint64_t)next_sec->getVirtualMemoryStart() + next_sec->getImageLength());
-                }
+                    if ( PROG_HEADER_LOAD != next_prog_hdr->getHeaderType() ) { continue; }
 
-                output->verbose(
-                    CALL_INFO, 2, 0,
-                    "-> expecting max address for initial binary load is "
-                    "0x%llx, zeroing the memory\n",
-                    max_content_address);
-                initial_mem_contents.resize(max_content_address, (uint8_t)0);
-
-                // Populate the memory with contents from the binary
-                output->verbose(CALL_INFO, 2, 0, "-> populating memory contents with info from the executable...\n");
-                /*
-                                                for( size_t i = 0; i <
-                   binary_elf_info->countProgramHeaders(); ++i ) { const
-                   VanadisELFProgramHeaderEntry* next_prog_hdr =
-                   binary_elf_info->getProgramHeader(i);
-
-                                                        if( (PROG_HEADER_LOAD ==
-                   next_prog_hdr->getHeaderType()) ) { output->verbose(CALL_INFO, 2, 0,
-                   ">> Loading Program Header from executable at %p, len=%" PRIu64
-                   "...\n", (void*) next_prog_hdr->getImageOffset(),
-                   next_prog_hdr->getHeaderImageLength()); output->verbose(CALL_INFO, 2,
-                   0, ">>>> Placing at virtual address: %p\n", (void*)
-                   next_prog_hdr->getVirtualMemoryStart());
-
-                                                                // Note - padding
-                   automatically zeros because we perform a resize with parameter 0
-                   given const uint64_t padding = 4096 -
-                   ((next_prog_hdr->getVirtualMemoryStart() +
-                   next_prog_hdr->getHeaderImageLength()) % 4096);
-
-                                                                // Do we have enough
-                   space in the memory image, if not, extend and zero if(
-                   initial_mem_contents.size() < (
-                   next_prog_hdr->getVirtualMemoryStart() +
-                   next_prog_hdr->getHeaderImageLength() )) {
-                                                                        initial_mem_contents.resize(
-                   ( next_prog_hdr->getVirtualMemoryStart() +
-                   next_prog_hdr->getHeaderImageLength()
-                                                                                +
-                   padding), 0);
-                                                                }
-
-                                                                fseek( exec_file,
-                   next_prog_hdr->getImageOffset(), SEEK_SET ); fread(
-                   &initial_mem_contents[ next_prog_hdr->getVirtualMemoryStart() ],
-                                                                        next_prog_hdr->getHeaderImageLength(),
-                   1, exec_file);
-                                                        }
-                                                }
-                */
-                for ( size_t i = 0; i < binary_elf_info->countProgramSections(); ++i ) {
-                    const VanadisELFProgramSectionEntry* next_sec = binary_elf_info->getProgramSection(i);
-
-                    if ( SECTION_HEADER_PROG_DATA == next_sec->getSectionType() ) {
-                        output->verbose(
-                            CALL_INFO, 2, 0,
-                            ">> Loading Section (%" PRIu64 ") from executable at: 0x%0llx, len=%" PRIu64 "...\n",
-                            next_sec->getID(), next_sec->getVirtualMemoryStart(), next_sec->getImageLength());
-
-                        if ( next_sec->getVirtualMemoryStart() > 0 ) {
-                            const uint64_t padding =
-                                4096 - ((next_sec->getVirtualMemoryStart() + next_sec->getImageLength()) % 4096);
-
-                            // Executable data, let's load it in
-                            if ( initial_mem_contents.size() <
-                                 (next_sec->getVirtualMemoryStart() + next_sec->getImageLength()) ) {
-                                size_t size_now = initial_mem_contents.size();
-                                initial_mem_contents.resize(
-                                    next_sec->getVirtualMemoryStart() + next_sec->getImageLength() + padding, 0);
-                            }
+                    const uint64_t seg_start    = next_prog_hdr->getVirtualMemoryStart();
+                    const uint64_t seg_file_len = next_prog_hdr->getHeaderImageLength();
+                    const uint64_t seg_mem_len  = next_prog_hdr->getHeaderMemoryLength();
 
-                            // Find the section and read it all in
-                            fseek(exec_file, next_sec->getImageOffset(), SEEK_SET);
-                            fread(
-                                &initial_mem_contents[next_sec->getVirtualMemoryStart()], next_sec->getImageLength(), 1,
-                                exec_file);
-                        }
-                        else {
-                            output->verbose(CALL_INFO, 2, 0, "--> Not loading because virtual address is zero.\n");
-                        }
-                    }
-                    else if ( SECTION_HEADER_BSS == next_sec->getSectionType() ) {
-                        output->verbose(
-                            CALL_INFO, 2, 0,
-                            ">> Loading BSS Section (%" PRIu64 ") with zeroing at 0x%0llx, len=%" PRIu64 "\n",
-                            next_sec->getID(), next_sec->getVirtualMemoryStart(), next_sec->getImageLength());
-
-                        if ( next_sec->getVirtualMemoryStart() > 0 ) {
-                            const uint64_t padding =
-                                4096 - ((next_sec->getVirtualMemoryStart() + next_sec->getImageLength()) % 4096);
-
-                            // Resize if needed with zeroing
-                            if ( initial_mem_contents.size() <
-                                 (next_sec->getVirtualMemoryStart() + next_sec->getImageLength()) ) {
-                                size_t size_now = initial_mem_contents.size();
-                                initial_mem_contents.resize(
-                                    next_sec->getVirtualMemoryStart() + next_sec->getImageLength() + padding, 0);
-                            }
+                    output->verbose(
+                        CALL_INFO, 2, 0,
+                        ">> Loading Segment (%" PRIu64 ") at: 0x%0llx, file len=%" PRIu64 ", mem len=%" PRIu64 "\n",
+                        (uint64_t)i, seg_start, seg_file_len, seg_mem_len);
 
-                            // Zero out the section according to the Section header info
-                            std::memset(
-                                &initial_mem_contents[next_sec->getVirtualMemoryStart()], 0,
-                                next_sec->getImageLength());
-                        }
-                        else {
-                            output->verbose(CALL_INFO, 2, 0, "--> Not loading because virtual address is zero.\n");
-                        }
+                    if ( !exec_image->contains(next_prog_hdr->getImageOffset(), seg_file_len) ) {
+                        output->fatal(
+                            CALL_INFO, -1, "Error: segment %" PRIu64 " extends past the end of %s\n", (uint64_t)i,
+                            binary_elf_info->getBinaryPath());
                     }
-                    else {
-                        if ( next_sec->isAllocated() ) {
-                            output->verbose(
-                                CALL_INFO, 2, 0,
-                                ">> Loading Allocatable Section (%" PRIu64 ") at 0x%0llx, len: %" PRIu64 "\n",
-                                next_sec->getID(), next_sec->getVirtualMemoryStart(), next_sec->getImageLength());
-
-                            if ( next_sec->getVirtualMemoryStart() > 0 ) {
-                                const uint64_t padding =
-                                    4096 - ((next_sec->getVirtualMemoryStart() + next_sec->getImageLength()) % 4096);
-
-                                // Resize if needed with zeroing
-                                if ( initial_mem_contents.size() <
-                                     (next_sec->getVirtualMemoryStart() + next_sec->getImageLength()) ) {
-                                    size_t size_now = initial_mem_contents.size();
-                                    initial_mem_contents.resize(
-                                        next_sec->getVirtualMemoryStart() + next_sec->getImageLength() + padding, 0);
-                                }
 
-                                // Find the section and read it all in
-                                fseek(exec_file, next_sec->getImageOffset(), SEEK_SET);
-                                fread(
-                                    &initial_mem_contents[next_sec->getVirtualMemoryStart()],
-                                    next_sec->getImageLength(), 1, exec_file);
-                            }
-                        }
-                    }
-                }
+                    if ( seg_file_len > 0 ) {
+                        const uint8_t*       seg_data = exec_image->getPointer(next_prog_hdr->getImageOffset());
+                        std::vector<uint8_t> seg_contents(seg_data, seg_data + seg_file_len);
 
-                fclose(exec_file);
+                        lsq->setInitialMemory(seg_start, seg_contents);
+                    }
 
-                output->verbose(
-                    CALL_INFO, 2, 0, ">> Writing memory contents (%" PRIu64 " bytes at index 0)\n",
-                    (uint64_t)initial_mem_contents.size());
+                    // The rest of the segment (.bss) is left to the zeroed backing store
+                    if ( seg_mem_len > seg_file_len ) {
+                        lsq->setInitialZeroMemory(seg_start + seg_file_len, seg_mem_len - seg_file_len);
+                    }
 
-                //				SimpleMem::Request* writeExe = new
-                // SimpleMem::Request(SimpleMem::Request::Write, 					0,
-                // initial_mem_contents.size(), initial_mem_contents);
-                lsq->setInitialMemory(0, initial_mem_contents);
-                //				memInstInterface->sendInitData( writeExe
-                //);
+                    max_content_address =
+                        std::max(max_content_address, seg_start + std::max(seg_file_len, seg_mem_len));
+                }
 
                 const uint64_t page_size = 4096;
 
-                uint64_t initial_brk = (uint64_t)initial_mem_contents.size();
+                uint64_t initial_brk = max_content_address;
                 initial_brk          = initial_brk + (page_size - (initial_brk % page_size));
 
                 output->verbose(
@@ -2077,6 +2735,7 @@ VANADIS_COMPONENT::handleMisspeculate(const uint32_t hw_thr, const uint64_t new_
 
     // Notify the decoder we need a clear and reset to new instruction pointer
     thread_decoders[hw_thr]->setInstructionPointerAfterMisspeculate(output, new_ip);
+    thread_decoders[hw_thr]->getBranchPredictor()->recover();
 
     output->verbose(CALL_INFO, 16, 0, "-> Mis-speculate repair finished.\n");
 }
@@ -2151,6 +2810,8 @@ VANADIS_COMPONENT::clearROBMisspeculate(const uint32_t hw_thr)
 
     // clear the ROB entries and reset
     thr_rob->clear();
+
+    if ( !issue_queues.empty() ) { issue_queues[hw_thr]->clear(); }
 }
 
 void
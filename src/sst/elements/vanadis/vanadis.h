@@ -17,6 +17,7 @@
 #define _VANADIS_COMPONENT_H
 
 #include "datastruct/cqueue.h"
+#include "datastruct/vissueq.h"
 #include "decoder/vdecoder.h"
 #include "inst/isatable.h"
 #include "inst/regfile.h"
@@ -25,9 +26,12 @@
 #include "lsq/vlsq.h"
 #include "lsq/vlsqseq.h"
 #include "lsq/vlsqstd.h"
+#include "vcheckpoint.h"
 #include "velf/velfinfo.h"
 #include "vfpflags.h"
 #include "vfuncunit.h"
+#include "vprofiler.h"
+#include "vsimpoint.h"
 
 #include <array>
 #include <limits>
@@ -110,6 +114,8 @@ public:
                      "is more output" },
         { "max_cycles", "Maximum number of cycles to execute" },
         { "reorder_slots", "Number of slots in the reorder buffer" }, { "core_id", "Identifier for this core" },
+        { "node_id", "Identifier of the node this core belongs to, decoders with shared_uop_cache only share decoded "
+                     "instructions with cores of the same node. Defaults to the component name (no sharing)." },
         { "hardware_threads", "Number of hardware threads in this core" },
         { "physical_integer_registers", "Number of physical integer registers per hardware thread" },
         { "physical_fp_registers", "Number of physical floating point registers per hardware thread" },
@@ -126,9 +132,33 @@ public:
         { "max_stores_per_cycle", "Maximum number of stores that can issue to the cache per cycle" },
         { "branch_units", "Number of branch units" }, { "special_units", "Number of special instruction units" },
         { "issues_per_cycle", "Number of instruction issues per cycle" },
+        { "issue_scheduler", "How instructions are selected for issue. scan walks the ROB every cycle, wakeup keeps a "
+                             "per-thread issue queue and only reconsiders instructions once the registers they wait "
+                             "on change. Both select the same instructions with one hardware thread.", "scan" },
         { "fetches_per_cycle", "Number of instruction fetches per cycle" },
         { "retires_per_cycle", "Number of instruction retires per cycle" },
         { "decodes_per_cycle", "Number of instruction decodes per cycle" },
+        { "fast_forward_instructions", "Number of instructions to execute in functional mode before switching to "
+                                       "detailed timing, 0 means no instruction limit", "0" },
+        { "fast_forward_marker_syscall", "System call code which ends functional mode when it is retired, the call is "
+                                         "consumed by the core and not passed to the OS. 0 disables the marker", "0" },
+        { "functional_ins_per_cycle", "Maximum number of instructions executed per clock tick in functional mode",
+          "256" },
+        { "simpoint_interval", "Length in retired instructions of a basic block vector / SimPoint interval",
+          "100000000" },
+        { "bbv_file", "Write basic block vectors for SimPoint to this file, empty disables collection. Hardware "
+                      "thread N > 0 writes to this file with .N appended", "" },
+        { "simpoint_file", "SimPoint .simpoints file listing the intervals to simulate in detail, the rest of the run "
+                           "is executed in functional mode. Requires simpoint_weights_file", "" },
+        { "simpoint_weights_file", "SimPoint .weights file giving the weight of each interval in simpoint_file", "" },
+        { "profile_file", "Write a CPI stack and per instruction address retire/stall counters to this file at the "
+                          "end of simulation, empty disables profiling", "" },
+        { "checkpoint_file", "Write the architectural state of every hardware thread to this file when functional "
+                             "mode ends and stop the core. Lines written so far are flushed to memory first so a "
+                             "backing_out_file on the memory controller holds the matching memory image. Requires "
+                             "fast_forward_instructions or fast_forward_marker_syscall", "" },
+        { "restore_file", "Restore the architectural state of every hardware thread from a file written by "
+                          "checkpoint_file before simulation starts", "" },
         { "print_int_reg", "Print integer registers true/false, auto set to true if verbose > 16" },
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
                           "true if verbose > 16" })
@@ -150,7 +180,9 @@ public:
         { "stores_issued", "Number of store instructions issued to the LSQ", "instructions", 1 },
         { "phys_int_reg_in_use", "Number of physical integer registers that are in use each cycle", "registers", 1 },
         { "phys_fp_reg_in_use", "Number of physical floating point registers than are in use each cycle", "registers",
-          1 })
+          1 },
+        { "instructions_fast_forwarded", "Number of instructions retired in functional mode", "instructions", 1 },
+        { "functional_cycles", "Number of cycles spent in functional mode", "cycles", 1 })
 
     SST_ELI_DOCUMENT_PORTS({ "icache_link", "Connects the CPU to the instruction cache", {} },
                            { "dcache_link", "Connects the CPU to the data cache", {} })
@@ -185,6 +217,7 @@ public:
     void clearFuncUnit(const uint32_t hw_thr, std::vector<VanadisFunctionalUnit*>& unit);
 
     void syscallReturnCallback(uint32_t thr);
+    void endFunctionalMode();
     void setHalt(uint32_t thr, int64_t halt_code);
 
 private:
@@ -217,8 +250,18 @@ private:
     int  performFetch(const uint64_t cycle);
     int  performDecode(const uint64_t cycle);
     int  performIssue(const uint64_t cycle, uint32_t& rob_start, bool& found_store, bool& found_load);
+    void performIssueWakeup(const uint64_t cycle);
     int  performExecute(const uint64_t cycle);
     int  performRetire(VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle);
+    bool tickFunctional(const uint64_t cycle);
+    bool tickCheckpoint();
+    void writeCheckpoint();
+    void restoreCheckpoint();
+    void beginFunctionalMode();
+    void updateSimPointSample();
+    void profileCycle();
+    bool performFunctionalIssue(const uint32_t hw_thr);
+    bool isFastForwardMarker(VanadisSysCallInstruction* syscall_ins);
     int  allocateFunctionalUnit(VanadisInstruction* ins);
     bool mapInstructiontoFunctionalUnit(VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units);
 
@@ -235,6 +278,7 @@ private:
     uint32_t retires_per_cycle;
 
     std::vector<VanadisCircularQueue<VanadisInstruction*>*> rob;
+    std::vector<VanadisIssueQueue*>                         issue_queues;
     std::vector<VanadisDecoder*>                            thread_decoders;
     std::vector<const VanadisDecoderOptions*>               isa_options;
 
@@ -262,6 +306,9 @@ private:
     StandardMem*           memInstInterface;
 
     bool* halted_masks;
+    // Per thread retired instruction counts, used to report branch
+    // mispredictions per thousand instructions
+    std::vector<uint64_t> thread_ins_retired;
     bool  print_int_reg;
     bool  print_fp_reg;
 
@@ -297,6 +344,43 @@ private:
 
     uint64_t pause_on_retire_address;
 
+    // Functional (fast-forward) mode executes instructions one at a time in
+    // program order, with no functional unit latencies, until the instruction
+    // budget runs out or the marker system call retires. Once that happens no
+    // new instructions are started and the core switches to detailed timing
+    // when the last one in flight has retired.
+    bool     functional_mode;
+    bool     functional_draining;
+    uint64_t fast_forward_remaining;
+    uint64_t fast_forward_marker;
+    uint32_t functional_ins_per_cycle;
+
+    Statistic<uint64_t>* stat_ins_fast_forwarded;
+    Statistic<uint64_t>* stat_functional_cycles;
+
+    // Detailed mode stops issuing and waits for everything issued to
+    // execute before handing over to functional mode
+    bool     detailed_draining;
+    uint64_t total_ins_retired;
+
+    // SimPoint support, basic block vector collection and sampled simulation
+    uint64_t                 simpoint_interval;
+    std::vector<VanadisBasicBlockVector*> bbvs;
+    VanadisSimPointSchedule* simpoints;
+    bool                     in_simpoint_sample;
+    uint64_t                 sample_start_cycle;
+    uint64_t                 sample_start_ins;
+
+    // CPI stack and per address counters, nullptr unless profile_file is set
+    VanadisCPIProfiler* profiler;
+
+    // Architectural checkpoint, written once the flushes sent when
+    // functional mode ends have completed
+    std::string checkpoint_path;
+    std::string restore_path;
+    bool        checkpoint_pending;
+    VanadisWrittenPages written_pages;
+
     std::vector<VanadisFloatingPointFlags*> fp_flags;
 };
 
@@ -0,0 +1,131 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_BTB
+#define _H_VANADIS_BRANCH_UNIT_BTB
+
+#include "vbranch/vbranchunit.h"
+#include "vbranch/vbtb.h"
+
+namespace SST {
+namespace Vanadis {
+
+class VanadisBTBBranchUnit : public VanadisBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(VanadisBTBBranchUnit, "vanadis", "VanadisBTBBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Set associative branch target buffer with a return address stack and "
+                                          "a two bit direction counter per entry",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "btb_entries", "Number of entries in the branch target buffer", "512" },
+                            { "btb_associativity", "Number of ways in each set of the branch target buffer", "4" },
+                            { "ras_entries", "Number of entries in the return address stack, 0 disables it", "16" })
+
+    SST_ELI_DOCUMENT_STATISTICS({ "btb_hit", "Counts the number of fetched branches found in the branch target buffer",
+                                  "hits", 1 },
+                                { "btb_miss",
+                                  "Counts the number of fetched branches not found in the branch target buffer",
+                                  "misses", 1 },
+                                { "btb_castout",
+                                  "Counts the number of entries that are thrown out because of capacity limits",
+                                  "entries", 1 })
+
+    VanadisBTBBranchUnit(ComponentId_t id, Params& params) : VanadisBranchUnit(id, params), btb(nullptr) {
+        const uint32_t btb_entries = params.find<uint32_t>("btb_entries", 512);
+        const uint32_t btb_assoc = params.find<uint32_t>("btb_associativity", 4);
+        const uint32_t ras_entries = params.find<uint32_t>("ras_entries", 16);
+
+        if ((0 == btb_assoc) || (btb_entries < btb_assoc) || (0 != (btb_entries % btb_assoc))) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                                        "Error: btb_entries (%" PRIu32 ") must be a non-zero multiple of "
+                                        "btb_associativity (%" PRIu32 ")\n",
+                                        btb_entries, btb_assoc);
+        }
+
+        btb = new VanadisBranchTargetBuffer(btb_entries, btb_assoc, ras_entries);
+
+        stat_btb_hits = registerStatistic<uint64_t>("btb_hit", "1");
+        stat_btb_misses = registerStatistic<uint64_t>("btb_miss", "1");
+        stat_btb_castout = registerStatistic<uint64_t>("btb_castout", "1");
+    }
+
+    virtual ~VanadisBTBBranchUnit() { delete btb; }
+
+    virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) { btb->updateTarget(ins_addr, pred_addr); }
+
+    virtual uint64_t predictAddress(const uint64_t addr) {
+        VanadisBranchTargetBuffer::Entry* entry = btb->lookup(addr);
+
+        if (nullptr == entry) {
+            return 0;
+        }
+
+        const bool taken = (BRANCH_KIND_CONDITIONAL == entry->kind) ? predictTaken(entry) : true;
+        return btb->predict(entry, taken);
+    }
+
+    virtual bool contains(const uint64_t addr) {
+        const bool found = (nullptr != btb->lookup(addr));
+
+        if (found) {
+            stat_btb_hits->addData(1);
+        } else {
+            stat_btb_misses->addData(1);
+        }
+
+        return found;
+    }
+
+    virtual void recover() { btb->recover(); }
+
+protected:
+    virtual void update(VanadisSpeculatedInstruction* ins, const uint64_t resolved_addr) {
+        bool castout = false;
+        VanadisBranchTargetBuffer::Entry* entry = btb->update(ins, resolved_addr, castout);
+
+        if (castout) {
+            stat_btb_castout->addData(1);
+        }
+
+        if (BRANCH_KIND_CONDITIONAL == entry->kind) {
+            updateDirection(entry, resolved_addr != entry->fallthrough);
+        }
+    }
+
+    // Direction of a conditional branch, the base unit uses a two bit
+    // saturating counter held in the buffer entry
+    virtual bool predictTaken(VanadisBranchTargetBuffer::Entry* entry) { return entry->counter >= 2; }
+
+    virtual void updateDirection(VanadisBranchTargetBuffer::Entry* entry, const bool taken) {
+        if (taken) {
+            entry->counter = (entry->counter < 3) ? (entry->counter + 1) : 3;
+        } else {
+            entry->counter = (entry->counter > 0) ? (entry->counter - 1) : 0;
+        }
+    }
+
+    VanadisBranchTargetBuffer* btb;
+
+    Statistic<uint64_t>* stat_btb_hits;
+    Statistic<uint64_t>* stat_btb_misses;
+    Statistic<uint64_t>* stat_btb_castout;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
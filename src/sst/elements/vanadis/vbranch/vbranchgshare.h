@@ -0,0 +1,95 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_GSHARE
+#define _H_VANADIS_BRANCH_UNIT_GSHARE
+
+#include "vbranch/vbranchbtb.h"
+
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * gshare direction prediction: a table of two bit counters indexed by the
+ * branch address XOR'd with the global history of conditional branch
+ * outcomes. The history is updated at retire, so it never has to be
+ * repaired after a misprediction.
+ */
+class VanadisGShareBranchUnit : public VanadisBTBBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(VanadisGShareBranchUnit, "vanadis", "VanadisGShareBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "gshare direction predictor with a set associative branch target "
+                                          "buffer and return address stack",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "btb_entries", "Number of entries in the branch target buffer", "512" },
+                            { "btb_associativity", "Number of ways in each set of the branch target buffer", "4" },
+                            { "ras_entries", "Number of entries in the return address stack, 0 disables it", "16" },
+                            { "history_bits", "Number of global history bits, the counter table has "
+                                              "2^history_bits entries", "12" })
+
+    SST_ELI_DOCUMENT_STATISTICS({ "btb_hit", "Counts the number of fetched branches found in the branch target buffer",
+                                  "hits", 1 },
+                                { "btb_miss",
+                                  "Counts the number of fetched branches not found in the branch target buffer",
+                                  "misses", 1 },
+                                { "btb_castout",
+                                  "Counts the number of entries that are thrown out because of capacity limits",
+                                  "entries", 1 })
+
+    VanadisGShareBranchUnit(ComponentId_t id, Params& params) : VanadisBTBBranchUnit(id, params), history(0) {
+        const uint32_t history_bits = params.find<uint32_t>("history_bits", 12);
+
+        if ((0 == history_bits) || (history_bits > 30)) {
+            getSimulationOutput().fatal(CALL_INFO, -1, "Error: history_bits must be between 1 and 30, got %" PRIu32 "\n",
+                                        history_bits);
+        }
+
+        history_mask = (UINT64_C(1) << history_bits) - 1;
+
+        // Start every counter weakly taken
+        counters.resize(history_mask + 1, 2);
+    }
+
+protected:
+    size_t index(const uint64_t ins_addr) const { return (size_t)(((ins_addr >> 2) ^ history) & history_mask); }
+
+    virtual bool predictTaken(VanadisBranchTargetBuffer::Entry* entry) { return counters[index(entry->ins_addr)] >= 2; }
+
+    virtual void updateDirection(VanadisBranchTargetBuffer::Entry* entry, const bool taken) {
+        uint8_t& counter = counters[index(entry->ins_addr)];
+
+        if (taken) {
+            counter = (counter < 3) ? (counter + 1) : 3;
+        } else {
+            counter = (counter > 0) ? (counter - 1) : 0;
+        }
+
+        history = ((history << 1) | (taken ? 1 : 0)) & history_mask;
+    }
+
+    uint64_t history;
+    uint64_t history_mask;
+    std::vector<uint8_t> counters;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,306 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_TAGE
+#define _H_VANADIS_BRANCH_UNIT_TAGE
+
+#include "vbranch/vbranchbtb.h"
+
+#include <cmath>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * A reduced TAGE direction predictor: a bimodal base table and a number of
+ * tagged tables indexed with geometrically increasing lengths of global
+ * history. The longest matching table provides the prediction. Mispredicted
+ * branches allocate an entry in a longer table, guided by a useful counter
+ * per entry which is aged periodically. There is no loop predictor or
+ * statistical corrector.
+ *
+ * Histories are folded incrementally so an index or tag is computed in
+ * constant time whatever the history length. Like the gshare unit the
+ * history is updated at retire.
+ */
+class VanadisTAGEBranchUnit : public VanadisBTBBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(VanadisTAGEBranchUnit, "vanadis", "VanadisTAGEBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "TAGE-lite direction predictor with a set associative branch target "
+                                          "buffer and return address stack",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "btb_entries", "Number of entries in the branch target buffer", "512" },
+                            { "btb_associativity", "Number of ways in each set of the branch target buffer", "4" },
+                            { "ras_entries", "Number of entries in the return address stack, 0 disables it", "16" },
+                            { "bimodal_bits", "The base bimodal table has 2^bimodal_bits entries", "12" },
+                            { "tagged_tables", "Number of tagged tables", "4" },
+                            { "tagged_table_bits", "Each tagged table has 2^tagged_table_bits entries", "10" },
+                            { "tag_bits", "Width of the tags in the tagged tables", "9" },
+                            { "min_history", "History length used by the first tagged table", "4" },
+                            { "max_history", "History length used by the last tagged table", "64" })
+
+    SST_ELI_DOCUMENT_STATISTICS({ "btb_hit", "Counts the number of fetched branches found in the branch target buffer",
+                                  "hits", 1 },
+                                { "btb_miss",
+                                  "Counts the number of fetched branches not found in the branch target buffer",
+                                  "misses", 1 },
+                                { "btb_castout",
+                                  "Counts the number of entries that are thrown out because of capacity limits",
+                                  "entries", 1 },
+                                { "tagged_provider", "Counts the number of retired conditional branches whose "
+                                                     "direction came from a tagged table", "branches", 1 },
+                                { "tagged_allocations", "Counts the number of entries allocated in the tagged tables",
+                                  "entries", 1 })
+
+    VanadisTAGEBranchUnit(ComponentId_t id, Params& params)
+        : VanadisBTBBranchUnit(id, params), history_pos(0), update_count(0) {
+        const uint32_t bimodal_bits = params.find<uint32_t>("bimodal_bits", 12);
+        const uint32_t table_count = params.find<uint32_t>("tagged_tables", 4);
+        table_bits = params.find<uint32_t>("tagged_table_bits", 10);
+        tag_bits = params.find<uint32_t>("tag_bits", 9);
+        const uint32_t min_history = params.find<uint32_t>("min_history", 4);
+        const uint32_t max_history = params.find<uint32_t>("max_history", 64);
+
+        if ((0 == bimodal_bits) || (bimodal_bits > 30) || (0 == table_bits) || (table_bits > 30)) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                                        "Error: bimodal_bits and tagged_table_bits must be between 1 and 30.\n");
+        }
+
+        if ((0 == table_count) || (tag_bits < 2) || (tag_bits > 15)) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                                        "Error: tagged_tables must be at least 1 and tag_bits between 2 and 15.\n");
+        }
+
+        if ((0 == min_history) || (max_history < min_history)) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                                        "Error: min_history must be at least 1 and no more than max_history.\n");
+        }
+
+        bimodal_mask = (UINT64_C(1) << bimodal_bits) - 1;
+        bimodal.resize(bimodal_mask + 1, 2);
+
+        table_mask = (UINT64_C(1) << table_bits) - 1;
+        tag_mask = (1 << tag_bits) - 1;
+
+        size_t history_size = 1;
+        while (history_size <= max_history) {
+            history_size <<= 1;
+        }
+
+        history.resize(history_size, 0);
+        history_mask = history_size - 1;
+
+        for (uint32_t i = 0; i < table_count; ++i) {
+            // Geometric series of history lengths between min and max
+            const double ratio = (table_count > 1) ? ((double)i / (double)(table_count - 1)) : 0.0;
+            const uint32_t length =
+                (uint32_t)(min_history * std::pow((double)max_history / (double)min_history, ratio) + 0.5);
+
+            tables.emplace_back(length, table_bits, tag_bits);
+            // Tags are at most 15 bits so an empty entry never matches
+            tables.back().entries.resize(table_mask + 1, TaggedEntry{ UINT16_MAX, 0, 0 });
+        }
+
+        stat_tagged_provider = registerStatistic<uint64_t>("tagged_provider", "1");
+        stat_tagged_allocations = registerStatistic<uint64_t>("tagged_allocations", "1");
+    }
+
+protected:
+    struct TaggedEntry {
+        uint16_t tag;
+        int8_t counter; // 3-bit signed, taken when >= 0
+        uint8_t useful; // 2-bit
+    };
+
+    // Compresses the most recent length history bits into width bits,
+    // updated with one shift and two XORs per new outcome
+    struct FoldedHistory {
+        FoldedHistory() : value(0), length(0), width(1) {}
+        FoldedHistory(const uint32_t hist_len, const uint32_t fold_width)
+            : value(0), length(hist_len), width(fold_width) {}
+
+        void update(const uint32_t new_bit, const uint32_t old_bit) {
+            value = (value << 1) | new_bit;
+            value ^= old_bit << (length % width);
+            value ^= value >> width;
+            value &= (UINT32_C(1) << width) - 1;
+        }
+
+        uint32_t value;
+        uint32_t length;
+        uint32_t width;
+    };
+
+    struct TaggedTable {
+        TaggedTable(const uint32_t hist_len, const uint32_t index_bits, const uint32_t tag_width)
+            : history_length(hist_len), index_fold(hist_len, index_bits), tag_fold_a(hist_len, tag_width),
+              tag_fold_b(hist_len, tag_width - 1) {}
+
+        uint32_t history_length;
+        FoldedHistory index_fold;
+        FoldedHistory tag_fold_a;
+        FoldedHistory tag_fold_b;
+        std::vector<TaggedEntry> entries;
+    };
+
+    size_t tableIndex(const uint32_t table, const uint64_t ins_addr) const {
+        const uint64_t pc = ins_addr >> 2;
+        return (size_t)((pc ^ (pc >> (table_bits - (table % table_bits))) ^ tables[table].index_fold.value) &
+                        table_mask);
+    }
+
+    uint16_t tableTag(const uint32_t table, const uint64_t ins_addr) const {
+        const uint64_t pc = ins_addr >> 2;
+        return (uint16_t)((pc ^ tables[table].tag_fold_a.value ^ (tables[table].tag_fold_b.value << 1)) & tag_mask);
+    }
+
+    // Longest matching table, -1 if no tagged table matches
+    int findProvider(const uint64_t ins_addr, const int below) const {
+        for (int i = below - 1; i >= 0; --i) {
+            if (tables[i].entries[tableIndex(i, ins_addr)].tag == tableTag(i, ins_addr)) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    bool bimodalTaken(const uint64_t ins_addr) const { return bimodal[(ins_addr >> 2) & bimodal_mask] >= 2; }
+
+    virtual bool predictTaken(VanadisBranchTargetBuffer::Entry* entry) {
+        const int provider = findProvider(entry->ins_addr, (int)tables.size());
+
+        if (provider < 0) {
+            return bimodalTaken(entry->ins_addr);
+        }
+
+        return tables[provider].entries[tableIndex(provider, entry->ins_addr)].counter >= 0;
+    }
+
+    virtual void updateDirection(VanadisBranchTargetBuffer::Entry* entry, const bool taken) {
+        const uint64_t ins_addr = entry->ins_addr;
+        const int provider = findProvider(ins_addr, (int)tables.size());
+        const int alternate = (provider > 0) ? findProvider(ins_addr, provider) : -1;
+
+        const bool alt_taken = (alternate < 0)
+                                   ? bimodalTaken(ins_addr)
+                                   : (tables[alternate].entries[tableIndex(alternate, ins_addr)].counter >= 0);
+        bool provider_taken = alt_taken;
+
+        if (provider >= 0) {
+            stat_tagged_provider->addData(1);
+
+            TaggedEntry& hit = tables[provider].entries[tableIndex(provider, ins_addr)];
+            provider_taken = (hit.counter >= 0);
+
+            if (provider_taken != alt_taken) {
+                if (provider_taken == taken) {
+                    hit.useful = (hit.useful < 3) ? (hit.useful + 1) : 3;
+                } else {
+                    hit.useful = (hit.useful > 0) ? (hit.useful - 1) : 0;
+                }
+            }
+
+            if (taken) {
+                hit.counter = (hit.counter < 3) ? (hit.counter + 1) : 3;
+            } else {
+                hit.counter = (hit.counter > -4) ? (hit.counter - 1) : -4;
+            }
+        } else {
+            uint8_t& counter = bimodal[(ins_addr >> 2) & bimodal_mask];
+
+            if (taken) {
+                counter = (counter < 3) ? (counter + 1) : 3;
+            } else {
+                counter = (counter > 0) ? (counter - 1) : 0;
+            }
+        }
+
+        // On a misprediction try to allocate in a table with a longer history
+        if ((provider_taken != taken) && ((provider + 1) < (int)tables.size())) {
+            bool allocated = false;
+
+            for (int i = provider + 1; i < (int)tables.size(); ++i) {
+                TaggedEntry& next = tables[i].entries[tableIndex(i, ins_addr)];
+
+                if (0 == next.useful) {
+                    next.tag = tableTag(i, ins_addr);
+                    next.counter = taken ? 0 : -1;
+                    allocated = true;
+                    stat_tagged_allocations->addData(1);
+                    break;
+                }
+            }
+
+            if (!allocated) {
+                for (int i = provider + 1; i < (int)tables.size(); ++i) {
+                    TaggedEntry& next = tables[i].entries[tableIndex(i, ins_addr)];
+                    next.useful = (next.useful > 0) ? (next.useful - 1) : 0;
+                }
+            }
+        }
+
+        // Age the useful counters so stale entries can be replaced
+        if (0 == (++update_count & 0x3FFFF)) {
+            for (TaggedTable& next_table : tables) {
+                for (TaggedEntry& next : next_table.entries) {
+                    next.useful >>= 1;
+                }
+            }
+        }
+
+        pushHistory(taken);
+    }
+
+    void pushHistory(const bool taken) {
+        history_pos = (history_pos + 1) & history_mask;
+        history[history_pos] = taken ? 1 : 0;
+
+        for (TaggedTable& next_table : tables) {
+            const uint32_t old_bit = history[(history_pos - next_table.history_length) & history_mask];
+
+            next_table.index_fold.update(history[history_pos], old_bit);
+            next_table.tag_fold_a.update(history[history_pos], old_bit);
+            next_table.tag_fold_b.update(history[history_pos], old_bit);
+        }
+    }
+
+    std::vector<uint8_t> bimodal;
+    uint64_t bimodal_mask;
+
+    std::vector<TaggedTable> tables;
+    uint32_t table_bits;
+    uint64_t table_mask;
+    uint32_t tag_bits;
+    uint16_t tag_mask;
+
+    std::vector<uint8_t> history;
+    size_t history_mask;
+    size_t history_pos;
+
+    uint64_t update_count;
+
+    Statistic<uint64_t>* stat_tagged_provider;
+    Statistic<uint64_t>* stat_tagged_allocations;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,166 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/component.h>
+
+#include "inst/vjl.h"
+#include "inst/vjr.h"
+#include "vbranch/vbranchtester.h"
+
+using namespace SST::Vanadis;
+
+namespace {
+
+const uint64_t TRACE_INS_WIDTH = 4;
+const uint16_t TRACE_ZERO_REG = 0;
+const uint16_t TRACE_LINK_REG = 31;
+
+const uint64_t TRACE_LOOP_ADDR = 0x1000;
+const uint64_t TRACE_LOOP_TARGET = 0x0F00;
+const uint64_t TRACE_CALL_SITE_BASE = 0x2000;
+const uint64_t TRACE_CALL_SITE_STRIDE = 0x100;
+const uint64_t TRACE_FUNCTION_ADDR = 0x8000;
+const uint64_t TRACE_RETURN_ADDR = 0x8010;
+
+// A conditional branch whose outcome is given by the trace
+class VanadisTraceBranchInstruction : public VanadisSpeculatedInstruction {
+public:
+    VanadisTraceBranchInstruction(const uint64_t addr, const VanadisDecoderOptions* isa_opts)
+        : VanadisSpeculatedInstruction(addr, 0, isa_opts, TRACE_INS_WIDTH, 0, 0, 0, 0, 0, 0, 0, 0,
+                                       VANADIS_NO_DELAY_SLOT) {}
+
+    VanadisTraceBranchInstruction* clone() override { return new VanadisTraceBranchInstruction(*this); }
+    const char* getInstCode() const override { return "TRACEBR"; }
+    void execute(SST::Output* output, VanadisRegisterFile* regFile) override { markExecuted(); }
+};
+
+} // namespace
+
+VanadisBranchTester::VanadisBranchTester(ComponentId_t id, Params& params) : SST::Component(id) {
+    const uint32_t verbosity = params.find<uint32_t>("verbose", 0);
+    output = new SST::Output("[branch-tester]: ", verbosity, 0, SST::Output::STDOUT);
+
+    trace = params.find<std::string>("trace", "loop");
+    iterations = params.find<uint64_t>("iterations", 1000);
+    warmup = params.find<uint64_t>("warmup", 100);
+    loop_trip = params.find<uint32_t>("loop_trip", 8);
+    call_sites = params.find<uint32_t>("call_sites", 4);
+    min_mispredicts = params.find<uint64_t>("min_mispredicts", 0);
+    max_mispredicts = params.find<uint64_t>("max_mispredicts", 0);
+
+    if ((trace != "loop") && (trace != "calls")) {
+        output->fatal(CALL_INFO, -1, "Error: trace must be loop or calls, got %s\n", trace.c_str());
+    }
+
+    if (warmup >= iterations) {
+        output->fatal(CALL_INFO, -1, "Error: warmup (%" PRIu64 ") must be less than iterations (%" PRIu64 ")\n",
+                      warmup, iterations);
+    }
+
+    if ((loop_trip < 2) || (0 == call_sites)) {
+        output->fatal(CALL_INFO, -1, "Error: loop_trip must be at least 2 and call_sites at least 1\n");
+    }
+
+    branch_unit = loadUserSubComponent<SST::Vanadis::VanadisBranchUnit>("branch_unit");
+
+    if (nullptr == branch_unit) {
+        output->fatal(CALL_INFO, -1, "Error: no branch_unit was loaded into the tester\n");
+    }
+
+    isa_opts = new VanadisDecoderOptions(TRACE_ZERO_REG, 32, 32, 2, VANADIS_REGISTER_MODE_FP64);
+}
+
+VanadisBranchTester::~VanadisBranchTester() {
+    delete isa_opts;
+    delete output;
+}
+
+void VanadisBranchTester::setup() {
+    uint64_t warm_branches = 0;
+    uint64_t warm_mispredicts = 0;
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        if (i == warmup) {
+            warm_branches = branch_unit->getBranchCount();
+            warm_mispredicts = branch_unit->getMispredictCount();
+        }
+
+        if (trace == "loop") {
+            runLoop();
+        } else {
+            runCalls();
+        }
+    }
+
+    const uint64_t branches = branch_unit->getBranchCount() - warm_branches;
+    const uint64_t mispredicts = branch_unit->getMispredictCount() - warm_mispredicts;
+
+    output->output("Trace %s: %" PRIu64 " branches / %" PRIu64 " mispredicted after %" PRIu64 " warmup iterations\n",
+                   trace.c_str(), branches, mispredicts, warmup);
+
+    if ((mispredicts < min_mispredicts) || (mispredicts > max_mispredicts)) {
+        output->fatal(CALL_INFO, -1,
+                      "Error: %" PRIu64 " mispredictions is outside the expected range %" PRIu64 " to %" PRIu64 "\n",
+                      mispredicts, min_mispredicts, max_mispredicts);
+    }
+
+    output->output("Trace %s: PASS\n", trace.c_str());
+}
+
+void VanadisBranchTester::runLoop() {
+    for (uint32_t i = 0; i < loop_trip; ++i) {
+        const bool taken = (i + 1) < loop_trip;
+
+        runBranch(new VanadisTraceBranchInstruction(TRACE_LOOP_ADDR, isa_opts),
+                  taken ? TRACE_LOOP_TARGET : (TRACE_LOOP_ADDR + TRACE_INS_WIDTH));
+    }
+}
+
+void VanadisBranchTester::runCalls() {
+    for (uint32_t i = 0; i < call_sites; ++i) {
+        const uint64_t call_addr = TRACE_CALL_SITE_BASE + (i * TRACE_CALL_SITE_STRIDE);
+
+        runBranch(new VanadisJumpLinkInstruction(call_addr, 0, isa_opts, TRACE_INS_WIDTH, TRACE_LINK_REG,
+                                                 TRACE_FUNCTION_ADDR, VANADIS_NO_DELAY_SLOT),
+                  TRACE_FUNCTION_ADDR);
+        runBranch(new VanadisJumpRegInstruction(TRACE_RETURN_ADDR, 0, isa_opts, TRACE_INS_WIDTH, TRACE_LINK_REG,
+                                                VANADIS_NO_DELAY_SLOT),
+                  call_addr + TRACE_INS_WIDTH);
+    }
+}
+
+void VanadisBranchTester::runBranch(VanadisSpeculatedInstruction* ins, const uint64_t resolved_addr) {
+    const uint64_t ins_addr = ins->getInstructionAddress();
+
+    // Same as the decoders, a branch the unit does not know about is
+    // predicted to fall through
+    if (branch_unit->contains(ins_addr)) {
+        ins->setSpeculatedAddress(branch_unit->predictAddress(ins_addr));
+    }
+
+    output->verbose(CALL_INFO, 8, 0, "%s 0x%" PRIx64 " predicted 0x%" PRIx64 " resolved 0x%" PRIx64 "\n",
+                    ins->getInstCode(), ins_addr, ins->getSpeculatedAddress(), resolved_addr);
+
+    const bool mispredicted = (ins->getSpeculatedAddress() != resolved_addr);
+
+    branch_unit->retireBranch(ins, resolved_addr);
+
+    if (mispredicted) {
+        branch_unit->recover();
+    }
+
+    delete ins;
+}
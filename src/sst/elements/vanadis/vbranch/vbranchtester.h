@@ -0,0 +1,89 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_TESTER
+#define _H_VANADIS_BRANCH_TESTER
+
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+
+#include "decoder/visaopts.h"
+#include "inst/vspeculate.h"
+#include "vbranch/vbranchunit.h"
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Drives a branch unit with a synthetic trace of branches whose outcomes are
+ * known, without a core or a binary. Each branch is predicted the way the
+ * decoders do it, retired straight away and followed by a recover() when it
+ * was mispredicted, like a pipeline clear. The mispredictions after the
+ * warmup iterations are checked against the bounds given in the parameters.
+ *
+ *   loop  - one conditional branch taken loop_trip - 1 times then not taken
+ *   calls - one function called in turn from call_sites call sites, each
+ *           call is a jump-and-link and each return a register jump
+ */
+class VanadisBranchTester : public SST::Component {
+
+public:
+    SST_ELI_REGISTER_COMPONENT(VanadisBranchTester, "vanadis", "VanadisBranchTester", SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                               "Checks a branch unit against a synthetic branch trace", COMPONENT_CATEGORY_UNCATEGORIZED)
+
+    SST_ELI_DOCUMENT_PARAMS({ "verbose", "Set the output verbosity, 0 is no output, higher is more.", "0" },
+                            { "trace", "Branch trace to run, loop or calls", "loop" },
+                            { "iterations", "Number of times the trace is repeated", "1000" },
+                            { "warmup", "Number of iterations run before mispredictions are counted", "100" },
+                            { "loop_trip", "Trip count of the loop trace", "8" },
+                            { "call_sites", "Number of call sites in the calls trace", "4" },
+                            { "min_mispredicts", "Fewest mispredictions allowed after the warmup", "0" },
+                            { "max_mispredicts", "Most mispredictions allowed after the warmup", "0" })
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS({ "branch_unit", "Branch prediction unit under test",
+                                          "SST::Vanadis::VanadisBranchUnit" })
+
+    VanadisBranchTester(ComponentId_t id, Params& params);
+    ~VanadisBranchTester();
+
+    void setup();
+
+private:
+    VanadisBranchTester();                           // for serialization only
+    VanadisBranchTester(const VanadisBranchTester&); // do not implement
+    void operator=(const VanadisBranchTester&);      // do not implement
+
+    void runLoop();
+    void runCalls();
+    void runBranch(VanadisSpeculatedInstruction* ins, const uint64_t resolved_addr);
+
+    VanadisBranchUnit* branch_unit;
+    VanadisDecoderOptions* isa_opts;
+
+    std::string trace;
+    uint64_t iterations;
+    uint64_t warmup;
+    uint32_t loop_trip;
+    uint32_t call_sites;
+    uint64_t min_mispredicts;
+    uint64_t max_mispredicts;
+
+    SST::Output* output;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -34,12 +34,41 @@ public:
 
     SST_ELI_DOCUMENT_STATISTICS()
 
-    VanadisBranchUnit(ComponentId_t id, Params& params) : SubComponent(id) {}
+    VanadisBranchUnit(ComponentId_t id, Params& params) : SubComponent(id), branch_count(0), mispredict_count(0) {}
     virtual ~VanadisBranchUnit() {}
 
     virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) = 0;
     virtual uint64_t predictAddress(const uint64_t addr) = 0;
     virtual bool contains(const uint64_t addr) = 0;
+
+    // Called at retire for every branch once its target is known. These are
+    // the only branch and misprediction counts, units do not keep their own.
+    void retireBranch(VanadisSpeculatedInstruction* ins, const uint64_t resolved_addr) {
+        branch_count++;
+
+        if (resolved_addr != ins->getSpeculatedAddress()) {
+            mispredict_count++;
+        }
+
+        update(ins, resolved_addr);
+    }
+
+    // Called when the pipeline is cleared, predictors which update state
+    // speculatively at prediction time restore it here
+    virtual void recover() {}
+
+    uint64_t getBranchCount() const { return branch_count; }
+    uint64_t getMispredictCount() const { return mispredict_count; }
+
+protected:
+    // Predictors which need more than the target (direction, type of branch)
+    // override this
+    virtual void update(VanadisSpeculatedInstruction* ins, const uint64_t resolved_addr) {
+        push(ins->getInstructionAddress(), resolved_addr);
+    }
+
+    uint64_t branch_count;
+    uint64_t mispredict_count;
 };
 
 } // namespace Vanadis
@@ -0,0 +1,269 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_TARGET_BUFFER
+#define _H_VANADIS_BRANCH_TARGET_BUFFER
+
+#include "inst/vjl.h"
+#include "inst/vjlr.h"
+#include "inst/vjr.h"
+#include "inst/vjump.h"
+#include "inst/vspeculate.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+enum VanadisBranchKind {
+    BRANCH_KIND_CONDITIONAL,
+    BRANCH_KIND_JUMP,
+    BRANCH_KIND_INDIRECT,
+    BRANCH_KIND_CALL,
+    BRANCH_KIND_RETURN
+};
+
+/*
+ * Set associative branch target buffer with a return address stack, shared
+ * by the table based branch units. Each entry is filled at retire with the
+ * kind of the branch, its last taken target and its fall through address, so
+ * the units only have to supply a taken/not-taken direction for conditional
+ * branches.
+ *
+ * Calls push on to the return address stack and returns pop from it when
+ * they are predicted. A copy of the stack is kept up to date at retire and
+ * restores the speculative stack when the pipeline is cleared.
+ */
+class VanadisBranchTargetBuffer
+{
+public:
+    struct Entry
+    {
+        uint64_t          ins_addr;
+        uint64_t          target;
+        uint64_t          fallthrough;
+        uint64_t          last_use;
+        VanadisBranchKind kind;
+        uint8_t           counter;
+        bool              valid;
+    };
+
+    VanadisBranchTargetBuffer(const uint32_t entries, const uint32_t assoc, const uint32_t ras_entries) :
+        ways(assoc),
+        sets(entries / assoc),
+        use_count(0),
+        ras_size(ras_entries),
+        spec_ras(ras_entries, 0),
+        spec_ras_top(0),
+        spec_ras_count(0),
+        retire_ras(ras_entries, 0),
+        retire_ras_top(0),
+        retire_ras_count(0)
+    {
+        table.resize((size_t)sets * ways, Entry { 0, 0, 0, 0, BRANCH_KIND_JUMP, 0, false });
+    }
+
+    Entry* lookup(const uint64_t ins_addr)
+    {
+        Entry* set = &table[setIndex(ins_addr) * ways];
+
+        for ( uint32_t i = 0; i < ways; ++i ) {
+            if ( set[i].valid && (set[i].ins_addr == ins_addr) ) {
+                set[i].last_use = ++use_count;
+                return &set[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Find the entry for ins_addr, replacing the least recently used way of
+    // the set if there is not one. castout is set if a valid entry is lost.
+    Entry* allocate(const uint64_t ins_addr, bool& castout)
+    {
+        castout    = false;
+        Entry* hit = lookup(ins_addr);
+
+        if ( nullptr != hit ) { return hit; }
+
+        Entry* set    = &table[setIndex(ins_addr) * ways];
+        Entry* victim = &set[0];
+
+        for ( uint32_t i = 0; i < ways; ++i ) {
+            if ( !set[i].valid ) {
+                victim = &set[i];
+                break;
+            }
+
+            if ( set[i].last_use < victim->last_use ) { victim = &set[i]; }
+        }
+
+        castout = victim->valid;
+        *victim = Entry { ins_addr, 0, 0, ++use_count, BRANCH_KIND_JUMP, 0, true };
+
+        return victim;
+    }
+
+    // Next fetch address for a branch which is in the buffer, the direction
+    // is only used for conditional branches
+    uint64_t predict(Entry* entry, const bool taken)
+    {
+        switch ( entry->kind ) {
+        case BRANCH_KIND_CONDITIONAL:
+            return (taken && (entry->target != 0)) ? entry->target : entry->fallthrough;
+        case BRANCH_KIND_CALL:
+            push(spec_ras, spec_ras_top, spec_ras_count, entry->fallthrough);
+            return entry->target;
+        case BRANCH_KIND_RETURN:
+            if ( spec_ras_count > 0 ) { return pop(spec_ras, spec_ras_top, spec_ras_count); }
+            return entry->target;
+        default:
+            return entry->target;
+        }
+    }
+
+    // Record a retired branch, returns the entry it was written to
+    Entry* update(VanadisSpeculatedInstruction* ins, const uint64_t resolved_addr, bool& castout)
+    {
+        const VanadisBranchKind kind = classify(ins);
+        Entry*                  entry = allocate(ins->getInstructionAddress(), castout);
+
+        entry->kind        = kind;
+        entry->fallthrough = fallthroughAddress(ins);
+
+        if ( resolved_addr != entry->fallthrough ) { entry->target = resolved_addr; }
+
+        switch ( kind ) {
+        case BRANCH_KIND_CALL:
+            push(retire_ras, retire_ras_top, retire_ras_count, entry->fallthrough);
+            break;
+        case BRANCH_KIND_RETURN:
+            if ( retire_ras_count > 0 ) { pop(retire_ras, retire_ras_top, retire_ras_count); }
+            break;
+        default:
+            break;
+        }
+
+        return entry;
+    }
+
+    // Record a target without knowing anything about the branch
+    void updateTarget(const uint64_t ins_addr, const uint64_t target)
+    {
+        bool   castout = false;
+        Entry* entry   = allocate(ins_addr, castout);
+
+        entry->target = target;
+    }
+
+    // The pipeline was cleared, throw away speculative pushes and pops
+    void recover()
+    {
+        spec_ras       = retire_ras;
+        spec_ras_top   = retire_ras_top;
+        spec_ras_count = retire_ras_count;
+    }
+
+    static uint64_t fallthroughAddress(VanadisSpeculatedInstruction* ins)
+    {
+        switch ( ins->getDelaySlotType() ) {
+        case VANADIS_SINGLE_DELAY_SLOT:
+        case VANADIS_CONDITIONAL_SINGLE_DELAY_SLOT:
+            return ins->getInstructionAddress() + (ins->getInstructionWidth() * 2);
+        default:
+            return ins->getInstructionAddress() + ins->getInstructionWidth();
+        }
+    }
+
+private:
+    size_t setIndex(const uint64_t ins_addr) const
+    {
+        const uint64_t word = ins_addr >> 2;
+        return (size_t)((word ^ (word / sets)) % sets);
+    }
+
+    // Calls are jumps which write a link register. A register jump which
+    // reads a register a call has written as its link is taken to be a
+    // return, any other register jump is a plain indirect branch.
+    VanadisBranchKind classify(VanadisSpeculatedInstruction* ins)
+    {
+        const uint16_t ignore_reg = ins->getISAOptions()->getRegisterIgnoreWrites();
+
+        if ( (nullptr != dynamic_cast<VanadisJumpLinkInstruction*>(ins)) ||
+             (nullptr != dynamic_cast<VanadisJumpRegLinkInstruction*>(ins)) ) {
+            const uint16_t link_reg = ins->getISAIntRegOut(0);
+
+            if ( link_reg != ignore_reg ) {
+                if ( link_reg >= link_regs.size() ) { link_regs.resize(link_reg + 1, false); }
+                link_regs[link_reg] = true;
+                return BRANCH_KIND_CALL;
+            }
+        }
+
+        if ( (nullptr != dynamic_cast<VanadisJumpRegInstruction*>(ins)) ||
+             (nullptr != dynamic_cast<VanadisJumpRegLinkInstruction*>(ins)) ) {
+            const uint16_t addr_reg = ins->getISAIntRegIn(0);
+            return ((addr_reg < link_regs.size()) && link_regs[addr_reg]) ? BRANCH_KIND_RETURN : BRANCH_KIND_INDIRECT;
+        }
+
+        if ( (nullptr != dynamic_cast<VanadisJumpLinkInstruction*>(ins)) ||
+             (nullptr != dynamic_cast<VanadisJumpInstruction*>(ins)) ) {
+            return BRANCH_KIND_JUMP;
+        }
+
+        return BRANCH_KIND_CONDITIONAL;
+    }
+
+    void push(std::vector<uint64_t>& ras, uint32_t& top, uint32_t& count, const uint64_t addr)
+    {
+        if ( 0 == ras_size ) { return; }
+
+        // A full stack overwrites its oldest entry
+        top      = (top + 1) % ras_size;
+        ras[top] = addr;
+
+        if ( count < ras_size ) { count++; }
+    }
+
+    uint64_t pop(std::vector<uint64_t>& ras, uint32_t& top, uint32_t& count)
+    {
+        const uint64_t addr = ras[top];
+        top                 = (top + ras_size - 1) % ras_size;
+        count--;
+
+        return addr;
+    }
+
+    const uint32_t     ways;
+    const uint32_t     sets;
+    uint64_t           use_count;
+    std::vector<Entry> table;
+
+    const uint32_t        ras_size;
+    std::vector<uint64_t> spec_ras;
+    uint32_t              spec_ras_top;
+    uint32_t              spec_ras_count;
+    std::vector<uint64_t> retire_ras;
+    uint32_t              retire_ras_top;
+    uint32_t              retire_ras_count;
+
+    std::vector<bool> link_regs;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
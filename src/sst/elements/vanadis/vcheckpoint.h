@@ -0,0 +1,65 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_CHECKPOINT
+#define _H_VANADIS_CHECKPOINT
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+#define VANADIS_CHECKPOINT_PAGE_SIZE 4096
+#define VANADIS_CHECKPOINT_VERSION 1
+
+/*
+ * Pages written since the last checkpoint. Each core owns one, filled by
+ * its LSQ, and the node OS owns one for the writes it makes on behalf of
+ * system calls. Before checkpointing each flushes every line of its pages
+ * so the memory backing store (which memHierarchy checkpoints) holds the
+ * architectural memory image rather than whatever happens to have been
+ * evicted.
+ */
+class VanadisWrittenPages {
+public:
+    void record(const uint64_t addr, const uint64_t len) {
+        if (0 == len) {
+            return;
+        }
+
+        for (uint64_t page = addr / VANADIS_CHECKPOINT_PAGE_SIZE;
+             page <= ((addr + len - 1) / VANADIS_CHECKPOINT_PAGE_SIZE); ++page) {
+            pages.insert(page * VANADIS_CHECKPOINT_PAGE_SIZE);
+        }
+    }
+
+    // Start addresses of every page written since the last call
+    std::vector<uint64_t> take() {
+        std::vector<uint64_t> written(pages.begin(), pages.end());
+        pages.clear();
+
+        return written;
+    }
+
+private:
+    std::unordered_set<uint64_t> pages;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
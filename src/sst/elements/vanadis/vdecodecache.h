@@ -0,0 +1,318 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_DECODE_CACHE
+#define _H_VANADIS_DECODE_CACHE
+
+#include <sst/core/output.h>
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "vinsbundle.h"
+
+namespace SST {
+namespace Vanadis {
+
+#define VANADIS_DECODE_CACHE_PAGE_SIZE 4096
+
+/*
+ * Versions of the pages a node has decoded code from. A store to one of
+ * these pages bumps its version and the node's write generation, bundles
+ * stamped with an older version then miss in the shared cache and in every
+ * decoder's micro-op cache. Stores carry no notion of which executable they
+ * belong to so one table covers every executable on the node, and each node
+ * has its own since a store on one node leaves the others' memory alone.
+ */
+class VanadisCodePageVersions {
+public:
+    VanadisCodePageVersions() : code_start(UINT64_MAX), code_end(0), generation(0) {}
+
+    // Called for every store sent to memory, the range check means stores
+    // outside the decoded text do not take the lock
+    void notifyStore(const uint64_t addr, const uint64_t len) {
+        if ((0 == len) || (addr >= code_end.load(std::memory_order_relaxed)) ||
+            ((addr + len) <= code_start.load(std::memory_order_relaxed))) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+        bool invalidated = false;
+
+        for (uint64_t page = addr / VANADIS_DECODE_CACHE_PAGE_SIZE;
+             page <= ((addr + len - 1) / VANADIS_DECODE_CACHE_PAGE_SIZE); ++page) {
+            auto page_itr = page_versions.find(page);
+
+            if (page_itr != page_versions.end()) {
+                page_itr->second++;
+                invalidated = true;
+            }
+        }
+
+        if (invalidated) {
+            generation.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    // Changes whenever any code page is written, a decoder only needs to
+    // re-check its bundles when this moves
+    uint64_t writeGeneration() const { return generation.load(std::memory_order_acquire); }
+
+    // Sum of the versions of the pages covering [addr, addr + len), every
+    // write increases it so any change means one of the pages was written
+    uint64_t pageVersion(const uint64_t addr, const uint64_t len) {
+        std::lock_guard<std::mutex> guard(lock);
+
+        uint64_t version = 0;
+
+        for (uint64_t page = addr / VANADIS_DECODE_CACHE_PAGE_SIZE;
+             page <= ((addr + len - 1) / VANADIS_DECODE_CACHE_PAGE_SIZE); ++page) {
+            auto page_itr = page_versions.find(page);
+            version += (page_itr == page_versions.end()) ? 0 : page_itr->second;
+        }
+
+        return version;
+    }
+
+    uint64_t registerCodePage(const uint64_t addr, const uint64_t len) {
+        std::lock_guard<std::mutex> guard(lock);
+
+        if (addr < code_start.load(std::memory_order_relaxed)) {
+            code_start.store(addr, std::memory_order_relaxed);
+        }
+
+        if ((addr + len) > code_end.load(std::memory_order_relaxed)) {
+            code_end.store(addr + len, std::memory_order_relaxed);
+        }
+
+        // Instructions may straddle a page boundary, both pages are code
+        uint64_t version = 0;
+
+        for (uint64_t page = addr / VANADIS_DECODE_CACHE_PAGE_SIZE;
+             page <= ((addr + len - 1) / VANADIS_DECODE_CACHE_PAGE_SIZE); ++page) {
+            version += page_versions.insert(std::make_pair(page, (uint64_t)0)).first->second;
+        }
+
+        return version;
+    }
+
+private:
+    std::mutex lock;
+    std::unordered_map<uint64_t, uint64_t> page_versions;
+
+    std::atomic<uint64_t> code_start;
+    std::atomic<uint64_t> code_end;
+    std::atomic<uint64_t> generation;
+};
+
+/*
+ * Decoded instruction bundles shared by every decoder on a node that runs
+ * the same executable with the same ISA configuration, so an SPMD job
+ * decodes its text once per node rather than once per core. Decoders keep
+ * their own micro-op caches (these still model capacity and timing) but the
+ * entries refer to bundles held here rather than private copies.
+ *
+ * Bundles are stamped with the version of the code page they were decoded
+ * from in the node's VanadisCodePageVersions.
+ */
+class VanadisSharedDecodeCache {
+public:
+    typedef std::shared_ptr<VanadisInstructionBundle> BundleRef;
+
+    // One cache per (node, ISA configuration, executable) in the process
+    static VanadisSharedDecodeCache* get(SST::Output* output, const std::string& node, const std::string& isa_key,
+                                         const std::string& executable) {
+        VanadisDecodeCacheRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.lock);
+
+        const std::string key = node + ":" + isa_key + ":" + executable;
+        auto cache_itr = reg.caches.find(key);
+
+        if (cache_itr != reg.caches.end()) {
+            output->verbose(CALL_INFO, 2, 0, "Sharing decoded instructions for %s with other decoders.\n",
+                            key.c_str());
+            return cache_itr->second;
+        }
+
+        VanadisSharedDecodeCache* new_cache = new VanadisSharedDecodeCache(key, nodePages(reg, node));
+        reg.caches.insert(std::make_pair(key, new_cache));
+
+        return new_cache;
+    }
+
+    // The code page versions of a node, its LSQs report stores here
+    static VanadisCodePageVersions* codePages(const std::string& node) {
+        VanadisDecodeCacheRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.lock);
+
+        return nodePages(reg, node);
+    }
+
+    uint64_t writeGeneration() const { return code_pages->writeGeneration(); }
+
+    uint64_t pageVersion(const uint64_t addr, const uint64_t len) { return code_pages->pageVersion(addr, len); }
+
+    // Bundle for addr at the current version of its pages, nullptr if
+    // there is none
+    BundleRef find(const uint64_t addr, uint64_t& version) {
+        SharedBundle found;
+
+        {
+            std::lock_guard<std::mutex> lock(cache_lock);
+            lookups++;
+
+            auto bundle_itr = bundles.find(addr);
+
+            if (bundle_itr == bundles.end()) {
+                return BundleRef();
+            }
+
+            found = bundle_itr->second;
+        }
+
+        version = code_pages->pageVersion(addr, found.bundle->pcIncrement());
+
+        if (found.version != version) {
+            return BundleRef();
+        }
+
+        std::lock_guard<std::mutex> lock(cache_lock);
+        hits++;
+
+        return found.bundle;
+    }
+
+    // Takes ownership of a freshly decoded bundle. If another decoder got
+    // there first the existing bundle is returned and the new one dropped.
+    BundleRef insert(VanadisInstructionBundle* bundle, uint64_t& version) {
+        const uint64_t addr = bundle->getInstructionAddress();
+        version = code_pages->registerCodePage(addr, bundle->pcIncrement());
+
+        std::lock_guard<std::mutex> lock(cache_lock);
+        auto bundle_itr = bundles.find(addr);
+
+        if (bundle_itr != bundles.end()) {
+            if (bundle_itr->second.version == version) {
+                delete bundle;
+                return bundle_itr->second.bundle;
+            }
+
+            // Decoded before its page was written, replace it
+            invalidations++;
+            held_uops -= bundle_itr->second.bundle->getInstructionCount();
+            bundles.erase(bundle_itr);
+        }
+
+        BundleRef new_ref(bundle);
+        bundles.insert(std::make_pair(addr, SharedBundle{ new_ref, version }));
+
+        inserts++;
+        held_uops += bundle->getInstructionCount();
+
+        return new_ref;
+    }
+
+    void report(SST::Output* output) {
+        std::lock_guard<std::mutex> lock(cache_lock);
+
+        output->verbose(CALL_INFO, 1, 0, "Shared decode cache (%s):\n", name.c_str());
+        output->verbose(CALL_INFO, 1, 0, "-> Bundles held:            %" PRIu64 " (%" PRIu64 " micro-ops)\n",
+                        (uint64_t)bundles.size(), held_uops);
+        output->verbose(CALL_INFO, 1, 0, "-> Decodes performed:       %" PRIu64 "\n", inserts);
+        output->verbose(CALL_INFO, 1, 0, "-> Decodes avoided:         %" PRIu64 " of %" PRIu64 " lookups\n", hits,
+                        lookups);
+        output->verbose(CALL_INFO, 1, 0, "-> Invalidated by stores:   %" PRIu64 "\n", invalidations);
+    }
+
+    // Each cache is reported once, by whichever core finishes first
+    static void reportAll(SST::Output* output) {
+        VanadisDecodeCacheRegistry& reg = registry();
+        std::vector<VanadisSharedDecodeCache*> to_report;
+
+        {
+            std::lock_guard<std::mutex> lock(reg.lock);
+
+            for (auto& next_cache : reg.caches) {
+                if (!next_cache.second->reported) {
+                    next_cache.second->reported = true;
+                    to_report.push_back(next_cache.second);
+                }
+            }
+        }
+
+        for (VanadisSharedDecodeCache* next_cache : to_report) {
+            next_cache->report(output);
+        }
+    }
+
+private:
+    struct SharedBundle {
+        BundleRef bundle;
+        uint64_t version;
+    };
+
+    struct VanadisDecodeCacheRegistry {
+        std::mutex lock;
+        std::unordered_map<std::string, VanadisSharedDecodeCache*> caches;
+        std::unordered_map<std::string, VanadisCodePageVersions*> node_pages;
+    };
+
+    static VanadisDecodeCacheRegistry& registry() {
+        static VanadisDecodeCacheRegistry reg;
+        return reg;
+    }
+
+    // Called with the registry lock held
+    static VanadisCodePageVersions* nodePages(VanadisDecodeCacheRegistry& reg, const std::string& node) {
+        auto pages_itr = reg.node_pages.find(node);
+
+        if (pages_itr != reg.node_pages.end()) {
+            return pages_itr->second;
+        }
+
+        VanadisCodePageVersions* new_pages = new VanadisCodePageVersions();
+        reg.node_pages.insert(std::make_pair(node, new_pages));
+
+        return new_pages;
+    }
+
+    VanadisSharedDecodeCache(const std::string& cache_name, VanadisCodePageVersions* pages)
+        : name(cache_name), code_pages(pages), lookups(0), hits(0), inserts(0), invalidations(0), held_uops(0),
+          reported(false) {}
+
+    const std::string name;
+    VanadisCodePageVersions* code_pages;
+
+    std::mutex cache_lock;
+    std::unordered_map<uint64_t, SharedBundle> bundles;
+
+    uint64_t lookups;
+    uint64_t hits;
+    uint64_t inserts;
+    uint64_t invalidations;
+    uint64_t held_uops;
+    bool reported;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
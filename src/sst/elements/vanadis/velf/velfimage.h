@@ -0,0 +1,148 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_ELF_IMAGE
+#define _H_VANADIS_ELF_IMAGE
+
+#include <sst/core/output.h>
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Read-only memory mapping of an executable. Headers and tables are parsed
+ * straight from the mapping and segments are copied out of it when they are
+ * loaded, so only the pages which are touched are ever read from disk.
+ */
+class VanadisELFImage {
+public:
+    VanadisELFImage(SST::Output* output, const char* path) : image(nullptr), image_len(0) {
+        const int fd = open(path, O_RDONLY);
+
+        if (fd < 0) {
+            output->fatal(CALL_INFO, -1, "Error: unable to open \'%s\', cannot read ELF table.\n", path);
+        }
+
+        struct stat file_stat;
+
+        if (0 != fstat(fd, &file_stat)) {
+            output->fatal(CALL_INFO, -1, "Error: unable to read the size of \'%s\'.\n", path);
+        }
+
+        image_len = (size_t)file_stat.st_size;
+
+        if (image_len > 0) {
+            void* mapped = mmap(nullptr, image_len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (MAP_FAILED == mapped) {
+                output->fatal(CALL_INFO, -1, "Error: unable to map \'%s\' into memory.\n", path);
+            }
+
+            image = (const uint8_t*)mapped;
+        }
+
+        close(fd);
+    }
+
+    ~VanadisELFImage() {
+        if (nullptr != image) {
+            munmap((void*)image, image_len);
+        }
+    }
+
+    size_t size() const { return image_len; }
+
+    bool contains(const uint64_t offset, const uint64_t len) const {
+        return (offset <= image_len) && (len <= (image_len - offset));
+    }
+
+    const uint8_t* getPointer(const uint64_t offset) const { return image + offset; }
+
+protected:
+    const uint8_t* image;
+    size_t image_len;
+};
+
+/*
+ * Cursor over a mapped image, every read is bounds checked against the
+ * image so a truncated or corrupt binary is reported rather than read past.
+ */
+class VanadisELFReader {
+public:
+    VanadisELFReader(SST::Output* out, const VanadisELFImage* img, const uint64_t start)
+        : output(out), image(img), position(start) {}
+
+    template <typename T>
+    T read() {
+        T value;
+        check(sizeof(T));
+        std::memcpy(&value, image->getPointer(position), sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    void skip(const uint64_t len) {
+        check(len);
+        position += len;
+    }
+
+    void seek(const uint64_t new_position) { position = new_position; }
+    uint64_t getPosition() const { return position; }
+
+    // Null terminated string at offset, stops at the end of the image
+    const char* readString(const uint64_t offset, size_t& len) const {
+        len = 0;
+
+        if (offset >= image->size()) {
+            return "";
+        }
+
+        const char* str = (const char*)image->getPointer(offset);
+        const size_t max_len = image->size() - offset;
+
+        while ((len < max_len) && ('\0' != str[len])) {
+            len++;
+        }
+
+        return str;
+    }
+
+protected:
+    void check(const uint64_t len) {
+        if (!image->contains(position, len)) {
+            output->fatal(CALL_INFO, -1,
+                          "Error: ELF read of %" PRIu64 " bytes at offset %" PRIu64 " is past the end of the "
+                          "executable (%" PRIu64 " bytes).\n",
+                          len, position, (uint64_t)image->size());
+        }
+    }
+
+    SST::Output* output;
+    const VanadisELFImage* image;
+    uint64_t position;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
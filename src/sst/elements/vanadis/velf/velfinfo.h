@@ -16,8 +16,14 @@
 #ifndef _H_VANADIS_ELF_INFO
 #define _H_VANADIS_ELF_INFO
 
+#include "velf/velfimage.h"
+
 #include <cinttypes>
 #include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace SST {
 namespace Vanadis {
@@ -364,6 +370,7 @@ public:
     void setImageOffset(const uint64_t new_off) { imgOffset = new_off; }
     void setImageLength(const uint64_t new_len) { imgDataLen = new_len; }
     void setAlignment(const uint64_t new_align) { alignment = new_align; }
+    void setLink(const uint64_t new_link) { link = new_link; }
     void setID(const uint64_t new_id) { id = new_id; }
 
     VanadisELFSectionHeaderType getSectionType() const { return sec_type; }
@@ -381,6 +388,7 @@ public:
     uint64_t getImageOffset() const { return imgOffset; }
     uint64_t getImageLength() const { return imgDataLen; }
     uint64_t getAlignment() const { return alignment; }
+    uint64_t getLink() const { return link; }
 
     void print(SST::Output* output, uint64_t index) {
         output->verbose(CALL_INFO, 16, 0, ">> Section Entry %" PRIu64 " (id: %" PRIu64 ")\n", index, id);
@@ -414,6 +422,7 @@ private:
         imgOffset = 0;
         imgDataLen = 0;
         alignment = 0;
+        link = 0;
         id = 0;
     }
 
@@ -424,12 +433,14 @@ private:
     uint64_t imgOffset;
     uint64_t imgDataLen;
     uint64_t alignment;
+    uint64_t link;
 };
 
 class VanadisELFInfo {
 public:
     VanadisELFInfo() {
         bin_path = nullptr;
+        image = nullptr;
         elf_class = UINT8_MAX;
         elf_endian = VANADIS_LITTLE_ENDIAN;
         elf_os_abi = UINT8_MAX;
@@ -561,6 +572,9 @@ public:
 
     const char* getBinaryPath() const { return bin_path; }
 
+    void setImage(VanadisELFImage* new_image) { image = new_image; }
+    const VanadisELFImage* getImage() const { return image; }
+
     uint64_t getEntryPoint() const { return elf_entry_point; }
     VanadisELFEndianness getEndian() const { return elf_endian; }
     uint64_t getProgramHeaderOffset() const { return elf_prog_header_start; }
@@ -625,10 +639,13 @@ public:
         for (VanadisELFRelocationEntry* next_rel : progRelDyn) {
             delete next_rel;
         }
+
+        delete image;
     }
 
 protected:
     char* bin_path;
+    VanadisELFImage* image;
     uint8_t elf_class;
     VanadisELFEndianness elf_endian;
     uint8_t elf_os_abi;
@@ -652,605 +669,320 @@ protected:
     std::vector<VanadisELFRelocationEntry*> progRelDyn;
 };
 
-void
-readString(FILE* bin_file, uint64_t stringTableStart, uint64_t stringTableOffset, std::vector<char>& nameBuffer) {
-    uint64_t current_file_pos = (uint64_t)ftell(bin_file);
-
-    nameBuffer.clear();
-    fseek(bin_file, stringTableStart + stringTableOffset, SEEK_SET);
-
-    while (!feof(bin_file)) {
-        int next_c = fgetc(bin_file);
-
-        if ('\0' == next_c) {
-            break;
-        } else if (EOF == next_c) {
-            break;
-        }
-
-        nameBuffer.push_back((char)next_c);
+inline VanadisSymbolBindType
+getSymbolBindTypeFromInfo(const uint8_t sym_info) {
+    switch ((sym_info >> 4)) {
+    case 0:
+        return SYMBOL_BIND_LOCAL;
+    case 1:
+        return SYMBOL_BIND_GLOBAL;
+    case 2:
+        return SYMBOL_BIND_WEAK;
+    default:
+        return SYMBOL_BIND_UNKNOWN;
     }
+}
 
-    // Push back a null character as we are turning this into a string later
-    nameBuffer.push_back('\0');
-
-    // Restore file position
-    fseek(bin_file, current_file_pos, SEEK_SET);
+inline VanadisSymbolType
+getSymbolTypeFromInfo(const uint8_t sym_info) {
+    switch ((sym_info & 0xf)) {
+    case 0:
+        return SYMBOL_NO_TYPE;
+    case 1:
+        return SYMBOL_OBJECT;
+    case 2:
+        return SYMBOL_FUNCTION;
+    case 3:
+        return SYMBOL_SECTION;
+    case 4:
+        return SYMBOL_FILE;
+    default:
+        return SYMBOL_UNKNOWN;
+    }
 }
 
-void
-readBinarySymbolTable(SST::Output* output, const char* path, VanadisELFInfo* elf_info,
+inline void
+readBinarySymbolTable(SST::Output* output, const VanadisELFImage* image, VanadisELFInfo* elf_info,
                       const VanadisELFProgramSectionEntry* symbolSection,
                       const VanadisELFProgramSectionEntry* stringTableEntry) {
 
-    FILE* bin_file = fopen(path, "rb");
-
-    if (nullptr == bin_file) {
-        output->fatal(CALL_INFO, -1, "Error: unable to open %s for reading symbol table.\n", path);
-    }
-
     const bool binary_is_32 = elf_info->isELF32();
 
     output->verbose(CALL_INFO, 16, 0, "Symbol Table located at %" PRIu64 " / 0x%0llx in executable (is 32bit? %s).\n",
                     symbolSection->getImageOffset(), symbolSection->getImageOffset(), binary_is_32 ? "yes" : "no");
 
-    // Wind forward to the symbol table entries
-    fseek(bin_file, symbolSection->getImageOffset(), SEEK_SET);
-    uint64_t symbol_size = binary_is_32 ? (4 + 4 + 4 + 2 + 2) : (4 + 2 + 2 + 8 + 8);
+    const uint64_t symbol_size = binary_is_32 ? (4 + 4 + 4 + 1 + 1 + 2) : (4 + 1 + 1 + 2 + 8 + 8);
 
     output->verbose(
         CALL_INFO, 16, 0,
         "Symbol entry is %" PRIu64 " bytes in size, expecting %" PRIu64 " symbols (remainder: %" PRIu64 ")\n",
         symbol_size, (symbolSection->getImageLength() / symbol_size), symbolSection->getImageLength() % symbol_size);
 
-    uint8_t tmp_u8 = 0;
-    uint16_t tmp_u16 = 0;
-    uint32_t tmp_u32 = 0;
-    uint64_t tmp_u64 = 0;
-
-    std::vector<char> name_buffer;
-
-	if(elf_info->isELF32()) {
-		output->verbose(CALL_INFO, 16, 0, "Binary is marked as 32bit\n");
-	}
-
-	if(elf_info->isELF64()) {
-		output->verbose(CALL_INFO, 16, 0, "Binary is marked as 64bit\n");
-	}
-
-    for (uint64_t i = symbolSection->getImageOffset();
-         i < (symbolSection->getImageOffset() + symbolSection->getImageLength()); i += symbol_size) {
+    VanadisELFReader reader(output, image, symbolSection->getImageOffset());
+    const uint64_t symbol_count = symbolSection->getImageLength() / symbol_size;
 
+    for (uint64_t i = 0; i < symbol_count; ++i) {
         VanadisSymbolTableEntry* new_symbol = new VanadisSymbolTableEntry();
+        uint8_t sym_info = 0;
+
+        if (binary_is_32) {
+            new_symbol->setNameOffset(reader.read<uint32_t>());
+            new_symbol->setAddress(reader.read<uint32_t>());
+            new_symbol->setSize(reader.read<uint32_t>());
+            sym_info = reader.read<uint8_t>();
+            reader.skip(1);
+            new_symbol->setSymbolSection(reader.read<uint16_t>());
+        } else {
+            new_symbol->setNameOffset(reader.read<uint32_t>());
+            sym_info = reader.read<uint8_t>();
+            reader.skip(1);
+            new_symbol->setSymbolSection(reader.read<uint16_t>());
+            new_symbol->setAddress(reader.read<uint64_t>());
+            new_symbol->setSize(reader.read<uint64_t>());
+        }
 
-        if (elf_info->isELF32()) {
-            fread(&tmp_u32, 4, 1, bin_file);
-            new_symbol->setNameOffset(tmp_u32);
-
-            fread(&tmp_u32, 4, 1, bin_file);
-            new_symbol->setAddress(tmp_u32);
-
-            fread(&tmp_u32, 4, 1, bin_file);
-            new_symbol->setSize(tmp_u32);
-
-            fread(&tmp_u8, 1, 1, bin_file);
-            // output->verbose(CALL_INFO, 16, 0, "Symbol info >> 4 = %" PRIu64 "\n", (tmp_u8 >> 4));
-
-            switch ((tmp_u8 >> 4)) {
-            case 0:
-                new_symbol->setBindType(SYMBOL_BIND_LOCAL);
-                break;
-            case 1:
-                new_symbol->setBindType(SYMBOL_BIND_GLOBAL);
-                break;
-            case 2:
-                new_symbol->setBindType(SYMBOL_BIND_WEAK);
-                break;
-            default:
-                break;
-            }
-
-            // output->verbose(CALL_INFO, 16, 0, "Symbol type = %" PRIu64 "\n", (tmp_u8 & 0xf) );
-            switch ((tmp_u8 & 0xf)) {
-            case 0:
-                new_symbol->setType(SYMBOL_NO_TYPE);
-                break;
-            case 1:
-                new_symbol->setType(SYMBOL_OBJECT);
-                break;
-            case 2:
-                new_symbol->setType(SYMBOL_FUNCTION);
-                break;
-            case 3:
-                new_symbol->setType(SYMBOL_SECTION);
-                break;
-            case 4:
-                new_symbol->setType(SYMBOL_FILE);
-                break;
-            default:
-                break;
-            }
-
-            fread(&tmp_u8, 1, 1, bin_file);
-            fread(&tmp_u16, 2, 1, bin_file);
-
-            new_symbol->setSymbolSection(tmp_u16);
-
-            if (nullptr != stringTableEntry) {
-                if (new_symbol->getNameOffset() > 0) {
-                    readString(bin_file, stringTableEntry->getImageOffset(), new_symbol->getNameOffset(), name_buffer);
-                    new_symbol->setName(&name_buffer[0]);
-                } else {
-                    const char* no_symbol_name = "";
-                    new_symbol->setName(no_symbol_name);
-                }
-            }
-
-            elf_info->addSymbolTableEntry(new_symbol);
-        } else if(elf_info->isELF64()) {
-            fread(&tmp_u64, 8, 1, bin_file);
-            new_symbol->setNameOffset(tmp_u32);
-
-            fread(&tmp_u8, 1, 1, bin_file);
-            // output->verbose(CALL_INFO, 16, 0, "Symbol info >> 4 = %" PRIu64 "\n", (tmp_u8 >> 4));
-
-            switch ((tmp_u8 >> 4)) {
-            case 0:
-                new_symbol->setBindType(SYMBOL_BIND_LOCAL);
-                break;
-            case 1:
-                new_symbol->setBindType(SYMBOL_BIND_GLOBAL);
-                break;
-            case 2:
-                new_symbol->setBindType(SYMBOL_BIND_WEAK);
-                break;
-            default:
-                break;
-            }
-
-            // output->verbose(CALL_INFO, 16, 0, "Symbol type = %" PRIu64 "\n", (tmp_u8 & 0xf) );
-            switch ((tmp_u8 & 0xf)) {
-            case 0:
-                new_symbol->setType(SYMBOL_NO_TYPE);
-                break;
-            case 1:
-                new_symbol->setType(SYMBOL_OBJECT);
-                break;
-            case 2:
-                new_symbol->setType(SYMBOL_FUNCTION);
-                break;
-            case 3:
-                new_symbol->setType(SYMBOL_SECTION);
-                break;
-            case 4:
-                new_symbol->setType(SYMBOL_FILE);
-                break;
-            default:
-                break;
-            }
-
-            fread(&tmp_u8, 1, 1, bin_file);
-            fread(&tmp_u16, 2, 1, bin_file);
-
-            new_symbol->setSymbolSection(tmp_u16);
-
-            fread(&tmp_u64, 8, 1, bin_file);
-            new_symbol->setAddress(tmp_u32);
-
-            fread(&tmp_u64, 8, 1, bin_file);
-            new_symbol->setSize(tmp_u32);
-
-            if (nullptr != stringTableEntry) {
-                if (new_symbol->getNameOffset() > 0) {
-                    readString(bin_file, stringTableEntry->getImageOffset(), new_symbol->getNameOffset(), name_buffer);
-                    new_symbol->setName(&name_buffer[0]);
-                } else {
-                    const char* no_symbol_name = "";
-                    new_symbol->setName(no_symbol_name);
-                }
-            }
+        new_symbol->setBindType(getSymbolBindTypeFromInfo(sym_info));
+        new_symbol->setType(getSymbolTypeFromInfo(sym_info));
 
-            elf_info->addSymbolTableEntry(new_symbol);
+        if ((nullptr != stringTableEntry) && (new_symbol->getNameOffset() > 0) &&
+            (new_symbol->getNameOffset() < stringTableEntry->getImageLength())) {
+            size_t name_len = 0;
+            const char* name =
+                reader.readString(stringTableEntry->getImageOffset() + new_symbol->getNameOffset(), name_len);
+            new_symbol->setName(std::string(name, name_len).c_str());
         } else {
-				output->fatal(CALL_INFO, -1, "Error - image is not marked as either 32b or 64b, potential ELF read error.\n");
-			}
-    }
+            new_symbol->setName("");
+        }
 
-    fclose(bin_file);
+        elf_info->addSymbolTableEntry(new_symbol);
+    }
 }
 
-void
-readELFRelocationInformation(SST::Output* output, const char* path, VanadisELFInfo* elf_info,
+inline void
+readELFRelocationInformation(SST::Output* output, const VanadisELFImage* image, VanadisELFInfo* elf_info,
                              const VanadisELFProgramSectionEntry* relocationEntry) {
 
-    FILE* bin_file = fopen(path, "rb");
-
-    if (nullptr == bin_file) {
-        output->fatal(CALL_INFO, -1, "Error - unable to open %s\n", path);
-    }
-
-    fseek(bin_file, relocationEntry->getImageOffset(), SEEK_SET);
-
-    if (elf_info->isELF32()) {
-        uint32_t u32_tmp = 0;
-
-        for (size_t i = relocationEntry->getImageOffset();
-             i < (relocationEntry->getImageOffset() + relocationEntry->getImageLength()); i += 8) {
-
-            VanadisELFRelocationEntry* new_reloc = new VanadisELFRelocationEntry();
+    VanadisELFReader reader(output, image, relocationEntry->getImageOffset());
 
-            fread(&u32_tmp, 4, 1, bin_file);
-            new_reloc->setAddress(u32_tmp);
+    // SHT_REL entries are an address and an info word
+    const uint64_t entry_size = elf_info->isELF32() ? 8 : 16;
+    const uint64_t entry_count = relocationEntry->getImageLength() / entry_size;
 
-            fread(&u32_tmp, 4, 1, bin_file);
-            new_reloc->setInfo(u32_tmp);
+    for (uint64_t i = 0; i < entry_count; ++i) {
+        VanadisELFRelocationEntry* new_reloc = new VanadisELFRelocationEntry();
 
-            elf_info->addRelocationEntry(new_reloc);
+        if (elf_info->isELF32()) {
+            new_reloc->setAddress(reader.read<uint32_t>());
+            new_reloc->setInfo(reader.read<uint32_t>());
+        } else {
+            new_reloc->setAddress(reader.read<uint64_t>());
+            new_reloc->setInfo(reader.read<uint64_t>());
         }
-    } else if(elf_info->isELF64()) {
-        uint64_t u64_tmp = 0;
-
-        for (size_t i = relocationEntry->getImageOffset();
-             i < (relocationEntry->getImageOffset() + relocationEntry->getImageLength()); i += 8) {
-
-            VanadisELFRelocationEntry* new_reloc = new VanadisELFRelocationEntry();
-
-            fread(&u64_tmp, 8, 1, bin_file);
-            new_reloc->setAddress(u64_tmp);
 
-            fread(&u64_tmp, 8, 1, bin_file);
-            new_reloc->setInfo(u64_tmp);
-
-            elf_info->addRelocationEntry(new_reloc);
-        }
-	} else {
-		output->fatal(CALL_INFO, -1, "ELF info does not show 32b or 64b executable type.\n");
+        elf_info->addRelocationEntry(new_reloc);
     }
-
-    fclose(bin_file);
 }
 
-VanadisELFInfo*
-readBinaryELFInfo(SST::Output* output, const char* path) {
-
-    FILE* bin_file = fopen(path, "rb");
+inline VanadisELFProgramHeaderType
+getProgramHeaderTypeFromNumber(SST::Output* output, const uint32_t hdr_type_num) {
+    switch (hdr_type_num) {
+    case 0x0:
+        return PROG_HEADER_NOT_USED;
+    case 0x1:
+        return PROG_HEADER_LOAD;
+    case 0x2:
+        return PROG_HEADER_DYNAMIC;
+    case 0x3:
+        return PROG_HEADER_INTERPRETER;
+    case 0x4:
+        return PROG_HEADER_NOTE;
+    case 0x5: /* not used? */
+        return PROG_HEADER_NOT_USED;
+    case 0x6:
+        return PROG_HEADER_TABLE_INFO;
+    case 0x7:
+        return PROG_HEADER_THREAD_LOCAL;
+    default:
+        output->verbose(CALL_INFO, 4, 0, "Unknown program header type in ELF: %" PRIu32 "\n", hdr_type_num);
+        return PROG_HEADER_NOT_USED;
+    }
+}
 
-    if (nullptr == bin_file) {
-        output->fatal(CALL_INFO, -1, "Error: unable to open \'%s\', cannot read ELF table.\n", path);
+inline VanadisELFSectionHeaderType
+getSectionHeaderTypeFromNumber(SST::Output* output, const uint32_t sec_type_num) {
+    switch (sec_type_num) {
+    case 0x0:
+        return SECTION_HEADER_NOT_USED;
+    case 0x1:
+        return SECTION_HEADER_PROG_DATA;
+    case 0x2:
+        return SECTION_HEADER_SYMBOL_TABLE;
+    case 0x3:
+        return SECTION_HEADER_STRING_TABLE;
+    case 0x4:
+        return SECTION_HEADER_RELOCATABLE_ENTRY;
+    case 0x5:
+        return SECTION_HEADER_SYMBOL_HASH_TABLE;
+    case 0x6:
+        return SECTION_HEADER_DYN_LINK_INFO;
+    case 0x7:
+        return SECTION_HEADER_NOTE;
+    case 0x8:
+        return SECTION_HEADER_BSS;
+    case 0x9:
+        return SECTION_HEADER_REL;
+    case 0x0B:
+        return SECTION_HEADER_DYN_SYMBOL_INFO;
+    case 0x0E:
+        return SECTION_HEADER_INIT_ARRAY;
+    case 0x0F:
+        return SECTION_HEADER_FINI_ARRAY;
+    case 0x10:
+        return SECTION_HEADER_PREINIT_ARRAY;
+    case 0x11:
+        return SECTION_HEADER_SECTION_GROUP;
+    case 0x12:
+        return SECTION_HEADER_EXTENDED_SECTION_INDEX;
+    case 0x13:
+        return SECTION_HEADER_DEFINED_TYPES;
+    default:
+        output->verbose(CALL_INFO, 4, 0, "Unknown Section type: %" PRIu32 "\n", sec_type_num);
+        return SECTION_HEADER_NOT_USED;
     }
+}
 
-    uint8_t* elf_magic = new uint8_t[4];
-    fread(elf_magic, 1, 4, bin_file);
+inline VanadisELFInfo*
+parseBinaryELFInfo(SST::Output* output, const char* path) {
+    VanadisELFImage* image = new VanadisELFImage(output, path);
+    VanadisELFReader reader(output, image, 0);
 
-    if (!(elf_magic[0] == 0x7F && elf_magic[1] == 0x45 && elf_magic[2] == 0x4c && elf_magic[3] == 0x46)) {
+    if (!(image->contains(0, 4) && image->getPointer(0)[0] == 0x7F && image->getPointer(0)[1] == 0x45 &&
+          image->getPointer(0)[2] == 0x4c && image->getPointer(0)[3] == 0x46)) {
         output->fatal(CALL_INFO, -1, "Error: opened %s, but the ELF magic header is not correct.\n", path);
     }
 
     VanadisELFInfo* elf_info = new VanadisELFInfo();
 
     elf_info->setBinaryPath(path);
-
-    uint8_t tmp_byte = 0;
-    uint16_t tmp_2byte = 0;
-    uint32_t tmp_4byte = 0;
-    uint64_t tmp_8byte = 0;
-
-    fread(&tmp_byte, 1, 1, bin_file);
-    elf_info->setClass(tmp_byte);
-
-    fread(&tmp_byte, 1, 1, bin_file);
-    switch( tmp_byte ) {
-	case 1:
-		elf_info->setEndian(VANADIS_LITTLE_ENDIAN);
-		break;
-	case 2:
-		elf_info->setEndian(VANADIS_BIG_ENDIAN);
-		break;
-	default:
-		output->fatal(CALL_INFO, -1, "Error: unknown endian type: %" PRIu8 "\n", tmp_byte);
-		break;
+    elf_info->setImage(image);
+
+    reader.seek(4);
+    elf_info->setClass(reader.read<uint8_t>());
+
+    const uint8_t endian = reader.read<uint8_t>();
+    switch (endian) {
+    case 1:
+        elf_info->setEndian(VANADIS_LITTLE_ENDIAN);
+        break;
+    case 2:
+        elf_info->setEndian(VANADIS_BIG_ENDIAN);
+        break;
+    default:
+        output->fatal(CALL_INFO, -1, "Error: unknown endian type: %" PRIu8 "\n", endian);
+        break;
     }
 
-    fread(&tmp_byte, 1, 1, bin_file);
-    // Discard this read, it is set to 1 for modern ELF
-
-    fread(&tmp_byte, 1, 1, bin_file);
-    elf_info->setOSABI(tmp_byte);
+    // Discard the version, it is set to 1 for modern ELF
+    reader.skip(1);
 
-    fread(&tmp_byte, 1, 1, bin_file);
-    elf_info->setOSABIVersion(tmp_byte);
+    elf_info->setOSABI(reader.read<uint8_t>());
+    elf_info->setOSABIVersion(reader.read<uint8_t>());
 
     // Discard the next 7 bytes, these pad the header
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
-
-    fread(&tmp_2byte, 2, 1, bin_file);
-    elf_info->setObjectType(tmp_2byte);
+    reader.skip(7);
 
-    fread(&tmp_2byte, 2, 1, bin_file);
-    elf_info->setISA(tmp_2byte);
+    elf_info->setObjectType(reader.read<uint16_t>());
+    elf_info->setISA(reader.read<uint16_t>());
 
     // Discard the next 4 bytes, these just set to 1 to pad
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
-    fread(&tmp_byte, 1, 1, bin_file);
+    reader.skip(4);
 
     if (elf_info->isELF64()) {
-        fread(&tmp_8byte, 8, 1, bin_file);
-        elf_info->setEntryPoint(tmp_8byte);
-
-        fread(&tmp_8byte, 8, 1, bin_file);
-        elf_info->setProgramHeaderOffset(tmp_8byte);
-
-        fread(&tmp_8byte, 8, 1, bin_file);
-        elf_info->setSectionHeaderOffset(tmp_8byte);
+        elf_info->setEntryPoint(reader.read<uint64_t>());
+        elf_info->setProgramHeaderOffset(reader.read<uint64_t>());
+        elf_info->setSectionHeaderOffset(reader.read<uint64_t>());
     } else if (elf_info->isELF32()) {
-        fread(&tmp_4byte, 4, 1, bin_file);
-        elf_info->setEntryPoint((uint64_t)tmp_4byte);
-
-        fread(&tmp_4byte, 4, 1, bin_file);
-        elf_info->setProgramHeaderOffset((uint64_t)tmp_4byte);
-
-        fread(&tmp_4byte, 4, 1, bin_file);
-        elf_info->setSectionHeaderOffset((uint64_t)tmp_4byte);
+        elf_info->setEntryPoint(reader.read<uint32_t>());
+        elf_info->setProgramHeaderOffset(reader.read<uint32_t>());
+        elf_info->setSectionHeaderOffset(reader.read<uint32_t>());
     } else {
         output->fatal(CALL_INFO, -1, "Error: unable to determine if binary is 32/64 bits during ELF read.\n");
     }
 
-    // Discard, ISA specific, need to understand whether we need this.
-    fread(&tmp_4byte, 4, 1, bin_file);
-
-    // Discard, is just a size read for ELF header info
-    fread(&tmp_2byte, 2, 1, bin_file);
-
-    fread(&tmp_2byte, 2, 1, bin_file);
-    elf_info->setProgramHeaderEntrySize(tmp_2byte);
-
-    fread(&tmp_2byte, 2, 1, bin_file);
-    elf_info->setProgramHeaderEntryCount(tmp_2byte);
+    // Discard the ISA specific flags and the size of the ELF header
+    reader.skip(4 + 2);
 
-    const uint32_t prog_header_count = (uint32_t)tmp_2byte;
+    elf_info->setProgramHeaderEntrySize(reader.read<uint16_t>());
+    elf_info->setProgramHeaderEntryCount(reader.read<uint16_t>());
+    elf_info->setSectionHeaderEntrySize(reader.read<uint16_t>());
+    elf_info->setSectionHeaderEntryCount(reader.read<uint16_t>());
+    elf_info->setSectionEntryIndexForNames(reader.read<uint16_t>());
 
-    fread(&tmp_2byte, 2, 1, bin_file);
-    elf_info->setSectionHeaderEntrySize(tmp_2byte);
-
-    fread(&tmp_2byte, 2, 1, bin_file);
-    elf_info->setSectionHeaderEntryCount(tmp_2byte);
-
-    fread(&tmp_2byte, 2, 1, bin_file);
-    elf_info->setSectionEntryIndexForNames(tmp_2byte);
-
-    // Wind the file pointer to the program header offset
-    fseek(bin_file, elf_info->getProgramHeaderOffset(), SEEK_SET);
-
-    for (uint32_t i = 0; i < prog_header_count; ++i) {
+    for (uint32_t i = 0; i < elf_info->getProgramHeaderEntryCount(); ++i) {
         output->verbose(CALL_INFO, 4, 0, "Reading Program Header %" PRIu32 "...\n", i);
         VanadisELFProgramHeaderEntry* new_prg_hdr = new VanadisELFProgramHeaderEntry();
 
-        // Header type
-        fread(&tmp_4byte, 4, 1, bin_file);
-
-        VanadisELFProgramHeaderType prg_hdr_type = PROG_HEADER_NOT_USED;
-
-        switch (tmp_4byte) {
-        case 0x0:
-            prg_hdr_type = PROG_HEADER_NOT_USED;
-            break;
-        case 0x1:
-            prg_hdr_type = PROG_HEADER_LOAD;
-            break;
-        case 0x2:
-            prg_hdr_type = PROG_HEADER_DYNAMIC;
-            break;
-        case 0x3:
-            prg_hdr_type = PROG_HEADER_INTERPRETER;
-            break;
-        case 0x4:
-            prg_hdr_type = PROG_HEADER_NOTE;
-            break;
-        case 0x5: /* not used? */
-            break;
-        case 0x6:
-            prg_hdr_type = PROG_HEADER_TABLE_INFO;
-            break;
-        case 0x7:
-            prg_hdr_type = PROG_HEADER_THREAD_LOCAL;
-            break;
-        default:
-            output->verbose(CALL_INFO, 4, 0, "Unknown program header type in ELF: %" PRIu32 "\n", tmp_4byte);
-        }
-
-        new_prg_hdr->setHeaderTypeNum(tmp_4byte);
-        new_prg_hdr->setHeaderType(prg_hdr_type);
-
-        if (elf_info->isELF64()) {
-            // Discard segment-dependent flags
-            fread(&tmp_4byte, 4, 1, bin_file);
-
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_prg_hdr->setImageOffset(tmp_8byte);
+        reader.seek(elf_info->getProgramHeaderOffset() + ((uint64_t)i * elf_info->getProgramHeaderEntrySize()));
 
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_prg_hdr->setVirtualMemoryStart(tmp_8byte);
+        const uint32_t hdr_type_num = reader.read<uint32_t>();
 
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_prg_hdr->setPhysicalMemoryStart(tmp_8byte);
+        new_prg_hdr->setHeaderTypeNum(hdr_type_num);
+        new_prg_hdr->setHeaderType(getProgramHeaderTypeFromNumber(output, hdr_type_num));
 
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_prg_hdr->setHeaderImageLength(tmp_8byte);
-
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_prg_hdr->setHeaderMemoryLength(tmp_8byte);
-
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_prg_hdr->setAlignment(tmp_8byte);
-        } else if (elf_info->isELF32()) {
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_prg_hdr->setImageOffset(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_prg_hdr->setVirtualMemoryStart(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_prg_hdr->setPhysicalMemoryStart(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_prg_hdr->setHeaderImageLength(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_prg_hdr->setHeaderMemoryLength(tmp_4byte);
-
-            // Segment dependent flags - ignore?
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_prg_hdr->setSegmentFlags(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_prg_hdr->setAlignment(tmp_4byte);
+        if (elf_info->isELF64()) {
+            new_prg_hdr->setSegmentFlags(reader.read<uint32_t>());
+            new_prg_hdr->setImageOffset(reader.read<uint64_t>());
+            new_prg_hdr->setVirtualMemoryStart(reader.read<uint64_t>());
+            new_prg_hdr->setPhysicalMemoryStart(reader.read<uint64_t>());
+            new_prg_hdr->setHeaderImageLength(reader.read<uint64_t>());
+            new_prg_hdr->setHeaderMemoryLength(reader.read<uint64_t>());
+            new_prg_hdr->setAlignment(reader.read<uint64_t>());
         } else {
-            output->fatal(CALL_INFO, -1, "Error: neither 32 or 64 bit test passed ELF read.\n");
+            new_prg_hdr->setImageOffset(reader.read<uint32_t>());
+            new_prg_hdr->setVirtualMemoryStart(reader.read<uint32_t>());
+            new_prg_hdr->setPhysicalMemoryStart(reader.read<uint32_t>());
+            new_prg_hdr->setHeaderImageLength(reader.read<uint32_t>());
+            new_prg_hdr->setHeaderMemoryLength(reader.read<uint32_t>());
+            new_prg_hdr->setSegmentFlags(reader.read<uint32_t>());
+            new_prg_hdr->setAlignment(reader.read<uint32_t>());
         }
 
         elf_info->addProgramHeader(new_prg_hdr);
     }
 
-    fseek(bin_file, elf_info->getSectionHeaderOffset(), SEEK_SET);
-
     for (uint32_t i = 0; i < elf_info->getSectionHeaderEntryCount(); ++i) {
         output->verbose(CALL_INFO, 4, 0, "Reading Section Header %" PRIu32 "...\n", i);
         VanadisELFProgramSectionEntry* new_sec = new VanadisELFProgramSectionEntry();
         new_sec->setID(i);
 
+        reader.seek(elf_info->getSectionHeaderOffset() + ((uint64_t)i * elf_info->getSectionHeaderEntrySize()));
+
         // Offset for section name
-        fread(&tmp_4byte, 4, 1, bin_file);
-
-        fread(&tmp_4byte, 4, 1, bin_file);
-        VanadisELFSectionHeaderType sec_type = SECTION_HEADER_NOT_USED;
-
-        switch (tmp_4byte) {
-        case 0x0:
-            sec_type = SECTION_HEADER_NOT_USED;
-            break;
-        case 0x1:
-            sec_type = SECTION_HEADER_PROG_DATA;
-            break;
-        case 0x2:
-            sec_type = SECTION_HEADER_SYMBOL_TABLE;
-            break;
-        case 0x3:
-            sec_type = SECTION_HEADER_STRING_TABLE;
-            break;
-        case 0x4:
-            sec_type = SECTION_HEADER_RELOCATABLE_ENTRY;
-            break;
-        case 0x5:
-            sec_type = SECTION_HEADER_SYMBOL_HASH_TABLE;
-            break;
-        case 0x6:
-            sec_type = SECTION_HEADER_DYN_LINK_INFO;
-            break;
-        case 0x7:
-            sec_type = SECTION_HEADER_NOTE;
-            break;
-        case 0x8:
-            sec_type = SECTION_HEADER_BSS;
-            break;
-        case 0x9:
-            sec_type = SECTION_HEADER_REL;
-            break;
-        case 0x0B:
-            sec_type = SECTION_HEADER_DYN_SYMBOL_INFO;
-            break;
-        case 0x0E:
-            sec_type = SECTION_HEADER_INIT_ARRAY;
-            break;
-        case 0x0F:
-            sec_type = SECTION_HEADER_FINI_ARRAY;
-            break;
-        case 0x10:
-            sec_type = SECTION_HEADER_PREINIT_ARRAY;
-            break;
-        case 0x11:
-            sec_type = SECTION_HEADER_SECTION_GROUP;
-            break;
-        case 0x12:
-            sec_type = SECTION_HEADER_EXTENDED_SECTION_INDEX;
-            break;
-        case 0x13:
-            sec_type = SECTION_HEADER_DEFINED_TYPES;
-            break;
-        default:
-            output->verbose(CALL_INFO, 4, 0, "Unknown Section type: %" PRIu32 "\n", tmp_4byte);
-            break;
-        }
+        reader.skip(4);
 
-        new_sec->setSectionType(sec_type);
+        new_sec->setSectionType(getSectionHeaderTypeFromNumber(output, reader.read<uint32_t>()));
 
         if (elf_info->isELF64()) {
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_sec->setSectionFlags(tmp_8byte);
-
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_sec->setVirtualMemoryStart(tmp_8byte);
-
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_sec->setImageOffset(tmp_8byte);
-
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_sec->setImageLength(tmp_8byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            fread(&tmp_4byte, 4, 1, bin_file);
-
-            fread(&tmp_8byte, 8, 1, bin_file);
-            new_sec->setAlignment(tmp_8byte);
-
-            fread(&tmp_8byte, 8, 1, bin_file);
-        } else if (elf_info->isELF32()) {
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_sec->setSectionFlags(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_sec->setVirtualMemoryStart(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_sec->setImageOffset(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_sec->setImageLength(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            fread(&tmp_4byte, 4, 1, bin_file);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
-            new_sec->setAlignment(tmp_4byte);
-
-            fread(&tmp_4byte, 4, 1, bin_file);
+            new_sec->setSectionFlags(reader.read<uint64_t>());
+            new_sec->setVirtualMemoryStart(reader.read<uint64_t>());
+            new_sec->setImageOffset(reader.read<uint64_t>());
+            new_sec->setImageLength(reader.read<uint64_t>());
+            new_sec->setLink(reader.read<uint32_t>());
+            reader.skip(4);
+            new_sec->setAlignment(reader.read<uint64_t>());
         } else {
-            output->fatal(CALL_INFO, -1, "Error: not 32 or 64-bit type ELF info. Not sure what to do.\n");
+            new_sec->setSectionFlags(reader.read<uint32_t>());
+            new_sec->setVirtualMemoryStart(reader.read<uint32_t>());
+            new_sec->setImageOffset(reader.read<uint32_t>());
+            new_sec->setImageLength(reader.read<uint32_t>());
+            new_sec->setLink(reader.read<uint32_t>());
+            reader.skip(4);
+            new_sec->setAlignment(reader.read<uint32_t>());
         }
 
         elf_info->addProgramSection(new_sec);
     }
 
-    fclose(bin_file);
-
-    VanadisELFProgramSectionEntry* string_table_entry = nullptr;
-
-    for (size_t i = 0; i < elf_info->countProgramSections(); ++i) {
-        const VanadisELFProgramSectionEntry* next_entry = elf_info->getProgramSection(i);
-
-        if (next_entry->getSectionType() == SECTION_HEADER_STRING_TABLE) {
-            string_table_entry = const_cast<VanadisELFProgramSectionEntry*>(next_entry);
-            break;
-        }
-    }
-
     for (size_t i = 0; i < elf_info->countProgramSections(); ++i) {
         const VanadisELFProgramSectionEntry* next_entry = elf_info->getProgramSection(i);
 
@@ -1258,21 +990,54 @@ readBinaryELFInfo(SST::Output* output, const char* path) {
             output->verbose(CALL_INFO, 16, 0, "Reading in symbol table (Section %" PRIu64 ")...\n",
                             next_entry->getID());
 
-            readBinarySymbolTable(output, path, elf_info, next_entry, string_table_entry);
+            // The linked section holds the names of the symbols
+            const VanadisELFProgramSectionEntry* string_table_entry = nullptr;
+
+            if (next_entry->getLink() < elf_info->countProgramSections()) {
+                string_table_entry = elf_info->getProgramSection(next_entry->getLink());
+
+                if (string_table_entry->getSectionType() != SECTION_HEADER_STRING_TABLE) {
+                    string_table_entry = nullptr;
+                }
+            }
+
+            readBinarySymbolTable(output, image, elf_info, next_entry, string_table_entry);
 
             output->verbose(CALL_INFO, 16, 0, "Read of section completed.\n");
         } else if (next_entry->getSectionType() == SECTION_HEADER_REL) {
             output->verbose(CALL_INFO, 16, 0, "Reading in relocation table (Section %" PRIu64 ")...\n",
                             next_entry->getID());
 
-            readELFRelocationInformation(output, path, elf_info, next_entry);
+            readELFRelocationInformation(output, image, elf_info, next_entry);
 
             output->verbose(CALL_INFO, 16, 0, "Read of relocation entry completed\n");
         }
     }
 
     return elf_info;
-};
+}
+
+// Cores running the same executable share one mapped and parsed image. The
+// image stays mapped for the life of the simulation.
+inline VanadisELFInfo*
+readBinaryELFInfo(SST::Output* output, const char* path) {
+    static std::mutex elf_cache_mutex;
+    static std::unordered_map<std::string, VanadisELFInfo*> elf_cache;
+
+    std::lock_guard<std::mutex> lock(elf_cache_mutex);
+
+    auto cache_itr = elf_cache.find(path);
+
+    if (cache_itr != elf_cache.end()) {
+        output->verbose(CALL_INFO, 2, 0, "Executable %s has already been read, sharing the parsed image.\n", path);
+        return cache_itr->second;
+    }
+
+    VanadisELFInfo* elf_info = parseBinaryELFInfo(output, path);
+    elf_cache.insert(std::make_pair(std::string(path), elf_info));
+
+    return elf_info;
+}
 
 } // namespace Vanadis
 } // namespace SST
@@ -24,21 +24,37 @@
 #include <vector>
 
 #include "datastruct/vcache.h"
+#include "vdecodecache.h"
 #include "vinsbundle.h"
 
 namespace SST {
 namespace Vanadis {
 
+// Entry in the micro-op cache, the bundle may be shared with other decoders
+// so it is held by reference along with the code page version it was
+// decoded from
+struct VanadisCachedBundle {
+    VanadisCachedBundle(VanadisSharedDecodeCache::BundleRef ref, const uint64_t page_version,
+                        const uint64_t write_generation)
+        : bundle(ref), version(page_version), generation(write_generation) {}
+
+    VanadisSharedDecodeCache::BundleRef bundle;
+    uint64_t version;
+    uint64_t generation;
+};
+
 class VanadisInstructionLoader {
 public:
     VanadisInstructionLoader(const size_t uop_cache_size, const size_t predecode_cache_entries,
                              const uint64_t cachelinewidth) {
 
         cache_line_width = cachelinewidth;
-        uop_cache = new VanadisCache<uint64_t, VanadisInstructionBundle*>(uop_cache_size);
+        uop_cache = new VanadisCache<uint64_t, VanadisCachedBundle*>(uop_cache_size);
         predecode_cache = new VanadisCache<uint64_t, std::vector<uint8_t>*>(predecode_cache_entries);
 
         mem_if = nullptr;
+        shared_cache = nullptr;
+        seen_generation = 0;
     }
 
     ~VanadisInstructionLoader() {
@@ -59,6 +75,13 @@ public:
 
     void setMemoryInterface(SST::Interfaces::StandardMem* new_if) { mem_if = new_if; }
 
+    void setSharedCache(VanadisSharedDecodeCache* new_cache) {
+        shared_cache = new_cache;
+        seen_generation = shared_cache->writeGeneration();
+    }
+
+    bool hasSharedCache() const { return nullptr != shared_cache; }
+
     bool acceptResponse(SST::Output* output, SST::Interfaces::StandardMem::Request* req) {
         // Looks like we created this request, so we should accept and process it
         auto check_hit_local = pending_loads.find(req->getID());
@@ -175,7 +198,39 @@ public:
     }
 
     void cacheDecodedBundle(VanadisInstructionBundle* bundle) {
-        uop_cache->store(bundle->getInstructionAddress(), bundle);
+        const uint64_t addr = bundle->getInstructionAddress();
+
+        // Drop any stale entry first, store() would replace it without
+        // releasing it
+        uop_cache->erase(addr);
+
+        if (nullptr == shared_cache) {
+            uop_cache->store(addr, new VanadisCachedBundle(VanadisSharedDecodeCache::BundleRef(bundle), 0, 0));
+        } else {
+            uint64_t version = 0;
+            VanadisSharedDecodeCache::BundleRef shared_bundle = shared_cache->insert(bundle, version);
+            uop_cache->store(addr, new VanadisCachedBundle(shared_bundle, version, seen_generation));
+        }
+    }
+
+    // Fill the micro-op cache from the shared cache rather than decoding,
+    // false if no other decoder has decoded addr at the current page version
+    bool cacheSharedBundle(const uint64_t addr) {
+        if (nullptr == shared_cache) {
+            return false;
+        }
+
+        uint64_t version = 0;
+        VanadisSharedDecodeCache::BundleRef shared_bundle = shared_cache->find(addr, version);
+
+        if (!shared_bundle) {
+            return false;
+        }
+
+        uop_cache->erase(addr);
+        uop_cache->store(addr, new VanadisCachedBundle(shared_bundle, version, seen_generation));
+
+        return true;
     }
 
     void clearCache() {
@@ -183,9 +238,38 @@ public:
         predecode_cache->clear();
     }
 
-    bool hasBundleAt(const uint64_t addr) const { return uop_cache->contains(addr); }
+    bool hasBundleAt(const uint64_t addr) {
+        if (!uop_cache->contains(addr)) {
+            return false;
+        }
+
+        if (nullptr == shared_cache) {
+            return true;
+        }
+
+        checkWriteGeneration();
+
+        VanadisCachedBundle* cached = uop_cache->peek(addr);
+
+        if (cached->generation == seen_generation) {
+            return true;
+        }
+
+        // Some code page was written since this entry was last checked
+        if (cached->version == shared_cache->pageVersion(addr, cached->bundle->pcIncrement())) {
+            cached->generation = seen_generation;
+            return true;
+        }
+
+        uop_cache->erase(addr);
+        return false;
+    }
+
+	bool hasPredecodeAt(const uint64_t addr, const uint64_t len) {
+		if(nullptr != shared_cache) {
+			checkWriteGeneration();
+		}
 
-	bool hasPredecodeAt(const uint64_t addr, const uint64_t len) const {
 		const uint64_t line_start    = addr - (addr % static_cast<uint64_t>(cache_line_width));
 		const uint64_t len_line_left = cache_line_width - (addr % static_cast<uint64_t>(cache_line_width));
 
@@ -197,7 +281,7 @@ public:
 		}
 	}
 
-    VanadisInstructionBundle* getBundleAt(const uint64_t addr) { return uop_cache->find(addr); }
+    VanadisInstructionBundle* getBundleAt(const uint64_t addr) { return uop_cache->find(addr)->bundle.get(); }
 
     void requestLoadAt(SST::Output* output, const uint64_t addr, const uint64_t len) {
         if (len > cache_line_width) {
@@ -281,6 +365,17 @@ public:
 
 private:
 
+    // Lines fetched before a code page was written may hold the old bytes,
+    // the predecode cache is small so drop all of it
+    void checkWriteGeneration() {
+        const uint64_t generation = shared_cache->writeGeneration();
+
+        if (generation != seen_generation) {
+            predecode_cache->clear();
+            seen_generation = generation;
+        }
+    }
+
 	void printPendingLoads(SST::Output* output) {
 		output->verbose(CALL_INFO, 8, 0, "[ins-loader]: Pending loads table\n");
 		for( auto next_load : pending_loads ) {
@@ -292,9 +387,12 @@ private:
     uint64_t cache_line_width;
     SST::Interfaces::StandardMem* mem_if;
 
-    VanadisCache<uint64_t, VanadisInstructionBundle*>* uop_cache;
+    VanadisCache<uint64_t, VanadisCachedBundle*>* uop_cache;
     VanadisCache<uint64_t, std::vector<uint8_t>*>* predecode_cache;
 
+    VanadisSharedDecodeCache* shared_cache;
+    uint64_t seen_generation;
+
     std::unordered_map<SST::Interfaces::StandardMem::Request::id_t, SST::Interfaces::StandardMem::Read*> pending_loads;
 };
 
@@ -0,0 +1,248 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_PROFILER
+#define _H_VANADIS_PROFILER
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+enum VanadisCPICategory {
+    VANADIS_CPI_RETIRING,
+    VANADIS_CPI_FRONTEND,
+    VANADIS_CPI_ISSUE,
+    VANADIS_CPI_BRANCH,
+    VANADIS_CPI_ROB_FULL,
+    VANADIS_CPI_LSQ_FULL,
+    VANADIS_CPI_EXECUTE,
+    VANADIS_CPI_MEMORY,
+    VANADIS_CPI_MISSPECULATION,
+    VANADIS_CPI_IDLE,
+    VANADIS_CPI_CATEGORY_COUNT
+};
+
+inline const char*
+getCPICategoryName(const VanadisCPICategory category)
+{
+    switch ( category ) {
+    case VANADIS_CPI_RETIRING:
+        return "retiring";
+    case VANADIS_CPI_FRONTEND:
+        return "frontend";
+    case VANADIS_CPI_ISSUE:
+        return "issue";
+    case VANADIS_CPI_BRANCH:
+        return "branch";
+    case VANADIS_CPI_ROB_FULL:
+        return "rob_full";
+    case VANADIS_CPI_LSQ_FULL:
+        return "lsq_full";
+    case VANADIS_CPI_EXECUTE:
+        return "execute";
+    case VANADIS_CPI_MEMORY:
+        return "memory";
+    case VANADIS_CPI_MISSPECULATION:
+        return "misspeculation";
+    case VANADIS_CPI_IDLE:
+        return "idle";
+    default:
+        return "unknown";
+    }
+}
+
+/*
+ * Cycle accounting and per instruction address counters. Every detailed
+ * cycle is charged to exactly one CPI stack category, cycles which retire
+ * nothing are also charged to the instruction holding up the front of the
+ * ROB. A stalled front is waiting to issue (operands or a functional unit),
+ * a branch waiting to resolve, memory (or a full LSQ), or some other
+ * instruction still executing, split by whether the ROB is full. Counters live in an open addressed table keyed by instruction
+ * address so each retire or stall costs one hash probe.
+ *
+ * At finish the stack and the per address counters (busiest first) are
+ * written out as text:
+ *
+ *   <category> <cycles> <fraction>
+ *   ...
+ *   0x<address> <retired> <stall-cycles> <memory-stall-cycles> <mispredicts>
+ */
+class VanadisCPIProfiler
+{
+public:
+    VanadisCPIProfiler(FILE* profile_out, const uint32_t hw_threads) :
+        profile_file(profile_out),
+        table_used(0),
+        recovering(hw_threads, false)
+    {
+        std::fill(cpi_stack, cpi_stack + VANADIS_CPI_CATEGORY_COUNT, 0);
+        resize(4096);
+    }
+
+    ~VanadisCPIProfiler()
+    {
+        if ( nullptr != profile_file ) { fclose(profile_file); }
+    }
+
+    void retire(const uint32_t hw_thr, const uint64_t ins_address)
+    {
+        recovering[hw_thr] = false;
+        find(ins_address).retired++;
+    }
+
+    // The thread's next retire ends the misspeculation penalty
+    void mispredict(const uint32_t hw_thr, const uint64_t ins_address)
+    {
+        recovering[hw_thr] = true;
+        find(ins_address).mispredicts++;
+    }
+
+    bool isRecovering(const uint32_t hw_thr) const { return recovering[hw_thr]; }
+
+    void cycle(const VanadisCPICategory category) { cpi_stack[category]++; }
+
+    void stall(const VanadisCPICategory category, const uint64_t ins_address)
+    {
+        cpi_stack[category]++;
+
+        PCRecord& record = find(ins_address);
+        record.stall_cycles++;
+
+        if ( VANADIS_CPI_MEMORY == category ) { record.memory_cycles++; }
+    }
+
+    void write(const uint16_t core_id)
+    {
+        uint64_t total_cycles = 0;
+
+        for ( int i = 0; i < VANADIS_CPI_CATEGORY_COUNT; ++i ) {
+            total_cycles += cpi_stack[i];
+        }
+
+        fprintf(profile_file, "# Vanadis core %" PRIu16 " CPI stack, %" PRIu64 " cycles\n", core_id, total_cycles);
+
+        for ( int i = 0; i < VANADIS_CPI_CATEGORY_COUNT; ++i ) {
+            fprintf(
+                profile_file, "%-16s %16" PRIu64 " %8.4f\n", getCPICategoryName((VanadisCPICategory)i), cpi_stack[i],
+                (total_cycles > 0) ? ((double)cpi_stack[i] / (double)total_cycles) : 0.0);
+        }
+
+        std::vector<const PCRecord*> records;
+        records.reserve(table_used);
+
+        for ( const PCRecord& next_record : table ) {
+            if ( EMPTY_SLOT != next_record.ins_address ) { records.push_back(&next_record); }
+        }
+
+        std::sort(records.begin(), records.end(), [](const PCRecord* a, const PCRecord* b) {
+            const uint64_t a_cost = a->retired + a->stall_cycles;
+            const uint64_t b_cost = b->retired + b->stall_cycles;
+            return (a_cost != b_cost) ? (a_cost > b_cost) : (a->ins_address < b->ins_address);
+        });
+
+        fprintf(profile_file, "# address retired stall-cycles memory-stall-cycles mispredicts\n");
+
+        for ( const PCRecord* next_record : records ) {
+            fprintf(
+                profile_file, "0x%016" PRIx64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+                next_record->ins_address, next_record->retired, next_record->stall_cycles, next_record->memory_cycles,
+                next_record->mispredicts);
+        }
+
+        fflush(profile_file);
+    }
+
+private:
+    static constexpr uint64_t EMPTY_SLOT = UINT64_MAX;
+
+    struct PCRecord
+    {
+        uint64_t ins_address;
+        uint64_t retired;
+        uint64_t stall_cycles;
+        uint64_t memory_cycles;
+        uint64_t mispredicts;
+    };
+
+    PCRecord& find(const uint64_t ins_address)
+    {
+        size_t slot = hash(ins_address);
+
+        while ( true ) {
+            PCRecord& next_record = table[slot];
+
+            if ( next_record.ins_address == ins_address ) { return next_record; }
+
+            if ( EMPTY_SLOT == next_record.ins_address ) {
+                // Keep the table at most half full so probe chains stay short
+                if ( (table_used + 1) * 2 > table.size() ) {
+                    resize(table.size() * 2);
+                    return find(ins_address);
+                }
+
+                next_record.ins_address = ins_address;
+                table_used++;
+                return next_record;
+            }
+
+            slot = (slot + 1) & table_mask;
+        }
+    }
+
+    size_t hash(const uint64_t ins_address) const
+    {
+        return (size_t)(((ins_address >> 1) * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & table_mask;
+    }
+
+    void resize(const size_t new_size)
+    {
+        std::vector<PCRecord> old_table;
+        old_table.swap(table);
+
+        table.resize(new_size, PCRecord { EMPTY_SLOT, 0, 0, 0, 0 });
+        table_mask = new_size - 1;
+        table_used = 0;
+
+        for ( const PCRecord& next_record : old_table ) {
+            if ( EMPTY_SLOT != next_record.ins_address ) {
+                size_t slot = hash(next_record.ins_address);
+
+                while ( EMPTY_SLOT != table[slot].ins_address ) {
+                    slot = (slot + 1) & table_mask;
+                }
+
+                table[slot] = next_record;
+                table_used++;
+            }
+        }
+    }
+
+    FILE*                 profile_file;
+    uint64_t              cpi_stack[VANADIS_CPI_CATEGORY_COUNT];
+    std::vector<PCRecord> table;
+    size_t                table_mask;
+    size_t                table_used;
+    std::vector<bool>     recovering;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,254 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_SIMPOINT
+#define _H_VANADIS_SIMPOINT
+
+#include <sst/core/output.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Collects basic block vectors in the format read by the SimPoint tools.
+ * A basic block is named by the address of its first instruction (the same
+ * address the instruction loader caches decoded bundles under) and ends at
+ * a retired branch. Every interval of interval_len retired instructions
+ * writes one line:
+ *
+ *   T:<block-id>:<instructions> :<block-id>:<instructions> ...
+ *
+ * Block ids start at 1 and are given out in the order blocks are first seen.
+ */
+class VanadisBasicBlockVector {
+public:
+    VanadisBasicBlockVector(FILE* bbv_out, const uint64_t interval_len) :
+        bbv_file(bbv_out),
+        interval_length(interval_len),
+        interval_count(0),
+        block_start(0),
+        block_count(0),
+        block_open(false)
+    {}
+
+    ~VanadisBasicBlockVector()
+    {
+        if ( nullptr != bbv_file ) { fclose(bbv_file); }
+    }
+
+    void retire(const uint64_t ins_address)
+    {
+        if ( !block_open ) {
+            block_start = ins_address;
+            block_open  = true;
+        }
+
+        block_count++;
+        interval_count++;
+
+        if ( interval_count >= interval_length ) {
+            // Blocks which straddle the boundary are split between intervals
+            addBlockCount();
+            writeInterval();
+        }
+    }
+
+    void endBlock()
+    {
+        addBlockCount();
+        block_open = false;
+    }
+
+    // Write out the last partial interval
+    void flush()
+    {
+        addBlockCount();
+
+        if ( !interval_blocks.empty() ) { writeInterval(); }
+
+        fflush(bbv_file);
+    }
+
+private:
+    void addBlockCount()
+    {
+        if ( block_count > 0 ) {
+            auto id_itr = block_ids.find(block_start);
+
+            if ( id_itr == block_ids.end() ) {
+                id_itr = block_ids.insert(std::make_pair(block_start, (uint32_t)(block_ids.size() + 1))).first;
+            }
+
+            interval_blocks[id_itr->second] += block_count;
+            block_count = 0;
+        }
+    }
+
+    void writeInterval()
+    {
+        fprintf(bbv_file, "T");
+
+        for ( auto next_block : interval_blocks ) {
+            fprintf(bbv_file, ":%" PRIu32 ":%" PRIu64 " ", next_block.first, next_block.second);
+        }
+
+        fprintf(bbv_file, "\n");
+
+        interval_blocks.clear();
+        interval_count = 0;
+    }
+
+    FILE*          bbv_file;
+    const uint64_t interval_length;
+    uint64_t       interval_count;
+
+    uint64_t block_start;
+    uint64_t block_count;
+    bool     block_open;
+
+    std::unordered_map<uint64_t, uint32_t> block_ids;
+    std::map<uint32_t, uint64_t>           interval_blocks;
+};
+
+/*
+ * The intervals chosen by SimPoint and their weights, read from the
+ * .simpoints ("<interval> <cluster>") and .weights ("<weight> <cluster>")
+ * files. Each chosen interval is simulated in detail, the rest of the run is
+ * executed functionally, and the measured cycles per instruction of every
+ * interval are combined by weight at the end of simulation.
+ */
+class VanadisSimPointSchedule {
+public:
+    struct Sample {
+        uint64_t interval;
+        double   weight;
+        uint64_t instructions;
+        uint64_t cycles;
+    };
+
+    VanadisSimPointSchedule(SST::Output* output, const std::string& simpoint_path, const std::string& weight_path)
+    {
+        std::map<uint64_t, uint64_t> cluster_interval;
+        std::map<uint64_t, double>   cluster_weight;
+
+        FILE* simpoint_file = fopen(simpoint_path.c_str(), "rt");
+
+        if ( nullptr == simpoint_file ) {
+            output->fatal(CALL_INFO, -1, "Error: unable to open simpoint file: %s\n", simpoint_path.c_str());
+        }
+
+        uint64_t interval = 0;
+        uint64_t cluster  = 0;
+
+        while ( 2 == fscanf(simpoint_file, "%" SCNu64 " %" SCNu64, &interval, &cluster) ) {
+            cluster_interval[cluster] = interval;
+        }
+
+        fclose(simpoint_file);
+
+        FILE* weight_file = fopen(weight_path.c_str(), "rt");
+
+        if ( nullptr == weight_file ) {
+            output->fatal(CALL_INFO, -1, "Error: unable to open simpoint weights file: %s\n", weight_path.c_str());
+        }
+
+        double weight = 0;
+
+        while ( 2 == fscanf(weight_file, "%lf %" SCNu64, &weight, &cluster) ) {
+            cluster_weight[cluster] = weight;
+        }
+
+        fclose(weight_file);
+
+        for ( auto next_cluster : cluster_interval ) {
+            auto weight_itr = cluster_weight.find(next_cluster.first);
+
+            if ( weight_itr == cluster_weight.end() ) {
+                output->fatal(
+                    CALL_INFO, -1, "Error: simpoint cluster %" PRIu64 " has no entry in the weights file %s\n",
+                    next_cluster.first, weight_path.c_str());
+            }
+
+            samples.push_back({ next_cluster.second, weight_itr->second, 0, 0 });
+        }
+
+        std::sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) {
+            return a.interval < b.interval;
+        });
+
+        next_sample = 0;
+    }
+
+    bool     complete() const { return next_sample >= samples.size(); }
+    uint64_t nextInterval() const { return samples[next_sample].interval; }
+
+    void recordSample(const uint64_t instructions, const uint64_t cycles)
+    {
+        samples[next_sample].instructions = instructions;
+        samples[next_sample].cycles       = cycles;
+        next_sample++;
+    }
+
+    void report(SST::Output* output, const uint16_t core_id) const
+    {
+        double weighted_cpi = 0;
+        double total_weight = 0;
+
+        output->verbose(CALL_INFO, 0, 0, "Vanadis core %" PRIu16 " SimPoint samples:\n", core_id);
+
+        for ( const Sample& next : samples ) {
+            const double cpi = (next.instructions > 0) ? ((double)next.cycles / (double)next.instructions) : 0;
+
+            output->verbose(
+                CALL_INFO, 0, 0,
+                "-> interval: %10" PRIu64 " / weight: %8.5f / instructions: %12" PRIu64 " / cycles: %12" PRIu64
+                " / CPI: %8.4f\n",
+                next.interval, next.weight, next.instructions, next.cycles, cpi);
+
+            if ( next.instructions > 0 ) {
+                weighted_cpi += next.weight * cpi;
+                total_weight += next.weight;
+            }
+        }
+
+        if ( total_weight > 0 ) {
+            // Renormalise in case the run ended before every sample was taken
+            weighted_cpi /= total_weight;
+
+            output->verbose(
+                CALL_INFO, 0, 0, "-> weighted CPI: %8.4f / weighted IPC: %8.4f (sampled weight: %6.4f)\n",
+                weighted_cpi, 1.0 / weighted_cpi, total_weight);
+        }
+    }
+
+private:
+    std::vector<Sample> samples;
+    size_t              next_sample;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -32,6 +32,7 @@
 #include "sirius/siriusconst.h"
 
 #include "zevent.h"
+#include "zreader.h"
 #include "zinitevent.h"
 #include "zsendevent.h"
 #include "zirecvevent.h"
@@ -49,7 +50,7 @@ using namespace SST::Hermes::MP;
 namespace SST {
 namespace Zodiac {
 
-class SiriusReader {
+class SiriusReader : public ZodiacReader {
     public:
 	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
         void close();
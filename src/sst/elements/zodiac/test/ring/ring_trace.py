@@ -0,0 +1,130 @@
+# -*- coding: utf-8 -*-
+#
+# Writes a small Sirius trace, one file per rank (<prefix>.<rank>), in
+# which the ranks pass messages around a ring and then reduce. It uses
+# every call ZodiacSiriusTraceReader replays, so it can be used to check
+# that a trace converted by sst-zodiac-convert replays the same events.
+#
+#   python ring_trace.py [--ranks=N] [--rounds=N] <prefix>
+
+import getopt
+import struct
+import sys
+
+# sirius/siriusconst.h
+SIRIUS_MPI_INIT = 1
+SIRIUS_MPI_FINALIZE = 2
+SIRIUS_MPI_SEND = 4
+SIRIUS_MPI_RECV = 16
+SIRIUS_MPI_IRECV = 17
+SIRIUS_MPI_BARRIER = 64
+SIRIUS_MPI_ALLREDUCE = 65
+SIRIUS_MPI_WAIT = 128
+
+SIRIUS_MPI_COMM_WORLD = 0
+
+SIRIUS_MPI_INTEGER = 1
+SIRIUS_MPI_DOUBLE = 2
+
+SIRIUS_MPI_SUM = 1
+SIRIUS_MPI_MAX = 16
+SIRIUS_MPI_MIN = 17
+
+# Records are packed and in the byte order of the machine that reads them
+def pack(fmt, *values):
+    return struct.pack("=" + fmt, *values)
+
+class RankTrace:
+    def __init__(self, rank):
+        self.rank = rank
+        self.now = 0.0
+        self.data = b""
+
+    # Each call starts after some compute and takes a little while itself,
+    # the gaps differ by rank so the compute events differ too
+    def call(self, call_type, args, compute_us, call_us=1.0):
+        self.now += (compute_us + self.rank * 0.25) * 1e-6
+        self.data += pack("Id", call_type, self.now) + args
+        self.now += call_us * 1e-6
+        self.data += pack("di", self.now, 0)
+
+    def init(self):
+        self.call(SIRIUS_MPI_INIT, b"", 0.0)
+
+    def finalize(self):
+        self.call(SIRIUS_MPI_FINALIZE, b"", 2.0)
+
+    def send(self, count, dtype, dest, tag, compute_us):
+        self.call(SIRIUS_MPI_SEND, pack("QIIiiI", 0, count, dtype, dest, tag, SIRIUS_MPI_COMM_WORLD), compute_us)
+
+    def recv(self, count, dtype, src, tag, compute_us):
+        self.call(SIRIUS_MPI_RECV, pack("QIIiiI", 0, count, dtype, src, tag, SIRIUS_MPI_COMM_WORLD), compute_us)
+
+    def irecv(self, count, dtype, src, tag, request, compute_us):
+        self.call(SIRIUS_MPI_IRECV, pack("QIIiiIQ", 0, count, dtype, src, tag, SIRIUS_MPI_COMM_WORLD, request),
+                  compute_us)
+
+    def wait(self, request, compute_us):
+        self.call(SIRIUS_MPI_WAIT, pack("QQ", request, 0), compute_us)
+
+    def barrier(self, compute_us):
+        self.call(SIRIUS_MPI_BARRIER, pack("I", SIRIUS_MPI_COMM_WORLD), compute_us)
+
+    def allreduce(self, count, dtype, op, compute_us):
+        self.call(SIRIUS_MPI_ALLREDUCE, pack("QQIIII", 0, 0, count, dtype, op, SIRIUS_MPI_COMM_WORLD), compute_us)
+
+def build_rank(rank, ranks, rounds):
+    trace = RankTrace(rank)
+    right = (rank + 1) % ranks
+    left = (rank + ranks - 1) % ranks
+
+    trace.init()
+
+    for i in range(rounds):
+        # Non-blocking exchange to the right
+        trace.irecv(64, SIRIUS_MPI_DOUBLE, left, 10 + i, 100 + i, 5.0)
+        trace.send(64, SIRIUS_MPI_DOUBLE, right, 10 + i, 3.0)
+        trace.wait(100 + i, 1.0)
+
+        # Blocking exchange to the left, odd ranks receive first
+        if rank % 2 == 0:
+            trace.send(32, SIRIUS_MPI_INTEGER, left, 20 + i, 4.0)
+            trace.recv(32, SIRIUS_MPI_INTEGER, right, 20 + i, 1.0)
+        else:
+            trace.recv(32, SIRIUS_MPI_INTEGER, right, 20 + i, 4.0)
+            trace.send(32, SIRIUS_MPI_INTEGER, left, 20 + i, 1.0)
+
+        trace.allreduce(16, SIRIUS_MPI_DOUBLE, SIRIUS_MPI_SUM, 6.0)
+
+    trace.allreduce(4, SIRIUS_MPI_INTEGER, SIRIUS_MPI_MAX, 2.0)
+    trace.allreduce(4, SIRIUS_MPI_INTEGER, SIRIUS_MPI_MIN, 2.0)
+    trace.barrier(3.0)
+    trace.finalize()
+
+    return trace.data
+
+def main():
+    ranks = 4
+    rounds = 3
+
+    try:
+        opts, args = getopt.getopt(sys.argv[1:], "", ["ranks=", "rounds="])
+    except getopt.GetoptError as err:
+        print(str(err))
+        sys.exit(2)
+
+    for o, a in opts:
+        if o == "--ranks":
+            ranks = int(a)
+        elif o == "--rounds":
+            rounds = int(a)
+
+    if len(args) != 1 or ranks < 2:
+        print("usage: ring_trace.py [--ranks=N] [--rounds=N] <prefix>")
+        sys.exit(2)
+
+    for rank in range(ranks):
+        with open("{0}.{1}".format(args[0], rank), "wb") as f:
+            f.write(build_rank(rank, ranks, rounds))
+
+main()
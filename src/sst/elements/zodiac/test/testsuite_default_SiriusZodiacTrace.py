@@ -60,6 +60,9 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
     def test_Sirius_Zodiac_128(self):
         self.SiriusZodiacTrace_test_template("8x8x2")
 
+    def test_Sirius_Zodiac_binary_roundtrip(self):
+        self.SiriusZodiacBinary_roundtrip_template("4")
+
 #####
 
     def SiriusZodiacTrace_test_template(self, testcase, testtimeout = 60):
@@ -112,6 +115,70 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted/Filtered output file {0} does not match Reference File {1}".format(tmpfile2, reffile))
 
+#####
+
+    def SiriusZodiacBinary_roundtrip_template(self, shape, testtimeout = 60):
+
+        # Get the path to the test files
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        # Check that the trace converter was built and installed
+        rtn = OSCommand("which sst-zodiac-convert").run()
+        if rtn.result() != 0:
+            self.skipTest("SiriusZodiacTrace: sst-zodiac-convert not found")
+
+        testDataFileName = "test_Sirius_binary_roundtrip_{0}".format(shape)
+        tracedir = "{0}/{1}".format(outdir, testDataFileName)
+        if os.path.isdir(tracedir):
+            shutil.rmtree(tracedir, True)
+        os.makedirs(tracedir)
+
+        numRanks = 1
+        for dim in shape.split('x'):
+            numRanks = numRanks * int(dim)
+
+        # Write the Sirius trace and convert it into a binary trace
+        cmd = "{0} {1}/ring/ring_trace.py --ranks={2} ring.stf".format(sys.executable, test_path, numRanks)
+        rtn = OSCommand(cmd, set_cwd=tracedir).run()
+        self.assertTrue(rtn.result() == 0, "Failed to write the Sirius ring trace:\n{0}".format(rtn.output()))
+
+        cmd = "sst-zodiac-convert --ranks={0} ring.stf ring.zbt".format(numRanks)
+        rtn = OSCommand(cmd, set_cwd=tracedir).run()
+        self.assertTrue(rtn.result() == 0, "Failed to convert the Sirius ring trace:\n{0}".format(rtn.output()))
+
+        # Replay both traces, each logs every event it processes
+        sdlfile = "{0}/ring/ring.py".format(test_path)
+        eventfiles = {}
+
+        for traceformat, tracefile in (("sirius", "ring.stf"), ("binary", "ring.zbt")):
+            outfile = "{0}/{1}_{2}.out".format(outdir, testDataFileName, traceformat)
+            errfile = "{0}/{1}_{2}.err".format(outdir, testDataFileName, traceformat)
+            mpioutfiles = "{0}/{1}_{2}.testfile".format(outdir, testDataFileName, traceformat)
+            otherargs = '--model-options \"--shape={0} --trace={1} --traceformat={2}\"'.format(shape, tracefile, traceformat)
+
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles,
+                         other_args=otherargs, set_cwd=tracedir,
+                         timeout_sec=testtimeout)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("SiriusZodiacTrace test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            # Keep only the event log, the lines naming the trace file differ
+            eventfiles[traceformat] = "{0}/{1}_{2}_events.tmp".format(outdir, testDataFileName, traceformat)
+            with open(outfile, 'r') as fin, open(eventfiles[traceformat], 'w') as fout:
+                for line in fin:
+                    if ":ZSirius::" in line:
+                        fout.write(line)
+
+        self.assertTrue(os_test_file(eventfiles["sirius"], "-s"), "Sirius replay of {0} logged no events".format(testDataFileName))
+
+        cmp_result = testing_compare_sorted_diff(testDataFileName, eventfiles["binary"], eventfiles["sirius"])
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testDataFileName)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Binary trace events {0} do not match the Sirius trace events {1}".format(eventfiles["binary"], eventfiles["sirius"]))
+
 #####
 
     def _setupSiriusZodiacTraceTestFiles(self):
@@ -0,0 +1,712 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Converts per rank Sirius (or DUMPI) traces into a single Zodiac binary
+ * trace (see zbinaryformat.h). Ranks are converted in parallel, each worker
+ * decodes a whole rank into memory and writes it to the next free part of
+ * the output, the rank table is written last.
+ *
+ *   sst-zodiac-convert [--format=sirius|dumpi] [--threads=N] --ranks=N <input> <output>
+ *
+ * For Sirius traces <input> is the prefix of the per rank files (as given to
+ * ZodiacSiriusTraceReader's trace parameter), rank N is read from
+ * <input>.N. For DUMPI traces <input> is a printf pattern taking the rank,
+ * for example dumpi-2021.01.01.00.00.00-%04d.bin.
+ */
+
+#include <sst_config.h>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../sirius/siriusconst.h"
+#include "../../zbinaryformat.h"
+
+#ifdef HAVE_ZODIAC_DUMPI
+extern "C" {
+#include "dumpi/libundumpi/libundumpi.h"
+#include "dumpi/libundumpi/callbacks.h"
+}
+#endif
+
+typedef std::vector<ZodiacBinaryRecord> RecordList;
+
+static ZodiacBinaryRecord
+make_record(uint32_t type)
+{
+    ZodiacBinaryRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = type;
+    return record;
+}
+
+static void
+push_compute(RecordList& records, double seconds)
+{
+    if (seconds > 0) {
+        ZodiacBinaryRecord record = make_record(ZBIN_COMPUTE);
+        record.time = seconds;
+        records.push_back(record);
+    }
+}
+
+static std::string
+rank_path(const char* pattern, uint32_t rank, bool is_prefix)
+{
+    char path[4096];
+
+    if (is_prefix) {
+        snprintf(path, sizeof(path), "%s.%" PRIu32, pattern, rank);
+    } else {
+        snprintf(path, sizeof(path), pattern, rank);
+    }
+
+    return path;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Sirius
+
+/*
+ * Bounds checked cursor over a mapped Sirius trace. The event stream is
+ * decoded exactly as SiriusReader does so a binary trace replays the same
+ * events as the trace it was converted from.
+ */
+class SiriusCursor {
+public:
+    SiriusCursor(const char* data, size_t len) : position(data), end(data + len), truncated(false) {}
+
+    template <typename T>
+    T read() {
+        T value = 0;
+
+        if ((size_t)(end - position) < sizeof(T)) {
+            truncated = true;
+            position = end;
+        } else {
+            memcpy(&value, position, sizeof(T));
+            position += sizeof(T);
+        }
+
+        return value;
+    }
+
+    bool atEnd() const { return position == end; }
+    bool isTruncated() const { return truncated; }
+
+private:
+    const char* position;
+    const char* end;
+    bool truncated;
+};
+
+static uint16_t
+sirius_type(uint32_t dtype)
+{
+    if (SIRIUS_MPI_INTEGER == dtype) {
+        return ZBIN_INT;
+    } else if (SIRIUS_MPI_DOUBLE == dtype) {
+        return ZBIN_DOUBLE;
+    }
+
+    return ZBIN_CHAR;
+}
+
+static bool
+sirius_op(uint32_t op, uint16_t& converted)
+{
+    switch (op) {
+    case SIRIUS_MPI_SUM:
+        converted = ZBIN_SUM;
+        return true;
+    case SIRIUS_MPI_MAX:
+        converted = ZBIN_MAX;
+        return true;
+    case SIRIUS_MPI_MIN:
+        converted = ZBIN_MIN;
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool
+convert_sirius_stream(SiriusCursor& trace, RecordList& records, std::string& error)
+{
+    // SiriusReader starts every rank with an init of its own
+    records.push_back(make_record(ZBIN_INIT));
+
+    double prev_time = 0;
+    bool found_finalize = false;
+
+    while (!found_finalize) {
+        if (trace.atEnd()) {
+            error = "trace ends without an MPI_Finalize";
+            return false;
+        }
+
+        const uint32_t call_type = trace.read<uint32_t>();
+        push_compute(records, trace.read<double>() - prev_time);
+
+        ZodiacBinaryRecord record = make_record(0);
+
+        switch (call_type) {
+        case SIRIUS_MPI_SEND:
+        case SIRIUS_MPI_RECV:
+        case SIRIUS_MPI_IRECV:
+            record.type = (SIRIUS_MPI_SEND == call_type) ? ZBIN_SEND :
+                          ((SIRIUS_MPI_RECV == call_type) ? ZBIN_RECV : ZBIN_IRECV);
+            trace.read<uint64_t>(); // buffer
+            record.count = trace.read<uint32_t>();
+            record.dtype = sirius_type(trace.read<uint32_t>());
+            record.peer = trace.read<int32_t>();
+            record.tag = trace.read<int32_t>();
+            record.comm = trace.read<uint32_t>();
+
+            if (SIRIUS_MPI_IRECV == call_type) {
+                record.request = trace.read<uint64_t>();
+            }
+            break;
+
+        case SIRIUS_MPI_ALLREDUCE:
+            record.type = ZBIN_ALLREDUCE;
+            trace.read<uint64_t>(); // send buffer
+            trace.read<uint64_t>(); // receive buffer
+            record.count = trace.read<uint32_t>();
+            record.dtype = sirius_type(trace.read<uint32_t>());
+
+            if (!sirius_op(trace.read<uint32_t>(), record.op)) {
+                error = "unknown MPI operation in an MPI_Allreduce";
+                return false;
+            }
+
+            record.comm = trace.read<uint32_t>();
+            break;
+
+        case SIRIUS_MPI_BARRIER:
+            record.type = ZBIN_BARRIER;
+            record.comm = trace.read<uint32_t>();
+            break;
+
+        case SIRIUS_MPI_WAIT:
+            record.type = ZBIN_WAIT;
+            record.request = trace.read<uint64_t>();
+            trace.read<uint64_t>(); // status
+            break;
+
+        case SIRIUS_MPI_INIT:
+            record.type = ZBIN_INIT;
+            break;
+
+        case SIRIUS_MPI_FINALIZE:
+            record.type = ZBIN_FINALIZE;
+            found_finalize = true;
+            break;
+
+        default:
+            error = "unknown MPI command " + std::to_string(call_type);
+            return false;
+        }
+
+        // profiled time of the call and its result
+        prev_time = trace.read<double>();
+        trace.read<int32_t>();
+
+        if (trace.isTruncated()) {
+            error = "trace is truncated";
+            return false;
+        }
+
+        records.push_back(record);
+    }
+
+    return true;
+}
+
+static bool
+convert_sirius(const std::string& path, RecordList& records, std::string& error)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        error = "unable to open the trace";
+        return false;
+    }
+
+    struct stat file_stat;
+
+    if (0 != fstat(fd, &file_stat)) {
+        close(fd);
+        error = "unable to read the size of the trace";
+        return false;
+    }
+
+    const size_t len = (size_t)file_stat.st_size;
+    void* mapped = NULL;
+
+    if (len > 0) {
+        mapped = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (MAP_FAILED == mapped) {
+            close(fd);
+            error = "unable to map the trace";
+            return false;
+        }
+
+        madvise(mapped, len, MADV_SEQUENTIAL);
+    }
+
+    close(fd);
+
+    SiriusCursor trace((const char*)mapped, len);
+    const bool converted = convert_sirius_stream(trace, records, error);
+
+    if (NULL != mapped) {
+        munmap(mapped, len);
+    }
+
+    return converted;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// DUMPI
+
+#ifdef HAVE_ZODIAC_DUMPI
+
+/*
+ * Only the calls Zodiac can replay are converted, time spent in any other
+ * call becomes part of the compute time before the next converted call.
+ */
+struct DUMPIRank {
+    RecordList* records;
+    double prev_stop;
+    bool started;
+    bool found_finalize;
+    std::string error;
+};
+
+static double
+dumpi_seconds(const dumpi_clock& clock)
+{
+    return (double)clock.sec + ((double)clock.nsec / 1000000000.0);
+}
+
+static void
+dumpi_push(DUMPIRank* rank, const dumpi_time* wall, const ZodiacBinaryRecord& record)
+{
+    if (rank->started) {
+        push_compute(*rank->records, dumpi_seconds(wall->start) - rank->prev_stop);
+    }
+
+    rank->records->push_back(record);
+    rank->prev_stop = dumpi_seconds(wall->stop);
+    rank->started = true;
+}
+
+static uint16_t
+dumpi_type(dumpi_datatype dtype)
+{
+    if (DUMPI_INT == dtype) {
+        return ZBIN_INT;
+    } else if (DUMPI_DOUBLE == dtype) {
+        return ZBIN_DOUBLE;
+    }
+
+    return ZBIN_CHAR;
+}
+
+static uint32_t
+dumpi_comm(dumpi_comm comm)
+{
+    if (DUMPI_COMM_WORLD == comm) {
+        return SIRIUS_MPI_COMM_WORLD;
+    } else if (DUMPI_COMM_SELF == comm) {
+        return SIRIUS_MPI_COMM_SELF;
+    }
+
+    return (uint32_t)comm;
+}
+
+static int32_t
+dumpi_peer(int peer)
+{
+    return (DUMPI_ANY_SOURCE == peer) ? -1 : peer;
+}
+
+static int32_t
+dumpi_tag(int tag)
+{
+    return (DUMPI_ANY_TAG == tag) ? -1 : tag;
+}
+
+static int
+on_dumpi_init(const dumpi_init* prm, uint16_t thread, const dumpi_time* cpu, const dumpi_time* wall,
+              const dumpi_perfinfo* perf, void* userarg)
+{
+    dumpi_push((DUMPIRank*)userarg, wall, make_record(ZBIN_INIT));
+    return 1;
+}
+
+static int
+on_dumpi_finalize(const dumpi_finalize* prm, uint16_t thread, const dumpi_time* cpu, const dumpi_time* wall,
+                  const dumpi_perfinfo* perf, void* userarg)
+{
+    DUMPIRank* rank = (DUMPIRank*)userarg;
+    dumpi_push(rank, wall, make_record(ZBIN_FINALIZE));
+    rank->found_finalize = true;
+    return 1;
+}
+
+static int
+on_dumpi_send(const dumpi_send* prm, uint16_t thread, const dumpi_time* cpu, const dumpi_time* wall,
+              const dumpi_perfinfo* perf, void* userarg)
+{
+    ZodiacBinaryRecord record = make_record(ZBIN_SEND);
+    record.count = prm->count;
+    record.dtype = dumpi_type(prm->datatype);
+    record.peer = prm->dest;
+    record.tag = prm->tag;
+    record.comm = dumpi_comm(prm->comm);
+
+    dumpi_push((DUMPIRank*)userarg, wall, record);
+    return 1;
+}
+
+static int
+on_dumpi_recv(const dumpi_recv* prm, uint16_t thread, const dumpi_time* cpu, const dumpi_time* wall,
+              const dumpi_perfinfo* perf, void* userarg)
+{
+    ZodiacBinaryRecord record = make_record(ZBIN_RECV);
+    record.count = prm->count;
+    record.dtype = dumpi_type(prm->datatype);
+    record.peer = dumpi_peer(prm->source);
+    record.tag = dumpi_tag(prm->tag);
+    record.comm = dumpi_comm(prm->comm);
+
+    dumpi_push((DUMPIRank*)userarg, wall, record);
+    return 1;
+}
+
+static int
+on_dumpi_irecv(const dumpi_irecv* prm, uint16_t thread, const dumpi_time* cpu, const dumpi_time* wall,
+               const dumpi_perfinfo* perf, void* userarg)
+{
+    ZodiacBinaryRecord record = make_record(ZBIN_IRECV);
+    record.count = prm->count;
+    record.dtype = dumpi_type(prm->datatype);
+    record.peer = dumpi_peer(prm->source);
+    record.tag = dumpi_tag(prm->tag);
+    record.comm = dumpi_comm(prm->comm);
+    record.request = (uint64_t)prm->request;
+
+    dumpi_push((DUMPIRank*)userarg, wall, record);
+    return 1;
+}
+
+static int
+on_dumpi_wait(const dumpi_wait* prm, uint16_t thread, const dumpi_time* cpu, const dumpi_time* wall,
+              const dumpi_perfinfo* perf, void* userarg)
+{
+    ZodiacBinaryRecord record = make_record(ZBIN_WAIT);
+    record.request = (uint64_t)prm->request;
+
+    dumpi_push((DUMPIRank*)userarg, wall, record);
+    return 1;
+}
+
+static int
+on_dumpi_barrier(const dumpi_barrier* prm, uint16_t thread, const dumpi_time* cpu, const dumpi_time* wall,
+                 const dumpi_perfinfo* perf, void* userarg)
+{
+    ZodiacBinaryRecord record = make_record(ZBIN_BARRIER);
+    record.comm = dumpi_comm(prm->comm);
+
+    dumpi_push((DUMPIRank*)userarg, wall, record);
+    return 1;
+}
+
+static int
+on_dumpi_allreduce(const dumpi_allreduce* prm, uint16_t thread, const dumpi_time* cpu, const dumpi_time* wall,
+                   const dumpi_perfinfo* perf, void* userarg)
+{
+    DUMPIRank* rank = (DUMPIRank*)userarg;
+    ZodiacBinaryRecord record = make_record(ZBIN_ALLREDUCE);
+    record.count = prm->count;
+    record.dtype = dumpi_type(prm->datatype);
+    record.comm = dumpi_comm(prm->comm);
+
+    if (DUMPI_SUM == prm->op) {
+        record.op = ZBIN_SUM;
+    } else if (DUMPI_MAX == prm->op) {
+        record.op = ZBIN_MAX;
+    } else if (DUMPI_MIN == prm->op) {
+        record.op = ZBIN_MIN;
+    } else if (rank->error.empty()) {
+        rank->error = "unknown MPI operation in an MPI_Allreduce";
+    }
+
+    dumpi_push(rank, wall, record);
+    return 1;
+}
+
+static bool
+convert_dumpi(const std::string& path, RecordList& records, std::string& error)
+{
+    dumpi_profile* profile = undumpi_open(path.c_str());
+
+    if (NULL == profile) {
+        error = "unable to open the trace";
+        return false;
+    }
+
+    dumpi_header* header = undumpi_read_header(profile);
+    dumpi_free_header(header);
+
+    libundumpi_callbacks callbacks;
+    libundumpi_clear_callbacks(&callbacks);
+
+    callbacks.on_init = on_dumpi_init;
+    callbacks.on_finalize = on_dumpi_finalize;
+    callbacks.on_send = on_dumpi_send;
+    callbacks.on_recv = on_dumpi_recv;
+    callbacks.on_irecv = on_dumpi_irecv;
+    callbacks.on_wait = on_dumpi_wait;
+    callbacks.on_barrier = on_dumpi_barrier;
+    callbacks.on_allreduce = on_dumpi_allreduce;
+
+    DUMPIRank rank;
+    rank.records = &records;
+    rank.prev_stop = 0;
+    rank.started = false;
+    rank.found_finalize = false;
+
+    undumpi_read_stream(profile, &callbacks, &rank);
+    undumpi_close(profile);
+
+    if (!rank.error.empty()) {
+        error = rank.error;
+        return false;
+    }
+
+    if (!rank.found_finalize) {
+        error = "trace ends without an MPI_Finalize";
+        return false;
+    }
+
+    return true;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+
+static bool
+write_all(int fd, const void* data, size_t len, uint64_t offset)
+{
+    const char* next = (const char*)data;
+
+    while (len > 0) {
+        const ssize_t written = pwrite(fd, next, len, (off_t)offset);
+
+        if (written <= 0) {
+            return false;
+        }
+
+        next += written;
+        len -= (size_t)written;
+        offset += (uint64_t)written;
+    }
+
+    return true;
+}
+
+static void
+print_usage()
+{
+    fprintf(stderr, "usage: sst-zodiac-convert [--format=sirius|dumpi] [--threads=N] --ranks=N <input> <output>\n");
+    fprintf(stderr, "  sirius: <input> is the trace prefix, rank N is read from <input>.N\n");
+    fprintf(stderr, "  dumpi:  <input> is a printf pattern taking the rank, e.g. dumpi-%%04d.bin\n");
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string format = "sirius";
+    uint32_t num_ranks = 0;
+    uint32_t num_threads = std::thread::hardware_concurrency();
+
+    static struct option long_options[] = { { "format", required_argument, 0, 'f' },
+                                            { "ranks", required_argument, 0, 'r' },
+                                            { "threads", required_argument, 0, 't' },
+                                            { "help", no_argument, 0, 'h' },
+                                            { 0, 0, 0, 0 } };
+
+    int opt;
+
+    while (-1 != (opt = getopt_long(argc, argv, "f:r:t:h", long_options, NULL))) {
+        switch (opt) {
+        case 'f':
+            format = optarg;
+            break;
+        case 'r':
+            num_ranks = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            num_threads = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            print_usage();
+            exit(1);
+        }
+    }
+
+    if ((argc - optind) != 2 || 0 == num_ranks) {
+        print_usage();
+        exit(1);
+    }
+
+    const bool is_sirius = ("sirius" == format);
+
+    if (!is_sirius && "dumpi" != format) {
+        fprintf(stderr, "Error: unknown trace format %s\n", format.c_str());
+        exit(1);
+    }
+
+#ifndef HAVE_ZODIAC_DUMPI
+    if (!is_sirius) {
+        fprintf(stderr, "Error: sst-zodiac-convert was built without DUMPI support\n");
+        exit(1);
+    }
+#endif
+
+    const char* input = argv[optind];
+    const char* output_path = argv[optind + 1];
+
+    const int out_fd = open(output_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (out_fd < 0) {
+        fprintf(stderr, "Error: unable to create %s\n", output_path);
+        exit(1);
+    }
+
+    num_threads = std::max((uint32_t)1, std::min(num_threads, num_ranks));
+
+    ZodiacBinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ZODIAC_BINARY_MAGIC, sizeof(header.magic));
+    header.version = ZODIAC_BINARY_VERSION;
+    header.recordSize = sizeof(ZodiacBinaryRecord);
+    header.numRanks = num_ranks;
+    header.tableOffset = sizeof(ZodiacBinaryHeader);
+
+    std::vector<ZodiacBinaryRankEntry> table(num_ranks);
+    std::vector<std::string> errors(num_ranks);
+
+    std::atomic<uint32_t> next_rank(0);
+    std::atomic<uint64_t> next_offset(header.tableOffset + (uint64_t)num_ranks * sizeof(ZodiacBinaryRankEntry));
+    std::atomic<bool> write_failed(false);
+
+    auto worker = [&]() {
+        RecordList records;
+        uint32_t rank;
+
+        while ((rank = next_rank++) < num_ranks) {
+            const std::string path = rank_path(input, rank, is_sirius);
+            bool converted = false;
+
+            records.clear();
+
+            if (is_sirius) {
+                converted = convert_sirius(path, records, errors[rank]);
+            }
+#ifdef HAVE_ZODIAC_DUMPI
+            else {
+                converted = convert_dumpi(path, records, errors[rank]);
+            }
+#endif
+
+            if (!converted) {
+                errors[rank] = path + ": " + errors[rank];
+                continue;
+            }
+
+            const uint64_t len = records.size() * sizeof(ZodiacBinaryRecord);
+            const uint64_t offset = next_offset.fetch_add(len);
+
+            if (!write_all(out_fd, records.data(), len, offset)) {
+                write_failed = true;
+            }
+
+            table[rank].offset = offset;
+            table[rank].count = records.size();
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        workers.push_back(std::thread(worker));
+    }
+
+    for (std::thread& next_worker : workers) {
+        next_worker.join();
+    }
+
+    bool failed = write_failed;
+
+    for (uint32_t rank = 0; rank < num_ranks; ++rank) {
+        if (!errors[rank].empty()) {
+            fprintf(stderr, "Error: %s\n", errors[rank].c_str());
+            failed = true;
+        }
+    }
+
+    if (!failed) {
+        failed = !write_all(out_fd, &header, sizeof(header), 0) ||
+                 !write_all(out_fd, table.data(), table.size() * sizeof(ZodiacBinaryRankEntry), header.tableOffset);
+    }
+
+    if (0 != close(out_fd) || failed) {
+        fprintf(stderr, "Error: conversion failed, removing %s\n", output_path);
+        unlink(output_path);
+        exit(1);
+    }
+
+    uint64_t total_records = 0;
+
+    for (const ZodiacBinaryRankEntry& entry : table) {
+        total_records += entry.count;
+    }
+
+    printf("Converted %" PRIu32 " ranks, %" PRIu64 " records, into %s using %" PRIu32 " threads\n", num_ranks,
+           total_records, output_path, num_threads);
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_BINARY_FORMAT
+#define _H_ZODIAC_BINARY_FORMAT
+
+#include <stdint.h>
+
+/*
+ * Zodiac binary trace format. One file holds the traces of every rank:
+ *
+ *   ZodiacBinaryHeader
+ *   ZodiacBinaryRankEntry[numRanks]   offset (bytes) and count of records
+ *   ZodiacBinaryRecord[...]           each rank's records are contiguous
+ *
+ * Ranks may appear in any order after the table, a reader maps the file and
+ * walks its own rank's records in place. Every field is fixed width and in
+ * the byte order of the machine that wrote the file, readers refuse files
+ * whose magic, version or record size do not match their own.
+ *
+ * Records are the replayable events, already decoded, so a record turns
+ * into a Zodiac event with no further parsing. Compute records carry the
+ * time between two calls in seconds as recorded in the original trace.
+ */
+
+#define ZODIAC_BINARY_MAGIC   "ZODIACBT"
+#define ZODIAC_BINARY_VERSION 1
+
+enum ZodiacBinaryRecordType {
+	ZBIN_COMPUTE = 1,
+	ZBIN_SEND,
+	ZBIN_RECV,
+	ZBIN_IRECV,
+	ZBIN_WAIT,
+	ZBIN_BARRIER,
+	ZBIN_ALLREDUCE,
+	ZBIN_INIT,
+	ZBIN_FINALIZE
+};
+
+enum ZodiacBinaryDataType {
+	ZBIN_CHAR = 0,
+	ZBIN_INT,
+	ZBIN_DOUBLE
+};
+
+enum ZodiacBinaryOp {
+	ZBIN_SUM = 0,
+	ZBIN_MAX,
+	ZBIN_MIN
+};
+
+struct ZodiacBinaryHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t recordSize;
+	uint64_t numRanks;
+	uint64_t tableOffset;
+};
+
+struct ZodiacBinaryRankEntry {
+	uint64_t offset;
+	uint64_t count;
+};
+
+struct ZodiacBinaryRecord {
+	uint32_t type;
+	uint32_t comm;
+	int32_t  peer;      // destination of a send, source of a receive
+	int32_t  tag;
+	uint32_t count;
+	uint16_t dtype;
+	uint16_t op;
+	uint64_t request;   // request of an irecv or wait
+	double   time;      // length of a compute record in seconds
+};
+
+static_assert(sizeof(ZodiacBinaryHeader) == 32, "ZodiacBinaryHeader must be 32 bytes");
+static_assert(sizeof(ZodiacBinaryRankEntry) == 16, "ZodiacBinaryRankEntry must be 16 bytes");
+static_assert(sizeof(ZodiacBinaryRecord) == 40, "ZodiacBinaryRecord must be 40 bytes");
+
+#endif
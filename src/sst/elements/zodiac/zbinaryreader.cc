@@ -0,0 +1,323 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <map>
+#include <mutex>
+
+#include "zbinaryreader.h"
+#include "zinitevent.h"
+#include "zsendevent.h"
+#include "zirecvevent.h"
+#include "zrecvevent.h"
+#include "zbarrierevent.h"
+#include "zcomputeevent.h"
+#include "zwaitevent.h"
+#include "zfinalizeevent.h"
+#include "zallredevent.h"
+
+using namespace std;
+using namespace SST::Zodiac;
+
+namespace SST {
+namespace Zodiac {
+
+// A mapped trace file, shared by every reader in the process which names
+// the same path and unmapped when the last of them closes it.
+class ZodiacBinaryFile {
+    public:
+	static ZodiacBinaryFile* open(Output* output, const std::string& path) {
+		std::lock_guard<std::mutex> lock(registryLock());
+		std::map<std::string, ZodiacBinaryFile*>& files = registry();
+
+		std::map<std::string, ZodiacBinaryFile*>::iterator file_itr = files.find(path);
+		if(file_itr != files.end()) {
+			file_itr->second->users++;
+			return file_itr->second;
+		}
+
+		ZodiacBinaryFile* file = new ZodiacBinaryFile(output, path);
+		files.insert(std::make_pair(path, file));
+		return file;
+	}
+
+	static void close(ZodiacBinaryFile* file) {
+		std::lock_guard<std::mutex> lock(registryLock());
+
+		if(0 == --file->users) {
+			registry().erase(file->path);
+			delete file;
+		}
+	}
+
+	uint64_t numRanks() const { return header()->numRanks; }
+
+	// Records of one rank, bounds checked against the file when mapped
+	const ZodiacBinaryRecord* records(uint32_t rank, uint64_t& count) const {
+		const ZodiacBinaryRankEntry* entry = reinterpret_cast<const ZodiacBinaryRankEntry*>(
+			image + header()->tableOffset) + rank;
+		count = entry->count;
+		return reinterpret_cast<const ZodiacBinaryRecord*>(image + entry->offset);
+	}
+
+    private:
+	ZodiacBinaryFile(Output* output, const std::string& file_path) :
+		path(file_path), users(1), image(NULL), length(0) {
+
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if(fd < 0) {
+			output->fatal(CALL_INFO, -1, "Error: unable to open the Zodiac binary trace: %s\n", path.c_str());
+		}
+
+		struct stat file_stat;
+		if(0 != fstat(fd, &file_stat)) {
+			output->fatal(CALL_INFO, -1, "Error: unable to read the size of %s\n", path.c_str());
+		}
+
+		length = (size_t) file_stat.st_size;
+		if(length < sizeof(ZodiacBinaryHeader)) {
+			output->fatal(CALL_INFO, -1, "Error: %s is too short to be a Zodiac binary trace\n", path.c_str());
+		}
+
+		void* mapped = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+		if(MAP_FAILED == mapped) {
+			output->fatal(CALL_INFO, -1, "Error: unable to map %s into memory\n", path.c_str());
+		}
+
+		::close(fd);
+		image = (const char*) mapped;
+
+		validate(output);
+	}
+
+	~ZodiacBinaryFile() {
+		munmap((void*) image, length);
+	}
+
+	const ZodiacBinaryHeader* header() const {
+		return reinterpret_cast<const ZodiacBinaryHeader*>(image);
+	}
+
+	void validate(Output* output) {
+		const ZodiacBinaryHeader* hdr = header();
+
+		if(0 != memcmp(hdr->magic, ZODIAC_BINARY_MAGIC, sizeof(hdr->magic)) ||
+			ZODIAC_BINARY_VERSION != hdr->version ||
+			sizeof(ZodiacBinaryRecord) != hdr->recordSize) {
+			output->fatal(CALL_INFO, -1, "Error: %s is not a version %d Zodiac binary trace written on a "
+				"machine like this one\n", path.c_str(), ZODIAC_BINARY_VERSION);
+		}
+
+		if(hdr->tableOffset > length ||
+			hdr->numRanks > (length - hdr->tableOffset) / sizeof(ZodiacBinaryRankEntry)) {
+			output->fatal(CALL_INFO, -1, "Error: the rank table of %s is truncated\n", path.c_str());
+		}
+
+		for(uint64_t i = 0; i < hdr->numRanks; i++) {
+			const ZodiacBinaryRankEntry* entry = reinterpret_cast<const ZodiacBinaryRankEntry*>(
+				image + hdr->tableOffset) + i;
+
+			if(entry->offset > length || 0 != entry->offset % sizeof(uint64_t) ||
+				entry->count > (length - entry->offset) / sizeof(ZodiacBinaryRecord)) {
+				output->fatal(CALL_INFO, -1, "Error: the records of rank %" PRIu64 " in %s are truncated\n",
+					i, path.c_str());
+			}
+		}
+	}
+
+	static std::map<std::string, ZodiacBinaryFile*>& registry() {
+		static std::map<std::string, ZodiacBinaryFile*> files;
+		return files;
+	}
+
+	static std::mutex& registryLock() {
+		static std::mutex lock;
+		return lock;
+	}
+
+	const std::string path;
+	uint32_t users;
+	const char* image;
+	size_t length;
+};
+
+}
+}
+
+ZodiacBinaryReader::ZodiacBinaryReader(const std::string& file, uint32_t focusOnRank, uint32_t maxQLen,
+	std::queue<ZodiacEvent*>* evQ, int verbose) :
+	freeEvents(Z_WAIT + 1)
+{
+	rank = focusOnRank;
+	eventQ = evQ;
+	qLimit = maxQLen;
+	foundFinalize = false;
+
+	output = new Output("ZodiacBinaryReader", verbose, 0, Output::STDOUT);
+	ownOutput = true;
+
+	traceFile = ZodiacBinaryFile::open(output, file);
+
+	if(rank >= traceFile->numRanks()) {
+		output->fatal(CALL_INFO, -1, "Error: %s holds %" PRIu64 " ranks, rank %" PRIu32 " is not one of them\n",
+			file.c_str(), traceFile->numRanks(), rank);
+	}
+
+	uint64_t count = 0;
+	nextRecord = traceFile->records(rank, count);
+	endRecord = nextRecord + count;
+
+	output->verbose(CALL_INFO, 4, 0, "Rank %" PRIu32 " has %" PRIu64 " records in %s\n",
+		rank, count, file.c_str());
+}
+
+ZodiacBinaryReader::~ZodiacBinaryReader() {
+	for(size_t i = 0; i < freeEvents.size(); i++) {
+		for(size_t j = 0; j < freeEvents[i].size(); j++) {
+			delete freeEvents[i][j];
+		}
+	}
+
+	if(ownOutput) {
+		delete output;
+	}
+}
+
+void ZodiacBinaryReader::close() {
+	if(NULL == traceFile) {
+		output->fatal(CALL_INFO, -1, "Error: binary trace closed twice\n");
+	}
+
+	output->verbose(CALL_INFO, 4, 0, "Closing trace file.\n");
+
+	ZodiacBinaryFile::close(traceFile);
+	traceFile = NULL;
+	nextRecord = endRecord = NULL;
+}
+
+void ZodiacBinaryReader::setOutput(Output* oput) {
+	if(ownOutput) {
+		delete output;
+	}
+
+	output = oput;
+	ownOutput = false;
+}
+
+uint32_t ZodiacBinaryReader::generateNextEvents() {
+	while((foundFinalize == false) && (eventQ->size() < qLimit)) {
+		if(nextRecord == endRecord) {
+			output->fatal(CALL_INFO, -1, "Error: rank %" PRIu32 " reached the end of its trace "
+				"without a finalize\n", rank);
+		}
+
+		generateNextEvent(*nextRecord++);
+	}
+
+	return (uint32_t) eventQ->size();
+}
+
+bool ZodiacBinaryReader::hasReachedFinalize() {
+	return foundFinalize;
+}
+
+void ZodiacBinaryReader::release(ZodiacEvent* ev) {
+	freeEvents[ev->getEventType()].push_back(ev);
+}
+
+void ZodiacBinaryReader::generateNextEvent(const ZodiacBinaryRecord& record) {
+	switch(record.type) {
+	case ZBIN_COMPUTE:
+		eventQ->push(build<ZodiacComputeEvent>(Z_COMPUTE, record.time));
+		break;
+
+	case ZBIN_SEND:
+		eventQ->push(build<ZodiacSendEvent>(Z_SEND, (uint32_t) record.peer, record.count,
+			convertToHermesType(record.dtype), (uint32_t) record.tag, (Communicator) record.comm));
+		break;
+
+	case ZBIN_RECV:
+		eventQ->push(build<ZodiacRecvEvent>(Z_RECV, (uint32_t) record.peer, record.count,
+			convertToHermesType(record.dtype), (uint32_t) record.tag, (Communicator) record.comm));
+		break;
+
+	case ZBIN_IRECV:
+		eventQ->push(build<ZodiacIRecvEvent>(Z_IRECV, (uint32_t) record.peer, record.count,
+			convertToHermesType(record.dtype), (uint32_t) record.tag, (Communicator) record.comm,
+			record.request));
+		break;
+
+	case ZBIN_WAIT:
+		eventQ->push(build<ZodiacWaitEvent>(Z_WAIT, record.request));
+		break;
+
+	case ZBIN_BARRIER:
+		eventQ->push(build<ZodiacBarrierEvent>(Z_BARRIER, (Communicator) record.comm));
+		break;
+
+	case ZBIN_ALLREDUCE:
+		eventQ->push(build<ZodiacAllreduceEvent>(Z_ALLREDUCE, record.count,
+			convertToHermesType(record.dtype), convertToHermesOp(record.op),
+			(Communicator) record.comm));
+		break;
+
+	case ZBIN_INIT:
+		eventQ->push(build<ZodiacInitEvent>(Z_INIT));
+		break;
+
+	case ZBIN_FINALIZE:
+		eventQ->push(build<ZodiacFinalizeEvent>(Z_FINALIZE));
+		foundFinalize = true;
+		break;
+
+	default:
+		output->fatal(CALL_INFO, -1, "Error: unknown record type %" PRIu32 " in the trace of rank %" PRIu32 "\n",
+			record.type, rank);
+		break;
+	}
+}
+
+PayloadDataType ZodiacBinaryReader::convertToHermesType(uint16_t dtype) {
+	switch(dtype) {
+	case ZBIN_INT:
+		return INT;
+	case ZBIN_DOUBLE:
+		return DOUBLE;
+	default:
+		return CHAR;
+	}
+}
+
+ReductionOperation ZodiacBinaryReader::convertToHermesOp(uint16_t op) {
+	switch(op) {
+	case ZBIN_SUM:
+		return SUM;
+	case ZBIN_MAX:
+		return MAX;
+	case ZBIN_MIN:
+		return MIN;
+	default:
+		output->fatal(CALL_INFO, -1, "Error: unknown reduction %" PRIu16 " in the trace of rank %" PRIu32 "\n",
+			op, rank);
+		return SUM;
+	}
+}
@@ -0,0 +1,95 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_BINARY_READER
+#define _H_ZODIAC_BINARY_READER
+
+#include <stdint.h>
+
+#include <new>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "sst/core/output.h"
+#include "sst/elements/hermes/msgapi.h"
+
+#include "zbinaryformat.h"
+#include "zreader.h"
+
+using namespace SST::Hermes;
+using namespace SST::Hermes::MP;
+
+namespace SST {
+namespace Zodiac {
+
+class ZodiacBinaryFile;
+
+// Replays one rank of a Zodiac binary trace (see zbinaryformat.h). The
+// file is mapped once per process and shared by every rank reading it,
+// records are turned into events straight from the mapping. Events handed
+// back through release() are reused so a steady state replay does no
+// allocation.
+class ZodiacBinaryReader : public ZodiacReader {
+    public:
+	ZodiacBinaryReader(const std::string& file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
+	~ZodiacBinaryReader();
+	void close();
+	void setOutput(Output* oput);
+	uint32_t generateNextEvents();
+	bool hasReachedFinalize();
+	void release(ZodiacEvent* ev);
+
+    private:
+	// Released events are kept whole so they go back to whichever
+	// allocator built them, reuse rebuilds one in place
+	template<class T, typename... Args>
+	T* build(ZodiacEventType type, Args... args) {
+		std::vector<ZodiacEvent*>& pool = freeEvents[type];
+
+		if(pool.empty()) {
+			return new T(args...);
+		}
+
+		T* ev = static_cast<T*>(pool.back());
+		pool.pop_back();
+
+		ev->~T();
+		return ::new (ev) T(args...);
+	}
+
+	void generateNextEvent(const ZodiacBinaryRecord& record);
+	PayloadDataType convertToHermesType(uint16_t dtype);
+	ReductionOperation convertToHermesOp(uint16_t op);
+
+	Output* output;
+	bool ownOutput;
+	uint32_t rank;
+	uint32_t qLimit;
+	bool foundFinalize;
+	std::queue<ZodiacEvent*>* eventQ;
+	ZodiacBinaryFile* traceFile;
+	const ZodiacBinaryRecord* nextRecord;
+	const ZodiacBinaryRecord* endRecord;
+
+	// released events, indexed by ZodiacEventType
+	std::vector<std::vector<ZodiacEvent*> > freeEvents;
+};
+
+}
+}
+
+#endif
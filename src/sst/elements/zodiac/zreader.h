@@ -0,0 +1,45 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_READER
+#define _H_ZODIAC_READER
+
+#include <stdint.h>
+
+#include "sst/core/output.h"
+
+#include "zevent.h"
+
+namespace SST {
+namespace Zodiac {
+
+// A source of events for one rank's replay. Readers fill the event queue
+// they were created with, events taken from the queue are handed back with
+// release() once they have been processed.
+class ZodiacReader {
+    public:
+	virtual ~ZodiacReader() {}
+	virtual void close() = 0;
+	virtual void setOutput(Output* oput) = 0;
+	virtual uint32_t generateNextEvents() = 0;
+	virtual bool hasReachedFinalize() = 0;
+	virtual void release(ZodiacEvent* ev) { delete ev; }
+};
+
+}
+}
+
+#endif
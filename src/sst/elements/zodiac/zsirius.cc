@@ -67,6 +67,12 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
         std::cout << "Trace prefix: " << trace_file << std::endl;
     }
 
+    trace_format = params.find<std::string>("traceformat", "sirius");
+    if(trace_format != "sirius" && trace_format != "binary") {
+        std::cerr << "Error: unknown trace format " << trace_format << std::endl;
+        exit(-1);
+    }
+
     eventQ = new std::queue<ZodiacEvent*>();
 
     verbosityLevel = params.find("verbose", 0);
@@ -97,11 +103,16 @@ void ZodiacSiriusTraceReader::setup() {
 
     eventQ = new std::queue<ZodiacEvent*>();
 
-    char trace_name[trace_file.length() + 20];
-    sprintf(trace_name, "%s.%d", trace_file.c_str(), rank);
+    if(trace_format == "binary") {
+        printf("Opening trace file: %s (rank %d)\n", trace_file.c_str(), rank);
+        trace = new ZodiacBinaryReader(trace_file, rank, 64, eventQ, verbosityLevel);
+    } else {
+        char trace_name[trace_file.length() + 20];
+        sprintf(trace_name, "%s.%d", trace_file.c_str(), rank);
 
-    printf("Opening trace file: %s\n", trace_name);
-    trace = new SiriusReader(trace_name, rank, 64, eventQ, verbosityLevel);
+        printf("Opening trace file: %s\n", trace_name);
+        trace = new SiriusReader(trace_name, rank, 64, eventQ, verbosityLevel);
+    }
     trace->setOutput(&zOut);
 
     int count = trace->generateNextEvents();
@@ -265,7 +276,7 @@ void ZodiacSiriusTraceReader::handleSelfEvent(Event* ev)
 
 	zOut.verbose(__LINE__, __FILE__, "handleSelfEvent", 0, 16,
 		"Attempting to delete processed event...");
-	delete zEv;
+	trace->release(zEv);
 	zOut.verbose(__LINE__, __FILE__, "handleSelfEvent", 0, 16,
 		"Successfully deleted event.");
 
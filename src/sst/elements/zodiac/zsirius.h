@@ -31,6 +31,7 @@
 #include <sst/elements/hermes/msgapi.h>
 
 #include "siriusreader.h"
+#include "zbinaryreader.h"
 #include "zevent.h"
 
 using namespace SST::Hermes;
@@ -57,7 +58,8 @@ public:
   )
 
   SST_ELI_DOCUMENT_PARAMS(
-	{ "trace", "Set the trace file to be read in for this end point." },
+	{ "trace", "Set the trace file to be read in for this end point, a Sirius trace is the prefix of the per rank files." },
+	{ "traceformat", "Format of the trace, sirius or binary (a single file written by sst-zodiac-convert)", "sirius" },
 	{ "os.module", "Sets the messaging API to use for generation and handling of the message protocol" },
 	{ "scalecompute", "Scale compute event times by a double precision value (allows dilation of times in traces), default is 1.0", "1.0" },
 	{ "verbose", "Sets the verbosity level for the component to output debug/information messages", "0" },
@@ -108,7 +110,7 @@ private:
   Output zOut;
   OS* os;
   MP::Interface* msgapi;
-  SiriusReader* trace;
+  ZodiacReader* trace;
   std::queue<ZodiacEvent*>* eventQ;
   SST::Link* selfLink;
   SST::TimeConverter* tConv;
@@ -129,6 +131,7 @@ private:
   MessageResponse* currentRecv;
   int rank;
   string trace_file;
+  string trace_format;
   int verbosityLevel;
 
   uint64_t zSendCount;